@@ -0,0 +1,68 @@
+"""
+Times the global Newton method and iterated polymatrix approximation
+solvers on the action graph games in contrib/games.
+
+Usage: aggbench.py [-n REPEATS] BINDIR [BASELINEDIR]
+
+BINDIR (and optionally BASELINEDIR) is a directory containing
+gambit-gnm and gambit-ipa.  For each game and solver, the best wall
+time over REPEATS runs is reported; if a baseline directory is given,
+the baseline time and the speedup relative to it are reported as well,
+and the script checks that both builds print the same equilibria.
+"""
+
+from __future__ import print_function
+
+import os, sys, time, glob, getopt, subprocess
+
+SOLVERS = [ "gnm", "ipa" ]
+
+def game_files():
+    here = os.path.dirname(os.path.abspath(__file__))
+    games = os.path.join(here, "..", "..", "games")
+    return sorted(glob.glob(os.path.join(games, "*.agg")) +
+                  glob.glob(os.path.join(games, "*.bagg")))
+
+def run(bindir, solver, game, repeats):
+    """
+    Runs the solver on the game 'repeats' times, and returns the best
+    wall time and the output of the last run.
+    """
+    prog = os.path.join(bindir, "gambit-%s" % solver)
+    best = None
+    for i in range(repeats):
+        start = time.time()
+        output = subprocess.check_output([ prog, "-q", game ])
+        elapsed = time.time() - start
+        if best is None or elapsed < best:
+            best = elapsed
+    return best, output
+
+def main(argv):
+    opts, args = getopt.getopt(argv, "n:")
+    repeats = 3
+    for opt, val in opts:
+        if opt == "-n":
+            repeats = int(val)
+    if len(args) not in [ 1, 2 ]:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    status = 0
+    for game in game_files():
+        for solver in SOLVERS:
+            elapsed, output = run(args[0], solver, game, repeats)
+            line = "%-32s %-4s %9.3fs" % (os.path.basename(game), solver,
+                                          elapsed)
+            if len(args) == 2:
+                base, base_output = run(args[1], solver, game, repeats)
+                line += " %9.3fs %6.2fx" % (base, base / max(elapsed, 1e-6))
+                if output != base_output:
+                    line += "  OUTPUT DIFFERS"
+                    status = 1
+            print(line)
+            sys.stdout.flush()
+    return status
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
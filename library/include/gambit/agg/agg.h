@@ -98,7 +98,6 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
    std::vector<std::vector<std::vector<config> > >& proj,
    std::vector<std::vector<proj_func*> > & projF,
    std::vector<std::vector<std::vector<int> > >& Po,
-   std::vector<aggdistrib> &P,
       std::vector<aggpayoff>& payoffs);
 
 
@@ -107,6 +106,9 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
 
   //destructor
   virtual ~AGG(){
+      for (size_t i=0;i<contextPool.size();++i){
+        delete contextPool[i];
+      }
       delete [] actions;
       delete [] strategyOffset;
       //free projFunctions
@@ -153,11 +155,67 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
   }
 
 
+  //Working storage for computing expected payoffs.  Evaluating a
+  //payoff only writes to the context it is given, so several threads
+  //may evaluate the same AGG concurrently, each with its own context.
+  class Context {
+  public:
+    Context(const AGG &g);
+
+    //foreach s \in S, foreach i \in N, the projected mixed strat
+    //which is a prob distribution over the set of 'contributions'
+    std::vector< std::vector<aggdistrib > > projectedStrat;
+
+    //when computing the induced distribution via ComputeP():
+    //foreach k<= n-1,
+    //prob. distrib P_k induced by the partial strat profile of agents o_1..o_k
+
+    //when computing the partial distributions for the payoff jacobian:
+    //  foreach  j \in N,
+    // the partial distribution induced by all agents except j.
+    std::vector<aggdistrib>  Pr;
+
+    //cache of jacobian entries.
+    trie_map<AggNumber> cache;
+
+    //scratch distributions for the k-symmetric payoffs
+    aggdistrib d, temp;
+
+    //scratch mixed strategy profile, with one entry per action, for
+    //callers converting a profile from another representation
+    StrategyProfile profile;
+  };
+
+  //Borrows a context from the AGG's pool for the lifetime of the object.
+  //The versions of the payoff functions without a context argument
+  //use one of these.
+  class ContextLease {
+  public:
+    ContextLease(AGG &g) : game(g), context(g.acquireContext()) { }
+    ~ContextLease() { game.releaseContext(context); }
+    operator Context &() { return *context; }
+    Context *operator->() { return context; }
+  private:
+    AGG &game;
+    Context *context;
+
+    ContextLease(const ContextLease &);
+    ContextLease &operator=(const ContextLease &);
+  };
+
   //exp. payoff under mixed strat profile
-  AggNumber getMixedPayoff(int player, StrategyProfile &s);
-  void getPayoffVector(AggNumberVector &dest, int player,const StrategyProfile &s);
-  AggNumber getV (int player, int action,const StrategyProfile &s);
-  AggNumber getJ(int player,int action, int player2,int action2,StrategyProfile &s);
+  AggNumber getMixedPayoff(int player, StrategyProfile &s)
+    { ContextLease c(*this); return getMixedPayoff(c, player, s); }
+  AggNumber getMixedPayoff(Context &c, int player, const StrategyProfile &s);
+  void getPayoffVector(AggNumberVector &dest, int player,const StrategyProfile &s)
+    { ContextLease c(*this); getPayoffVector(c, dest, player, s); }
+  void getPayoffVector(Context &c, AggNumberVector &dest, int player,const StrategyProfile &s);
+  AggNumber getV (int player, int action,const StrategyProfile &s)
+    { ContextLease c(*this); return getV(c, player, action, s); }
+  AggNumber getV (Context &c, int player, int action,const StrategyProfile &s);
+  AggNumber getJ(int player,int action, int player2,int action2,StrategyProfile &s)
+    { ContextLease c(*this); return getJ(c, player, action, player2, action2, s); }
+  AggNumber getJ(Context &c, int player,int action, int player2,int action2,const StrategyProfile &s);
 
 
   AggNumber getPurePayoff(int player, int *s);
@@ -172,14 +230,30 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
     }
     return true;
   }
-  AggNumber getSymMixedPayoff( StrategyProfile &s);
-  AggNumber getSymMixedPayoff(int actnode, StrategyProfile &s);
-  void getSymPayoffVector(AggNumberVector& dest, StrategyProfile &s);
-  AggNumber getKSymMixedPayoff( int playerClass,std::vector<StrategyProfile> &s);
-  AggNumber getKSymMixedPayoff( int playerClass,StrategyProfile &s);
-  AggNumber getKSymMixedPayoff(int playerClass, int act, std::vector<StrategyProfile> &s);
-  AggNumber getKSymMixedPayoff(const StrategyProfile &s,int pClass1,int act1,int pClass2=-1,int act2=-1);
-  void getKSymPayoffVector(AggNumberVector& dest, int playerClass, StrategyProfile &s);
+  AggNumber getSymMixedPayoff( StrategyProfile &s)
+    { ContextLease c(*this); return getSymMixedPayoff(c, s); }
+  AggNumber getSymMixedPayoff(Context &c, const StrategyProfile &s);
+  AggNumber getSymMixedPayoff(int actnode, StrategyProfile &s)
+    { ContextLease c(*this); return getSymMixedPayoff(c, actnode, s); }
+  AggNumber getSymMixedPayoff(Context &c, int actnode, const StrategyProfile &s);
+  void getSymPayoffVector(AggNumberVector& dest, StrategyProfile &s)
+    { ContextLease c(*this); getSymPayoffVector(c, dest, s); }
+  void getSymPayoffVector(Context &c, AggNumberVector& dest, const StrategyProfile &s);
+  AggNumber getKSymMixedPayoff( int playerClass,std::vector<StrategyProfile> &s)
+    { ContextLease c(*this); return getKSymMixedPayoff(c, playerClass, s); }
+  AggNumber getKSymMixedPayoff(Context &c, int playerClass,const std::vector<StrategyProfile> &s);
+  AggNumber getKSymMixedPayoff( int playerClass,StrategyProfile &s)
+    { ContextLease c(*this); return getKSymMixedPayoff(c, playerClass, s); }
+  AggNumber getKSymMixedPayoff(Context &c, int playerClass,const StrategyProfile &s);
+  AggNumber getKSymMixedPayoff(int playerClass, int act, std::vector<StrategyProfile> &s)
+    { ContextLease c(*this); return getKSymMixedPayoff(c, playerClass, act, s); }
+  AggNumber getKSymMixedPayoff(Context &c, int playerClass, int act, const std::vector<StrategyProfile> &s);
+  AggNumber getKSymMixedPayoff(const StrategyProfile &s,int pClass1,int act1,int pClass2=-1,int act2=-1)
+    { ContextLease c(*this); return getKSymMixedPayoff(c, s, pClass1, act1, pClass2, act2); }
+  AggNumber getKSymMixedPayoff(Context &c, const StrategyProfile &s,int pClass1,int act1,int pClass2=-1,int act2=-1);
+  void getKSymPayoffVector(AggNumberVector& dest, int playerClass, StrategyProfile &s)
+    { ContextLease c(*this); getKSymPayoffVector(c, dest, playerClass, s); }
+  void getKSymPayoffVector(Context &c, AggNumberVector& dest, int playerClass, const StrategyProfile &s);
 
 
 
@@ -202,8 +276,8 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
   const std::vector<int>& getActionSet(int player){return actionSets.at(player);}
   const aggpayoff& getPayoffMap(int node){return payoffs.at(node);}
 
-  AggNumber getMaxPayoff();
-  AggNumber getMinPayoff();
+  AggNumber getMaxPayoff() const { return maxPayoff; }
+  AggNumber getMinPayoff() const { return minPayoff; }
 
 
 
@@ -212,6 +286,11 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
   int numPlayers;
   int *actions;
 private:
+  //an AGG owns its arrays and the contexts in its pool, so it is not
+  //to be copied
+  AGG(const AGG &);
+  AGG &operator=(const AGG &);
+
   int *strategyOffset;
   int totalActions;
   int maxActions;
@@ -232,6 +311,18 @@ private:
   //payoff function for each action node \in S
   std::vector<aggpayoff> payoffs;
 
+  //dense index of the payoff function, for each action node \in S:
+  //configuration c is stored in row-major order at offset c-payoffLow
+  //in a box of size payoffExtent.  densePayoffs[s] is empty if the
+  //configurations are too sparse for a flat array, in which case
+  //lookups fall back to payoffs[s].
+  std::vector<config> payoffLow, payoffExtent;
+  std::vector<AggNumberVector> densePayoffs;
+  std::vector<std::vector<char> > densePresent;
+
+  //extreme payoff values over all action nodes
+  AggNumber maxPayoff, minPayoff;
+
   //auxillary data strucutres
 
   //originally:
@@ -244,10 +335,6 @@ private:
   // the contribution of s' to D^(s)
   //std::vector<std::vector<config> > projection;
 
-  //foreach s \in S, foreach i \in N, the projected mixed strat
-  //which is a prob distribution over the set of 'contributions'
-  std::vector< std::vector<aggdistrib > > projectedStrat;
-
   // foreach s in S, i in N, the full set of projected actions.
   std::vector<std::vector<aggdistrib> >fullProjectedStrat;
 
@@ -258,23 +345,19 @@ private:
   // in which we apply the DP algorithm
   std::vector< std::vector< std::vector<int> > > Porder;
 
-  //when computing the induced distribution via ComputeP():
-  //foreach k<= n-1,  
-  //prob. distrib P_k induced by the partial strat profile of agents o_1..o_k
-
-  //when computing the partial distributions for the payoff jacobian:
-  //  foreach  j \in N,
-  // the partial distribution induced by all agents except j. 
-  std::vector<aggdistrib>  Pr;
-
   //foreach s in S, whether s's neighbors are all action nodes
   std::vector<bool> isPure;
 
   //foreach s in S, j in N, the index of s in j's action set, or -1 if N/A
   std::vector<std::vector<int> > node2Action;
 
-  //cache of jacobian entries.
-  trie_map<AggNumber> cache;
+  //foreach s in S, the smallest action node with the same neighbor list
+  //as s.  Projections onto nodes in one class coincide, and so do
+  //the distributions induced by the other players.
+  std::vector<int> neighborClass;
+
+  //contexts not currently lent out by a ContextLease
+  std::vector<Context *> contextPool;
 
   //the unique action sets
   std::vector<ActionSet> uniqueActionSets;
@@ -336,17 +419,24 @@ private:
 
 
   //private methods:
-  void computeP(int player, int act, int player2=-1,int act2=-1);
-  void doProjection(int Node,const StrategyProfile& s){
-	  doProjection (Node, &(const_cast<StrategyProfile &>(s)[0]));
+  Context *acquireContext();
+  void releaseContext(Context *);
+  void computeP(Context &c, int player, int act, int player2=-1,int act2=-1);
+  void computeOthersP(Context &c, int player, int act);
+  void indexPayoffs();
+  inline bool findPayoff(int Node, const config &c, AggNumber &value) const;
+  AggNumber expectedPayoff(int Node, const aggdistrib &P) const;
+  AggNumber expectedPayoff(int Node, const aggdistrib &P, const config &x) const;
+  void doProjection(Context &c, int Node,const StrategyProfile& s){
+	  doProjection (c, Node, &(s[0]));
   }
-  void doProjection(int Node, int player, const StrategyProfile& s){
-	  doProjection(Node,player, &(const_cast<StrategyProfile &>(s)[firstAction(player)]));
+  void doProjection(Context &c, int Node, int player, const StrategyProfile& s){
+	  doProjection(c, Node,player, &(s[firstAction(player)]));
   }
-  void doProjection(int Node, AggNumber* s);
-  void doProjection(int Node, int player, AggNumber* s);
+  void doProjection(Context &c, int Node, const AggNumber* s);
+  void doProjection(Context &c, int Node, int player, const AggNumber* s);
 
-  void getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int act, aggdistrib &dest,int plClass2=-1,int act2=-1);
+  void getSymConfigProb(Context &c, int plClass, const StrategyProfile &s, int ownPlClass, int act, aggdistrib &dest,int plClass2=-1,int act2=-1);
 };
 
 }  // end namespace Gambit::agg
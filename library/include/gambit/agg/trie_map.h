@@ -141,6 +141,7 @@ public:
 	iterator endp = data.end();
 #endif
 	data.clear();
+	spare.clear();
 #ifdef AGGDEBUG
 	if(endp != end()) {std::cerr<<"Error: end() changed"<<std::endl; exit(1);}
 #endif
@@ -170,7 +171,8 @@ public:
       leaves.back()->val=data.end();
       leaves.pop_back();
     }
-    data.clear();
+    //keep the list nodes for reuse by later insertions
+    spare.splice(spare.end(), data);
   }
 
   //number of elements with key exactly k.
@@ -194,8 +196,8 @@ public:
   void multiply (const trie_map<V>& t1,const trie_map<V>& t2,size_t keylen,
 	 std::vector<proj_func*>& f)
   {
-    static size_t i;
-    static std::pair<std::vector<int>, V> v;
+    size_t i;
+    std::pair<std::vector<int>, V> v;
     const_iterator p1,p2;
     //assert(this!=&t1 && this != &t2);
     v.first.resize(keylen);
@@ -219,7 +221,7 @@ public:
   void multiply_smart (const trie_map<V>& P_k_minus_1,const trie_map<V>& projectedStrat,size_t keylen,
                         std::vector<proj_func*>& f)
         {
-                static std::pair<std::vector<int>, V> v;
+                std::pair<std::vector<int>, V> v;
                 v.first.resize(keylen);
                 reset();
 
@@ -274,7 +276,7 @@ public:
 
   //squaring
   void square(trie_map<V>& dest, size_t keylen, std::vector<proj_func*>& f) const{
-    static std::pair<std::vector<int>, V> v;
+    std::pair<std::vector<int>, V> v;
     v.first.resize(keylen);
     //assert(this!=&dest);
     dest.reset();
@@ -293,8 +295,8 @@ public:
 
   //squaring in-place
   void square(size_t keylen, std::vector<proj_func*>& f){
-    static typename std::list<typename trie_map<V>::value_type>::iterator p1,p2;
-    static std::pair<std::vector<int>, V> v;
+    typename std::list<typename trie_map<V>::value_type>::iterator p1,p2;
+    std::pair<std::vector<int>, V> v;
     v.first.resize(keylen);
     std::list<typename trie_map<V>::value_type> data2;
     //data.swap(data2);
@@ -385,7 +387,7 @@ public:
   { 
     V result(init);
     V th(THRESH);
-    static iterator p2;
+    iterator p2;
     //V s(-1);
     for (const_iterator p=begin(); p!=end();++p)if((*p).second>(V)0){
       value_type y= *p;
@@ -428,6 +430,9 @@ private:
 
   std::vector<TrieNode<V>*> leaves;
 
+  //list nodes released by reset(), recycled by push_front()
+  std::list<value_type> spare;
+
   static const double  THRESH;
   
   
@@ -445,11 +450,29 @@ private:
 
 
   //private methods:
+  //store a copy of x at the front of data, reusing a spare node if possible
+  inline iterator push_front(const value_type& x){
+    if (spare.empty()) return data.insert(data.begin(), x);
+    data.splice(data.begin(), spare, spare.begin());
+    data.front() = x;
+    return data.begin();
+  }
+
   //div: helper for operator/=()
   void  div(const std::vector<V>& denom, TrieNode<V>* n, int current, int pivot);
 
 
 
+  //point the nodes of the subtree holding no value at to instead of from
+  __attribute__((noinline)) void replaceEnd(TrieNode<V> *n, iterator from, iterator to){
+	if (!n) return;
+	if (n->val==from) n->val=to;
+	size_type i,s=n->children.size();
+	for (i=0;i<s;++i) if (n->children[i]) {
+	  replaceEnd (n->children[i], from, to);
+	}
+  }
+
   __attribute__((noinline)) void deleteNodes(TrieNode<V> *n){
 	if (!n) return;
 	size_type i,s=n->children.size();
@@ -23,6 +23,7 @@
 #ifndef LIBGAMBIT_BEHAVSPT_H
 #define LIBGAMBIT_BEHAVSPT_H
 
+#include <vector>
 #include "game.h"
 
 namespace Gambit {
@@ -39,17 +40,25 @@ protected:
   Game m_efg;
   Array<Array<Array<GameAction> > > m_actions;
 
-  Array<List<bool> > m_infosetActive;
-  Array<List<List<bool> > > m_nonterminalActive;
+  /// Activity flags of nonterminal nodes, indexed by node number
+  std::vector<bool> m_nodeActive;
+  /// Number of active members of each information set, indexed
+  /// consecutively across players, starting with chance
+  Array<int> m_numActiveMembers;
+  /// Offset of each player's information sets in m_numActiveMembers
+  Array<int> m_infosetOffset;
 
+  int InfosetIndex(const GameInfoset &p_infoset) const
+  { return m_infosetOffset[p_infoset->GetPlayer()->GetNumber()] + p_infoset->GetNumber(); }
   void activate(const GameNode &);
   void deactivate(const GameNode &);
-  void activate(const GameInfoset &);
-  void deactivate(const GameInfoset &);
-  bool HasActiveMembers(int pl, int iset) const;
+  bool HasActiveMembers(int pl, int iset) const
+  { return m_numActiveMembers[m_infosetOffset[pl] + iset] > 0; }
   void ActivateSubtree(const GameNode &);
   void DeactivateSubtree(const GameNode &);
   void DeactivateSubtree(const GameNode &, List<GameInfoset> &);
+  void AppendReachableNonterminalNodes(const GameNode &, List<GameNode> &) const;
+  void AppendReachableMembers(const GameInfoset &, List<GameNode> &) const;
 
 public:
   /// @name Lifecycle
@@ -0,0 +1,126 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/context.h
+// Budgets and cancellation for runs of the solvers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_CONTEXT_H
+#define LIBGAMBIT_CONTEXT_H
+
+#include <csignal>
+
+namespace Gambit {
+
+/// The reason a solver stopped
+enum SolverStatus {
+  /// The solver ran to completion
+  SOLVER_COMPLETED = 0,
+  /// Cancellation was requested through the context's token
+  SOLVER_CANCELLED,
+  /// The context's deadline passed
+  SOLVER_DEADLINE_PASSED,
+  /// Peak memory use exceeded the context's ceiling
+  SOLVER_MEMORY_EXCEEDED,
+  /// The context's budget of iterations was used up
+  SOLVER_ITERATIONS_EXCEEDED
+};
+
+///
+/// A flag asking the solvers which hold it to stop.  It may be set from
+/// another thread, or from a signal handler.
+///
+class CancellationToken {
+public:
+  CancellationToken(void) : m_cancelled(0) { }
+
+  void Cancel(void) { m_cancelled = 1; }
+  bool IsCancelled(void) const { return m_cancelled != 0; }
+
+private:
+  volatile sig_atomic_t m_cancelled;
+};
+
+///
+/// Thrown by SolverContext::Check() when a solver should stop.  Solvers
+/// catch this, and return the equilibria found so far.
+///
+class SolverInterrupted : public Exception {
+public:
+  SolverInterrupted(SolverStatus p_status) : m_status(p_status) { }
+  virtual ~SolverInterrupted() throw() { }
+  const char *what(void) const throw();
+
+  SolverStatus GetStatus(void) const { return m_status; }
+
+private:
+  SolverStatus m_status;
+};
+
+///
+/// The budgets for a computation: a deadline, a ceiling on memory, a
+/// number of iterations, and a token for cancellation.  Solvers call
+/// Check() at each pivot, step, or support considered.  A context is
+/// meant to cover one computation, which may run several solvers (as
+/// in solving by subgames) on several threads; the iteration budget is
+/// shared among all of them, not allotted to each.  Once a budget is
+/// exhausted, every later Check() fails, and GetStatus() records why,
+/// until Reset() is called.
+///
+class SolverContext {
+public:
+  SolverContext(void);
+
+  /// Sets the deadline, as a time returned by Stats::WallClock()
+  void SetDeadline(double p_deadline) { m_deadline = p_deadline; }
+  /// Sets the deadline to p_seconds from now
+  void SetTimeLimit(double p_seconds);
+  /// Sets the ceiling on the peak resident memory of the process, in
+  /// kilobytes.  This is not enforced on Windows.
+  void SetMemoryLimit(long p_kilobytes) { m_memoryLimit = p_kilobytes; }
+  /// Sets the number of calls to Check() allowed
+  void SetIterationLimit(long p_iterations) { m_iterationLimit = p_iterations; }
+  void SetCancellationToken(shared_ptr<CancellationToken> p_token)
+  { m_token = p_token; }
+
+  /// Returns the number of calls to Check() so far
+  long NumIterations(void) const { return m_iterations; }
+  SolverStatus GetStatus(void) const { return m_status; }
+  bool IsInterrupted(void) const { return m_status != SOLVER_COMPLETED; }
+  /// Clears the count of iterations and the status, so the context may
+  /// be used for another computation.  The deadline, which is a point in
+  /// time, and the cancellation token are left as they are.
+  void Reset(void);
+
+  /// Throws SolverInterrupted if any budget is exhausted, or if
+  /// cancellation has been requested.  Memory is sampled only on every
+  /// 64th call, as measuring it requires a system call.
+  void Check(void);
+
+private:
+  double m_deadline;
+  long m_memoryLimit, m_iterationLimit, m_iterations;
+  shared_ptr<CancellationToken> m_token;
+  SolverStatus m_status;
+
+  void Interrupt(SolverStatus);
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_CONTEXT_H
@@ -125,6 +125,8 @@ public:
 #include "matrix.h"
 
 #include "rational.h"
+#include "stats.h"
+#include "context.h"
 
 
 #include "game.h"
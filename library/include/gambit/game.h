@@ -241,6 +241,9 @@ public:
     m_payoffs[pl] = p_value;
     //m_game->ClearComputedValues();
   }
+  /// Sets the payoff to player 'pl' to an exact rational value
+  void SetPayoff(int pl, const Rational &p_value)
+  { m_payoffs[pl] = p_value; }
 
   /// Map the outcome to the corresponding outcome in the unrestricted game
   GameOutcome Unrestrict(void) const 
@@ -42,6 +42,7 @@ private:
   //@{
   void IndexStrategies(void);
   void RebuildTable(void);
+  void UniqueOutcomes(void);
   //@}
 
 public:
@@ -122,6 +123,38 @@ public:
   virtual void WriteNfgFile(std::ostream &) const;
   //@}
 
+  /// @name Bulk access to payoffs
+  //@{
+  /// Returns the number of contingencies (cells) in the table
+  int NumContingencies(void) const { return m_results.Length(); }
+  /// \brief Copies the payoffs at all contingencies as doubles
+  ///
+  /// Writes the payoff to player pl at the contingency with index c
+  /// to p_payoffs[(pl-1) * NumContingencies() + c-1].  Contingencies are
+  /// indexed as by PureStrategyProfile, with the strategy of player 1
+  /// varying fastest.  Payoffs at contingencies with no outcome are zero.
+  void GetPayoffs(double *p_payoffs) const;
+  /// \brief Returns the payoff to player pl at the contingency with index c
+  ///
+  /// Contingencies are indexed as for GetPayoffs().  No reference counts
+  /// are changed, so this may be called from several threads at once,
+  /// provided the game is not modified meanwhile.
+  const Rational &GetContingencyPayoff(int p_cont, int p_player) const;
+  /// \brief Sets the payoffs at all contingencies from doubles
+  ///
+  /// The array is laid out as for GetPayoffs().  Each double is converted
+  /// exactly to a rational.  Every contingency is given an outcome of its
+  /// own, so payoffs are never shared between cells after the call.
+  /// Throws ValueException if any entry is not finite.
+  void SetPayoffs(const double *p_payoffs);
+  /// \brief Sets the payoffs at all contingencies from rationals
+  ///
+  /// As SetPayoffs(const double *), with the payoff being
+  /// p_num[i] / p_den[i].  Throws ZeroDivideException if any
+  /// denominator is zero.
+  void SetPayoffs(const long *p_num, const long *p_den);
+  //@}
+
   virtual PureStrategyProfile NewPureStrategyProfile(void) const;
   virtual MixedStrategyProfile<double> NewMixedStrategyProfile(double) const;
   virtual MixedStrategyProfile<Rational> NewMixedStrategyProfile(const Rational &) const; 
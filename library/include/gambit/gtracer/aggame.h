@@ -26,8 +26,8 @@
 
 #include "cmatrix.h"
 #include "gnmgame.h"
-#include "gambit/agg/agg.h"
 #include "gambit/gambit.h"
+#include "gambit/agg/agg.h"
 #include "gambit/gameagg.h"
 
 namespace Gambit {
@@ -47,13 +47,13 @@ class aggame : public gnmgame {
 
     aggame ( Gambit::agg::AGG *_aggPtr)
       :gnmgame(_aggPtr->getNumPlayers(), _aggPtr->actions),
-      aggPtr (_aggPtr)
+      aggPtr (_aggPtr), ctx(*_aggPtr)
     {
     }
 
     aggame(Gambit::GameAggRep& g)
       :gnmgame(g.aggPtr->getNumPlayers(), g.aggPtr->actions),
-      aggPtr (g.aggPtr)
+      aggPtr (g.aggPtr), ctx(*g.aggPtr)
     {
     }
 
@@ -66,12 +66,12 @@ class aggame : public gnmgame {
 
     double getMixedPayoff(int player, cvector &s){
       std::vector<double> sp (s.values(), s.values()+s.getm());
-      return (double)aggPtr->getMixedPayoff(player,sp);
+      return (double)aggPtr->getMixedPayoff(ctx,player,sp);
     }
 
     double getKSymMixedPayoff(int cls, cvector &s){
       std::vector<double> sp (s.values(), s.values()+s.getm());
-      return (double) aggPtr->getKSymMixedPayoff(cls,sp);
+      return (double) aggPtr->getKSymMixedPayoff(ctx,cls,sp);
     }
 
     void payoffMatrix(cmatrix &dest, cvector &s, double fuzz);
@@ -92,19 +92,19 @@ class aggame : public gnmgame {
       cvector & ss = const_cast<cvector &>(s);
       std::vector<double> sp (ss.values(), ss.values()+ss.getm());
       std::vector<double> d(aggPtr->getNumActions(player));
-      aggPtr->getPayoffVector(d,player,sp);
+      aggPtr->getPayoffVector(ctx,d,player,sp);
       std::copy(d.begin(),d.end(), dest.values());
     }
     void getSymPayoffVector(cvector& dest, cvector &s){
       std::vector<double> sp (s.values(), s.values()+s.getm());
       std::vector<double> d(aggPtr->getNumActionNodes());
-      aggPtr->getSymPayoffVector(d,sp);
+      aggPtr->getSymPayoffVector(ctx,d,sp);
       std::copy(d.begin(),d.end(), dest.values());
     }
     void getKSymPayoffVector(cvector &dest, int playerClass, cvector &s){
       std::vector<double> sp (s.values(), s.values()+s.getm());
       std::vector<double> d (aggPtr->getNumKSymActions(playerClass));
-      aggPtr->getKSymPayoffVector(d,playerClass,sp);
+      aggPtr->getKSymPayoffVector(ctx,d,playerClass,sp);
       std::copy(d.begin(),d.end(), dest.values());
     }
     double getPurePayoff(int player, int* s){
@@ -139,6 +139,9 @@ class aggame : public gnmgame {
     Gambit::agg::AGG *aggPtr;
 
   private:
+    //scratch space for evaluating payoffs of *aggPtr; several aggames
+    //may share one AGG, e.g. on different threads
+    Gambit::agg::AGG::Context ctx;
 
   //helper functions for computing jacobian
     void computePartialP_PureNode(int player,int act,std::vector<int>& tasks);
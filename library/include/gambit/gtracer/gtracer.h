@@ -33,9 +33,12 @@
 namespace Gambit {
 namespace gametracer {
 
-int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold, bool verbose);
+// If a context is given, GNM checks its budgets at each step, and
+// returns the equilibria found so far once they are exhausted; IPA
+// checks them at each iteration, and throws SolverInterrupted.
+int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold, bool verbose, SolverContext *p_context = 0);
 
-int IPA(gnmgame &A, cvector &g, cvector &zh, double alpha, double fuzz, cvector &ans,int maxiter=-1);
+int IPA(gnmgame &A, cvector &g, cvector &zh, double alpha, double fuzz, cvector &ans,int maxiter=-1, SolverContext *p_context = 0);
 
 }  // end namespace Gambit::gametracer
 }  // end namespace Gambit
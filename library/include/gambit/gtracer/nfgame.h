@@ -27,6 +27,8 @@
 
 #include "gnmgame.h"
 #include "cmatrix.h"
+#include "gambit/gambit.h"
+#include "gambit/gametable.h"
 
 namespace Gambit {
 namespace gametracer {
@@ -35,6 +37,9 @@ class nfgame : public gnmgame {
  public:
   friend std::ostream& operator<< (std::ostream& s, nfgame& g);
   nfgame(int numPlayers, int *actions, const cvector &payoffs);
+  // Reads the payoffs directly from the table of a strategic game, 
+  // storing (payoff - offset) * scale for each payoff.
+  nfgame(const Gambit::GameTableRep &g, double offset = 0.0, double scale = 1.0);
   ~nfgame();
 
   // Input: s[i] has integer index of player i's pure strategy
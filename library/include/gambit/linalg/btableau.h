@@ -86,6 +86,7 @@ protected:
   long npivots;
   T eps1,eps2;
   Array<int> artificial;  // artificial variables
+  SolverContext *m_context;  // budgets checked before each pivot, if any
 
 public:
   TableauInterface(const Matrix<T> &A, const Vector<T> &b); 
@@ -113,6 +114,12 @@ public:
 
   long NumPivots() const;
   long &NumPivots();
+
+  /// Sets the context whose budgets are checked before each pivot;
+  /// Pivot() then throws SolverInterrupted once they are exhausted.
+  /// The context is shared by copies of the tableau.
+  void SetContext(SolverContext *p_context) { m_context = p_context; }
+  SolverContext *GetContext(void) const { return m_context; }
   
   void Mark(int label);     // marks label to block it from entering basis
   void UnMark(int label);   // unmarks label
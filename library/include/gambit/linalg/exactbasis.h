@@ -0,0 +1,92 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/linalg/exactbasis.h
+// Exact solution of linear systems for a known basis
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_LINALG_EXACTBASIS_H
+#define GAMBIT_LINALG_EXACTBASIS_H
+
+#include "gambit/gambit.h"
+#include "gambit/sqmatrix.h"
+#include "gambit/linalg/bfs.h"
+
+namespace Gambit {
+
+namespace linalg {
+
+/// Arithmetic used by ExactBasis to solve systems in its basis
+enum ExactBackend {
+  /// Gaussian elimination over the rationals
+  EXACT_RATIONAL,
+  /// Elimination modulo several word-sized primes, with the rational
+  /// solution recovered by Chinese remaindering and rational reconstruction
+  EXACT_MODULAR
+};
+
+///
+/// Solves the square system A x = b exactly, by Gaussian elimination
+/// modulo word-sized primes (several in parallel, when OpenMP is
+/// available).  Primes are added until the reconstructed solution
+/// satisfies the system, or until the Hadamard bound guarantees it does.
+/// x must be indexed by the columns of A.  Throws
+/// SingularMatrixException if A is singular.
+///
+void ModularSolve(const SquareMatrix<Rational> &A, const Vector<Rational> &b,
+		  Vector<Rational> &x);
+
+///
+/// A basis of the system [A I] z = b used by the tableau classes, known
+/// in advance (typically found by pivoting in floating point).  As in
+/// the tableaux, a positive label j denotes column j of A, and a
+/// negative label -i the slack column for row i.  The basic solution
+/// and dual vector are computed directly in exact arithmetic, rather
+/// than by exact pivoting along a path to the basis.
+///
+class ExactBasis {
+public:
+  /// Labels are indexed by the rows of A, giving the basic variable of
+  /// each row.  Throws IndexException if a label does not denote a
+  /// column of [A I].
+  ExactBasis(const Matrix<Rational> &A, const Array<int> &p_labels,
+	     ExactBackend p_backend = EXACT_MODULAR);
+
+  /// Solves B x = b, with b and x indexed by the rows of A.  Throws
+  /// SingularMatrixException if the basis is singular.
+  void Solve(const Vector<Rational> &b, Vector<Rational> &x) const;
+  /// Solves y B = c, with c indexed by the rows of A (so c[i] is the
+  /// cost of the basic variable of row i)
+  void SolveT(const Vector<Rational> &c, Vector<Rational> &y) const;
+  /// Returns the basic solution of [A I] z = b, indexed by label
+  BFS<Rational> GetBFS(const Vector<Rational> &b) const;
+
+private:
+  Array<int> m_labels;
+  SquareMatrix<Rational> m_matrix;
+  ExactBackend m_backend;
+
+  void Solve(const SquareMatrix<Rational> &,
+	     const Vector<Rational> &, Vector<Rational> &) const;
+};
+
+}  // end namespace Gambit::linalg
+
+}  // end namespace Gambit
+
+#endif  // GAMBIT_LINALG_EXACTBASIS_H
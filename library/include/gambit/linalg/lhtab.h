@@ -60,6 +60,9 @@ public:
   /// Perform apivot operation -- outgoing is row, incoming is column
   void Pivot(int outrow, int inlabel);
   long NumPivots(void) const { return T1.NumPivots() + T2.NumPivots(); }
+  /// Sets the context whose budgets are checked before each pivot
+  void SetContext(SolverContext *p_context)
+  { T1.SetContext(p_context);  T2.SetContext(p_context); }
   //@}
 
   /// @name Raw Tableau functions
@@ -74,7 +77,9 @@ public:
   int PivotIn(int i);
   int ExitIndex(int i);
   /// Follow a path of ACBFS's from one CBFS to another
-  int LemkePath(int dup);
+  int LemkePath(int dup, long maxPivots = 0);
+  /// Return the basic variables, indexed by row
+  Array<int> GetLabels(void) const;
   //@}
 
 protected:
@@ -59,10 +59,14 @@ private:
   int Exit(int);
 
   static Array<int> Artificials(const Vector<T> &);
+  void Release(void);
   
 public:
+  /// nequals is the number of equalities (the last nequals rows).  If
+  /// a context is given, its budgets are checked at each pivot, and
+  /// SolverInterrupted is thrown once they are exhausted.
   LPSolve(const Matrix<T> &A, const Vector<T> &B, const Vector<T> &C,
-	  int nequals);   // nequals = number of equalities (last nequals rows)
+	  int nequals, SolverContext *p_context = 0);
   ~LPSolve();
   
   T OptimumCost(void) const { return total_cost; }
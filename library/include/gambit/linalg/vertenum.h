@@ -55,6 +55,7 @@ private:
   Gambit::List<Vector<T> > Verts;
   long npivots, nodes;
   Gambit::List<long> visits,branches;
+  SolverContext *m_context;
 
   void Enum(void);
   void Deeper(void);
@@ -63,7 +64,10 @@ private:
   void DualSearch(LPTableau<T> &tab);
 
 public:
-  VertexEnumerator(const Matrix<T> &, const Vector<T> &);
+  /// If a context is given, its budgets are checked at each pivot, and
+  /// SolverInterrupted is thrown once they are exhausted
+  VertexEnumerator(const Matrix<T> &, const Vector<T> &,
+		   SolverContext *p_context = 0);
   VertexEnumerator(LPTableau<T> &);
   ~VertexEnumerator() { }
   
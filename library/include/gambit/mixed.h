@@ -24,6 +24,7 @@
 #define LIBGAMBIT_MIXED_H
 
 #include "vector.h"
+#include "stats.h"
 #include "gameagg.h"
 #include "gamebagg.h"
 
@@ -229,7 +230,8 @@ public:
   /// @name Computation of interesting quantities
   //@{
   /// Computes the payoff of the profile to player 'pl'
-  T GetPayoff(int pl) const { return m_rep->GetPayoff(pl); }
+  T GetPayoff(int pl) const
+  { Stats::Count(Stats::PAYOFF_EVALUATIONS); return m_rep->GetPayoff(pl); }
 
   /// Computes the payoff of the profile to the player
   T GetPayoff(const GamePlayer &p_player) const
@@ -240,14 +242,17 @@ public:
   /// Computes the derivative of the payoff to the player with respect
   /// to the probability the strategy is played
   T GetPayoffDeriv(int pl, const GameStrategy &s) const
-  { return m_rep->GetPayoffDeriv(pl, s); }
+  { Stats::Count(Stats::PAYOFF_EVALUATIONS); return m_rep->GetPayoffDeriv(pl, s); }
   
   /// \brief Computes the second derivative of the player's payoff
   ///
   /// Computes the second derivative of the payoff to the player,
   /// with respect to the probabilities with which the strategies are played
   T GetPayoffDeriv(int pl, const GameStrategy &s1, const GameStrategy &s2) const
-  { return m_rep->GetPayoffDeriv(pl, s1, s2); }
+  {
+    Stats::Count(Stats::PAYOFF_EVALUATIONS);
+    return m_rep->GetPayoffDeriv(pl, s1, s2);
+  }
 
   /// Computes the payoff to playing the pure strategy against the profile
   T GetPayoff(const GameStrategy &p_strategy) const
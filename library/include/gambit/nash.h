@@ -142,6 +142,151 @@ private:
   int m_numDecimals;
 };
 
+//------------------------------------------------------------------------
+//                      Binary profile rendering
+//------------------------------------------------------------------------
+
+//
+// The binary renderers write profiles in a compact form, for consumers
+// which read back many profiles, and would otherwise spend longer
+// formatting and parsing text than solving.  The stream begins with a
+// header: the bytes "GBTP", the format version, 'm' or 'b' for mixed
+// strategy or behavior profiles, and 'd' or 'q' for floating-point or
+// rational probabilities.  The renderers write the header on
+// construction, so that a run finding no profiles still produces a valid
+// stream.  Each profile is then its label (a 16-bit length and the
+// bytes), the number of probabilities (32 bits), and the probabilities in
+// the order written by the CSV renderers.  Integers are little-endian.
+// Floating-point probabilities are IEEE doubles; a rational is a tag
+// byte 0 followed by its numerator and denominator in 64 bits each, or,
+// when either does not fit, a tag byte 1 followed by its text "p/q" with
+// a 32-bit length.  ProfileBinaryReader reads the format back.
+//
+template <class T>
+class MixedStrategyBinaryRenderer : public MixedStrategyRenderer<T> {
+public:
+  MixedStrategyBinaryRenderer(std::ostream &p_stream);
+  virtual ~MixedStrategyBinaryRenderer() { }
+  virtual void Render(const MixedStrategyProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const;
+
+private:
+  std::ostream &m_stream;
+};
+
+template <class T>
+class BehavStrategyBinaryRenderer : public BehavStrategyRenderer<T> {
+public:
+  BehavStrategyBinaryRenderer(std::ostream &p_stream);
+  virtual ~BehavStrategyBinaryRenderer() { }
+  virtual void Render(const MixedBehaviorProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const;
+
+private:
+  std::ostream &m_stream;
+};
+
+/// Puts standard output into binary mode, which the binary renderers
+/// need when writing to it.  On Windows, text mode would write each byte
+/// 0x0a as 0x0d 0x0a; elsewhere this does nothing.  Call this before
+/// anything is written to standard output.
+void SetBinaryStdout(void);
+
+///
+/// Reads profiles written by MixedStrategyBinaryRenderer or
+/// BehavStrategyBinaryRenderer.  Probabilities are converted to T when
+/// the stream holds the other type.  A stream which is not in the format,
+/// or which ends part way through a profile, raises InvalidFileException.
+///
+template <class T> class ProfileBinaryReader {
+public:
+  /// Reads the header from the stream
+  explicit ProfileBinaryReader(std::istream &p_stream);
+
+  /// Returns true if the stream holds behavior profiles, and false if
+  /// it holds mixed strategy profiles
+  bool IsBehavior(void) const { return m_kind == 'b'; }
+
+  /// Reads the label and probabilities of the next profile; returns
+  /// false if the stream has no more profiles
+  bool Next(std::string &p_label, Array<T> &p_probs);
+
+  /// Reads the remaining profiles, which must be mixed strategy
+  /// profiles on p_game
+  List<MixedStrategyProfile<T> > ReadMixed(const Game &p_game);
+  /// Reads the remaining profiles, which must be behavior profiles
+  /// on p_game
+  List<MixedBehaviorProfile<T> > ReadBehav(const Game &p_game);
+
+private:
+  std::istream &m_stream;
+  char m_kind, m_type;
+};
+
+//------------------------------------------------------------------------
+//                          Progress reporting
+//------------------------------------------------------------------------
+
+///
+/// Receives periodic reports on the progress of a solver.  The
+/// instrumentation counters in Gambit::Stats give further detail on
+/// the work done so far.
+///
+class ProgressObserver {
+public:
+  virtual ~ProgressObserver() { }
+  /// Called with the number of equilibria found, and the seconds
+  /// elapsed since the solver started
+  virtual void OnProgress(int p_found, double p_elapsed) = 0;
+};
+
+///
+/// Writes each progress report to a stream as a line of JSON, together
+/// with the current values of the instrumentation counters
+///
+class ProgressJSONWriter : public ProgressObserver {
+public:
+  ProgressJSONWriter(std::ostream &p_stream) : m_stream(p_stream) { }
+  virtual ~ProgressJSONWriter() { }
+  virtual void OnProgress(int p_found, double p_elapsed);
+
+private:
+  std::ostream &m_stream;
+};
+
+///
+/// Used by solvers to pass reports to an observer, at most once per
+/// interval.  Reporting is cheap when no observer is set, so solvers
+/// may report from their inner loops.  One solver may run on several
+/// threads at once (as in a batch), sharing its reporter; its state is
+/// then updated in a critical section, and elapsed times are measured
+/// from the latest Start().
+///
+class ProgressReporter {
+public:
+  ProgressReporter(void) : m_interval(1.0), m_start(0.0), m_last(0.0) { }
+
+  void SetObserver(shared_ptr<ProgressObserver> p_observer, double p_interval)
+  { m_observer = p_observer;  m_interval = p_interval; }
+
+  /// Marks the start of a run of the solver
+  void Start(void)
+  { if (m_observer.get()) { Restart(); } }
+  /// Reports progress, if an interval has passed since the last report
+  void Report(int p_found)
+  { if (m_observer.get()) { Notify(p_found, false); } }
+  /// Reports progress at the end of a run of the solver
+  void Finish(int p_found)
+  { if (m_observer.get()) { Notify(p_found, true); } }
+
+private:
+  shared_ptr<ProgressObserver> m_observer;
+  double m_interval, m_start, m_last;
+
+  void Restart(void);
+  void Notify(int p_found, bool p_force);
+};
+
 //------------------------------------------------------------------------
 //                      Algorithm base classes
 //------------------------------------------------------------------------
@@ -155,8 +300,25 @@ public:
 
   virtual List<MixedStrategyProfile<T> > Solve(const Game &) const = 0;
 
+  /// Requests reports on progress, at most every p_interval seconds
+  void SetProgressObserver(shared_ptr<ProgressObserver> p_observer,
+			   double p_interval = 1.0)
+  { m_progress.SetObserver(p_observer, p_interval); }
+  /// Sets the budgets and cancellation token for subsequent calls to
+  /// Solve().  When a budget is exhausted, Solve() returns the
+  /// equilibria found so far, and the context's GetStatus() says why.
+  virtual void SetContext(shared_ptr<SolverContext> p_context)
+  { m_context = p_context; }
+  shared_ptr<SolverContext> GetContext(void) const { return m_context; }
+
 protected:
   shared_ptr<StrategyProfileRenderer<T> > m_onEquilibrium;
+  mutable ProgressReporter m_progress;
+  shared_ptr<SolverContext> m_context;
+
+  /// Throws SolverInterrupted if the budgets in the context are exhausted
+  void Checkpoint(void) const
+  { if (m_context.get()) { m_context->Check(); } }
 };
 
 template <class T> class BehavSolver {
@@ -166,8 +328,25 @@ public:
 
   virtual List<MixedBehaviorProfile<T> > Solve(const BehaviorSupportProfile &) const = 0;
 
+  /// Requests reports on progress, at most every p_interval seconds
+  void SetProgressObserver(shared_ptr<ProgressObserver> p_observer,
+			   double p_interval = 1.0)
+  { m_progress.SetObserver(p_observer, p_interval); }
+  /// Sets the budgets and cancellation token for subsequent calls to
+  /// Solve().  When a budget is exhausted, Solve() returns the
+  /// equilibria found so far, and the context's GetStatus() says why.
+  virtual void SetContext(shared_ptr<SolverContext> p_context)
+  { m_context = p_context; }
+  shared_ptr<SolverContext> GetContext(void) const { return m_context; }
+
 protected:
   shared_ptr<StrategyProfileRenderer<T> > m_onEquilibrium;
+  mutable ProgressReporter m_progress;
+  shared_ptr<SolverContext> m_context;
+
+  /// Throws SolverInterrupted if the budgets in the context are exhausted
+  void Checkpoint(void) const
+  { if (m_context.get()) { m_context->Check(); } }
 };
 
 //
@@ -181,28 +360,44 @@ public:
   virtual ~BehavViaStrategySolver() { }
 
   virtual List<MixedBehaviorProfile<T> > Solve(const BehaviorSupportProfile &) const;
+  /// The context is shared with the strategy solver
+  virtual void SetContext(shared_ptr<SolverContext> p_context)
+  { this->m_context = p_context;  m_solver->SetContext(p_context); }
 
 protected:
   shared_ptr<StrategySolver<T> > m_solver;
 };
 
+//
+// Solves by backward induction on the proper subgames, using the given
+// solver on each.  Subgames which are the same up to a positive affine
+// transformation of each player's payoffs are solved only once; with a
+// solver which finds only some equilibria, those found for the first
+// are used for the others.  This relies on the solver treating such
+// subgames alike; p_reuse is false for solvers which do not (such as
+// the linear programming solver, which is only correct for constant-sum
+// games).  Subgames which do not contain one another
+// are solved on up to p_threads threads (zero for the OpenMP default);
+// the solver for the subgames is then called concurrently, and should
+// neither render equilibria nor report progress.
+//
 template <class T> class SubgameBehavSolver : public BehavSolver<T> {
 public:
   SubgameBehavSolver(shared_ptr<BehavSolver<T> > p_solver,
-		     shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0);
+		     shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+		     int p_threads = 1, bool p_reuse = true);
   virtual ~SubgameBehavSolver()  { }
 
   virtual List<MixedBehaviorProfile<T> > Solve(const BehaviorSupportProfile &) const;
+  /// The context is shared with the solver for the subgames, so that
+  /// the budgets cover the whole computation
+  virtual void SetContext(shared_ptr<SolverContext> p_context)
+  { this->m_context = p_context;  m_solver->SetContext(p_context); }
 
 protected:
   shared_ptr<BehavSolver<T> > m_solver;
-
-private:
-  void SolveSubgames(const BehaviorSupportProfile &p_support,
-		     const DVector<T> &p_templateSolution,
-		     GameNode n,
-		     List<DVector<T> > &solns,
-		     List<GameOutcome> &values) const;
+  int m_threads;
+  bool m_reuse;
 };
 
 //
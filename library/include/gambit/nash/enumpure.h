@@ -31,32 +31,30 @@ namespace Nash {
 ///
 /// Enumerate pure-strategy Nash equilibria of a game.  By definition,
 /// pure-strategy equilibrium uses the strategic representation of a game.
+///
+/// Rather than testing each contingency for deviations, the payoffs to
+/// each player are swept once, marking the strategies which are not best
+/// responses to each profile of the other players' strategies; the
+/// equilibria are the contingencies left unmarked.  The lines of the
+/// sweep are split among up to p_threads threads (all available if
+/// p_threads <= 0).  Except for games in table form, this holds the
+/// payoffs to one player at every contingency; if there are too many
+/// contingencies for this, each is instead tested in turn.
 /// 
 class EnumPureStrategySolver : public StrategySolver<Rational> {
 public:
-   EnumPureStrategySolver(shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0) 
-    : StrategySolver<Rational>(p_onEquilibrium) { }
+  EnumPureStrategySolver(shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0,
+			 int p_threads = 1)
+    : StrategySolver<Rational>(p_onEquilibrium), m_threads(p_threads) { }
   virtual ~EnumPureStrategySolver()  { }
 
   List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
-};
 
-inline List<MixedStrategyProfile<Rational> >
-EnumPureStrategySolver::Solve(const Game &p_game) const
-{
-  if (!p_game->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
-  }
-  List<MixedStrategyProfile<Rational> > solutions;
-  for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
-    if ((*citer)->IsNash()) {
-      MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
-      m_onEquilibrium->Render(profile);
-      solutions.Append(profile);
-    }
-  }
-  return solutions;
-}
+private:
+  int m_threads;
+
+  List<MixedStrategyProfile<Rational> > SolveByContingency(const Game &) const;
+};
 
 ///
 /// Enumerate pure-strategy agent Nash equilibria of a game.  This uses
@@ -65,28 +63,25 @@ EnumPureStrategySolver::Solve(const Game &p_game) const
 /// set (rather than possible deviations by the same player at multiple
 /// information sets.
 ///
+/// As for EnumPureStrategySolver, the payoffs are swept once for each
+/// player, marking actions which are not best responses at each of the
+/// player's information sets, unless there are too many contingencies
+/// to hold the payoffs.
+///
 class EnumPureAgentSolver : public BehavSolver<Rational> {
 public:
-  EnumPureAgentSolver(shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0)
-    : BehavSolver<Rational>(p_onEquilibrium) { }
+  EnumPureAgentSolver(shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0,
+		      int p_threads = 1)
+    : BehavSolver<Rational>(p_onEquilibrium), m_threads(p_threads) { }
   virtual ~EnumPureAgentSolver()  { }
 
   List<MixedBehaviorProfile<Rational> > Solve(const BehaviorSupportProfile &) const;
-};
 
-inline List<MixedBehaviorProfile<Rational> > 
-EnumPureAgentSolver::Solve(const BehaviorSupportProfile &p_support) const
-{
-  List<MixedBehaviorProfile<Rational> > solutions;
-  for (BehaviorProfileIterator citer(p_support); !citer.AtEnd(); citer++) {
-    if (citer->IsAgentNash()) {
-      MixedBehaviorProfile<Rational> profile = citer->ToMixedBehaviorProfile();
-      m_onEquilibrium->Render(profile);
-      solutions.Append(profile);
-    }
-  }
-  return solutions;
-}
+private:
+  int m_threads;
+
+  List<MixedBehaviorProfile<Rational> > SolveByContingency(const BehaviorSupportProfile &) const;
+};
 
 }  // end namespace Nash
 }  // end namespace Gambit
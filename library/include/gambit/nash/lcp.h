@@ -28,29 +28,48 @@
 namespace Gambit {
 
 namespace linalg {
+template <class T> class BFS;
 template <class T> class LHTableau;
 template <class T> class LemkeTableau;
 }
 
 namespace Nash {
  
+///
+/// Solves a two-player strategic game via the Lemke-Howson algorithm.
+/// If p_hybrid is set (meaningful only for exact arithmetic), the paths
+/// are first followed using floating-point tableaux, and only the bases
+/// of the equilibria found are replayed in exact arithmetic; if any
+/// replayed profile fails to be an exact equilibrium, the solver falls
+/// back to exact pivoting along the whole of each path.
+///
 template <class T> class NashLcpStrategySolver : public StrategySolver<T> {
+  template <class U> friend class NashLcpStrategySolver;
+
 public:
   NashLcpStrategySolver(int p_stopAfter, int p_maxDepth,
-			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			bool p_hybrid = false)
     : StrategySolver<T>(p_onEquilibrium),
-      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth) { }
+      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth), m_hybrid(p_hybrid),
+      m_maxPathPivots(0) { }
   virtual ~NashLcpStrategySolver()  { }
 
   virtual List<MixedStrategyProfile<T> > Solve(const Game &) const;
 
 private:
   int m_stopAfter, m_maxDepth;
+  bool m_hybrid;
+  long m_maxPathPivots;
 
   class Solution;
 
+  bool GetProfile(const Game &, const linalg::BFS<T> &,
+		  MixedStrategyProfile<T> &) const;
   bool OnBFS(const Game &, linalg::LHTableau<T> &, Solution &) const;
   void AllLemke(const Game &, int j, linalg::LHTableau<T> &, Solution &, int) const;
+  void Enumerate(const Game &, Solution &) const;
+  bool SolveHybrid(const Game &, Solution &) const;
 };
 
  
@@ -33,21 +33,32 @@ namespace Nash {
 /// mixed strategy solutions to general finite n-person games.  It is based on
 /// van Der Laan, Talman and van Der Heyden, Math in Oper Res, 1987.
 ///
-class NashSimpdivStrategySolver : public StrategySolver<Rational> {
+/// The grid is set by a starting profile with rational probabilities.
+/// With T = double, the subdivision is carried out in floating point,
+/// and exact arithmetic is used only to certify the final approximation
+/// (refining it further in exact arithmetic if it fails).
+///
+template <class T> class NashSimpdivStrategySolver : public StrategySolver<T> {
+  template <class U> friend class NashSimpdivStrategySolver;
+
 public:
   NashSimpdivStrategySolver(int p_gridResize = 2, int p_leashLength = 0,
 			    bool p_verbose = false,
-			    shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0)
-    : StrategySolver<Rational>(p_onEquilibrium),
+			    shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+    : StrategySolver<T>(p_onEquilibrium),
       m_gridResize(p_gridResize),
       m_leashLength((p_leashLength > 0) ? p_leashLength : 32000),
       m_verbose(p_verbose)
   { }
   virtual ~NashSimpdivStrategySolver() { }
 
-  List<MixedStrategyProfile<Rational> > Solve(const MixedStrategyProfile<Rational> &p_start) const;
-  List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
-
+  List<MixedStrategyProfile<T> > Solve(const MixedStrategyProfile<Rational> &p_start) const;
+  List<MixedStrategyProfile<T> > Solve(const Game &p_game) const;
+  /// Solves from each of p_starts, using up to p_threads threads (all
+  /// available if p_threads <= 0), and returns the distinct equilibria
+  /// found.  If p_stopAfter is positive, stops once that many are found.
+  List<MixedStrategyProfile<T> > Solve(const List<MixedStrategyProfile<Rational> > &p_starts,
+				       int p_stopAfter = 0, int p_threads = 1) const;
 
 private:
   int m_gridResize, m_leashLength;
@@ -56,21 +67,47 @@ private:
   class State {
   public:
     int t, ibar;
-    Rational d, pay, maxz, bestz;
+    T d, pay, maxz, bestz;
     
-    State(void) : t(0), ibar(1), bestz(1.0e30) { }
-    Rational getlabel(MixedStrategyProfile<Rational> &yy, Array<int> &, 
-		      PVector<Rational> &);
+    /// If p_incremental is set, the payoffs to each strategy are kept
+    /// between vertices, and corrected for the coordinates which move,
+    /// rather than evaluated afresh at each vertex
+    State(const MixedStrategyProfile<T> &p_y, bool p_incremental);
+    T getlabel(MixedStrategyProfile<T> &yy, Array<int> &, PVector<T> &);
+
+  private:
+    bool incremental, havePayoffs;
+    int updates;
+    MixedStrategyProfile<T> lasty;
+    PVector<T> payoffs;
+
+    void UpdatePayoffs(const MixedStrategyProfile<T> &yy);
+  };
+
+  /// The approximations made on each grid during one run, kept in
+  /// verbose mode so that a run on its own thread can print them in one
+  /// block once it finishes
+  class Trace {
+  public:
+    List<MixedStrategyProfile<T> > m_profiles;
+    List<std::string> m_labels;
   };
 
-  Rational Simplex(MixedStrategyProfile<Rational> &, const Rational &d) const;
-  void update(State &, RectArray<int> &, RectArray<int> &, PVector<Rational> &,
+  bool Approximate(const MixedStrategyProfile<Rational> &p_start,
+		   MixedStrategyProfile<T> &p_result, bool p_report,
+		   Trace *p_trace = 0) const;
+  void Verbose(const MixedStrategyProfile<T> &, const std::string &,
+	       Trace *) const;
+  void Certify(MixedStrategyProfile<T> &, const Rational &d) const;
+  T Simplex(MixedStrategyProfile<T> &, const T &d) const;
+  bool AtBoundary(const State &, const T &v, const T &y) const;
+  void update(State &, RectArray<int> &, RectArray<int> &, PVector<T> &,
 	      const PVector<int> &, int j, int i) const;
-  void getY(State &, MixedStrategyProfile<Rational> &x, PVector<Rational> &, 
+  void getY(State &, MixedStrategyProfile<T> &x, PVector<T> &, 
 	    const PVector<int> &, const PVector<int> &, 
-	    const PVector<Rational> &, const RectArray<int> &, int k) const;
+	    const PVector<T> &, const RectArray<int> &, int k) const;
   void getnexty(State &, 
-		MixedStrategyProfile<Rational> &x, const RectArray<int> &,
+		MixedStrategyProfile<T> &x, const RectArray<int> &,
 		const PVector<int> &, int i) const;
   int get_c(int j, int h, int nstrats, const PVector<int> &) const;
   int get_b(int j, int h, int nstrats, const PVector<int> &) const;
@@ -39,6 +39,10 @@ public:
     : m_text(p_text), m_rational(lexical_cast<Rational>(p_text)), 
       m_double((double) m_rational)
   { }
+  Number(const Rational &p_value)
+    : m_text(lexical_cast<std::string>(p_value)), m_rational(p_value),
+      m_double((double) p_value)
+  { }
   
   Number &operator=(const std::string &p_text)
   {
@@ -49,6 +53,13 @@ public:
     m_double = (double) m_rational;
     return *this; 
   }
+  Number &operator=(const Rational &p_value)
+  {
+    m_rational = p_value;
+    m_text = lexical_cast<std::string>(p_value);
+    m_double = (double) p_value;
+    return *this;
+  }
 
   operator const double &(void) const { return m_double; }
   operator const Rational &(void) const { return m_rational; }
@@ -0,0 +1,132 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/stats.h
+// Instrumentation counters and phase timers for the solvers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_STATS_H
+#define LIBGAMBIT_STATS_H
+
+#include <iostream>
+#include <string>
+#include <config.h>
+
+namespace Gambit {
+
+///
+/// Lightweight instrumentation of the solvers.  Counters and phase
+/// times are process-wide, and accumulate across all solvers (and
+/// threads) until Reset() is called.  Configuring with --disable-stats
+/// defines GAMBIT_NO_STATS, which compiles the counting out entirely;
+/// the interface remains, and reports zeroes.
+///
+namespace Stats {
+
+/// The quantities counted
+enum Counter {
+  /// Pivots on a tableau, in any of the pivoting algorithms
+  PIVOTS = 0,
+  /// Refactorizations of a tableau's basis
+  REFACTORIZATIONS,
+  /// Evaluations of the payoff, or payoff derivatives, of a profile
+  PAYOFF_EVALUATIONS,
+  /// Evaluations of the Jacobian in path-following
+  JACOBIAN_BUILDS,
+  /// QR decompositions of the Jacobian in path-following
+  QR_DECOMPOSITIONS,
+  /// Accepted predictor-corrector steps in path-following
+  PATH_STEPS,
+  NUM_COUNTERS
+};
+
+/// Returns the name of the counter, as used in reports
+const char *GetName(Counter);
+
+#ifndef GAMBIT_NO_STATS
+///
+/// The counts made by one thread.  Each thread counts into its own
+/// block, without synchronization, and the blocks are summed when the
+/// counts are read.  Blocks are padded so that no two share a cache line.
+///
+struct CounterBlock {
+  long m_counts[NUM_COUNTERS];
+  char m_padding[64];
+};
+
+/// The calling thread's block, or null before it first counts
+extern CounterBlock *g_threadCounts;
+#ifdef _OPENMP
+#pragma omp threadprivate(g_threadCounts)
+#endif  // _OPENMP
+
+/// Creates and registers a block for the calling thread
+CounterBlock *NewCounterBlock(void);
+
+inline void Count(Counter p_counter, long p_amount = 1)
+{
+  if (!g_threadCounts)  g_threadCounts = NewCounterBlock();
+  g_threadCounts->m_counts[p_counter] += p_amount;
+}
+
+/// Returns the total over all threads.  Counts made by threads still
+/// running while this is called may be missed.
+long GetCount(Counter);
+#else
+inline void Count(Counter, long = 1) { }
+inline long GetCount(Counter) { return 0; }
+#endif  // GAMBIT_NO_STATS
+
+/// Returns the total seconds spent in the named phase
+double GetPhaseTime(const std::string &p_phase);
+
+/// Sets all counters and phase times to zero
+void Reset(void);
+
+/// Returns wall-clock time in seconds, from an arbitrary origin
+double WallClock(void);
+
+/// Writes the counters and phase times as a JSON object, on one line
+/// and without a line ending
+void WriteJSON(std::ostream &);
+
+///
+/// Adds the time from its construction to its destruction to the total
+/// for the named phase.  Phases may nest, in which case time is counted
+/// in each.  The name must outlive the timer (typically it is a literal).
+///
+class PhaseTimer {
+public:
+#ifndef GAMBIT_NO_STATS
+  explicit PhaseTimer(const char *p_phase)
+    : m_phase(p_phase), m_start(WallClock()) { }
+  ~PhaseTimer();
+
+private:
+  const char *m_phase;
+  double m_start;
+#else
+  explicit PhaseTimer(const char *) { }
+#endif  // GAMBIT_NO_STATS
+};
+
+}  // end namespace Gambit::Stats
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_STATS_H
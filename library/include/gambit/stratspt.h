@@ -136,10 +136,22 @@ public:
 		 bool p_strict) const;
   bool IsDominated(const GameStrategy &s, bool p_strict, 
 		   bool p_external = false) const; 
+  /// Returns true if the strategy is dominated by some mixture of the
+  /// player's other strategies in the support
+  bool IsMixedDominated(const GameStrategy &s, bool p_strict) const;
 
   /// Returns a copy of the support with dominated strategies eliminated
   StrategySupportProfile Undominated(bool p_strict, bool p_external = false) const;
   StrategySupportProfile Undominated(bool strong, const Array<int> &players) const;
+  /// \brief Returns a copy of the support with dominated strategies
+  /// eliminated iteratively
+  ///
+  /// Eliminates dominated strategies for all players simultaneously,
+  /// and repeats until no further strategies are eliminated.  The result
+  /// is the same as repeatedly calling Undominated(p_strict).  If p_mixed
+  /// is true, strategies dominated by mixed strategies are also eliminated.
+  StrategySupportProfile IteratedUndominated(bool p_strict, 
+					     bool p_mixed = false) const;
   //@}
 
   /// @name Identification of overwhelmed strategies
@@ -27,6 +27,7 @@
 #include <sstream>
 #include <cassert>
 #include <algorithm>
+#include "gambit/gambit.h"
 #include "gambit/agg/gray.h"
 #include "gambit/agg/agg.h"
 
@@ -45,7 +46,6 @@ AGG::AGG(int numPlayers,int* _actions, int numANodes, int _numPNodes,
  vector<vector<vector<config> > >& proj,
  vector<vector<proj_func*> > & projF,
  vector<vector<vector<int> > >& Po,
- vector<aggdistrib> &P,
  vector<aggpayoff>& _payoffs) :
 numPlayers(numPlayers),
 numActionNodes(numANodes),
@@ -55,14 +55,12 @@ neighbors(neighb),
 projectionTypes(projTypes),
 payoffs(_payoffs),
 projection(proj),
-projectedStrat(projS),
 fullProjectedStrat(projS),
 projFunctions(projF),
 Porder(Po),
-Pr(P),
 isPure(numANodes,true),
 node2Action(numANodes,vector<int>(numPlayers)),
-cache(numPlayers+1),
+neighborClass(numANodes),
 player2Class(numPlayers),
 kSymStrategyOffset(1,0)
 {
@@ -133,6 +131,46 @@ kSymStrategyOffset(1,0)
     for(int j=0;j<actions[i];j++)
 	node2Action[actionSets[i][j]][i]=j;
 
+  //set neighborClass
+  for (int i=0;i<numANodes;i++){
+    neighborClass[i]=i;
+    for (int j=0;j<i;j++) if (neighb[j]==neighb[i]){
+      neighborClass[i]=j;
+      break;
+    }
+  }
+
+  indexPayoffs();
+}
+
+AGG::Context::Context(const AGG &g)
+  : projectedStrat(g.fullProjectedStrat),
+    Pr(g.numPlayers),
+    cache(g.numPlayers+1),
+    profile(g.totalActions)
+{ }
+
+AGG::Context *AGG::acquireContext()
+{
+  Context *c = 0;
+#ifdef _OPENMP
+#pragma omp critical(agg_context_pool)
+#endif  // _OPENMP
+  {
+    if (!contextPool.empty()) {
+      c = contextPool.back();
+      contextPool.pop_back();
+    }
+  }
+  return (c) ? c : new Context(*this);
+}
+
+void AGG::releaseContext(Context *c)
+{
+#ifdef _OPENMP
+#pragma omp critical(agg_context_pool)
+#endif  // _OPENMP
+  contextPool.push_back(c);
 }
 
 /*
@@ -383,20 +421,20 @@ AGG *AGG::makeAGG(istream &in){
 	    break;
 	case ADDITIVE:
         default:
-	    cerr<<"Unknown payoff type "<<t 
-			<<endl;
-	    exit(1);
+	    delete [] size;
+	    std::ostringstream msg;
+	    msg<<"Unknown payoff type "<<t;
+	    throw InvalidFileException(msg.str());
       }
       
     }
     AGG *r=NULL;
-    r=new AGG(n,size,S,P,ASets,neighb,projTypes,projS,proj,projF,Po,Pr,pays);
+    r=new AGG(n,size,S,P,ASets,neighb,projTypes,projS,proj,projF,Po,pays);
     if (!r)cout<<"Failed to allocate memory for new AGG";
     delete [] size;
     return r;
   } else {
-    cout << "Bad game file.\n";
-    exit(1);
+    throw InvalidFileException("Bad game file.");
   }
 }
 
@@ -461,7 +499,7 @@ vector<projtype>& projTypes, int seed, bool int_payoffs, int int_factor){
 	    numPayoffs += pays[i].size();
     }
     cout << "Creating an AGG with "<<numPayoffs <<" payoff values"<<endl;
-    AGG *r= new AGG(n,actions,S,P,ASets,neighb,projTypes,projS,proj,projF,Po,Pr,pays);
+    AGG *r= new AGG(n,actions,S,P,ASets,neighb,projTypes,projS,proj,projF,Po,pays);
     
     return r;
  
@@ -535,11 +573,11 @@ AGG::getAn(multiset<int>& dest, vector<vector<int> >& neighb, vector<projtype>&
   //cycle check
   for (vector<int>::iterator p=path.begin();p!=path.end();++p){
     if (Node == (*p)) {
-	cout<<"ERROR: cycle of projected nodes at "<<Node  <<endl;
-	cout <<"Path: (Size "<<path.size() <<")"<<endl;
-	copy(path.begin(),path.end(),ostream_iterator<int>(cout, " "));
-	cout<<endl;
-	exit(1);
+	std::ostringstream msg;
+	msg<<"ERROR: cycle of projected nodes at "<<Node<<endl;
+	msg<<"Path: (Size "<<path.size() <<")"<<endl;
+	copy(path.begin(),path.end(),ostream_iterator<int>(msg, " "));
+	throw InvalidFileException(msg.str());
     }
   }
 
@@ -548,9 +586,10 @@ AGG::getAn(multiset<int>& dest, vector<vector<int> >& neighb, vector<projtype>&
   for (int i=0; i<numNei;++i){
     //check consistency of proj. signatures
     if(neighb[Node][i]>=S && *(projTypes[neighb[Node][i]-S])!= *(projTypes[Node-S])){
-	cout<<"ERROR: projection type mismatch: Node "<< Node 
-	   <<" and its neighbor "<<neighb[Node][i]<<endl;
-	exit(1);
+	std::ostringstream msg;
+	msg<<"ERROR: projection type mismatch: Node "<< Node 
+	   <<" and its neighbor "<<neighb[Node][i];
+	throw InvalidFileException(msg.str());
     }
     getAn(dest, neighb,projTypes, S, neighb[Node][i],path);
   }
@@ -583,8 +622,9 @@ AGG::initPorder(vector<int>& Po,
 
 //compute the induced distribution 
 void
-AGG::computeP(int player, int act, int player2,int act2)
+AGG::computeP(Context &c, int player, int act, int player2,int act2)
 {
+  vector<aggdistrib> &Pr = c.Pr;
   //apply player's strat
   Pr[0].reset();
   Pr[0].insert(make_pair(projection[actionSets[player][act]][player][act], 1.0) );
@@ -605,25 +645,171 @@ AGG::computeP(int player, int act, int player2,int act2)
       }
     } else {
       Pr[k].multiply (Pr[k-1], 
-	projectedStrat[actionSets[player][act]][Porder[player][act][k]],
+	c.projectedStrat[actionSets[player][act]][Porder[player][act][k]],
 	numNei  ,projFunctions[actionSets[player][act]] ); 
     }
   }
     
 }
 
-void AGG:: doProjection(int Node, AggNumber* s)
+//compute the distribution induced by the strategies of all players
+//except player, on the neighborhood of player's action act.
+//The result is stored in c.Pr[numPlayers-1].
+void
+AGG::computeOthersP(Context &c, int player, int act)
+{
+  int Node = actionSets[player][act];
+  int numNei = neighbors[Node].size();
+  const vector<int> &order = Porder[player][act];
+  vector<aggdistrib> &Pr = c.Pr;
+
+  Pr[1] = c.projectedStrat[Node][order[1]];
+  for (int k=2; k<numPlayers;k++){
+    Pr[k].multiply (Pr[k-1], c.projectedStrat[Node][order[k]],
+		    numNei, projFunctions[Node]);
+  }
+}
+
+//maximum ratio of the size of the dense payoff array to the number
+//of configurations in the payoff function
+static const size_t DENSE_FACTOR = 8;
+
+void AGG::indexPayoffs()
+{
+  payoffLow.assign(numActionNodes, config());
+  payoffExtent.assign(numActionNodes, config());
+  densePayoffs.assign(numActionNodes, AggNumberVector());
+  densePresent.assign(numActionNodes, vector<char>());
+
+  for (int Node=0; Node<numActionNodes; ++Node){
+    aggpayoff &pay = payoffs[Node];
+    if (pay.empty()) continue;
+    size_t keylen = pay.begin()->first.size();
+    config low(pay.begin()->first), high(pay.begin()->first);
+    for (aggpayoff::iterator p=pay.begin(); p!=pay.end(); ++p){
+      if (p->first.size() != keylen) break;
+      for (size_t k=0; k<keylen; ++k){
+	low[k] = min(low[k], p->first[k]);
+	high[k] = max(high[k], p->first[k]);
+      }
+    }
+    double size = 1.0;
+    config extent(keylen);
+    for (size_t k=0; k<keylen; ++k){
+      extent[k] = high[k] - low[k] + 1;
+      size *= extent[k];
+    }
+    if (size > (double) (DENSE_FACTOR * pay.size())) continue;
+
+    AggNumberVector values((size_t) size, 0.0);
+    vector<char> present((size_t) size, 0);
+    bool ok = true;
+    for (aggpayoff::iterator p=pay.begin(); p!=pay.end() && ok; ++p){
+      if (p->first.size() != keylen) { ok = false; break; }
+      size_t index = 0;
+      for (size_t k=0; k<keylen; ++k){
+	index = index * extent[k] + (p->first[k] - low[k]);
+      }
+      values[index] = p->second;
+      present[index] = 1;
+    }
+    if (!ok) continue;
+    payoffLow[Node] = low;
+    payoffExtent[Node] = extent;
+    densePayoffs[Node].swap(values);
+    densePresent[Node].swap(present);
+  }
+
+  maxPayoff = minPayoff = 0;
+  bool first = true;
+  for (int Node=0; Node<numActionNodes; ++Node){
+    for (aggpayoff::iterator p=payoffs[Node].begin(); p!=payoffs[Node].end(); ++p){
+      if (first || p->second > maxPayoff) maxPayoff = p->second;
+      if (first || p->second < minPayoff) minPayoff = p->second;
+      first = false;
+    }
+  }
+}
+
+inline bool AGG::findPayoff(int Node, const config &c, AggNumber &value) const
+{
+  if (densePayoffs[Node].empty()){
+    aggpayoff::iterator p = payoffs[Node].find(c);
+    if (p == payoffs[Node].end()) return false;
+    value = p->second;
+    return true;
+  }
+  const config &low = payoffLow[Node], &extent = payoffExtent[Node];
+  if (c.size() != low.size()) return false;
+  size_t index = 0;
+  for (size_t k=0; k<c.size(); ++k){
+    int d = c[k] - low[k];
+    if (d < 0 || d >= extent[k]) return false;
+    index = index * extent[k] + d;
+  }
+  if (!densePresent[Node][index]) return false;
+  value = densePayoffs[Node][index];
+  return true;
+}
+
+static void discardWarning(const AGG::config &c, AggNumber prob)
+{
+  if (prob > (AggNumber) 1e-12){
+    cout<<"inner_prod WARNING: discarding [";
+    copy(c.begin(),c.end(), ostream_iterator<int>(cout," "));
+    cout<<"] "<<prob<<endl;
+  }
+}
+
+//expected payoff of action node Node under the distribution P
+AggNumber AGG::expectedPayoff(int Node, const aggdistrib &P) const
+{
+  AggNumber result = 0.0, value;
+  for (aggdistrib::const_iterator p=P.begin(); p!=P.end(); ++p)if(p->second>(AggNumber)0){
+    if (findPayoff(Node, p->first, value)){
+      result += p->second * value;
+    }
+    else{
+      discardWarning(p->first, p->second);
+    }
+  }
+  return result;
+}
+
+//expected payoff of action node Node under the distribution P,
+//after applying the contribution x to each configuration
+AggNumber AGG::expectedPayoff(int Node, const aggdistrib &P, const config &x) const
+{
+  size_t keylen = x.size();
+  const vector<proj_func*> &f = projFunctions[Node];
+  config c(keylen);
+  AggNumber result = 0.0, value;
+  for (aggdistrib::const_iterator p=P.begin(); p!=P.end(); ++p)if(p->second>(AggNumber)0){
+    for (size_t k=0; k<keylen; ++k){
+      c[k] = (*f[k]) (p->first[k], x[k]);
+    }
+    if (findPayoff(Node, c, value)){
+      result += p->second * value;
+    }
+    else{
+      discardWarning(c, p->second);
+    }
+  }
+  return result;
+}
+
+void AGG:: doProjection(Context &c, int Node, const AggNumber* s)
 {
   for (int i=0;i<numPlayers;i++){
-    doProjection(Node,i, &(s[firstAction(i)]));
+    doProjection(c, Node,i, &(s[firstAction(i)]));
   }
 }
 
-inline void AGG:: doProjection(int Node, int i, AggNumber* s)
+inline void AGG:: doProjection(Context &c, int Node, int i, const AggNumber* s)
 {
-  projectedStrat[Node][i].reset();
+  c.projectedStrat[Node][i].reset();
   for (int j=0;j<actions[i];j++)if(s[j]>(AggNumber)0.0){
-    projectedStrat[Node][i]+= make_pair(projection[Node][i][j],
+    c.projectedStrat[Node][i]+= make_pair(projection[Node][i][j],
               s[j]);
   }
 }
@@ -638,47 +824,75 @@ AggNumber AGG::getPurePayoff(int player, int *s){
         (*projFunctions[Node][j]) (pureprofile[j],projection[Node][i][s[i]][j] );
     }
   }
-  aggpayoff::iterator p= payoffs[Node].find(pureprofile);
-  if ( p == payoffs[Node].end() ){
-    cout<<"AGG::getPurePayoff ERROR: unable to find the following configuration"
+  AggNumber value;
+  if (!findPayoff(Node, pureprofile, value)){
+    std::ostringstream msg;
+    msg<<"AGG::getPurePayoff ERROR: unable to find the following configuration"
         <<endl;
-    cout <<"[";
-    copy(pureprofile.begin(),pureprofile.end(),ostream_iterator<int>(cout, " "));
-    cout<<"]" <<endl;
-    cout<< "\tin payoffs of action node #"<<Node<<endl;
-    exit(1);
+    msg <<"[";
+    copy(pureprofile.begin(),pureprofile.end(),ostream_iterator<int>(msg, " "));
+    msg<<"]" <<endl;
+    msg<< "\tin payoffs of action node #"<<Node;
+    throw UndefinedException(msg.str());
   }
-  return p->second;
+  return value;
 }
 
-AggNumber AGG::getMixedPayoff(int player, StrategyProfile &s){
+AggNumber AGG::getMixedPayoff(Context &c, int player, const StrategyProfile &s){
   AggNumber result=0.0;
   assert(player>=0 && player < numPlayers);
   for (int act=0;act <actions[player];++act)if (s[act+firstAction(player)]>(AggNumber)0.0){
-	result+= s[act+firstAction(player)]* getV(player, act, s);
+	result+= s[act+firstAction(player)]* getV(c, player, act, s);
   }
   return result;
 }
 
-void AGG::getPayoffVector(AggNumberVector &dest, int player,const StrategyProfile &s){
+void AGG::getPayoffVector(Context &c, AggNumberVector &dest, int player,const StrategyProfile &s){
     assert(player>=0 && player < numPlayers);
+    if (numPlayers == 1){
+      for (int act=0;act<actions[player]; ++act){
+	dest[act]=getV(c,player,act,s);
+      }
+      return;
+    }
+    //actions on nodes with the same neighborhood share the distribution
+    //induced by the other players, which is computed only once.
+    vector<aggdistrib> others;
+    others.reserve(actions[player]);
+    vector<int> slot(numActionNodes, -1);
     for (int act=0;act<actions[player]; ++act){
-	dest[act]=getV(player,act,s);
+	int Node = actionSets[player][act];
+	int &k = slot[neighborClass[Node]];
+	if (k == -1){
+	  for (int i=0;i<numPlayers;i++)if(i!=player){
+	    doProjection(c, Node, i, s);
+	  }
+	  computeOthersP(c, player, act);
+	  k = others.size();
+	  others.push_back(aggdistrib());
+	  others.back().swap(c.Pr[numPlayers-1]);
+	}
+	dest[act]=expectedPayoff(Node, others[k], projection[Node][player][act]);
     }
 }
 
-AggNumber AGG::getV(int player, int act,const StrategyProfile &s){
+AggNumber AGG::getV(Context &c, int player, int act,const StrategyProfile &s){
+    int Node = actionSets.at(player).at(act);
     //project s to the projectedStrat
-    doProjection(actionSets.at(player).at(act), s);
-    computeP(player, act);
-    return Pr[numPlayers-1].inner_prod(payoffs[actionSets[player][act]]);
+    doProjection(c, Node, s);
+    if (numPlayers == 1){
+      computeP(c, player, act);
+      return expectedPayoff(Node, c.Pr[0]);
+    }
+    computeOthersP(c, player, act);
+    return expectedPayoff(Node, c.Pr[numPlayers-1], projection[Node][player][act]);
 }
 
-AggNumber AGG::getJ(int player1, int act1, int player2,int act2,StrategyProfile &s)
+AggNumber AGG::getJ(Context &c, int player1, int act1, int player2,int act2,const StrategyProfile &s)
 {
-    doProjection(actionSets[player1][act1],s);
-    computeP(player1,act1,player2,act2);
-    return Pr[numPlayers-1].inner_prod(payoffs[actionSets[player1][act1]]);
+    doProjection(c, actionSets[player1][act1],s);
+    computeP(c, player1,act1,player2,act2);
+    return expectedPayoff(actionSets[player1][act1], c.Pr[numPlayers-1]);
 }
 
 //getSymMixedPayoff: compute expected payoff under a symmetric mixed strat,
@@ -686,23 +900,21 @@ AggNumber AGG::getJ(int player1, int act1, int player2,int act2,StrategyProfile
 // parameter: s is the mixed strategy of one player. It is a vector of 
 // probabilities, indexed by the action node.
 
-AggNumber AGG::getSymMixedPayoff( StrategyProfile &s){
+AggNumber AGG::getSymMixedPayoff(Context &c, const StrategyProfile &s){
   AggNumber result=0;
   if (! isSymmetric() ) {
-    cerr<< "AGG::getSymMixedPayoff: the game is not symmetric!"<<endl;
-    exit(1);
+    throw UndefinedException("AGG::getSymMixedPayoff: the game is not symmetric!");
   }
 
 
   for (int node=0; node<numActionNodes; ++node)if(s[node]>(AggNumber)0.0){
-    result+= s[node]* getSymMixedPayoff(node,s);
+    result+= s[node]* getSymMixedPayoff(c,node,s);
   }
   return result;
 }
-void AGG::getSymPayoffVector(AggNumberVector& dest, StrategyProfile &s){
+void AGG::getSymPayoffVector(Context &c, AggNumberVector& dest, const StrategyProfile &s){
   if (! isSymmetric() ) {
-    cerr<< "AGG::getSymMixedPayoff: the game is not symmetric!"<<endl;
-    exit(1);
+    throw UndefinedException("AGG::getSymMixedPayoff: the game is not symmetric!");
   }
 
   //check the pureness
@@ -723,21 +935,21 @@ void AGG::getSymPayoffVector(AggNumberVector& dest, StrategyProfile &s){
   //  return;
   //}
   for (int act=0;act<numActionNodes; ++act){
-          dest[act]=getSymMixedPayoff(act,s);
+          dest[act]=getSymMixedPayoff(c,act,s);
   }
 }
-AggNumber AGG::getSymMixedPayoff(int node, StrategyProfile &s)
+AggNumber AGG::getSymMixedPayoff(Context &c, int node, const StrategyProfile &s)
 {
     int numNei = neighbors[node].size();
 
     if(!isPure[node]){ // then compute EU using trie_map::power()
-      doProjection(node,0,s);
+      doProjection(c,node,0,s);
       assert(numPlayers>1);
       //aggdistrib *dest;
       //projectedStrat[node][0].power(numPlayers-1, dest, Pr, numNei,projFunctions[node]);
-      aggdistrib &dest = Pr[numPlayers-1];
-      projectedStrat[node][0].power(numPlayers-1, dest, Pr[numPlayers-2],numNei,projFunctions[node]);
-      return dest.inner_prod(projection[node][0][node], numNei, projFunctions[node], payoffs[node]);
+      aggdistrib &dest = c.Pr[numPlayers-1];
+      c.projectedStrat[node][0].power(numPlayers-1, dest, c.Pr[numPlayers-2],numNei,projFunctions[node]);
+      return expectedPayoff(node, dest, projection[node][0][node]);
     }
 
     AggNumber V = 0.0;
@@ -759,7 +971,7 @@ AggNumber AGG::getSymMixedPayoff(int node, StrategyProfile &s)
     //gray code
     GrayComposition gc (numPlayers-1, support.size() );
 
-    AggNumber prob = pow((support.at(0)>=0)?s[neighbors[node][support[0]]]:null_prob,
+    AggNumber prob = std::pow((support.at(0)>=0)?s[neighbors[node][support[0]]]:null_prob,
 		numPlayers-1);
 
     while (1){
@@ -771,7 +983,8 @@ AggNumber AGG::getSymMixedPayoff(int node, StrategyProfile &s)
       }
       //add current player's action
       if (self!=-1) c[self]++;
-      V+= prob *  payoffs[node].find(c)->second ;
+      AggNumber value;
+      if (findPayoff(node, c, value)) V+= prob * value;
 
       //get next composition
       gc.incr();
@@ -791,7 +1004,7 @@ AggNumber AGG::getSymMixedPayoff(int node, StrategyProfile &s)
 //plClass: the index for the player class
 //s: mixed strat for that player class
 
-void AGG::getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int act, aggdistrib &dest,int plClass2,int act2){
+void AGG::getSymConfigProb(Context &c, int plClass, const StrategyProfile &s, int ownPlClass, int act, aggdistrib &dest,int plClass2,int act2){
     int node = uniqueActionSets.at(ownPlClass).at(act);
     int numPl = playerClasses.at(plClass).size();
     assert(numPl>0);
@@ -806,12 +1019,13 @@ void AGG::getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int
 
     if(!isPure[node]){
       int player = playerClasses[plClass].at(0);
-      projectedStrat[node][player].reset();
+      aggdistrib &projected = c.projectedStrat[node][player];
+      projected.reset();
       if(numPl>0){
         for (int j=0;j<actions[player];j++)if(s[j]>(AggNumber)0.0){
-          projectedStrat[node][player]+= make_pair(projection[node][player][j], s[j]);
+          projected+= make_pair(projection[node][player][j], s[j]);
         }
-        projectedStrat[node][player].power(numPl, dest,Pr[0],numNei, projFunctions[node]);
+        projected.power(numPl, dest,c.Pr[0],numNei, projFunctions[node]);
       }
       if(plClass==ownPlClass){
         aggdistrib temp;
@@ -865,7 +1079,7 @@ void AGG::getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int
     GrayComposition gc (numPl, support.size() );
 
     AggNumber prob0=(support.at(0)>=0)?s[node2Action[neighbors[node].at(support[0])][p]]:null_prob;
-    AggNumber prob = pow(prob0,numPl);
+    AggNumber prob = std::pow(prob0,numPl);
 
     while (1){
       const vector<int>& comp = gc.get();
@@ -896,50 +1110,50 @@ void AGG::getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int
   
 }
 
-AggNumber AGG::getKSymMixedPayoff( int playerClass,vector<StrategyProfile> &s){
+AggNumber AGG::getKSymMixedPayoff(Context &c, int playerClass,const vector<StrategyProfile> &s){
   AggNumber result=0.0;
 
   for(int act=0;act<(int)uniqueActionSets[playerClass].size();act++)if(s[playerClass][act]>(AggNumber)0.0){
 
-      result += s[playerClass][act] *getKSymMixedPayoff(playerClass, act,s);
+      result += s[playerClass][act] *getKSymMixedPayoff(c, playerClass, act,s);
   }
   return result;
 }
-AggNumber AGG::getKSymMixedPayoff( int playerClass,StrategyProfile &s){
+AggNumber AGG::getKSymMixedPayoff(Context &c, int playerClass,const StrategyProfile &s){
   AggNumber result=0.0;
 
   for(int act=0;act<(int)uniqueActionSets[playerClass].size();act++)if(s[firstKSymAction(playerClass)+act]>(AggNumber)0.0){
 
-      result += s[firstKSymAction(playerClass)+act] *getKSymMixedPayoff(s,playerClass, act);
+      result += s[firstKSymAction(playerClass)+act] *getKSymMixedPayoff(c, s,playerClass, act);
   }
   return result;
 }
-void AGG::getKSymPayoffVector(AggNumberVector& dest,int playerClass, StrategyProfile &s){
+void AGG::getKSymPayoffVector(Context &c, AggNumberVector& dest,int playerClass, const StrategyProfile &s){
   for (size_t act=0;act<uniqueActionSets[playerClass].size();++act){
-    dest[act]=getKSymMixedPayoff(s,playerClass,act);
+    dest[act]=getKSymMixedPayoff(c, s,playerClass,act);
   }
 }
-AggNumber AGG::getKSymMixedPayoff(int playerClass, int act, vector<StrategyProfile> &s){
+AggNumber AGG::getKSymMixedPayoff(Context &c, int playerClass, int act, const vector<StrategyProfile> &s){
       
       int numPC = playerClasses.size();
       
       int numNei = neighbors[uniqueActionSets[playerClass][act]].size();
 
-      static aggdistrib d,temp;
+      aggdistrib &d = c.d, &temp = c.temp;
       d.reset();
       temp.reset();
-      getSymConfigProb(0, s[0], playerClass, act, d);
+      getSymConfigProb(c, 0, s[0], playerClass, act, d);
       for(int pc=1;pc<numPC;pc++){
-	  getSymConfigProb(pc, s[pc], playerClass, act, temp);
+	  getSymConfigProb(c, pc, s[pc], playerClass, act, temp);
 	  d.multiply(temp, numNei, projFunctions[uniqueActionSets[playerClass][act]]);
       }
-      return d.inner_prod(payoffs[uniqueActionSets[playerClass][act]]);
+      return expectedPayoff(uniqueActionSets[playerClass][act], d);
 }
 
-AggNumber AGG::getKSymMixedPayoff(const StrategyProfile &s,int pClass1,int act1,int pClass2,int act2){
+AggNumber AGG::getKSymMixedPayoff(Context &c, const StrategyProfile &s,int pClass1,int act1,int pClass2,int act2){
   int numPC=playerClasses.size();
   int numNei=neighbors[uniqueActionSets[pClass1][act1]].size();
-  static aggdistrib d,temp;
+  aggdistrib &d = c.d, &temp = c.temp;
   if (pClass2>=0 && pClass1==pClass2 && playerClasses.at(pClass1).size()<=1){
     return 0;
   }
@@ -949,16 +1163,16 @@ AggNumber AGG::getKSymMixedPayoff(const StrategyProfile &s,int pClass1,int act1,
   //if (0==pClass2) s0[act2]=1;
   //else
   for (int a=firstKSymAction(0);a<lastKSymAction(0);++a)s0[a]=s[a];
-  getSymConfigProb(0,s0,pClass1,act1,d,pClass2,act2);
+  getSymConfigProb(c,0,s0,pClass1,act1,d,pClass2,act2);
   for (int pc=1;pc<numPC;pc++){
     StrategyProfile ss(getNumKSymActions(pc), 0.0);
     //if (pc==pClass2)ss[act2]=1;
     //else
     for (int a=0;a<getNumKSymActions(pc);++a)ss[a]=s[a+firstKSymAction(pc)];
-    getSymConfigProb(pc,ss,pClass1,act1,temp,pClass2,act2);
+    getSymConfigProb(c,pc,ss,pClass1,act1,temp,pClass2,act2);
     d.multiply(temp,numNei,projFunctions[uniqueActionSets[pClass1][act1]]);
   }
-  return d.inner_prod(payoffs[uniqueActionSets[pClass1][act1]]);
+  return expectedPayoff(uniqueActionSets[pClass1][act1], d);
 }
 
 
@@ -975,26 +1189,25 @@ void AGG::makeMAPPINGpayoff(std::istream& in, aggpayoff& pay, int numNei){
     stripComment(in);
     in>>num;
     if(!in.good()){
-      cerr<<"Error reading the integer number of configuration-value pairs"<<endl;
-      exit(1);
+      throw InvalidFileException("Error reading the integer number of configuration-value pairs");
     }
 
     while (num--){
         in>>ws;
         if(in.eof()||in.bad()){
-          cerr<<"ERROR: bad input"<<endl;
-          exit(1);
+          throw InvalidFileException("ERROR: bad input");
         }
 
 	c = in.get();
 	assert(in.good());
 	if (c != AGG::LBRACKET){
-	    cerr<< "ERROR: "<<AGG::LBRACKET <<" expected. Instead, got "<<c <<endl;
-	    cerr<<"The rest of the line is: ";
+	    std::ostringstream msg;
+	    msg<< "ERROR: "<<AGG::LBRACKET <<" expected. Instead, got "<<c <<endl;
+	    msg<<"The rest of the line is: ";
 	    stringbuf discard(ios_base::out);
 	    in.get(discard);
-	    cerr<<discard.str()<<endl;
-	    exit(1);
+	    msg<<discard.str();
+	    throw InvalidFileException(msg.str());
 	}
 	vector<int> key;
 
@@ -1002,8 +1215,9 @@ void AGG::makeMAPPINGpayoff(std::istream& in, aggpayoff& pay, int numNei){
 	    int cnt;
 	    in>>cnt;
 	    if(!in.good()){
-	      cerr<<"ERROR trying to read element #"<<j<<" of the configuraiton"<<endl;
-	      exit(1);
+	      std::ostringstream msg;
+	      msg<<"ERROR trying to read element #"<<j<<" of the configuraiton";
+	      throw InvalidFileException(msg.str());
 	    }
 	    key.push_back(cnt);
 	}
@@ -1014,19 +1228,19 @@ void AGG::makeMAPPINGpayoff(std::istream& in, aggpayoff& pay, int numNei){
 	assert (in.good());
 
 	if (c!=AGG::RBRACKET){
-	    cerr<< "ERROR: "<<AGG::RBRACKET <<" expected. Instead, got "<<c<<endl;
-	    cerr<< "current configuration: ";
-	    copy(key.begin(),key.end(), ostream_iterator<int>(cerr, " "));
-	    cerr<<endl;
-	    exit(1);
+	    std::ostringstream msg;
+	    msg<< "ERROR: "<<AGG::RBRACKET <<" expected. Instead, got "<<c<<endl;
+	    msg<< "current configuration: ";
+	    copy(key.begin(),key.end(), ostream_iterator<int>(msg, " "));
+	    throw InvalidFileException(msg.str());
 	}
 	
 	in>>u;  //get payoff
 	if(!in.good()){
-	  cerr<<"Error trying to read the utility value for configuration ";
-	  copy(key.begin(),key.end(), ostream_iterator<int>(cerr, " "));
-	  cerr<<endl;
-	  exit(1);
+	  std::ostringstream msg;
+	  msg<<"Error trying to read the utility value for configuration ";
+	  copy(key.begin(),key.end(), ostream_iterator<int>(msg, " "));
+	  throw InvalidFileException(msg.str());
 	}
 
 
@@ -1048,48 +1262,22 @@ void AGG::makeMAPPINGpayoff(std::istream& in, aggpayoff& pay, int numNei){
 	//pair<trie_map<AggNumber>::iterator,bool> res = pay.insert( *it);
 	
 	if (pay.count(it->first)==0){
-	    cerr<<"ERROR: utility at [";
-	    copy(it->first.begin(),it->first.end(), ostream_iterator<int>(cerr, " "));
-	    cerr<<"] not specified."<<endl;
-	    cerr<<"The set of configurations (requiring utility to be specified) are: "<<endl;
-	    cerr<<temp;
-	    cerr<<endl;
-	    cerr<<"The set of configurations to which utility has been specified are: "<<endl;
-	    cerr<<pay;
-	    cerr<<endl;
-	    exit(1);
+	    std::ostringstream msg;
+	    msg<<"ERROR: utility at [";
+	    copy(it->first.begin(),it->first.end(), ostream_iterator<int>(msg, " "));
+	    msg<<"] not specified."<<endl;
+	    msg<<"The set of configurations (requiring utility to be specified) are: "<<endl;
+	    msg<<temp;
+	    msg<<endl;
+	    msg<<"The set of configurations to which utility has been specified are: "<<endl;
+	    msg<<pay;
+	    throw InvalidFileException(msg.str());
 	}
     }
 
 
 }
 
-AggNumber AGG::getMaxPayoff(){
-  static bool done=false;
-  static AggNumber result=0;
-  if (done)return result;
-  assert(numActionNodes>0);
-  result=payoffs[0].begin()->second;
-  for (int i=1;i<numActionNodes;i++)
-    for (aggpayoff::iterator it=payoffs[i].begin();it!=payoffs[i].end();++it)
-      result=max(result, it->second);
-
-  done=true;
-  return result;
-}
-AggNumber AGG::getMinPayoff(){
-  static bool done=false;
-  static AggNumber result=0;
-  if (done)return result;
-  assert(numActionNodes>0);
-  result=payoffs[0].begin()->second;
-  for (int i=1;i<numActionNodes;i++)
-      for (aggpayoff::iterator it=payoffs[i].begin();it!=payoffs[i].end();++it)
-        result=min(result, it->second);
-  done=true;
-  return result;
-}
-
 
 }  // end namespace Gambit::agg
 
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cassert>
+#include "gambit/gambit.h"
 #include "gambit/agg/bagg.h"
 
 using namespace std;
@@ -80,8 +81,9 @@ BAGG *BAGG::makeBAGG(istream& in){
   //input number of types for each player
   for(int i=0;i<N;++i){
     if(in.eof()||in.bad()){
-      cerr<<"Error in game file: integer expected for the number of types for player "<<i<<endl;
-      exit(1);
+      std::ostringstream msg;
+      msg<<"Error in game file: integer expected for the number of types for player "<<i;
+      throw InvalidFileException(msg.str());
     }
     in>>numTypes[i];
   }
@@ -93,8 +95,7 @@ BAGG *BAGG::makeBAGG(istream& in){
     TDist.push_back(ProbDist(numTypes[i]) );
     for(int j=0;j<numTypes[i];++j){
       if(in.eof()||in.bad()){
-            cerr<<"Error in game file: number expected for type distribution"<<endl;
-            exit(1);
+            throw InvalidFileException("Error in game file: number expected for type distribution");
       }
       in>>TDist[i][j];
     }
@@ -106,8 +107,7 @@ BAGG *BAGG::makeBAGG(istream& in){
   for (int i=0;i<N;++i){
     for(int j=0;j<numTypes[i];++j){
       if(in.eof()||in.bad()){
-            cerr<<"Error in game file: integer expected for size of type action set"<<endl;
-            exit(1);
+            throw InvalidFileException("Error in game file: integer expected for size of type action set");
       }
       int temp;
       in>>temp;
@@ -123,8 +123,7 @@ BAGG *BAGG::makeBAGG(istream& in){
     for(int j=0;j<numTypes[i];++j){
       for(size_t k=0;k<typeActionSets[i][j].size();++k){
         if(in.eof()||in.bad()){
-              cerr<<"Error in game file: integer expected for type action set"<<endl;
-              exit(1);
+              throw InvalidFileException("Error in game file: integer expected for type action set");
         }
         in>> typeActionSets[i][j][k];
       }
@@ -173,8 +172,7 @@ BAGG *BAGG::makeBAGG(istream& in){
 
   AGG *aggPtr = AGG::makeAGG(aggss);
   if(!aggPtr){
-	  cerr<<"Error in BAGG file when reading the AGG part of the input."<<endl;
-	  exit(1);
+	  throw InvalidFileException("Error in BAGG file when reading the AGG part of the input.");
   }
   return new BAGG(N, S, numTypes, TDist, typeActionSets,
 		  typeAction2ActionIndex, aggPtr);
@@ -30,8 +30,8 @@ namespace Gambit {
 
 BehaviorSupportProfile::BehaviorSupportProfile(const Game &p_efg) 
   : m_efg(p_efg),
-    m_infosetActive(0, p_efg->NumPlayers()), 
-    m_nonterminalActive(0, p_efg->NumPlayers())
+    m_nodeActive(p_efg->NumNodes() + 1, false),
+    m_infosetOffset(0, p_efg->NumPlayers())
 {
   for (int pl = 1; pl <= p_efg->NumPlayers(); pl++) {
     m_actions.Append(Array<Array<GameAction> >());
@@ -45,24 +45,15 @@ BehaviorSupportProfile::BehaviorSupportProfile(const Game &p_efg)
     }
   }
 
-  // Initialize the list of reachable information sets and nodes
+  // Initialize the counts of reachable members of information sets
+  int numInfosets = 0;
   for (int pl = 0; pl <= GetGame()->NumPlayers(); pl++) {
     GamePlayer player = (pl == 0) ? GetGame()->GetChance() : GetGame()->GetPlayer(pl);
-    List<bool> is_players_infoset_active;
-    List<List<bool> > is_players_node_active;
-
-    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      is_players_infoset_active.Append(false);
-
-      List<bool> is_infosets_node_active;
-      for (int n = 1; n <= player->GetInfoset(iset)->NumMembers()
-; n++)
-	is_infosets_node_active.Append(false);
-      is_players_node_active.Append(is_infosets_node_active);
-    }
-    m_infosetActive[pl] = is_players_infoset_active;
-    m_nonterminalActive[pl] = is_players_node_active;
+    m_infosetOffset[pl] = numInfosets;
+    numInfosets += player->NumInfosets();
   }
+  m_numActiveMembers = Array<int>(numInfosets);
+  for (int i = 1; i <= numInfosets; m_numActiveMembers[i++] = 0);
 
   ActivateSubtree(GetGame()->GetRoot());
 }
@@ -138,11 +129,14 @@ bool BehaviorSupportProfile::HasActiveActionsAtAllInfosets(void) const
 
 bool BehaviorSupportProfile::RemoveAction(const GameAction &s)
 {
-  List<GameNode> startlist(ReachableMembers(s->GetInfoset()));
-  for (int i = 1; i <= startlist.Length(); i++)
-    DeactivateSubtree(startlist[i]->GetChild(s->GetNumber()));
-
   GameInfoset infoset = s->GetInfoset();
+  for (int i = 1; i <= infoset->NumMembers(); i++) {
+    GameNode member = infoset->GetMember(i);
+    if (m_nodeActive[member->GetNumber()]) {
+      DeactivateSubtree(member->GetChild(s->GetNumber()));
+    }
+  }
+
   GamePlayer player = infoset->GetPlayer();
   Array<GameAction> &actions = m_actions[player->GetNumber()][infoset->GetNumber()];
 
@@ -161,9 +155,12 @@ bool BehaviorSupportProfile::RemoveAction(const GameAction &s)
 
 bool BehaviorSupportProfile::RemoveAction(const GameAction &s, List<GameInfoset> &list)
 {
-  List<GameNode> startlist(ReachableMembers(s->GetInfoset()));
-  for (int i = 1; i <= startlist.Length(); i++) {
-    DeactivateSubtree(startlist[i]->GetChild(s->GetNumber()), list);
+  GameInfoset infoset = s->GetInfoset();
+  for (int i = 1; i <= infoset->NumMembers(); i++) {
+    GameNode member = infoset->GetMember(i);
+    if (m_nodeActive[member->GetNumber()]) {
+      DeactivateSubtree(member->GetChild(s->GetNumber()), list);
+    }
   }
 
   // the following returns false if s was not in the support
@@ -192,19 +189,24 @@ void BehaviorSupportProfile::AddAction(const GameAction &s)
     actions.Append(s);
   }
 
-  List<GameNode> startlist(ReachableMembers(s->GetInfoset()));
-  for (int i = 1; i <= startlist.Length(); i++)
-    DeactivateSubtree(startlist[i]);
+  for (int i = 1; i <= infoset->NumMembers(); i++) {
+    GameNode member = infoset->GetMember(i);
+    if (m_nodeActive[member->GetNumber()]) {
+      DeactivateSubtree(member);
+    }
+  }
 }
 
 int BehaviorSupportProfile::NumSequences(int j) const
 {
   if (j < 1 || j > m_efg->NumPlayers()) return 1;
-  List<GameInfoset> isets = ReachableInfosets(m_efg->GetPlayer(j));
+  GamePlayer player = m_efg->GetPlayer(j);
   int num = 1;
-  for(int i = 1; i <= isets.Length(); i++)
-    num+=NumActions(isets[i]->GetPlayer()->GetNumber(),
-		    isets[i]->GetNumber());
+  for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+    if (MayReach(player->GetInfoset(iset))) {
+      num += NumActions(j, iset);
+    }
+  }
   return num;
 }
 
@@ -216,35 +218,48 @@ int BehaviorSupportProfile::NumSequences(void) const
   return total;
 }
 
-List<GameNode> BehaviorSupportProfile::ReachableNonterminalNodes(const GameNode &n) const
+void
+BehaviorSupportProfile::AppendReachableNonterminalNodes(const GameNode &n,
+							List<GameNode> &p_nodes) const
 {
-  List<GameNode> answer;
-  if (!n->IsTerminal()) {
-    int pl = n->GetInfoset()->GetPlayer()->GetNumber();
-    int iset = n->GetInfoset()->GetNumber();
-    for (int i = 1; i <= NumActions(pl, iset); i++) {
-      GameNode nn = n->GetChild(GetAction(pl, iset, i)->GetNumber());
+  if (n->IsTerminal())  return;
+  if (n->GetInfoset()->GetPlayer()->IsChance()) {
+    for (int i = 1; i <= n->NumChildren(); i++) {
+      GameNode nn = n->GetChild(i);
       if (!nn->IsTerminal()) {
-	answer.Append(nn);
-	answer += ReachableNonterminalNodes(nn);
+	p_nodes.Append(nn);
+	AppendReachableNonterminalNodes(nn, p_nodes);
       }
     }
   }
+  else {
+    const Array<GameAction> &actions(m_actions[n->GetInfoset()->GetPlayer()->GetNumber()][n->GetInfoset()->GetNumber()]);
+    for (int i = 1; i <= actions.Length(); i++) {
+      GameNode nn = n->GetChild(actions[i]->GetNumber());
+      if (!nn->IsTerminal()) {
+	p_nodes.Append(nn);
+	AppendReachableNonterminalNodes(nn, p_nodes);
+      }
+    }
+  }
+}
+
+List<GameNode> BehaviorSupportProfile::ReachableNonterminalNodes(const GameNode &n) const
+{
+  List<GameNode> answer;
+  AppendReachableNonterminalNodes(n, answer);
   return answer;
 }
 
 List<GameInfoset> 
 BehaviorSupportProfile::ReachableInfosets(const GamePlayer &p) const
 { 
-  Array<GameInfoset> isets;
+  List<GameInfoset> answer;
   for (int iset = 1; iset <= p->NumInfosets(); iset++) {
-    isets.Append(p->GetInfoset(iset));
+    if (MayReach(p->GetInfoset(iset))) {
+      answer.Append(p->GetInfoset(iset));
+    }
   }
-  List<GameInfoset> answer;
-
-  for (int i = isets.First(); i <= isets.Last(); i++)
-    if (MayReach(isets[i]))
-      answer.Append(isets[i]);
   return answer;
 }
 
@@ -433,25 +448,23 @@ bool BehaviorSupportProfile::Dominates(const GameAction &a, const GameAction &b,
   }
 
   else {
-    List<GameNode> nodelist = ReachableMembers(infoset);  
-    if (nodelist.Length() == 0) {
-      // This may not be a good idea; I suggest checking for this
-      // prior to entry
-      for (int i = 1; i <= infoset->NumMembers(); i++) {
-	nodelist.Append(infoset->GetMember(i));
-      }
-    }
-    
-    for (int n = 1; n <= nodelist.Length(); n++) {
-      PVector<int> reachable(GetGame()->NumInfosets());
+    // If no member is reachable, all members are compared.
+    // This may not be a good idea; I suggest checking for this
+    // prior to entry
+    bool anyActive = IsActive(infoset);
+    PVector<int> reachable(GetGame()->NumInfosets());
+    for (int n = 1; n <= infoset->NumMembers(); n++) {
+      GameNode member = infoset->GetMember(n);
+      if (anyActive && !m_nodeActive[member->GetNumber()])  continue;
+
       reachable = 0;
-      ReachableInfosets(nodelist[n]->GetChild(a->GetNumber()), reachable);
-      ReachableInfosets(nodelist[n]->GetChild(b->GetNumber()), reachable);
+      ReachableInfosets(member->GetChild(a->GetNumber()), reachable);
+      ReachableInfosets(member->GetChild(b->GetNumber()), reachable);
       
       for (BehavConditionalIterator iter(*this, reachable); 
 	   !iter.AtEnd(); iter++) {
-	Rational ap = iter->GetPayoff<Rational>(nodelist[n]->GetChild(a->GetNumber()), pl);
-	Rational bp = iter->GetPayoff<Rational>(nodelist[n]->GetChild(b->GetNumber()), pl);
+	Rational ap = iter->GetPayoff<Rational>(member->GetChild(a->GetNumber()), pl);
+	Rational bp = iter->GetPayoff<Rational>(member->GetChild(b->GetNumber()), pl);
 	
 	if (p_strict) {
 	  if (ap <= bp) {
@@ -588,45 +601,26 @@ BehaviorSupportProfile BehaviorSupportProfile::Undominated(bool strong, bool con
 
 
 // Utilities 
-bool BehaviorSupportProfile::HasActiveMembers(int pl, int iset) const
-{
-  for (int i = 1; i <= m_nonterminalActive[pl][iset].Length(); i++) {
-    if (m_nonterminalActive[pl][iset][i]) {
-      return true;
-    }
-  }
-  return false;
-}
-
 void BehaviorSupportProfile::activate(const GameNode &n)
 {
-  m_nonterminalActive[n->GetPlayer()->GetNumber()]
-                            [n->GetInfoset()->GetNumber()]
-                            [n->NumberInInfoset()] = true;
+  if (!m_nodeActive[n->GetNumber()]) {
+    m_nodeActive[n->GetNumber()] = true;
+    m_numActiveMembers[InfosetIndex(n->GetInfoset())]++;
+  }
 }
 
 void BehaviorSupportProfile::deactivate(const GameNode &n)
 {
-  m_nonterminalActive[n->GetPlayer()->GetNumber()]
-                            [n->GetInfoset()->GetNumber()]
-                            [n->NumberInInfoset()] = false;
-}
-
-void BehaviorSupportProfile::activate(const GameInfoset &i)
-{
-  m_infosetActive[i->GetPlayer()->GetNumber()][i->GetNumber()] = true;
-}
-
-void BehaviorSupportProfile::deactivate(const GameInfoset &i)
-{
-  m_infosetActive[i->GetPlayer()->GetNumber()][i->GetNumber()] = false;
+  if (m_nodeActive[n->GetNumber()]) {
+    m_nodeActive[n->GetNumber()] = false;
+    m_numActiveMembers[InfosetIndex(n->GetInfoset())]--;
+  }
 }
 
 void BehaviorSupportProfile::ActivateSubtree(const GameNode &n)
 {
   if (!n->IsTerminal()) {
     activate(n); 
-    activate(n->GetInfoset());
     if (n->GetInfoset()->GetPlayer()->IsChance()) {
       for (int i = 1; i <= n->NumChildren(); i++) {
 	ActivateSubtree(n->GetChild(i));
@@ -643,20 +637,16 @@ void BehaviorSupportProfile::ActivateSubtree(const GameNode &n)
 
 void BehaviorSupportProfile::DeactivateSubtree(const GameNode &n)
 {
-  if (!n->IsTerminal()) {  // THIS ALL LOOKS FISHY
+  if (!n->IsTerminal()) {
     deactivate(n); 
-    if ( !HasActiveMembers(n->GetInfoset()->GetPlayer()->GetNumber(),
-			   n->GetInfoset()->GetNumber())) {
-      deactivate(n->GetInfoset());
-    }
     if (!n->GetPlayer()->IsChance()) {
-      Array<GameAction> actions(m_actions[n->GetInfoset()->GetPlayer()->GetNumber()][n->GetInfoset()->GetNumber()]);
+      const Array<GameAction> &actions(m_actions[n->GetInfoset()->GetPlayer()->GetNumber()][n->GetInfoset()->GetNumber()]);
       for (int i = 1; i <= actions.Length(); i++) {
 	DeactivateSubtree(n->GetChild(actions[i]->GetNumber()));    
       }
     }
     else {
-      for (int i = 1; i <= n->GetInfoset()->NumActions(); i++) {
+      for (int i = 1; i <= n->NumChildren(); i++) {
 	DeactivateSubtree(n->GetChild(i));
       }
     }
@@ -668,27 +658,37 @@ BehaviorSupportProfile::DeactivateSubtree(const GameNode &n, List<GameInfoset> &
 {
   if (!n->IsTerminal()) {
     deactivate(n); 
-    if (!HasActiveMembers(n->GetInfoset()->GetPlayer()->GetNumber(),
-			  n->GetInfoset()->GetNumber())) {
+    if (m_numActiveMembers[InfosetIndex(n->GetInfoset())] == 0) {
       list.Append(n->GetInfoset()); 
-      deactivate(n->GetInfoset());
     }
-    Array<GameAction> actions(m_actions[n->GetInfoset()->GetPlayer()->GetNumber()][n->GetInfoset()->GetNumber()]);
-    for (int i = 1; i <= actions.Length(); i++) {
-      DeactivateSubtree(n->GetChild(actions[i]->GetNumber()), list);    
+    if (!n->GetPlayer()->IsChance()) {
+      const Array<GameAction> &actions(m_actions[n->GetInfoset()->GetPlayer()->GetNumber()][n->GetInfoset()->GetNumber()]);
+      for (int i = 1; i <= actions.Length(); i++) {
+	DeactivateSubtree(n->GetChild(actions[i]->GetNumber()), list);    
+      }
+    }
+    else {
+      for (int i = 1; i <= n->NumChildren(); i++) {
+	DeactivateSubtree(n->GetChild(i), list);
+      }
     }
   }
 }
 
+void
+BehaviorSupportProfile::AppendReachableMembers(const GameInfoset &i,
+					       List<GameNode> &p_nodes) const
+{
+  for (int j = 1; j <= i->NumMembers(); j++)
+    if (m_nodeActive[i->GetMember(j)->GetNumber()])
+      p_nodes.Append(i->GetMember(j));
+}
+
 List<GameNode> 
 BehaviorSupportProfile::ReachableMembers(const GameInfoset &i) const
 {
   List<GameNode> answer;
-  int pl = i->GetPlayer()->GetNumber();
-  int iset = i->GetNumber();
-  for (int j = 1; j <= i->NumMembers(); j++)
-    if (m_nonterminalActive[pl][iset][j])
-      answer.Append(i->GetMember(j));
+  AppendReachableMembers(i, answer);
   return answer;
 }
 
@@ -699,42 +699,32 @@ BehaviorSupportProfile::ReachableNonterminalNodes(void) const
   for (int pl = 1; pl <= GetGame()->NumPlayers(); pl++) {
     GamePlayer p = GetGame()->GetPlayer(pl);
     for (int iset = 1; iset <= p->NumInfosets(); iset++)
-      answer += ReachableMembers(p->GetInfoset(iset));
+      AppendReachableMembers(p->GetInfoset(iset), answer);
   }
   return answer;
 }
 
 int BehaviorSupportProfile::NumActiveMembers(const GameInfoset &p_infoset) const
 {
-  int answer = 0;
-  int pl = p_infoset->GetPlayer()->GetNumber();
-  int iset = p_infoset->GetNumber();
-
-  for (int i = 1; i <= m_nonterminalActive[pl][iset].Length(); i++) {
-    if (m_nonterminalActive[pl][iset][i]) {
-      answer++;
-    }
-  }
-  return answer;
+  return m_numActiveMembers[InfosetIndex(p_infoset)];
 }
 
 bool BehaviorSupportProfile::IsActive(const GameInfoset &i) const
 {
-  return m_infosetActive[i->GetPlayer()->GetNumber()][i->GetNumber()];
+  return (m_numActiveMembers[InfosetIndex(i)] > 0);
 }
 
 
 bool BehaviorSupportProfile::IsActive(const GameNode &n) const
 {
-  return m_nonterminalActive[n->GetInfoset()->GetPlayer()->GetNumber()]
-    [n->GetInfoset()->GetNumber()][n->NumberInInfoset()];
+  return m_nodeActive[n->GetNumber()];
 }
 
 bool BehaviorSupportProfile::HasActiveActionsAtActiveInfosets(void) const
 {
   for (int pl = 1; pl <= GetGame()->NumPlayers(); pl++) {
     for (int iset = 1; iset <= GetGame()->GetPlayer(pl)->NumInfosets(); iset++) {
-      if (m_infosetActive[pl][iset] && NumActions(pl, iset) == 0) {
+      if (HasActiveMembers(pl, iset) && NumActions(pl, iset) == 0) {
 	return false;
       }
     }
@@ -746,11 +736,11 @@ bool BehaviorSupportProfile::HasActiveActionsAtActiveInfosetsAndNoOthers(void) c
 {
   for (int pl = 1; pl <= GetGame()->NumPlayers(); pl++) {
     for (int iset = 1; iset <= GetGame()->GetPlayer(pl)->NumInfosets(); iset++) {
-      if (m_infosetActive[pl][iset] && NumActions(pl, iset) == 0) {
+      if (HasActiveMembers(pl, iset) && NumActions(pl, iset) == 0) {
 	return false;
       }
 
-      if (!m_infosetActive[pl][iset] && NumActions(pl, iset) > 0) {
+      if (!HasActiveMembers(pl, iset) && NumActions(pl, iset) > 0) {
 	return false;
       }
     }
@@ -0,0 +1,121 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/context.cc
+// Budgets and cancellation for runs of the solvers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef _WIN32
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif  // _WIN32
+#include "gambit/gambit.h"
+
+namespace Gambit {
+
+namespace {
+
+// Returns the peak resident set size of the process in kilobytes,
+// or zero where this is not available
+long PeakMemory(void)
+{
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)  return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif  // __APPLE__
+#else
+  return 0;
+#endif  // _WIN32
+}
+
+}  // end anonymous namespace
+
+const char *SolverInterrupted::what(void) const throw()
+{
+  switch (m_status) {
+  case SOLVER_CANCELLED:
+    return "Solver was cancelled";
+  case SOLVER_DEADLINE_PASSED:
+    return "Solver reached its deadline";
+  case SOLVER_MEMORY_EXCEEDED:
+    return "Solver exceeded its memory limit";
+  case SOLVER_ITERATIONS_EXCEEDED:
+    return "Solver exceeded its iteration limit";
+  default:
+    return "Solver was interrupted";
+  }
+}
+
+SolverContext::SolverContext(void)
+  : m_deadline(0.0), m_memoryLimit(0), m_iterationLimit(0), m_iterations(0),
+    m_status(SOLVER_COMPLETED)
+{ }
+
+void SolverContext::SetTimeLimit(double p_seconds)
+{
+  m_deadline = Stats::WallClock() + p_seconds;
+}
+
+void SolverContext::Reset(void)
+{
+  m_iterations = 0;
+  m_status = SOLVER_COMPLETED;
+}
+
+void SolverContext::Interrupt(SolverStatus p_status)
+{
+  // Several threads may find the same budget exhausted; the first to
+  // record a reason keeps it
+#ifdef _OPENMP
+#pragma omp critical(gambit_context)
+#endif  // _OPENMP
+  {
+    if (m_status == SOLVER_COMPLETED)  m_status = p_status;
+  }
+  throw SolverInterrupted(m_status);
+}
+
+void SolverContext::Check(void)
+{
+  if (m_status != SOLVER_COMPLETED)  throw SolverInterrupted(m_status);
+  long iteration;
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif  // _OPENMP
+  iteration = ++m_iterations;
+
+  if (m_token.get() && m_token->IsCancelled()) {
+    Interrupt(SOLVER_CANCELLED);
+  }
+  if (m_iterationLimit > 0 && iteration > m_iterationLimit) {
+    Interrupt(SOLVER_ITERATIONS_EXCEEDED);
+  }
+  if (m_deadline > 0.0 && Stats::WallClock() >= m_deadline) {
+    Interrupt(SOLVER_DEADLINE_PASSED);
+  }
+  if (m_memoryLimit > 0 && iteration % 64 == 1 &&
+      PeakMemory() > m_memoryLimit) {
+    Interrupt(SOLVER_MEMORY_EXCEEDED);
+  }
+}
+
+}  // end namespace Gambit
@@ -80,6 +80,7 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
   shared_ptr<EnumMixedStrategySolution<T> > solution = new EnumMixedStrategySolution<T>(p_game);
+  this->m_progress.Start();
 
   PureStrategyProfile profile = p_game->NewPureStrategyProfile();
 
@@ -118,11 +119,17 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   b2 = (T) -1;
 
   // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0
-  VertexEnumerator<T> poly1(A1, b1);
-  VertexEnumerator<T> poly2(A2, b2);
-
-  const List<BFS<T> > &verts1(poly1.VertexList());
-  const List<BFS<T> > &verts2(poly2.VertexList());
+  List<BFS<T> > verts1, verts2;
+  try {
+    Stats::PhaseTimer phase("enummixed.vertices");
+    verts1 = VertexEnumerator<T>(A1, b1, this->m_context.get()).VertexList();
+    verts2 = VertexEnumerator<T>(A2, b2, this->m_context.get()).VertexList();
+  }
+  catch (SolverInterrupted &) {
+    // No equilibria are known until both vertex lists are complete
+    this->m_progress.Finish(0);
+    return solution;
+  }
   solution->m_v1 = verts1.Length();
   solution->m_v2 = verts2.Length();
 
@@ -134,7 +141,15 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   int i = 0;
   int id1 = 0, id2 = 0;
 
+  Stats::PhaseTimer phase("enummixed.match");
   for (int i2 = 2; i2 <= solution->m_v2; i2++) {
+    this->m_progress.Report(solution->m_extremeEquilibria.Length());
+    try {
+      this->Checkpoint();
+    }
+    catch (SolverInterrupted &) {
+      break;
+    }
     BFS<T> bfs1 = verts2[i2];
     i++;
     for (int i1 = 2; i1 <= solution->m_v1; i1++) {
@@ -191,6 +206,7 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
       }
     }
   }
+  this->m_progress.Finish(solution->m_extremeEquilibria.Length());
   return solution;
 }
 
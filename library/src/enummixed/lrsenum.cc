@@ -943,17 +943,23 @@ EnumMixedLrsStrategySolver::Solve(const Game &p_game) const
   /* User can access each output line from output which is */
   /* vertex/ray/facet from the lrs_mp_vector output         */
   /* prune is TRUE if tree should be pruned at current node */
-  do {
-    // FIXME: In some circumstances, especially the Python extension,
-    // this algorithm runs very slowly.  However, adding any sort
-    // of output call makes it run very quickly. (!) (?)
-    // This needs to be chased up further.
-    prune = lrs_checkbound(data.P1, data.Q1);
-    if (!prune && lrs_getsolution(data.P1, data.Q1, output1, col)) {
-      nash2_main(data.P1,data.Q1,P2orig,data.Q2,output1,output2,p_game,
-		 equilibria, m_onEquilibrium);
-    }
-  } while (lrs_getnextbasis(&data.P1, data.Q1, prune));
+  try {
+    do {
+      // FIXME: In some circumstances, especially the Python extension,
+      // this algorithm runs very slowly.  However, adding any sort
+      // of output call makes it run very quickly. (!) (?)
+      // This needs to be chased up further.
+      Checkpoint();
+      prune = lrs_checkbound(data.P1, data.Q1);
+      if (!prune && lrs_getsolution(data.P1, data.Q1, output1, col)) {
+	nash2_main(data.P1,data.Q1,P2orig,data.Q2,output1,output2,p_game,
+		   equilibria, m_onEquilibrium);
+      }
+    } while (lrs_getnextbasis(&data.P1, data.Q1, prune));
+  }
+  catch (SolverInterrupted &) {
+    // The equilibria found at the bases visited so far are returned
+  }
 
   lrs_clear_mp_vector(output1, data.Q1->m + data.Q1->n);
   lrs_clear_mp_vector(output2, data.Q2->m + data.Q2->n);
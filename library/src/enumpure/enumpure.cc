@@ -0,0 +1,335 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/enumpure/enumpure.cc
+// Enumerate pure-strategy equilibria of a game
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif  // _OPENMP
+#include <algorithm>
+
+#include "gambit/gambit.h"
+#include "gambit/gametable.h"
+#include "gambit/nash/enumpure.h"
+
+namespace Gambit {
+namespace Nash {
+
+namespace {
+
+int NumThreads(int p_threads)
+{
+#ifdef _OPENMP
+  return (p_threads > 0) ? p_threads : omp_get_max_threads();
+#else
+  return 1;
+#endif  // _OPENMP
+}
+
+// The payoffs to one player, read in place from the table of a game
+class TablePayoffs {
+public:
+  TablePayoffs(const GameTableRep &p_table, int p_player)
+    : m_table(p_table), m_player(p_player) { }
+
+  const Rational &operator[](int p_cont) const
+  { return m_table.GetContingencyPayoff(p_cont, m_player); }
+
+private:
+  const GameTableRep &m_table;
+  int m_player;
+};
+
+// The number of lines swept between checks of the solver's context
+const int LINES_PER_CHECK = 4096;
+
+// The most contingencies for which the payoffs to a player are held,
+// when these cannot be read from a table
+const double MAX_HELD_CONTINGENCIES = 2097152.0;
+
+//
+// Contingencies are numbered from 1.  One agent's choice is numbered
+// 1 to p_radix, and moves the contingency by p_stride; a line is the
+// set of contingencies which differ only in this choice.  On each line
+// with a contingency still a candidate for equilibrium, this clears
+// the contingencies at which the agent's payoff is less than the best
+// on the line.
+//
+// Each line is handled by one thread, and only reads the payoffs, so
+// the lines are shared out among p_threads threads with no locking.
+// Checks of the context are made between blocks of lines, as an
+// exception cannot leave a parallel region.
+//
+template <class Payoffs> void
+ClearInferiorResponses(const Payoffs &p_payoffs, int p_stride, int p_radix,
+		       Array<bool> &p_candidate, int p_threads,
+		       SolverContext *p_context)
+{
+  if (p_radix == 1)  return;
+  int numLines = p_candidate.Length() / p_radix;
+  for (int block = 0; block < numLines; block += LINES_PER_CHECK) {
+    if (p_context)  p_context->Check();
+    int end = std::min(block + LINES_PER_CHECK, numLines);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(p_threads)
+#endif  // _OPENMP
+    for (int line = block; line < end; line++) {
+      int first = 1 + (line / p_stride) * p_stride * p_radix + line % p_stride;
+      bool open = false;
+      for (int k = 0; !open && k < p_radix; k++) {
+	open = p_candidate[first + k * p_stride];
+      }
+      if (!open)  continue;
+
+      const Rational *best = &p_payoffs[first];
+      for (int k = 1; k < p_radix; k++) {
+	if (p_payoffs[first + k * p_stride] > *best) {
+	  best = &p_payoffs[first + k * p_stride];
+	}
+      }
+      for (int k = 0; k < p_radix; k++) {
+	if (p_payoffs[first + k * p_stride] < *best) {
+	  p_candidate[first + k * p_stride] = false;
+	}
+      }
+    }
+  }
+}
+
+}  // end anonymous namespace
+
+//------------------------------------------------------------------------
+//                   class EnumPureStrategySolver
+//------------------------------------------------------------------------
+
+List<MixedStrategyProfile<Rational> >
+EnumPureStrategySolver::Solve(const Game &p_game) const
+{
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  const GameTableRep *table = dynamic_cast<const GameTableRep *>(&*p_game);
+  double size = 1.0;
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    size *= p_game->GetPlayer(pl)->NumStrategies();
+  }
+  if (!table && size > MAX_HELD_CONTINGENCIES) {
+    return SolveByContingency(p_game);
+  }
+
+  List<MixedStrategyProfile<Rational> > solutions;
+  m_progress.Start();
+  int threads = NumThreads(m_threads);
+
+  // Contingencies are numbered in the order of StrategyProfileIterator,
+  // which advances the lowest-numbered player first
+  Array<int> stride(p_game->NumPlayers());
+  int numCont = 1;
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    stride[pl] = numCont;
+    numCont *= p_game->GetPlayer(pl)->NumStrategies();
+  }
+  Array<bool> candidate(numCont);
+  for (int c = 1; c <= numCont; candidate[c++] = true);
+
+  try {
+    // Payoffs of games not in table form are computed through profiles,
+    // which cannot be shared among threads, so are collected before
+    // each sweep
+    Array<Rational> payoffs((table) ? 0 : numCont);
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      int radix = p_game->GetPlayer(pl)->NumStrategies();
+      if (table) {
+	ClearInferiorResponses(TablePayoffs(*table, pl), stride[pl], radix,
+			       candidate, threads, m_context.get());
+      }
+      else {
+	int c = 1;
+	for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
+	  Checkpoint();
+	  payoffs[c++] = (*citer)->GetPayoff(pl);
+	}
+	ClearInferiorResponses(payoffs, stride[pl], radix,
+			       candidate, threads, m_context.get());
+      }
+    }
+  }
+  catch (SolverInterrupted &) {
+    // Until the sweep is complete, no contingency is known to be an
+    // equilibrium
+    m_progress.Finish(0);
+    return solutions;
+  }
+
+  int c = 1;
+  for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++, c++) {
+    if (candidate[c]) {
+      MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
+      m_onEquilibrium->Render(profile);
+      solutions.Append(profile);
+      m_progress.Report(solutions.Length());
+    }
+  }
+  m_progress.Finish(solutions.Length());
+  return solutions;
+}
+
+List<MixedStrategyProfile<Rational> >
+EnumPureStrategySolver::SolveByContingency(const Game &p_game) const
+{
+  List<MixedStrategyProfile<Rational> > solutions;
+  m_progress.Start();
+  try {
+    for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
+      Checkpoint();
+      if ((*citer)->IsNash()) {
+	MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
+	m_onEquilibrium->Render(profile);
+	solutions.Append(profile);
+      }
+      m_progress.Report(solutions.Length());
+    }
+  }
+  catch (SolverInterrupted &) { }
+  m_progress.Finish(solutions.Length());
+  return solutions;
+}
+
+//------------------------------------------------------------------------
+//                     class EnumPureAgentSolver
+//------------------------------------------------------------------------
+
+List<MixedBehaviorProfile<Rational> > 
+EnumPureAgentSolver::Solve(const BehaviorSupportProfile &p_support) const
+{
+  Game game = p_support.GetGame();
+  // The agents are the information sets which may be reached under the
+  // support.  As in IsAgentNash(), deviations may be to any action of
+  // the game; choices elsewhere cannot affect payoffs, and are left at
+  // the first action, as BehaviorProfileIterator does.  Contingencies
+  // are numbered with the first agent's choice varying fastest.
+  Array<GameInfoset> agents;
+  double size = 1.0;
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = game->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      if (p_support.MayReach(player->GetInfoset(iset))) {
+	agents.Append(player->GetInfoset(iset));
+	size *= player->GetInfoset(iset)->NumActions();
+      }
+    }
+  }
+  if (size > MAX_HELD_CONTINGENCIES) {
+    return SolveByContingency(p_support);
+  }
+
+  List<MixedBehaviorProfile<Rational> > solutions;
+  m_progress.Start();
+  int threads = NumThreads(m_threads);
+
+  Array<int> stride(agents.Length());
+  int numCont = 1;
+  for (int a = 1; a <= agents.Length(); a++) {
+    stride[a] = numCont;
+    numCont *= agents[a]->NumActions();
+  }
+  Array<bool> candidate(numCont);
+  for (int c = 1; c <= numCont; candidate[c++] = true);
+
+  try {
+    // Payoffs are computed through a profile, which cannot be shared
+    // among threads, so those to each player are collected first
+    Array<Rational> payoffs(numCont);
+    Array<int> choice(agents.Length());
+    PureBehaviorProfile profile(game);
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      bool hasAgents = false;
+      for (int a = 1; a <= agents.Length(); a++) {
+	hasAgents = hasAgents || (agents[a]->GetPlayer()->GetNumber() == pl);
+	choice[a] = 1;
+	profile.SetAction(agents[a]->GetAction(1));
+      }
+      if (!hasAgents)  continue;
+
+      for (int c = 1; c <= numCont; c++) {
+	Checkpoint();
+	payoffs[c] = profile.GetPayoff<Rational>(pl);
+	for (int a = 1; a <= agents.Length(); a++) {
+	  if (choice[a] < agents[a]->NumActions()) {
+	    profile.SetAction(agents[a]->GetAction(++choice[a]));
+	    break;
+	  }
+	  choice[a] = 1;
+	  profile.SetAction(agents[a]->GetAction(1));
+	}
+      }
+
+      for (int a = 1; a <= agents.Length(); a++) {
+	if (agents[a]->GetPlayer()->GetNumber() == pl) {
+	  ClearInferiorResponses(payoffs, stride[a], agents[a]->NumActions(),
+				 candidate, threads, m_context.get());
+	}
+      }
+    }
+  }
+  catch (SolverInterrupted &) {
+    m_progress.Finish(0);
+    return solutions;
+  }
+
+  for (BehaviorProfileIterator citer(p_support); !citer.AtEnd(); citer++) {
+    int c = 1;
+    for (int a = 1; a <= agents.Length(); a++) {
+      c += (citer->GetAction(agents[a])->GetNumber() - 1) * stride[a];
+    }
+    if (candidate[c]) {
+      MixedBehaviorProfile<Rational> profile = citer->ToMixedBehaviorProfile();
+      m_onEquilibrium->Render(profile);
+      solutions.Append(profile);
+      m_progress.Report(solutions.Length());
+    }
+  }
+  m_progress.Finish(solutions.Length());
+  return solutions;
+}
+
+List<MixedBehaviorProfile<Rational> > 
+EnumPureAgentSolver::SolveByContingency(const BehaviorSupportProfile &p_support) const
+{
+  List<MixedBehaviorProfile<Rational> > solutions;
+  m_progress.Start();
+  try {
+    for (BehaviorProfileIterator citer(p_support); !citer.AtEnd(); citer++) {
+      Checkpoint();
+      if (citer->IsAgentNash()) {
+	MixedBehaviorProfile<Rational> profile = citer->ToMixedBehaviorProfile();
+	m_onEquilibrium->Render(profile);
+	solutions.Append(profile);
+      }
+      m_progress.Report(solutions.Length());
+    }
+  }
+  catch (SolverInterrupted &) { }
+  m_progress.Finish(solutions.Length());
+  return solutions;
+}
+
+}  // end namespace Gambit::Nash
+}  // end namespace Gambit
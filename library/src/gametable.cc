@@ -22,6 +22,8 @@
 
 #include <iostream>
 #include <sstream>
+#include <cmath>
+#include <vector>
 
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
@@ -176,6 +178,86 @@ Game GameTableRep::Copy(void) const
 //                  GameTableRep: General data access
 //------------------------------------------------------------------------
 
+void GameTableRep::GetPayoffs(double *p_payoffs) const
+{
+  int numCont = m_results.Length();
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    double *payoffs = p_payoffs + (pl - 1) * numCont;
+    for (int cont = 1; cont <= numCont; cont++) {
+      GameOutcomeRep *outcome = m_results[cont];
+      payoffs[cont - 1] = (outcome) ? outcome->GetPayoff<double>(pl) : 0.0;
+    }
+  }
+}
+
+namespace {
+// The payoff at contingencies with no outcome
+const Rational s_zeroPayoff(0);
+} // end anonymous namespace
+
+const Rational &GameTableRep::GetContingencyPayoff(int p_cont, 
+						   int p_player) const
+{
+  GameOutcomeRep *outcome = m_results[p_cont];
+  return (outcome) ? outcome->GetPayoff<Rational>(p_player) : s_zeroPayoff;
+}
+
+void GameTableRep::SetPayoffs(const double *p_payoffs)
+{
+  int numCont = m_results.Length();
+  for (int i = 0; i < m_players.Length() * numCont; i++) {
+    if (!std::isfinite(p_payoffs[i])) {
+      throw ValueException("Payoffs must be finite");
+    }
+  }
+
+  UniqueOutcomes();
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    const double *payoffs = p_payoffs + (pl - 1) * numCont;
+    for (int cont = 1; cont <= numCont; cont++) {
+      m_results[cont]->SetPayoff(pl, Rational(payoffs[cont - 1]));
+    }
+  }
+}
+
+void GameTableRep::SetPayoffs(const long *p_num, const long *p_den)
+{
+  int numCont = m_results.Length();
+  for (int i = 0; i < m_players.Length() * numCont; i++) {
+    if (p_den[i] == 0) {
+      throw ZeroDivideException();
+    }
+  }
+
+  UniqueOutcomes();
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    int offset = (pl - 1) * numCont;
+    for (int cont = 1; cont <= numCont; cont++) {
+      m_results[cont]->SetPayoff(pl, Rational(p_num[offset + cont - 1],
+					      p_den[offset + cont - 1]));
+    }
+  }
+}
+
+//
+// Makes sure every contingency has an outcome, and that no outcome
+// is attached to more than one contingency, so that payoffs can be
+// assigned cell by cell.
+//
+void GameTableRep::UniqueOutcomes(void)
+{
+  std::vector<bool> used(m_outcomes.Length() + 1, false);
+  for (int cont = 1; cont <= m_results.Length(); cont++) {
+    GameOutcomeRep *outcome = m_results[cont];
+    if (outcome && !used[outcome->GetNumber()]) {
+      used[outcome->GetNumber()] = true;
+    }
+    else {
+      m_results[cont] = NewOutcome();
+    }
+  }
+}
+
 bool GameTableRep::IsConstSum(void) const
 {
   TablePureStrategyProfileRep profile(const_cast<GameTableRep *>(this));
@@ -22,6 +22,8 @@
 
 #include <iostream>
 #include <sstream>
+#include <vector>
+#include <algorithm>
 
 #include "gambit/gambit.h"
 #include "gambit/gametree.h"
@@ -683,6 +685,34 @@ void GameTreeRep::NumberNodes(GameTreeNodeRep *n, int &index)
        NumberNodes(n->children[child++], index));
 } 
 
+namespace {
+
+bool PrecedesNode(const GameTreeNodeRep *p_node1,
+		  const GameTreeNodeRep *p_node2)
+{ return p_node1->GetNumber() < p_node2->GetNumber(); }
+
+// Information sets are ordered by their first member; those with
+// no members go last
+bool PrecedesInfoset(const GameTreeInfosetRep *p_infoset1,
+		     const GameTreeInfosetRep *p_infoset2)
+{
+  if (p_infoset2->NumMembers() == 0)  return p_infoset1->NumMembers() > 0;
+  if (p_infoset1->NumMembers() == 0)  return false;
+  return (p_infoset1->GetMember(1)->GetNumber() < 
+	  p_infoset2->GetMember(1)->GetNumber());
+}
+
+template <class T, class Compare>
+void SortArray(Array<T> &p_array, Compare p_precedes)
+{
+  std::vector<T> items(p_array.Length());
+  for (int i = 1; i <= p_array.Length(); i++)  items[i-1] = p_array[i];
+  std::stable_sort(items.begin(), items.end(), p_precedes);
+  for (int i = 1; i <= p_array.Length(); i++)  p_array[i] = items[i-1];
+}
+
+}  // end anonymous namespace
+
 void GameTreeRep::Canonicalize(void)
 {
   if (!m_doCanon)  return;
@@ -693,38 +723,12 @@ void GameTreeRep::Canonicalize(void)
     GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
     
     // Sort nodes within information sets according to ID.
-    // Coded using a bubble sort for simplicity; large games might
-    // find a quicksort worthwhile.
     for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
-      GameTreeInfosetRep *infoset = player->m_infosets[iset];
-      for (int i = 1; i < infoset->m_members.Length(); i++) {
-	for (int j = 1; j < infoset->m_members.Length() - i; j++) {
-	  if (infoset->m_members[j+1]->number < infoset->m_members[j]->number) {
-	    GameTreeNodeRep *tmp = infoset->m_members[j];
-	    infoset->m_members[j] = infoset->m_members[j+1];
-	    infoset->m_members[j+1] = tmp;
-	  }
-	}
-      }
+      SortArray(player->m_infosets[iset]->m_members, PrecedesNode);
     }
 
     // Sort information sets by the smallest ID among their members
-    // Coded using a bubble sort for simplicity; large games might
-    // find a quicksort worthwhile.
-    for (int i = 1; i < player->m_infosets.Length(); i++) {
-      for (int j = 1; j < player->m_infosets.Length() - i; j++) {
-	int a = ((player->m_infosets[j+1]->m_members.Length()) ?
-		 player->m_infosets[j+1]->m_members[1]->number : 0);
-	int b = ((player->m_infosets[j]->m_members.Length()) ?
-		 player->m_infosets[j]->m_members[1]->number : 0);
-
-	if (a < b || b == 0) {
-	  GameTreeInfosetRep *tmp = player->m_infosets[j];
-	  player->m_infosets[j] = player->m_infosets[j+1];
-	  player->m_infosets[j+1] = tmp;
-	}
-      }
-    }
+    SortArray(player->m_infosets, PrecedesInfoset);
 
     // Reassign information set IDs
     for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
@@ -736,9 +740,10 @@ void GameTreeRep::Canonicalize(void)
 void GameTreeRep::ClearComputedValues(void) const
 {
   for (int pl = 1; pl <= m_players.Length(); pl++) {
-    while (m_players[pl]->m_strategies.Length() > 0) {
-      m_players[pl]->m_strategies.Remove(1)->Invalidate();
+    for (int st = 1; st <= m_players[pl]->m_strategies.Length(); st++) {
+      m_players[pl]->m_strategies[st]->Invalidate();
     }
+    m_players[pl]->m_strategies = GameStrategyArray();
   }
 
   m_computedValues = false;
@@ -21,6 +21,7 @@
 //
 
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 #include "gambit/nash/gnm.h"
 #include "gambit/gtracer/gtracer.h"
 
@@ -60,15 +61,21 @@ NashGNMStrategySolver::Solve(const Game &p_game,
   }
   cvector norm_pert = p_pert / p_pert.norm(); 
   cvector **answers;
-  int numEq = GNM(*p_rep, norm_pert, answers,
-		  STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD,
-		  m_verbose);
+  m_progress.Start();
+  int numEq;
+  {
+    Stats::PhaseTimer phase("gnm.trace");
+    numEq = GNM(*p_rep, norm_pert, answers,
+		STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD,
+		m_verbose, m_context.get());
+  }
   for (int i = 0; i < numEq; i++) {
     eqa.push_back(ToProfile(p_game, *answers[i]));
     m_onEquilibrium->Render(eqa.back());
     free(answers[i]);
   }
   free(answers);
+  m_progress.Finish(eqa.Length());
   return eqa;
 }
 
@@ -78,11 +85,16 @@ NashGNMStrategySolver::BuildRepresentation(const Game &p_game) const
   if (p_game->IsAgg()) {
     return new aggame(dynamic_cast<GameAggRep &>(*p_game));
   }
-  else {
-    Rational maxPay = p_game->GetMaxPayoff();
-    Rational minPay = p_game->GetMinPayoff();
-    double scale = 1.0 / (maxPay - minPay);
 
+  Rational maxPay = p_game->GetMaxPayoff();
+  Rational minPay = p_game->GetMinPayoff();
+  double scale = 1.0 / (maxPay - minPay);
+
+  if (GameTableRep *table = dynamic_cast<GameTableRep *>(&*p_game)) {
+    // Read the payoffs straight from the table, rescaled to [0,1]
+    return new nfgame(*table, (double) minPay, scale);
+  }
+  else {
     int *actions = new int[p_game->NumPlayers()];
     int veclength = p_game->NumPlayers();
     for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
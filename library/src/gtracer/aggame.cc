@@ -21,6 +21,7 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include "gambit/stats.h"
 #include "gambit/gtracer/aggame.h"
 
 namespace Gambit {
@@ -34,21 +35,21 @@ void aggame::computePartialP_PureNode(int player1,int act1, std::vector<int>& ta
     std::vector<agg::AggNumber> strat (numNei);
     agg::AGG::config    a(numNei,0);
     //compute the full distrib
-    aggPtr->computeP (player1,act1);
+    aggPtr->computeP(ctx,player1,act1);
 
     //store the full distrib in Pr[player1]
-    aggPtr->Pr[player1].swap(aggPtr->Pr[numPlayers-1]);
+    ctx.Pr[player1].swap(ctx.Pr[numPlayers-1]);
     for(i=0;i<(int)tasks.size();i++){
       //assert(tasks[i]!=player1);
-      agg::aggdistrib& P = aggPtr->Pr[tasks[i]];
+      agg::aggdistrib& P = ctx.Pr[tasks[i]];
       //P.clear();  // to get ready for division, we need clear()
-      P=aggPtr->Pr[player1];
+      P=ctx.Pr[player1];
 
       bool NullOnly =true;
       for(j=0;j<numNei;++j){
 	a[j]++;
-	agg::aggdistrib::iterator pp = aggPtr->projectedStrat[Node][tasks[i]].find(a);
-	if (pp== aggPtr->projectedStrat[Node][tasks[i]].end()) {
+	agg::aggdistrib::iterator pp = ctx.projectedStrat[Node][tasks[i]].find(a);
+	if (pp== ctx.projectedStrat[Node][tasks[i]].end()) {
 	    strat[j]=0;
 	}
 	else {
@@ -90,7 +91,7 @@ void aggame::computePartialP_bisect(int player1,int act1,
     <<", act1="<<act1<<" *start="<<*start<<" *(endp-1)="<<*(endp-1)
     <<", (endp-start)="<< endp-start <<endl;
 #endif
-  if(endp-start==1){aggPtr->Pr[*start].reset();return;}
+  if(endp-start==1){ctx.Pr[*start].reset();return;}
   int Node = aggPtr->actionSets[player1][act1];
   int numNei=aggPtr->neighbors[Node].size();
 
@@ -105,27 +106,27 @@ void aggame::computePartialP_bisect(int player1,int act1,
 
 
   temp.reset();
-  temp = aggPtr->projectedStrat[Node][*start];
-  if (mid-start>1) temp.multiply(aggPtr->Pr[*start],numNei,aggPtr->projFunctions[Node]);
+  temp = ctx.projectedStrat[Node][*start];
+  if (mid-start>1) temp.multiply(ctx.Pr[*start],numNei,aggPtr->projFunctions[Node]);
 
   if (mid-start==1) {
-    //assert(aggPtr->Pr[*start].empty());
-    aggPtr->Pr[*start]= aggPtr->projectedStrat[Node][*mid];
-    if(endp-mid>1) aggPtr->Pr[*start].multiply(aggPtr->Pr[*mid],numNei,aggPtr->projFunctions[Node]);
+    //assert(ctx.Pr[*start].empty());
+    ctx.Pr[*start]= ctx.projectedStrat[Node][*mid];
+    if(endp-mid>1) ctx.Pr[*start].multiply(ctx.Pr[*mid],numNei,aggPtr->projFunctions[Node]);
   }
   else for (ptr=start; ptr!=mid; ++ptr){
     player2= *ptr;
-    aggPtr->Pr[player2].multiply(aggPtr->projectedStrat[Node][*mid],numNei,aggPtr->projFunctions[Node] );
-    if(endp-mid>1) aggPtr->Pr[player2].multiply(aggPtr->Pr[*mid],numNei,aggPtr->projFunctions[Node]);
+    ctx.Pr[player2].multiply(ctx.projectedStrat[Node][*mid],numNei,aggPtr->projFunctions[Node] );
+    if(endp-mid>1) ctx.Pr[player2].multiply(ctx.Pr[*mid],numNei,aggPtr->projFunctions[Node]);
   }
 
   if(endp-mid==1){
-    //assert(aggPtr->Pr[*mid].empty());
-    aggPtr->Pr[*mid]=temp;
+    //assert(ctx.Pr[*mid].empty());
+    ctx.Pr[*mid]=temp;
   }
   else for (ptr=mid;ptr!=endp;++ptr){
     player2=*ptr;
-    aggPtr->Pr[player2].multiply(temp,numNei, aggPtr->projFunctions[Node]);
+    ctx.Pr[player2].multiply(temp,numNei, aggPtr->projFunctions[Node]);
 
   }
 
@@ -135,6 +136,7 @@ void aggame::computePartialP_bisect(int player1,int act1,
 
 
 void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
+  Gambit::Stats::Count(Gambit::Stats::JACOBIAN_BUILDS);
   //compute jacobian
   //s: mixed strat
 
@@ -144,16 +146,16 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
 #endif
   agg::AggNumber fuzzcount;
   int rown, coln, rowi, coli,act1,act2,currNode,numNei;
-  static std::vector<int>::iterator p;
-  static std::vector<int> tasks,spares,nontasks;
+  std::vector<int>::iterator p;
+  std::vector<int> tasks,spares,nontasks;
   tasks.reserve(aggPtr->numPlayers);
   spares.reserve(aggPtr->numPlayers);
   nontasks.reserve(aggPtr->numPlayers);
-  aggPtr->cache.reset();
+  ctx.cache.reset();
 
   //do projection
   for(int Node=0; Node< aggPtr->numActionNodes; Node++)
-	aggPtr->doProjection(Node,s.values());
+	aggPtr->doProjection(ctx,Node,s.values());
 
   //deal with the diagonal
   for (rown=0; rown<aggPtr->numPlayers; ++rown){
@@ -173,7 +175,7 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
 #ifdef AGGDEBUG
             cout<<"for player "<<rown<<", action "<<act1
                 <<", action node "<<currNode<<endl;
-	    cout<< "cache is: "<<endl<<aggPtr->cache<<endl;
+	    cout<< "cache is: "<<endl<<ctx.cache<<endl;
 #endif
 	    tasks.clear();  //for these col players, we need to compute the distribution induced by their complements. input of the bisection alg
 	    spares.clear(); //these col players have only one projected action
@@ -197,8 +199,8 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
                 copy(key.begin(),key.end(),ostream_iterator<int>(cout," ") );
                 cout<<"]\n";
 #endif
-	        agg::aggdistrib::iterator r= aggPtr->cache.findExact(key);
-	        if (r!=aggPtr->cache.end()){
+	        agg::aggdistrib::iterator r= ctx.cache.findExact(key);
+	        if (r!=ctx.cache.end()){
 	          dest[act1+firstAction(rown)][act2+firstAction(coln)]=r->second;
 	        }
 	        else{
@@ -232,33 +234,33 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
 	    if(aggPtr->isPure[currNode]||tasks.size()==0){
 	      computePartialP_PureNode(rown, act1,tasks);
 	    }else{//do bisection
-	      computePartialP_bisect(rown,act1,tasks.begin(),tasks.end(),aggPtr->Pr[rown]);
+	      computePartialP_bisect(rown,act1,tasks.begin(),tasks.end(),ctx.Pr[rown]);
 #ifdef AGGDEBUG
               cout<<"after calling computePartialP_bisect:"<<endl;
               for (int tt=0;tt<tasks.size();tt++){
                 cout<<"for player "<<tasks[tt]<<endl;
-                cout<<aggPtr->Pr[tasks[tt]]<<endl;
+                cout<<ctx.Pr[tasks[tt]]<<endl;
               }
 #endif
 	      //now apply rown's action (act1), and the strategies of
 	      //players in nontasks
-          aggPtr->Pr[rown].reset();
-          aggPtr->Pr[rown].insert(
+          ctx.Pr[rown].reset();
+          ctx.Pr[rown].insert(
 		    make_pair(aggPtr->projection[currNode][rown][act1],1.0));
 	      for(p=nontasks.begin();p!=nontasks.end();++p)
-	    	  aggPtr->Pr[rown].multiply(aggPtr->projectedStrat[currNode][*p],numNei, aggPtr->projFunctions[currNode]);
+	    	  ctx.Pr[rown].multiply(ctx.projectedStrat[currNode][*p],numNei, aggPtr->projFunctions[currNode]);
 #ifdef AGGDEBUG
               cout<<"the polynomial product of strats of player "
                   <<rown<< " and players in the vector nontasks is:"
                   <<endl;
-              cout<<aggPtr->Pr[rown]<<endl;
+              cout<<ctx.Pr[rown]<<endl;
 #endif
 	      if (tasks.size()==1){
-	    	  aggPtr->Pr[tasks[0]]=aggPtr->Pr[rown];
+	    	  ctx.Pr[tasks[0]]=ctx.Pr[rown];
 	      }
 	      else {
                 for(p=tasks.begin();p!=tasks.end();++p){
-		  if(aggPtr->Pr[*p].size()==0){
+		  if(ctx.Pr[*p].size()==0){
 		    std::cerr<<"AGG::payoffMatrix() ERROR for rown="
 		        <<rown<<" act1="<<act1<<" *p=" <<*p
 			     <<": the distribution should not be empty!"<<std::endl;
@@ -267,8 +269,8 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
 #endif
 
 		  }
-		  aggPtr->Pr[*p].multiply(
-				  aggPtr->Pr[rown],numNei,aggPtr->projFunctions[currNode]);
+		  ctx.Pr[*p].multiply(
+				  ctx.Pr[rown],numNei,aggPtr->projFunctions[currNode]);
 	        }//end for(p=tasks.begin...
 	      }
 
@@ -277,10 +279,10 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
 	      //we store this distrib in Pr[rown][act1][rown]
 	      if (spares.size()>0){
 		//assert(tasks.size()>0);
-	    	  aggPtr->Pr[rown].reset();
-	    	  aggPtr->Pr[rown].multiply(
-	    			  aggPtr->Pr[tasks[0]],
-	    			  aggPtr->projectedStrat[currNode][tasks[0]],numNei,aggPtr->projFunctions[currNode]);
+	    	  ctx.Pr[rown].reset();
+	    	  ctx.Pr[rown].multiply(
+	    			  ctx.Pr[tasks[0]],
+	    			  ctx.projectedStrat[currNode][tasks[0]],numNei,aggPtr->projFunctions[currNode]);
 	      }
 	    } //end else
 #ifdef AGGDEBUG
@@ -288,7 +290,7 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
                 <<endl;
             for (int tt = 0;tt<numPlayers;tt++){
               cout<<"for player "<<tt<<endl;
-              cout<<aggPtr->Pr[tt];
+              cout<<ctx.Pr[tt];
               cout<<endl;
             }
 #endif
@@ -300,19 +302,19 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
 	      computeUndisturbedPayoff(undisturbedPayoff,hasUndisturbed,rown,act1, rown);
 	      for(p=spares.begin();p!=spares.end();++p)
 		for(act2=0;act2<aggPtr->actions[*p];act2++)
-		  savePayoff(dest,rown,act1,*p,act2, undisturbedPayoff,aggPtr->cache);
+		  savePayoff(dest,rown,act1,*p,act2, undisturbedPayoff,ctx.cache);
 
 	    }
 	    for(p=tasks.begin();p!=tasks.end();++p){
 	      for(act2=0;act2<aggPtr->actions[*p];act2++){//act2: col action
 
-		if (aggPtr->projectedStrat[currNode][*p].size()==1  &&
-				aggPtr->projectedStrat[currNode][*p].begin()->first==aggPtr->projection[currNode][*p][act2])
+		if (ctx.projectedStrat[currNode][*p].size()==1  &&
+				ctx.projectedStrat[currNode][*p].begin()->first==aggPtr->projection[currNode][*p][act2])
 		{
 		  computeUndisturbedPayoff(undisturbedPayoff,hasUndisturbed,rown,act1,*p);
-		  savePayoff(dest,rown,act1,*p,act2,undisturbedPayoff,aggPtr->cache);
+		  savePayoff(dest,rown,act1,*p,act2,undisturbedPayoff,ctx.cache);
 		}
-		computePayoff(dest,rown,act1,*p,act2,aggPtr->cache);
+		computePayoff(dest,rown,act1,*p,act2,ctx.cache);
 	      }//end for(act2
 	    }//end for(p
 	}//end for(act1
@@ -324,13 +326,12 @@ void aggame::computeUndisturbedPayoff(agg::AggNumber& undisturbedPayoff,bool& ha
 {
   if (has) return;
   int    Node =aggPtr->actionSets[player1][act1];
-  int    numNei= aggPtr->neighbors[Node].size();
   if (player2==player1){
-    undisturbedPayoff=aggPtr->Pr[player2].inner_prod(aggPtr->payoffs[Node]);
+    undisturbedPayoff=aggPtr->expectedPayoff(Node,ctx.Pr[player2]);
   }else{
-    //assert(aggPtr->projectedStrat[Node][player2].size()==1);
-    undisturbedPayoff=aggPtr->Pr[player2].inner_prod(
-    		aggPtr->projectedStrat[Node][player2].begin()->first,numNei,aggPtr->projFunctions[Node],aggPtr->payoffs[Node]);
+    //assert(ctx.projectedStrat[Node][player2].size()==1);
+    undisturbedPayoff=aggPtr->expectedPayoff(Node,ctx.Pr[player2],
+    		ctx.projectedStrat[Node][player2].begin()->first);
   }
   has=true;
 }
@@ -375,8 +376,8 @@ void aggame::computePayoff(cmatrix& dest,int player1,int act1,int player2,int ac
   if (! r.second) {
     dest[act1+firstAction(player1)][act2+firstAction(player2)]=r.first->second;
   }else{
-    r.first->second=aggPtr->Pr[player2].inner_prod(
-    		aggPtr->projection[Node][player2][act2],numNei,aggPtr->projFunctions[Node],aggPtr->payoffs[Node]);
+    r.first->second=aggPtr->expectedPayoff(Node,ctx.Pr[player2],
+    		aggPtr->projection[Node][player2][act2]);
     savePayoff(dest,player1,act1,player2,act2,r.first->second,cache,r.second);
   }
 }
@@ -385,12 +386,11 @@ void aggame::computePayoff(cmatrix& dest,int player1,int act1,int player2,int ac
 
 void aggame::SymPayoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
   if (getNumPlayerClasses()>1){
-    std::cerr<<"SymPayoffMatrix() Error: game is not symmetric"<<std::endl;
-    exit(1);
+    throw UndefinedException("SymPayoffMatrix() Error: game is not symmetric");
   }
   //assert(getNumPlayers()>1);
 
-  aggPtr->cache.clear();
+  ctx.cache.clear();
 
   agg::AggNumber fuzzcount;
 
@@ -400,10 +400,10 @@ void aggame::SymPayoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
     numNei= aggPtr->neighbors[currNode].size();
     //std::vector<int> key (numNei+1);
     //key[numNei]=currNode;
-    aggPtr->doProjection(currNode,0,&(s[firstAction(0)]));
-    agg::aggdistrib &Pdest = aggPtr->Pr[numPlayers-1];
-    aggPtr->projectedStrat[currNode][0].power(numPlayers-2, Pdest, aggPtr->Pr[numPlayers-2],numNei,aggPtr->projFunctions[currNode]);
-    agg::aggdistrib &temp=aggPtr->Pr[numPlayers-2];
+    aggPtr->doProjection(ctx,currNode,0,&(s[firstAction(0)]));
+    agg::aggdistrib &Pdest = ctx.Pr[numPlayers-1];
+    ctx.projectedStrat[currNode][0].power(numPlayers-2, Pdest, ctx.Pr[numPlayers-2],numNei,aggPtr->projFunctions[currNode]);
+    agg::aggdistrib &temp=ctx.Pr[numPlayers-2];
     temp.reset();
     temp.insert(make_pair(aggPtr->projection[currNode][0][rowa],1));
     Pdest.multiply(temp,numNei,aggPtr->projFunctions[currNode]);
@@ -412,13 +412,13 @@ void aggame::SymPayoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
 
       //insPair.first.reserve(numNei+3);
       insPair.first.push_back(currNode);
-      std::pair<agg::trie_map<agg::AggNumber>::iterator,bool> r =aggPtr->cache.insert(insPair);
+      std::pair<agg::trie_map<agg::AggNumber>::iterator,bool> r =ctx.cache.insert(insPair);
 
       if (! r.second) {
           dest[rowa][cola]=r.first->second;
       }else{
           r.first->second=agg::AggNumber(numPlayers-1)
-              * Pdest.inner_prod(aggPtr->projection[currNode][0][cola], numNei, aggPtr->projFunctions[currNode], aggPtr->payoffs[currNode]);
+              * aggPtr->expectedPayoff(currNode, Pdest, aggPtr->projection[currNode][0][cola]);
           dest[rowa][cola]=r.first->second;
       }
     }
@@ -450,7 +450,7 @@ void aggame::KSymPayoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
 
           dest[rowa+firstKSymAction(rowcls)][cola+firstKSymAction(colcls)]=
               (agg::AggNumber)multiplier *
-              aggPtr->getKSymMixedPayoff(sp,rowcls,rowa,colcls,cola);
+              aggPtr->getKSymMixedPayoff(ctx,sp,rowcls,rowa,colcls,cola);
         }
       }
     }
@@ -67,7 +67,7 @@ void PrintProfile(std::ostream &p_stream,
 //            wobbles are disabled, GNM will terminate if the error
 //            reaches this threshold.
 
-int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold, bool verbose)
+int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold, bool verbose, SolverContext *p_context)
 {
   int i, // utility variables
     bestAction,  
@@ -215,6 +215,18 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 
     // take the specified number of steps within these support boundaries.  
     for(stepsLeft = steps; stepsLeft > 0; stepsLeft--) { 
+      Stats::Count(Stats::PATH_STEPS);
+      if (p_context) {
+	try {
+	  p_context->Check();
+	}
+	catch (SolverInterrupted &) {
+	  if (verbose) {
+	    std::cerr << "gnm(): return since the solver was interrupted" << std::endl;
+	  }
+	  return numEq;
+	}
+      }
       //find J = Adj psi
       J = I;
       J += DG;
@@ -23,6 +23,7 @@
 //
 
 #include <cmath>
+#include "gambit/stats.h"
 #include "gambit/gtracer/cmatrix.h"
 #include "gambit/gtracer/gnmgame.h"
 
@@ -322,6 +323,7 @@ void gnmgame::LemkeHowson(cvector &dest, cmatrix &T, std::vector<int> &Im) {
 
 int gnmgame::Pivot(cmatrix &T, int pr, int pc, std::vector<int> &row, 
 		   std::vector<int> &col, double &D) {
+  Gambit::Stats::Count(Gambit::Stats::PIVOTS);
   double pivot = T[pr][pc];
   int i0,j0,p,sgn = pivot < 0 ? -1 : 1;
   
@@ -42,7 +42,7 @@ static bool g_verbose = false;
 //       stops refining it
 // ans: a pre-allocated vector in which the equilibrium will be stored
 
-int IPA(gnmgame &A, cvector &g, cvector &zh, double alpha, double fuzz, cvector &ans,int maxiter) {
+int IPA(gnmgame &A, cvector &g, cvector &zh, double alpha, double fuzz, cvector &ans,int maxiter, SolverContext *p_context) {
   int N = A.getNumPlayers(),
     M = A.getNumActions(), // For easy reference
     i,j,n,bestAction,B, // utility vars
@@ -92,6 +92,7 @@ int IPA(gnmgame &A, cvector &g, cvector &zh, double alpha, double fuzz, cvector
   so = sh;
 
   while(maxiter<0||iter<=maxiter) {
+    if (p_context) p_context->Check();
     A.payoffMatrix(DG,sh,0.0);
     DG /= (double)(N-1); // find the Jacobian of the approximating bimatrix game
 
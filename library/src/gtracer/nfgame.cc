@@ -23,6 +23,7 @@
 //
 
 #include <vector>
+#include "gambit/stats.h"
 #include "gambit/gtracer/cmatrix.h"
 #include "gambit/gtracer/nfgame.h"
 
@@ -37,6 +38,26 @@ nfgame::nfgame(int numPlayers, int *actions, const cvector &payoffs) : gnmgame(n
   }
 }
 
+nfgame::nfgame(const Gambit::GameTableRep &g, double offset, double scale)
+  : gnmgame(g.NumPlayers(), &g.NumStrategies()[1]),
+    payoffs(g.NumPlayers() * g.NumContingencies()) {
+  blockSize = new int[numPlayers + 1];
+  blockSize[0] = 1;
+  for(int i = 1; i <= numPlayers; i++) {
+    blockSize[i] = blockSize[i-1]*actions[i-1];
+  }
+
+  // The table is laid out as payoffs are here: by player, then with
+  // the first player's strategy varying fastest.
+  g.GetPayoffs(payoffs.values());
+  if (offset != 0.0 || scale != 1.0) {
+    double *x = payoffs.values();
+    for(int i = 0; i < payoffs.getm(); i++) {
+      x[i] = (x[i] - offset) * scale;
+    }
+  }
+}
+
 nfgame::~nfgame() {
   delete[] blockSize;
 }
@@ -69,6 +90,7 @@ void nfgame::getPayoffVector(cvector &dest, int player, const cvector &s){
 }
 
 void nfgame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz) {
+  Gambit::Stats::Count(Gambit::Stats::JACOBIAN_BUILDS);
   int rown, coln, rowi, coli;
   double fuzzcount;
   double *m = new double[blockSize[numPlayers]];
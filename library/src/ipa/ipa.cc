@@ -21,6 +21,7 @@
 //
 
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 #include "gambit/nash/ipa.h"
 #include "gambit/gtracer/gtracer.h"
 
@@ -53,6 +54,9 @@ NashIPAStrategySolver::Solve(const Game &p_game,
   if (p_game->IsAgg()){
     A = new aggame(dynamic_cast<GameAggRep &>(*p_game));
   }
+  else if (GameTableRep *table = dynamic_cast<GameTableRep *>(&*p_game)) {
+    A = new nfgame(*table);
+  }
   else {
     int *actions = new int[p_game->NumPlayers()];
     int veclength = p_game->NumPlayers();
@@ -81,16 +85,24 @@ NashIPAStrategySolver::Solve(const Game &p_game,
 
   cvector ans(A->getNumActions());
   cvector zh(A->getNumActions(),1.0);
-  do {
-    const double ALPHA = 0.2;
-    const double EQERR = 1e-6;
+  m_progress.Start();
+  try {
+    do {
+      Stats::PhaseTimer phase("ipa.iterate");
+      const double ALPHA = 0.2;
+      const double EQERR = 1e-6;
 
-    for (int i = 0; i < A->getNumActions(); i++) {
-      g[i] = p_pert[i+1];
-    }
-    g /= g.norm(); // normalized
-    numEq = IPA(*A, g, zh, ALPHA, EQERR, ans);
-  } while(numEq == 0);
+      for (int i = 0; i < A->getNumActions(); i++) {
+	g[i] = p_pert[i+1];
+      }
+      g /= g.norm(); // normalized
+      numEq = IPA(*A, g, zh, ALPHA, EQERR, ans, -1, m_context.get());
+    } while(numEq == 0);
+  }
+  catch (SolverInterrupted &) {
+    m_progress.Finish(0);
+    return solutions;
+  }
 
   MixedStrategyProfile<double> eqm = p_game->NewMixedStrategyProfile(0.0);
   for (int i = 1; i <= eqm.MixedProfileLength(); i++) {
@@ -98,6 +110,7 @@ NashIPAStrategySolver::Solve(const Game &p_game,
   }
   m_onEquilibrium->Render(eqm);
   solutions.push_back(eqm);
+  m_progress.Finish(solutions.Length());
   return solutions;
 }
 
@@ -87,6 +87,7 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   Gambit::linalg::BFS<T> cbfs;
   int i, j;
   Solution solution;
+  this->m_progress.Start();
 
   solution.isets1 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(1));
   solution.isets2 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(2));
@@ -125,8 +126,10 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   b[solution.ns1+solution.ns2+solution.ni1+1] = -(T)1;
 
   linalg::LemkeTableau<T> tab(A,b);
+  tab.SetContext(this->m_context.get());
   solution.eps = tab.Epsilon();
   
+  Stats::PhaseTimer phase("lcp.paths");
   try {
     if (m_stopAfter != 1) {
       try {
@@ -155,9 +158,13 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
       this->m_onEquilibrium->Render(profile);
     }
   }
+  catch (SolverInterrupted &) {
+    // The equilibria found so far are returned
+  }
   catch (std::runtime_error &e) {
     std::cerr << "Error: " << e.what() << std::endl;
   }
+  this->m_progress.Finish(solution.EquilibriumCount());
   return solution.m_equilibria;
 }
 
@@ -221,6 +228,7 @@ NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
     else {
       // gout << ": Dead End";
     }
+    this->m_progress.Report(p_solution.EquilibriumCount());
       
     A(i,0) = (T) -1;
     if (newsol) {
@@ -26,6 +26,7 @@
 
 #include "gambit/gambit.h"
 #include "gambit/linalg/lhtab.h"
+#include "gambit/linalg/exactbasis.h"
 #include "gambit/nash/lcp.h"
 
 namespace Gambit {
@@ -112,6 +113,12 @@ template <class T> Vector<T> Make_b2(const Game &p_game)
   return b2;
 }
 
+class PivotLimitReached : public Exception {
+public:
+  virtual ~PivotLimitReached() throw() { }
+  const char *what(void) const throw() { return "Reached limit on pivots along a path"; }
+};
+
 }  // end anonymous namespace
   
 
@@ -120,6 +127,8 @@ class NashLcpStrategySolver<T>::Solution {
 public:
   List<Gambit::linalg::BFS<T> > m_bfsList;
   List<MixedStrategyProfile<T> > m_equilibria;
+  // Basic variables of the tableau at each equilibrium, in the order found
+  List<Array<int> > m_bases;
 
   bool Contains(const Gambit::linalg::BFS<T> &p_bfs) const
   { return m_bfsList.Contains(p_bfs); }
@@ -128,32 +137,23 @@ public:
 
   int EquilibriumCount(void) const { return m_equilibria.size(); }
 };
-  
+
 //
-// Function called when a CBFS is encountered.
-// If it is not already in the list p_list, it is added.
-// The corresponding equilibrium is computed and output.
-// Returns 'true' if the CBFS is new; 'false' if it already appears in the
-// list.
+// Computes the strategy profile corresponding to a CBFS.
+// Returns 'false' if the CBFS is the trivial one, in which case
+// p_profile is not meaningful.
 //
 template <class T> bool
-NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
-				linalg::LHTableau<T> &p_tableau,
-				Solution &p_solution) const
+NashLcpStrategySolver<T>::GetProfile(const Game &p_game,
+				     const linalg::BFS<T> &p_cbfs,
+				     MixedStrategyProfile<T> &p_profile) const
 {
-  Gambit::linalg::BFS<T> cbfs(p_tableau.GetBFS());
-  if (p_solution.Contains(cbfs)) {
-    return false;
-  }
-  p_solution.push_back(cbfs);
-
-  MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0.0)));
   int n1 = p_game->Players()[1]->Strategies().size();
   int n2 = p_game->Players()[2]->Strategies().size();
   T sum = (T) 0;
 
   for (int j = 1; j <= n1; j++) {
-    if (cbfs.count(j))   sum += cbfs[j];
+    if (p_cbfs.count(j))   sum += p_cbfs[j];
   }
   if (sum == (T) 0)  {
     // This is the trivial CBFS.
@@ -162,31 +162,57 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
 
   for (int j = 1; j <= n1; j++) {
     GameStrategy strategy = p_game->Players()[1]->Strategies()[j];
-    if (cbfs.count(j)) {
-      profile[strategy] = cbfs[j] / sum;
+    if (p_cbfs.count(j)) {
+      p_profile[strategy] = p_cbfs[j] / sum;
     }
     else {
-      profile[strategy] = (T) 0;
+      p_profile[strategy] = (T) 0;
     }
   }
 
   sum = (T) 0;
   for (int j = 1; j <= n2; j++) {
-    if (cbfs.count(n1 + j))  sum += cbfs[n1 + j];
+    if (p_cbfs.count(n1 + j))  sum += p_cbfs[n1 + j];
   }
 
   for (int j = 1; j <= n2; j++) {
     GameStrategy strategy = p_game->Players()[2]->Strategies()[j];
-    if (cbfs.count(n1 + j)) {
-      profile[strategy] = cbfs[n1 + j] / sum;
+    if (p_cbfs.count(n1 + j)) {
+      p_profile[strategy] = p_cbfs[n1 + j] / sum;
     }
     else {
-      profile[strategy] = (T) 0;
+      p_profile[strategy] = (T) 0;
     }
   }
+  return true;
+}
+  
+//
+// Function called when a CBFS is encountered.
+// If it is not already in the list p_list, it is added.
+// The corresponding equilibrium is computed and output.
+// Returns 'true' if the CBFS is new; 'false' if it already appears in the
+// list.
+//
+template <class T> bool
+NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
+				linalg::LHTableau<T> &p_tableau,
+				Solution &p_solution) const
+{
+  Gambit::linalg::BFS<T> cbfs(p_tableau.GetBFS());
+  if (p_solution.Contains(cbfs)) {
+    return false;
+  }
+  p_solution.push_back(cbfs);
+
+  MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0.0)));
+  if (!GetProfile(p_game, cbfs, profile)) {
+    return false;
+  }
   
   this->m_onEquilibrium->Render(profile);
   p_solution.m_equilibria.push_back(profile);
+  p_solution.m_bases.push_back(p_tableau.GetLabels());
 
   if (m_stopAfter > 0 && p_solution.EquilibriumCount() >= m_stopAfter) {
     throw EquilibriumLimitReached();
@@ -221,45 +247,149 @@ NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
   for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
     if (i != j)  {
       linalg::LHTableau<T> Bcopy(B);
-      Bcopy.LemkePath(i);
+      if (!Bcopy.LemkePath(i, m_maxPathPivots)) {
+	throw PivotLimitReached();
+      }
+      this->m_progress.Report(p_solution.EquilibriumCount());
       AllLemke(p_game, i, Bcopy, p_solution, depth+1);
     }
   }
 }
 
-template <class T> List<MixedStrategyProfile<T> > 
-NashLcpStrategySolver<T>::Solve(const Game &p_game) const
+//
+// Follows the Lemke-Howson paths from the extraneous solution, adding
+// each equilibrium found to p_solution.
+//
+template <class T> void
+NashLcpStrategySolver<T>::Enumerate(const Game &p_game,
+				    Solution &p_solution) const
 {
-  if (p_game->NumPlayers() != 2) {
-    throw UndefinedException("Method only valid for two-player games.");
-  }
-  if (!p_game->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
-  }
-  Solution solution;
-
+  Stats::PhaseTimer phase("lcp.paths");
   try {
     Matrix<T> A1 = Make_A1<T>(p_game);
     Vector<T> b1 = Make_b1<T>(p_game);
     Matrix<T> A2 = Make_A2<T>(p_game);
     Vector<T> b2 = Make_b2<T>(p_game);
     linalg::LHTableau<T> B(A1, A2, b1, b2);
+    B.SetContext(this->m_context.get());
 
     if (m_stopAfter != 1) {
-      AllLemke(p_game, 0, B, solution, 0);
+      AllLemke(p_game, 0, B, p_solution, 0);
     }
     else  {
-      B.LemkePath(1);
-      OnBFS(p_game, B, solution);
+      if (!B.LemkePath(1, m_maxPathPivots)) {
+	throw PivotLimitReached();
+      }
+      OnBFS(p_game, B, p_solution);
     }
   }
   catch (EquilibriumLimitReached &) {
     // This pseudo-exception requires no additional action;
     // solution contains details of all equilibria found
   }
+  catch (SolverInterrupted &) {
+    // Likewise, solution contains the equilibria found so far
+  }
+}
+
+//
+// Follows the paths with floating-point tableaux, then solves for the
+// basic solution at each equilibrium found in exact arithmetic.
+// Each resulting profile is certified by checking that its Liapunov
+// value is exactly zero, which holds only at a Nash equilibrium.
+// Returns 'false', having rendered nothing, if the floating-point pass
+// fails or any certificate fails.
+//
+template <class T> bool
+NashLcpStrategySolver<T>::SolveHybrid(const Game &p_game,
+				      Solution &p_solution) const
+{
+  NashLcpStrategySolver<double> guide(m_stopAfter, m_maxDepth);
+  // Roundoff can make the floating-point paths cycle on degenerate games,
+  // so the guide gives up on paths much longer than the dimension
+  int dim = (p_game->Players()[1]->Strategies().size() +
+	     p_game->Players()[2]->Strategies().size());
+  guide.m_maxPathPivots = dim * dim;
+  guide.m_progress = this->m_progress;
+  guide.m_context = this->m_context;
+  NashLcpStrategySolver<double>::Solution guideSolution;
+  try {
+    Stats::PhaseTimer phase("lcp.guide");
+    guide.Enumerate(p_game, guideSolution);
+  }
+  catch (std::runtime_error &) {
+    return false;
+  }
+
+  Stats::PhaseTimer phase("lcp.certify");
+  Matrix<T> A1 = Make_A1<T>(p_game);
+  Vector<T> b1 = Make_b1<T>(p_game);
+  Matrix<T> A2 = Make_A2<T>(p_game);
+  Vector<T> b2 = Make_b2<T>(p_game);
+  Solution solution;
+  for (int i = 1; i <= guideSolution.m_bases.Length(); i++) {
+    const Array<int> &labels = guideSolution.m_bases[i];
+    Array<int> labels1(b1.First(), b1.Last()), labels2(b2.First(), b2.Last());
+    for (int j = b1.First(); j <= b1.Last(); j++)  labels1[j] = labels[j];
+    for (int j = b2.First(); j <= b2.Last(); j++)  labels2[j] = labels[j];
+    Vector<T> x1(b1.First(), b1.Last()), x2(b2.First(), b2.Last());
+    try {
+      linalg::ExactBasis(A1, labels1).Solve(b1, x1);
+      linalg::ExactBasis(A2, labels2).Solve(b2, x2);
+    }
+    catch (std::runtime_error &) {
+      return false;
+    }
+    Gambit::linalg::BFS<T> cbfs;
+    for (int j = b1.First(); j <= b1.Last(); j++)  cbfs.insert(labels1[j], x1[j]);
+    for (int j = b2.First(); j <= b2.Last(); j++)  cbfs.insert(labels2[j], x2[j]);
+    if (solution.Contains(cbfs)) {
+      continue;
+    }
+    solution.push_back(cbfs);
+    MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0.0)));
+    if (!GetProfile(p_game, cbfs, profile) ||
+	profile.GetLiapValue() != (T) 0) {
+      return false;
+    }
+    solution.m_equilibria.push_back(profile);
+  }
+
+  for (int i = 1; i <= solution.m_equilibria.Length(); i++) {
+    this->m_onEquilibrium->Render(solution.m_equilibria[i]);
+  }
+  p_solution = solution;
+  return true;
+}
+
+template<> bool
+NashLcpStrategySolver<double>::SolveHybrid(const Game &, Solution &) const
+{
+  // Floating-point solutions need no certificate
+  return false;
+}
+
+template <class T> List<MixedStrategyProfile<T> > 
+NashLcpStrategySolver<T>::Solve(const Game &p_game) const
+{
+  if (p_game->NumPlayers() != 2) {
+    throw UndefinedException("Method only valid for two-player games.");
+  }
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  Solution solution;
+  this->m_progress.Start();
+
+  try {
+    if (!m_hybrid || !SolveHybrid(p_game, solution)) {
+      Enumerate(p_game, solution);
+    }
+  }
   catch (std::runtime_error &e) {
     std::cerr << "ERROR: " << e.what() << std::endl;
   }
+  this->m_progress.Finish(solution.EquilibriumCount());
   return solution.m_equilibria;
 }
 
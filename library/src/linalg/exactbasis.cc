@@ -0,0 +1,328 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/linalg/exactbasis.cc
+// Exact solution of linear systems for a known basis
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <vector>
+#include <algorithm>
+#include "gambit/linalg/exactbasis.h"
+
+namespace Gambit {
+
+namespace linalg {
+
+//------------------------------------------------------------------------
+//                   Arithmetic modulo word-sized primes
+//------------------------------------------------------------------------
+
+namespace {
+
+// Residues are below 2^31, so that products fit in 64 bits
+typedef unsigned long Residue;
+typedef unsigned long long Product;
+
+Residue MulMod(Residue a, Residue b, Residue p)
+{ return (Residue) (((Product) a * (Product) b) % p); }
+
+Residue PowMod(Residue a, Residue e, Residue p)
+{
+  Residue result = 1;
+  while (e > 0) {
+    if (e & 1)  result = MulMod(result, a, p);
+    a = MulMod(a, a, p);
+    e >>= 1;
+  }
+  return result;
+}
+
+// Deterministic Miller-Rabin test; the witnesses 2, 7 and 61 suffice
+// for all n below 2^32
+bool IsPrime(Residue n)
+{
+  if (n < 2)  return false;
+  static const Residue witnesses[] = { 2, 7, 61 };
+  Residue d = n - 1;
+  int s = 0;
+  while (!(d & 1)) { d >>= 1; s++; }
+  for (int k = 0; k < 3; k++) {
+    Residue a = witnesses[k] % n;
+    if (a == 0)  continue;
+    Residue x = PowMod(a, d, n);
+    if (x == 1 || x == n - 1)  continue;
+    bool composite = true;
+    for (int r = 1; r < s && composite; r++) {
+      x = MulMod(x, x, n);
+      if (x == n - 1)  composite = false;
+    }
+    if (composite)  return false;
+  }
+  return true;
+}
+
+// Returns the largest prime less than p
+Residue PreviousPrime(Residue p)
+{
+  do { p -= 2; } while (!IsPrime(p));
+  return p;
+}
+
+Residue Reduce(const Integer &x, Residue p)
+{
+  long r = (x % (long) p).as_long();
+  return (Residue) ((r < 0) ? r + (long) p : r);
+}
+
+//
+// Solves the n by n system whose augmented matrix [A b] is given
+// row-major in p_matrix, modulo p, by Gauss-Jordan elimination.
+// Returns false if A is singular modulo p.
+//
+bool SolveModP(std::vector<Residue> &p_matrix, int n, Residue p,
+	       std::vector<Residue> &x)
+{
+  int width = n + 1;
+  for (int col = 0; col < n; col++) {
+    int pivot = col;
+    while (pivot < n && p_matrix[pivot * width + col] == 0)  pivot++;
+    if (pivot == n)  return false;
+    if (pivot != col) {
+      for (int j = col; j < width; j++) {
+	std::swap(p_matrix[pivot * width + j], p_matrix[col * width + j]);
+      }
+    }
+    Residue inv = PowMod(p_matrix[col * width + col], p - 2, p);
+    for (int j = col; j < width; j++) {
+      p_matrix[col * width + j] = MulMod(p_matrix[col * width + j], inv, p);
+    }
+    for (int i = 0; i < n; i++) {
+      Residue factor = p_matrix[i * width + col];
+      if (i == col || factor == 0)  continue;
+      for (int j = col; j < width; j++) {
+	Residue sub = MulMod(factor, p_matrix[col * width + j], p);
+	Residue &entry = p_matrix[i * width + j];
+	entry = (entry >= sub) ? entry - sub : entry + (p - sub);
+      }
+    }
+  }
+  x.resize(n);
+  for (int i = 0; i < n; i++)  x[i] = p_matrix[i * width + n];
+  return true;
+}
+
+//
+// Finds the fraction r/s congruent to u modulo m with |r|, s both below
+// sqrt(m/2), if there is one (Wang's algorithm).  Such a fraction is
+// unique when it exists.
+//
+bool Reconstruct(const Integer &u, const Integer &m, Rational &p_value)
+{
+  Integer r0 = m, r1 = u, s0 = 0, s1 = 1;
+  while (r1 * r1 * 2L >= m) {
+    Integer q = r0 / r1;
+    Integer r2 = r0 - q * r1;
+    r0 = r1;  r1 = r2;
+    Integer s2 = s0 - q * s1;
+    s0 = s1;  s1 = s2;
+  }
+  if (s1 == 0L || s1 * s1 * 2L >= m || gcd(r1, s1) != 1L) {
+    return false;
+  }
+  p_value = (s1 < 0L) ? Rational(-r1, -s1) : Rational(r1, s1);
+  return true;
+}
+
+}  // end anonymous namespace
+
+void ModularSolve(const SquareMatrix<Rational> &A, const Vector<Rational> &b,
+		  Vector<Rational> &x)
+{
+  int n = A.NumRows();
+  int width = n + 1;
+
+  // Scale each row of [A b] to integers, and bound the bits in the
+  // determinant of A and in the numerators of Cramer's rule (Hadamard)
+  std::vector<Integer> augmented(n * width);
+  long bits = 0;
+  for (int i = 0; i < n; i++) {
+    Integer scale = b[b.First() + i].denominator();
+    for (int j = 0; j < n; j++) {
+      scale = lcm(scale, A(A.MinRow() + i, A.MinCol() + j).denominator());
+    }
+    long rowbits = 0;
+    for (int j = 0; j < width; j++) {
+      const Rational &value = ((j < n) ? A(A.MinRow() + i, A.MinCol() + j) :
+			       b[b.First() + i]);
+      Integer &entry = augmented[i * width + j];
+      entry = value.numerator() * (scale / value.denominator());
+      if (entry != 0L && lg(entry) + 1 > rowbits)  rowbits = lg(entry) + 1;
+    }
+    // sqrt(n + 1) factor for the row norm, generously rounded up
+    bits += rowbits + 1;
+    for (int k = width; k > 1; k >>= 2)  bits++;
+  }
+
+  Integer modulus = 1;
+  long modbits = 0;
+  std::vector<Integer> solution(n, Integer(0));
+  int singular = 0;
+  Residue prime = 2147483659UL;   // the next prime above 2^31
+  int batch = 1;
+  while (true) {
+    // Residues of the augmented matrix for the next batch of primes
+    std::vector<Residue> primes(batch);
+    std::vector<std::vector<Residue> > systems(batch);
+    for (int k = 0; k < batch; k++) {
+      primes[k] = prime = PreviousPrime(prime);
+      systems[k].resize(n * width);
+      for (int e = 0; e < n * width; e++) {
+	systems[k][e] = Reduce(augmented[e], prime);
+      }
+    }
+
+    std::vector<std::vector<Residue> > residues(batch);
+    std::vector<char> solved(batch);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif  // _OPENMP
+    for (int k = 0; k < batch; k++) {
+      solved[k] = SolveModP(systems[k], n, primes[k], residues[k]);
+    }
+
+    // Chinese remaindering with the solutions found so far
+    for (int k = 0; k < batch; k++) {
+      if (!solved[k]) {
+	// p divides det(A).  Since each prime exceeds 2^30, at most
+	// bits/30 of them can do so unless det(A) is zero.
+	if (++singular * 30L > bits)  throw SingularMatrixException();
+	continue;
+      }
+      Residue p = primes[k];
+      Residue inverse = PowMod(Reduce(modulus, p), p - 2, p);
+      for (int i = 0; i < n; i++) {
+	Residue current = Reduce(solution[i], p);
+	Residue diff = ((residues[k][i] >= current) ?
+			residues[k][i] - current :
+			residues[k][i] + (p - current));
+	solution[i] += modulus * (long) MulMod(diff, inverse, p);
+      }
+      modulus *= (long) p;
+      modbits += 30;
+    }
+
+    // Once the modulus exceeds twice the square of the Hadamard bound,
+    // reconstruction is guaranteed to recover the solution; before then,
+    // an early answer is accepted if it satisfies the system exactly.
+    bool guaranteed = (modbits > 2 * bits + 1);
+    Vector<Rational> candidate(A.MinCol(), A.MaxCol());
+    bool reconstructed = (modbits > 0);
+    for (int i = 0; reconstructed && i < n; i++) {
+      reconstructed = Reconstruct(solution[i], modulus,
+				  candidate[A.MinCol() + i]);
+    }
+    if (reconstructed && (guaranteed || A * candidate == b)) {
+      x = candidate;
+      return;
+    }
+    if (guaranteed) {
+      throw AssertionException("Rational reconstruction failed within Hadamard bound");
+    }
+    batch *= 2;
+  }
+}
+
+//------------------------------------------------------------------------
+//                     ExactBasis: Lifecycle
+//------------------------------------------------------------------------
+
+ExactBasis::ExactBasis(const Matrix<Rational> &A, const Array<int> &p_labels,
+		       ExactBackend p_backend)
+  : m_labels(p_labels), m_matrix(A.NumRows()), m_backend(p_backend)
+{
+  if (p_labels.First() != A.MinRow() || p_labels.Last() != A.MaxRow()) {
+    throw DimensionException();
+  }
+  for (int j = p_labels.First(); j <= p_labels.Last(); j++) {
+    int label = p_labels[j];
+    int col = j - p_labels.First() + 1;
+    if (label > 0) {
+      if (label < A.MinCol() || label > A.MaxCol()) {
+	throw IndexException();
+      }
+      for (int i = A.MinRow(); i <= A.MaxRow(); i++) {
+	m_matrix(i - A.MinRow() + 1, col) = A(i, label);
+      }
+    }
+    else {
+      if (-label < A.MinRow() || -label > A.MaxRow()) {
+	throw IndexException();
+      }
+      for (int i = A.MinRow(); i <= A.MaxRow(); i++) {
+	m_matrix(i - A.MinRow() + 1, col) = Rational((i == -label) ? 1 : 0);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------
+//                     ExactBasis: Solving systems
+//------------------------------------------------------------------------
+
+void ExactBasis::Solve(const SquareMatrix<Rational> &p_matrix,
+		       const Vector<Rational> &b, Vector<Rational> &x) const
+{
+  Vector<Rational> rhs(b.Length()), sol(b.Length());
+  for (int i = 1; i <= b.Length(); i++) {
+    rhs[i] = b[b.First() + i - 1];
+  }
+  if (m_backend == EXACT_MODULAR) {
+    ModularSolve(p_matrix, rhs, sol);
+  }
+  else {
+    sol = p_matrix.Inverse() * rhs;
+  }
+  for (int i = 1; i <= sol.Length(); i++) {
+    x[m_labels.First() + i - 1] = sol[i];
+  }
+}
+
+void ExactBasis::Solve(const Vector<Rational> &b, Vector<Rational> &x) const
+{
+  Solve(m_matrix, b, x);
+}
+
+void ExactBasis::SolveT(const Vector<Rational> &c, Vector<Rational> &y) const
+{
+  Solve(SquareMatrix<Rational>(m_matrix.Transpose()), c, y);
+}
+
+BFS<Rational> ExactBasis::GetBFS(const Vector<Rational> &b) const
+{
+  Vector<Rational> x(m_labels.First(), m_labels.Last());
+  Solve(b, x);
+  BFS<Rational> bfs;
+  for (int i = m_labels.First(); i <= m_labels.Last(); i++) {
+    bfs.insert(m_labels[i], x[i]);
+  }
+  return bfs;
+}
+
+}  // end namespace Gambit::linalg
+
+}  // end namespace Gambit
@@ -78,6 +78,7 @@ bool Tableau<double>::CanPivot(int outlabel, int col) const
 void Tableau<double>::Pivot(int outrow,int col)
 {
   if(!RowIndex(outrow) || !ValidIndex(col)) throw BadPivot();
+  if (m_context)  m_context->Check();
 
   // int outlabel = Label(outrow);
   // gout << "\noutrow:" << outrow;
@@ -89,6 +90,7 @@ void Tableau<double>::Pivot(int outrow,int col)
   B.update(outrow, col);
   Solve(*b, solution);
   npivots++;
+  Stats::Count(Stats::PIVOTS);
   // BigDump(gout);
 }
 
@@ -322,6 +324,7 @@ void Tableau<Rational>::Pivot(int outrow,int in_col)
   // gout << " inlabel: " << in_col;
   if(!RowIndex(outrow) || !ValidIndex(in_col)) 
     throw BadPivot();
+  if (m_context)  m_context->Check();
   int outlabel = Label(outrow);
 
   // gout << "\noutrow:" << outrow;
@@ -377,6 +380,7 @@ void Tableau<Rational>::Pivot(int outrow,int in_col)
   Tabdat(row,col)=old_denom;
   // BigDump(gout);
   npivots++;
+  Stats::Count(Stats::PIVOTS);
 
   basis.Pivot(outrow,in_col);
   nonbasic[col] = outlabel;
@@ -437,6 +441,7 @@ void Tableau<Rational>::GetColumn(int col, Vector<Rational> &out) const
 
 void Tableau<Rational>::Refactor()
 { 
+  Stats::Count(Stats::REFACTORIZATIONS);
   Vector<Rational> mytmpcol(tmpcol);
   //BigDump(gout);
   //** Note -- we may need to recompute totdenom here, if A and b have changed. 
@@ -20,6 +20,21 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif  // _OPENMP
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif  // _WIN32
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+#include "gambit/gambit.h"
+#include "gambit/gametree.h"
 #include "gambit/nash.h"
 
 namespace Gambit {
@@ -155,6 +170,251 @@ BehavStrategyDetailRenderer<T>::Render(const MixedBehaviorProfile<T> &p_profile,
   }
 }
 
+//========================================================================
+//                       Binary profile rendering
+//========================================================================
+
+namespace {
+
+const char s_binaryMagic[] = "GBTP";
+const char s_binaryVersion = 1;
+
+// The tags preceding a rational probability
+const char s_rationalInteger = 0, s_rationalText = 1;
+
+void WriteUnsigned(std::ostream &p_stream, unsigned long long p_value,
+		   int p_bytes)
+{
+  char bytes[8];
+  for (int i = 0; i < p_bytes; i++) {
+    bytes[i] = (char) ((p_value >> (8 * i)) & 0xff);
+  }
+  p_stream.write(bytes, p_bytes);
+}
+
+void WriteValue(std::ostream &p_stream, double p_value)
+{
+  unsigned long long bits;
+  std::memcpy(&bits, &p_value, sizeof(bits));
+  WriteUnsigned(p_stream, bits, 8);
+}
+
+void WriteValue(std::ostream &p_stream, const Rational &p_value)
+{
+  if (p_value.numerator().fits_in_long() &&
+      p_value.denominator().fits_in_long()) {
+    p_stream.put(s_rationalInteger);
+    WriteUnsigned(p_stream, (long long) p_value.numerator().as_long(), 8);
+    WriteUnsigned(p_stream, (long long) p_value.denominator().as_long(), 8);
+  }
+  else {
+    std::string text = lexical_cast<std::string>(p_value);
+    p_stream.put(s_rationalText);
+    WriteUnsigned(p_stream, text.length(), 4);
+    p_stream.write(text.data(), text.length());
+  }
+}
+
+char TypeCode(double) { return 'd'; }
+char TypeCode(const Rational &) { return 'q'; }
+
+template <class T>
+void WriteHeader(std::ostream &p_stream, char p_kind)
+{
+  p_stream.write(s_binaryMagic, 4);
+  p_stream.put(s_binaryVersion);
+  p_stream.put(p_kind);
+  p_stream.put(TypeCode(T()));
+}
+
+template <class P>
+void WriteProfile(std::ostream &p_stream, const P &p_profile, int p_length,
+		  const std::string &p_label)
+{
+  WriteUnsigned(p_stream, p_label.length(), 2);
+  p_stream.write(p_label.data(), p_label.length());
+  WriteUnsigned(p_stream, p_length, 4);
+  for (int i = 1; i <= p_length; i++) {
+    WriteValue(p_stream, p_profile[i]);
+  }
+  // As the text renderers do, so a reader sees each profile when found
+  p_stream.flush();
+}
+
+void ReadBytes(std::istream &p_stream, char *p_bytes, std::streamsize p_count)
+{
+  if (!p_stream.read(p_bytes, p_count)) {
+    throw InvalidFileException("Profile stream ended part way through a profile");
+  }
+}
+
+unsigned long long ReadUnsigned(std::istream &p_stream, int p_bytes)
+{
+  unsigned char bytes[8];
+  ReadBytes(p_stream, (char *) bytes, p_bytes);
+  unsigned long long value = 0;
+  for (int i = p_bytes - 1; i >= 0; i--) {
+    value = (value << 8) | bytes[i];
+  }
+  return value;
+}
+
+double ReadDouble(std::istream &p_stream)
+{
+  unsigned long long bits = ReadUnsigned(p_stream, 8);
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+Rational ReadInteger(std::istream &p_stream)
+{
+  long long value = (long long) ReadUnsigned(p_stream, 8);
+  if (value >= LONG_MIN && value <= LONG_MAX) {
+    return Rational((long) value);
+  }
+  // Written where long is wider than it is here
+  return lexical_cast<Rational>(lexical_cast<std::string>(value));
+}
+
+Rational ReadRational(std::istream &p_stream)
+{
+  char tag;
+  ReadBytes(p_stream, &tag, 1);
+  if (tag == s_rationalInteger) {
+    Rational numerator = ReadInteger(p_stream);
+    return numerator / ReadInteger(p_stream);
+  }
+  else if (tag == s_rationalText) {
+    std::string text(ReadUnsigned(p_stream, 4), ' ');
+    ReadBytes(p_stream, &text[0], text.length());
+    return lexical_cast<Rational>(text);
+  }
+  throw InvalidFileException("Profile stream has an unknown rational tag");
+}
+
+}  // end anonymous namespace
+
+void SetBinaryStdout(void)
+{
+#ifdef _WIN32
+  _setmode(_fileno(stdout), _O_BINARY);
+#endif  // _WIN32
+}
+
+template <class T>
+MixedStrategyBinaryRenderer<T>::MixedStrategyBinaryRenderer(std::ostream &p_stream)
+  : m_stream(p_stream)
+{
+  WriteHeader<T>(m_stream, 'm');
+}
+
+template <class T> void
+MixedStrategyBinaryRenderer<T>::Render(const MixedStrategyProfile<T> &p_profile,
+				       const std::string &p_label) const
+{
+  WriteProfile(m_stream, p_profile, p_profile.MixedProfileLength(), p_label);
+}
+
+template <class T>
+BehavStrategyBinaryRenderer<T>::BehavStrategyBinaryRenderer(std::ostream &p_stream)
+  : m_stream(p_stream)
+{
+  WriteHeader<T>(m_stream, 'b');
+}
+
+template <class T> void
+BehavStrategyBinaryRenderer<T>::Render(const MixedBehaviorProfile<T> &p_profile,
+				       const std::string &p_label) const
+{
+  WriteProfile(m_stream, p_profile, p_profile.Length(), p_label);
+}
+
+template <class T>
+ProfileBinaryReader<T>::ProfileBinaryReader(std::istream &p_stream)
+  : m_stream(p_stream)
+{
+  char header[7];
+  if (!m_stream.read(header, 7) ||
+      std::string(header, 4) != s_binaryMagic ||
+      header[4] != s_binaryVersion ||
+      (header[5] != 'm' && header[5] != 'b') ||
+      (header[6] != 'd' && header[6] != 'q')) {
+    throw InvalidFileException("Not a binary profile stream");
+  }
+  m_kind = header[5];
+  m_type = header[6];
+}
+
+template <class T>
+bool ProfileBinaryReader<T>::Next(std::string &p_label, Array<T> &p_probs)
+{
+  if (m_stream.peek() == std::char_traits<char>::eof()) {
+    return false;
+  }
+  p_label.assign(ReadUnsigned(m_stream, 2), ' ');
+  if (!p_label.empty()) {
+    ReadBytes(m_stream, &p_label[0], p_label.length());
+  }
+  int length = ReadUnsigned(m_stream, 4);
+  if (p_probs.Length() != length) {
+    p_probs = Array<T>(length);
+  }
+  for (int i = 1; i <= length; i++) {
+    if (m_type == 'd') {
+      p_probs[i] = static_cast<T>(ReadDouble(m_stream));
+    }
+    else {
+      p_probs[i] = static_cast<T>(ReadRational(m_stream));
+    }
+  }
+  return true;
+}
+
+template <class T> List<MixedStrategyProfile<T> >
+ProfileBinaryReader<T>::ReadMixed(const Game &p_game)
+{
+  if (m_kind != 'm') {
+    throw InvalidFileException("Profile stream holds behavior profiles");
+  }
+  List<MixedStrategyProfile<T> > profiles;
+  std::string label;
+  Array<T> probs;
+  while (Next(label, probs)) {
+    MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(T(0)));
+    if (probs.Length() != profile.MixedProfileLength()) {
+      throw InvalidFileException("Profile does not match the game");
+    }
+    for (int i = 1; i <= probs.Length(); i++) {
+      profile[i] = probs[i];
+    }
+    profiles.push_back(profile);
+  }
+  return profiles;
+}
+
+template <class T> List<MixedBehaviorProfile<T> >
+ProfileBinaryReader<T>::ReadBehav(const Game &p_game)
+{
+  if (m_kind != 'b') {
+    throw InvalidFileException("Profile stream holds mixed strategy profiles");
+  }
+  List<MixedBehaviorProfile<T> > profiles;
+  std::string label;
+  Array<T> probs;
+  while (Next(label, probs)) {
+    MixedBehaviorProfile<T> profile(p_game);
+    if (probs.Length() != profile.Length()) {
+      throw InvalidFileException("Profile does not match the game");
+    }
+    for (int i = 1; i <= probs.Length(); i++) {
+      profile[i] = probs[i];
+    }
+    profiles.push_back(profile);
+  }
+  return profiles;
+}
+
 template class MixedStrategyRenderer<double>;
 template class MixedStrategyRenderer<Rational>;
 
@@ -179,7 +439,55 @@ template class BehavStrategyCSVRenderer<Rational>;
 template class BehavStrategyDetailRenderer<double>;
 template class BehavStrategyDetailRenderer<Rational>;
 
+template class MixedStrategyBinaryRenderer<double>;
+template class MixedStrategyBinaryRenderer<Rational>;
+
+template class BehavStrategyBinaryRenderer<double>;
+template class BehavStrategyBinaryRenderer<Rational>;
+
+template class ProfileBinaryReader<double>;
+template class ProfileBinaryReader<Rational>;
+
+
+
+//========================================================================
+//                          Progress reporting
+//========================================================================
+
+void ProgressJSONWriter::OnProgress(int p_found, double p_elapsed)
+{
+  m_stream << "{\"progress\": {\"equilibria\": " << p_found
+	   << ", \"elapsed\": " << p_elapsed << ", \"stats\": ";
+  Stats::WriteJSON(m_stream);
+  m_stream << "}}" << std::endl;
+}
+
+void ProgressReporter::Restart(void)
+{
+  double now = Stats::WallClock();
+#ifdef _OPENMP
+#pragma omp critical(gambit_progress)
+#endif  // _OPENMP
+  m_start = m_last = now;
+}
+
+void ProgressReporter::Notify(int p_found, bool p_force)
+{
+  double now = Stats::WallClock();
+#ifdef _OPENMP
+#pragma omp critical(gambit_progress)
+#endif  // _OPENMP
+  {
+    if (p_force || now - m_last >= m_interval) {
+      m_last = now;
+      m_observer->OnProgress(p_found, now - m_start);
+    }
+  }
+}
 
+//========================================================================
+//                        Algorithm base classes
+//========================================================================
 
 template <class T>
 StrategySolver<T>::StrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */)
@@ -219,230 +527,623 @@ BehavViaStrategySolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
 template <class T>
 SubgameBehavSolver<T>::SubgameBehavSolver(shared_ptr<BehavSolver<T> > p_solver,
-						  shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */)
-  : BehavSolver<T>(p_onEquilibrium), m_solver(p_solver)
+						  shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */,
+						  int p_threads /* = 1 */,
+						  bool p_reuse /* = true */)
+  : BehavSolver<T>(p_onEquilibrium), m_solver(p_solver), m_threads(p_threads),
+    m_reuse(p_reuse)
 { }
 
 // A nested anonymous namespace to privatize these functions 
 
 namespace {
 
-///
-/// Returns a list of the root nodes of all the immediate proper subgames
-/// in the subtree rooted at 'p_node'.
-/// 
-void ChildSubgames(const GameNode &p_node, List<GameNode> &p_list)
-{
-  if (p_node->IsSubgameRoot()) {
-    p_list.Append(p_node);
-  }
-  else {
-    for (int i = 1; i <= p_node->NumChildren(); 
-	 ChildSubgames(p_node->GetChild(i++), p_list));
-  }
-}
-
-} // end nested anonymous namespace
-
 //
 // Some general notes on the strategy for solving by subgames:
 //
-// * We work with a *copy* of the original game, which is destroyed
-//   as we go.
-// * Before solving, information set labels on the copy game are
-//   set to unique IDs.  These are used to match up information
-//   sets in the subgames (which are themselves copies) to the
-//   original game.
+// * Each proper subgame is extracted, once, as a game in its own right.
+//   The roots of the subgames immediately below it become terminal
+//   nodes, whose outcomes are set to the values of the equilibria
+//   chosen below before each call to the solver.
+// * Information sets of an extracted game are matched up with those
+//   of the original game by number, through a table built as the
+//   game is extracted.
 // * We only carry around DVectors instead of full MixedBehaviorProfiles,
 //   because MixedBehaviorProfiles allocate space several times the
 //   size of the tree to carry around useful quantities.  These
 //   quantities are irrelevant for this calculation, so we only
 //   store the probabilities, and convert to MixedBehaviorProfiles
 //   at the end of the computation
+// * Subgames are solved in order of their height in the tree of
+//   subgames; those of the same height do not depend on one another,
+//   and may be solved concurrently.  Once extracted, a subgame is
+//   touched only by the thread solving it, and by the one solving
+//   the subgame above it.
+// * Equilibria found are kept in a cache shared by all the subgames,
+//   keyed by the shape of the subgame and by its payoffs at terminal
+//   nodes, rescaled for each player to run from zero to one.  Subgames
+//   with the same key differ at most by a positive affine transformation
+//   of each player's payoffs, and so have the same equilibria; these
+//   are solved only once.  Without reuse, there is no cache, and each
+//   subgame is passed to the solver.
 //
 
+template <class T> class Subgame {
+public:
+  Subgame(int p_numPlayers)
+    : m_rootPayoffs(p_numPlayers), m_infosets(p_numPlayers), m_height(0)
+  { m_rootPayoffs = T(0); }
+
+  /// The subgame, as a game in its own right
+  Game m_game;
+  /// The outcomes at the roots of the subgames immediately below,
+  /// and the indices of those subgames
+  Array<GameOutcome> m_leaves;
+  Array<int> m_children;
+  /// The payoffs at the root of the subgame in the original game
+  Vector<T> m_rootPayoffs;
+  /// The number in the original game of each player's information sets
+  Array<Array<int> > m_infosets;
+  /// The longest chain of subgames below this one
+  int m_height;
+  /// The shape of the tree, information sets, and chance probabilities
+  std::string m_shape;
+
+  /// Equilibria of the subgame, combined with those chosen in the
+  /// subgames below, and the payoffs they give at the root
+  List<DVector<T> > m_solutions;
+  List<Vector<T> > m_values;
+};
+
+///
+/// Equilibria of a subgame, as kept in the cache.  Action probabilities
+/// are listed by player, information set, and action; payoffs are in
+/// the scale of the subgame which was solved, whose lowest payoff and
+/// range of payoffs for each player are recorded.  An entry which is
+/// not yet solved marks a subgame being solved on another thread.
+///
+template <class T> class CachedEquilibria {
+public:
+  CachedEquilibria(int p_numPlayers)
+    : m_low(p_numPlayers), m_range(p_numPlayers), m_solved(true) { }
+
+  List<Vector<T> > m_profiles, m_values;
+  Vector<T> m_low, m_range;
+  bool m_solved;
+};
+
+///
+/// Copies the subtree rooted at 'p_from' to 'p_to', stopping at the
+/// roots of proper subgames, which are appended to 'p_below'.
+/// The outcome at the root of the subtree is not copied, as by
+/// convention its payoffs are put in the subgame above.
+///
+void CopySubtree(const GameNode &p_from, const GameNode &p_to, bool p_isRoot,
+		 std::map<GameInfosetRep *, GameInfoset> &p_infosets,
+		 std::map<GameOutcomeRep *, GameOutcome> &p_outcomes,
+		 List<GameNode> &p_below, Array<GameOutcome> &p_leaves)
+{
+  Game game = p_to->GetGame();
+  p_to->SetLabel(p_from->GetLabel());
+
+  if (!p_isRoot && p_from->IsSubgameRoot()) {
+    p_below.push_back(p_from);
+    p_leaves.push_back(game->NewOutcome());
+    p_to->SetOutcome(p_leaves[p_leaves.Length()]);
+    return;
+  }
+
+  if (p_from->NumChildren() > 0) {
+    GameInfoset from = p_from->GetInfoset();
+    std::map<GameInfosetRep *, GameInfoset>::const_iterator to =
+      p_infosets.find(from.operator->());
+    if (to != p_infosets.end()) {
+      p_to->AppendMove(to->second);
+    }
+    else {
+      GameInfoset infoset =
+	p_to->AppendMove((from->IsChanceInfoset()) ? game->GetChance() :
+			 game->GetPlayer(from->GetPlayer()->GetNumber()),
+			 from->NumActions());
+      infoset->SetLabel(from->GetLabel());
+      for (int act = 1; act <= from->NumActions(); act++) {
+	infoset->GetAction(act)->SetLabel(from->GetAction(act)->GetLabel());
+	if (from->IsChanceInfoset()) {
+	  infoset->SetActionProb(act, from->GetActionProb(act, std::string()));
+	}
+      }
+      p_infosets[from.operator->()] = infoset;
+    }
+  }
+
+  GameOutcome outcome = p_from->GetOutcome();
+  if (!p_isRoot && outcome) {
+    std::map<GameOutcomeRep *, GameOutcome>::const_iterator to =
+      p_outcomes.find(outcome.operator->());
+    if (to != p_outcomes.end()) {
+      p_to->SetOutcome(to->second);
+    }
+    else {
+      GameOutcome copy = game->NewOutcome();
+      copy->SetLabel(outcome->GetLabel());
+      for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+	copy->SetPayoff(pl, outcome->GetPayoff<std::string>(pl));
+      }
+      p_outcomes[outcome.operator->()] = copy;
+      p_to->SetOutcome(copy);
+    }
+  }
+
+  for (int i = 1; i <= p_from->NumChildren(); i++) {
+    CopySubtree(p_from->GetChild(i), p_to->GetChild(i), false,
+		p_infosets, p_outcomes, p_below, p_leaves);
+  }
+}
+
+///
+/// Writes the shape of the subtree rooted at 'p_node' in preorder: the
+/// number of each node's player and information set (and so its actions),
+/// and the probabilities of chance actions.  Information sets of extracted
+/// subgames are numbered in order of their first member in preorder, so
+/// subgames with the same shape are the same up to labels and payoffs.
+///
+void WriteShape(const GameNode &p_node, std::ostream &p_stream)
+{
+  if (p_node->NumChildren() == 0) {
+    p_stream << "t ";
+    return;
+  }
+
+  GameInfoset infoset = p_node->GetInfoset();
+  if (infoset->IsChanceInfoset()) {
+    p_stream << "c " << infoset->GetNumber() << " {";
+    for (int act = 1; act <= infoset->NumActions(); act++) {
+      p_stream << ' ' << infoset->GetActionProb(act, std::string());
+    }
+    p_stream << " } ";
+  }
+  else {
+    p_stream << "p " << infoset->GetPlayer()->GetNumber() << ' '
+	     << infoset->GetNumber() << ' ' << infoset->NumActions() << ' ';
+  }
+  for (int i = 1; i <= p_node->NumChildren(); 
+       WriteShape(p_node->GetChild(i++), p_stream));
+}
+
+///
+/// Appends to 'p_payoffs' the total payoffs along the path to each
+/// terminal node in the subtree rooted at 'p_node', in preorder
+///
 template <class T>
-void SubgameBehavSolver<T>::SolveSubgames(const BehaviorSupportProfile &p_support,
-					      const DVector<T> &p_templateSolution,
-					      GameNode n,
-					      List<DVector<T> > &solns,
-					      List<GameOutcome> &values) const
+void TerminalPayoffs(const GameNode &p_node, const Vector<T> &p_path,
+		     List<Vector<T> > &p_payoffs)
 {
-  Game efg = p_support.GetGame();
-  
-  List<DVector<T> > thissolns;
-  thissolns.Append(p_templateSolution);
-  ((Vector<T> &) thissolns[1]).operator=(T(0));
-  
-  List<GameNode> subroots;
-  for (int i = 1; i <= n->NumChildren(); i++) {
-    ChildSubgames(n->GetChild(i), subroots);
+  Vector<T> path(p_path);
+  if (p_node->GetOutcome()) {
+    for (int pl = 1; pl <= path.Length(); pl++) {
+      path[pl] += p_node->GetOutcome()->GetPayoff<T>(pl);
+    }
   }
-  
-  List<Array<GameOutcome> > subrootvalues;
-  subrootvalues.Append(Array<GameOutcome>(subroots.Length()));
-  
-  for (int i = 1; i <= subroots.Length(); i++)  {
-    //printf("Looking at subgame %d of %d\n", i, subroots.Length());
-    List<DVector<T> > subsolns;
-    List<GameOutcome> subvalues;
-    
-    SolveSubgames(p_support, p_templateSolution,
-		  subroots[i], subsolns, subvalues);
-    
-    if (subsolns.Length() == 0)  {
-      solns = List<DVector<T> >();
-      return;
+  if (p_node->NumChildren() == 0) {
+    p_payoffs.push_back(path);
+  }
+  for (int i = 1; i <= p_node->NumChildren(); 
+       TerminalPayoffs(p_node->GetChild(i++), path, p_payoffs));
+}
+
+///
+/// Returns the key of the subgame in the cache of equilibria, and sets
+/// the lowest payoff and the range of payoffs for each player
+///
+template <class T>
+std::string CacheKey(const Subgame<T> &p_subgame, Vector<T> &p_low,
+		     Vector<T> &p_range)
+{
+  Game game = p_subgame.m_game;
+  Vector<T> zero(game->NumPlayers());
+  zero = T(0);
+  List<Vector<T> > payoffs;
+  TerminalPayoffs(game->GetRoot(), zero, payoffs);
+
+  Vector<T> high(payoffs.front());
+  p_low = payoffs.front();
+  for (int i = 2; i <= payoffs.Length(); i++) {
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      p_low[pl] = std::min(p_low[pl], payoffs[i][pl]);
+      high[pl] = std::max(high[pl], payoffs[i][pl]);
     }
+  }
+  p_range = high - p_low;
 
-    //printf("Found %d subsolutions for subgame %d of %d\n", 
-    //subsolns.Length(), i, subroots.Length());
-    
+  std::ostringstream key;
+  // Payoffs in floating point are written to the full precision of a
+  // double, so only payoffs which rescale to the same values are matched
+  key.precision(17);
+  key << p_subgame.m_shape << "|";
+  for (int i = 1; i <= payoffs.Length(); i++) {
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      key << ' ' << ((p_range[pl] == T(0)) ? T(0) :
+		     (payoffs[i][pl] - p_low[pl]) / p_range[pl]);
+    }
+  }
+  return key.str();
+}
+
+///
+/// The proper subgames of a game, in preorder of their roots, with the
+/// whole game first.
+///
+template <class T> class SubgameList {
+public:
+  explicit SubgameList(const GameNode &p_root);
+  ~SubgameList();
+
+  int Length(void) const { return m_subgames.Length(); }
+  Subgame<T> &operator[](int p_index) const { return *m_subgames[p_index]; }
+
+private:
+  Array<Subgame<T> *> m_subgames;
+
+  int Extract(const GameNode &p_root);
+
+  // Not implemented; the list owns its subgames
+  SubgameList(const SubgameList<T> &);
+  SubgameList<T> &operator=(const SubgameList<T> &);
+};
+
+template <class T> SubgameList<T>::SubgameList(const GameNode &p_root)
+{
+  try {
+    Extract(p_root);
+  }
+  catch (...) {
+    for (int i = 1; i <= m_subgames.Length(); delete m_subgames[i++]);
+    throw;
+  }
+  // Subgames follow the subgame above them
+  for (int i = m_subgames.Length(); i >= 1; i--) {
+    Subgame<T> &subgame = *m_subgames[i];
+    for (int j = 1; j <= subgame.m_children.Length(); j++) {
+      subgame.m_height = std::max(subgame.m_height,
+				  m_subgames[subgame.m_children[j]]->m_height + 1);
+    }
+  }
+}
+
+template <class T> SubgameList<T>::~SubgameList()
+{
+  for (int i = 1; i <= m_subgames.Length(); delete m_subgames[i++]);
+}
+
+template <class T> int SubgameList<T>::Extract(const GameNode &p_root)
+{
+  Game original = p_root->GetGame();
+  Subgame<T> *subgame = new Subgame<T>(original->NumPlayers());
+  m_subgames.push_back(subgame);
+  int index = m_subgames.Length();
+
+  subgame->m_game = NewTree();
+  GameTreeRep &tree = dynamic_cast<GameTreeRep &>(*subgame->m_game);
+  // As when reading a file, information sets are numbered once the
+  // tree is complete
+  tree.SetCanonicalization(false);
+  for (int pl = 1; pl <= original->NumPlayers(); pl++) {
+    subgame->m_game->NewPlayer()->SetLabel(original->GetPlayer(pl)->GetLabel());
+  }
+  std::map<GameInfosetRep *, GameInfoset> infosets;
+  std::map<GameOutcomeRep *, GameOutcome> outcomes;
+  List<GameNode> below;
+  CopySubtree(p_root, subgame->m_game->GetRoot(), true,
+	      infosets, outcomes, below, subgame->m_leaves);
+  tree.SetCanonicalization(true);
+  std::ostringstream shape;
+  WriteShape(subgame->m_game->GetRoot(), shape);
+  subgame->m_shape = shape.str();
+
+  for (int pl = 1; pl <= original->NumPlayers(); pl++) {
+    subgame->m_infosets[pl] = Array<int>(subgame->m_game->GetPlayer(pl)->NumInfosets());
+  }
+  for (std::map<GameInfosetRep *, GameInfoset>::const_iterator infoset = infosets.begin();
+       infoset != infosets.end(); ++infoset) {
+    if (!infoset->second->IsChanceInfoset()) {
+      subgame->m_infosets[infoset->second->GetPlayer()->GetNumber()][infoset->second->GetNumber()] =
+	infoset->first->GetNumber();
+    }
+  }
+
+  if (p_root->GetOutcome()) {
+    for (int pl = 1; pl <= original->NumPlayers(); pl++) {
+      subgame->m_rootPayoffs[pl] = p_root->GetOutcome()->GetPayoff<T>(pl);
+    }
+  }
+
+  for (int i = 1; i <= below.Length(); i++) {
+    subgame->m_children.push_back(Extract(below[i]));
+  }
+  return index;
+}
+
+///
+/// Returns the equilibria of the subgame, from the cache if an equivalent
+/// subgame has been solved, and otherwise from the solver, adding them
+/// to the cache.  The cache is null if equilibria are not reused.
+/// Payoffs are returned in the scale of the subgame.
+///
+template <class T>
+CachedEquilibria<T> Equilibria(const BehavSolver<T> &p_solver,
+			       const shared_ptr<SolverContext> &p_context,
+			       std::map<std::string, CachedEquilibria<T> > *p_cache,
+			       const Subgame<T> &p_subgame)
+{
+  Game subgame = p_subgame.m_game;
+  Vector<T> low(subgame->NumPlayers()), range(subgame->NumPlayers());
+  std::string key;
+  if (p_cache) {
+    key = CacheKey(p_subgame, low, range);
+  }
+
+  CachedEquilibria<T> cached(subgame->NumPlayers());
+  bool found = false;
+  // If an equivalent subgame is being solved on another thread, its
+  // equilibria are waited for rather than found again; otherwise, the
+  // subgame is marked as being solved on this one
+  for (bool waiting = (p_cache != 0); waiting; ) {
+#ifdef _OPENMP
+#pragma omp critical(gambit_subgame_cache)
+#endif  // _OPENMP
+    {
+      typename std::map<std::string, CachedEquilibria<T> >::iterator entry =
+	p_cache->find(key);
+      if (entry == p_cache->end()) {
+	CachedEquilibria<T> pending(0);
+	pending.m_solved = false;
+	p_cache->insert(std::make_pair(key, pending));
+	waiting = false;
+      }
+      else if (entry->second.m_solved) {
+	cached = entry->second;
+	found = true;
+	waiting = false;
+      }
+    }
+  }
+
+  if (found) {
+    for (int i = 1; i <= cached.m_values.Length(); i++) {
+      Vector<T> &value = cached.m_values[i];
+      for (int pl = 1; pl <= subgame->NumPlayers(); pl++) {
+	if (cached.m_low[pl] == low[pl] && cached.m_range[pl] == range[pl]) {
+	  continue;
+	}
+	else if (cached.m_range[pl] == T(0)) {
+	  value[pl] += low[pl] - cached.m_low[pl];
+	}
+	else {
+	  value[pl] = low[pl] + (value[pl] - cached.m_low[pl]) * 
+	    range[pl] / cached.m_range[pl];
+	}
+      }
+    }
+    return cached;
+  }
+
+  List<MixedBehaviorProfile<T> > sol;
+  try {
+    sol = p_solver.Solve(BehaviorSupportProfile(subgame));
+    // The stage solver returns normally when interrupted, with only some
+    // of the subgame's equilibria; those cannot be extended, nor cached
+    if (p_context.get()) {
+      p_context->Check();
+    }
+  }
+  catch (...) {
+    // Threads waiting for this subgame go on to solve it themselves
+    if (p_cache) {
+#ifdef _OPENMP
+#pragma omp critical(gambit_subgame_cache)
+#endif  // _OPENMP
+      p_cache->erase(key);
+    }
+    throw;
+  }
+
+  cached.m_low = low;
+  cached.m_range = range;
+  for (int solno = 1; solno <= sol.Length(); solno++) {
+    Vector<T> profile(sol[solno].Length()), value(subgame->NumPlayers());
+    for (int pl = 1, index = 1; pl <= subgame->NumPlayers(); pl++) {
+      GamePlayer player = subgame->GetPlayer(pl);
+      for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+	for (int act = 1; act <= player->GetInfoset(iset)->NumActions(); act++) {
+	  profile[index++] = sol[solno](pl, iset, act);
+	}
+      }
+      value[pl] = sol[solno].GetPayoff(pl);
+    }
+    cached.m_profiles.push_back(profile);
+    cached.m_values.push_back(value);
+  }
+
+  if (p_cache) {
+#ifdef _OPENMP
+#pragma omp critical(gambit_subgame_cache)
+#endif  // _OPENMP
+    {
+      p_cache->erase(key);
+      p_cache->insert(std::make_pair(key, cached));
+    }
+  }
+  return cached;
+}
+
+///
+/// Solves the subgame once for each combination of the equilibria of
+/// the subgames immediately below it.  If any combination has no
+/// equilibrium, the subgame is left with none.
+///
+template <class T>
+void SolveSubgame(const BehavSolver<T> &p_solver,
+		  const shared_ptr<SolverContext> &p_context,
+		  std::map<std::string, CachedEquilibria<T> > *p_cache,
+		  const SubgameList<T> &p_subgames, Subgame<T> &p_subgame,
+		  const DVector<T> &p_templateSolution)
+{
+  Game subgame = p_subgame.m_game;
+
+  List<DVector<T> > thissolns;
+  thissolns.push_back(p_templateSolution);
+  ((Vector<T> &) thissolns[1]).operator=(T(0));
+
+  // For each combination, the index of the equilibrium chosen below
+  List<Array<int> > choices;
+  choices.push_back(Array<int>(p_subgame.m_children.Length()));
+
+  for (int i = 1; i <= p_subgame.m_children.Length(); i++) {
+    const List<DVector<T> > &subsolns = p_subgames[p_subgame.m_children[i]].m_solutions;
     List<DVector<T> > newsolns;
-    List<Array<GameOutcome> > newsubrootvalues;
-    
-    //printf("Merging with %d existing solutions\n", thissolns.Length());
+    List<Array<int> > newchoices;
+
     for (int soln = 1; soln <= thissolns.Length(); soln++) {
       for (int subsoln = 1; subsoln <= subsolns.Length(); subsoln++) {
-	//printf("Merging existing %d with new %d\n", soln, subsoln);
 	DVector<T> bp(thissolns[soln]);
-	DVector<T> tmp(subsolns[subsoln]);
+	const DVector<T> &tmp = subsolns[subsoln];
 	for (int j = 1; j <= bp.Length(); j++) {
 	  bp[j] += tmp[j];
 	}
-	newsolns.Append(bp);
-	
-	newsubrootvalues.Append(subrootvalues[soln]);
-	newsubrootvalues[newsubrootvalues.Length()][i] = subvalues[subsoln];
+	newsolns.push_back(bp);
+
+	newchoices.push_back(choices[soln]);
+	newchoices[newchoices.Length()][i] = subsoln;
       }
     }
-    
+
     thissolns = newsolns;
-    subrootvalues = newsubrootvalues;
-    //printf("Finished solving subgame %d\n", i);
+    choices = newchoices;
   }
-  
-  for (int soln = 1; soln <= thissolns.Length(); soln++)   {
-    //printf("Analyzing scenario %d of %d\n", soln, thissolns.Length());
-    for (int i = 1; i <= subroots.Length(); i++) {
-      subroots[i]->SetOutcome(subrootvalues[soln][i]);
-    }
-    
-    Game subgame = n->CopySubgame();
-    // this prevents double-counting of outcomes at roots of subgames
-    // by convention, we will just put the payoffs in the parent subgame
-    subgame->GetRoot()->SetOutcome(0);
-
-    BehaviorSupportProfile subsupport(subgame);
-    // Here, we build the support for the subgame
-    /*
-    for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-      GamePlayer subplayer = subgame->GetPlayer(pl);
-      GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-
-      for (int iset = 1; iset <= subplayer->NumInfosets(); iset++) {
-	GameInfoset subinfoset = subplayer->GetInfoset(iset);
-
-	for (int j = 1; j <= player->NumInfosets(); j++) {
-	  GameInfoset infoset = player->GetInfoset(j);
-	  if (subinfoset->GetLabel() == infoset->GetLabel()) {
-	    for (int act = 1; act <= infoset->NumActions(); act++)  {
-	      if (!p_support.Contains(infoset->GetAction(act))) {
-		subsupport.RemoveAction(subinfoset->GetAction(act));
-	      }
-	    }
-	    break;
-	  }
-	}
+
+  for (int soln = 1; soln <= thissolns.Length(); soln++) {
+    for (int i = 1; i <= p_subgame.m_children.Length(); i++) {
+      const Vector<T> &value =
+	p_subgames[p_subgame.m_children[i]].m_values[choices[soln][i]];
+      for (int pl = 1; pl <= subgame->NumPlayers(); pl++) {
+	p_subgame.m_leaves[i]->SetPayoff(pl, lexical_cast<std::string>(value[pl]));
       }
     }
-    */
 
-    List<MixedBehaviorProfile<T> > sol = m_solver->Solve(subsupport);
-    
-    if (sol.Length() == 0)  {
-      solns = List<DVector<T> >();
-      //printf("No solutions found\n");
+    CachedEquilibria<T> sol = Equilibria(p_solver, p_context, p_cache, p_subgame);
+    if (sol.m_profiles.Length() == 0) {
+      p_subgame.m_solutions = List<DVector<T> >();
+      p_subgame.m_values = List<Vector<T> >();
       return;
     }
-    
-    // Put behavior profile in "total" solution here...
-    for (int solno = 1; solno <= sol.Length(); solno++)  {
-      solns.Append(thissolns[soln]);
-      
-      for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-	GamePlayer subplayer = subgame->GetPlayer(pl);
-	GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-
-	for (int iset = 1; iset <= subplayer->NumInfosets(); iset++) {
-	  GameInfoset subinfoset = subplayer->GetInfoset(iset);
-
-	  for (int j = 1; j <= player->NumInfosets(); j++) {
-	    if (subinfoset->GetLabel() == player->GetInfoset(j)->GetLabel()) {
-	      int id = atoi(subinfoset->GetLabel().c_str());
-	      for (int act = 1; act <= subsupport.NumActions(pl, iset); act++) {
-		int actno = subsupport.GetAction(pl, iset, act)->GetNumber();
-		solns[solns.Length()](pl, id, actno) = sol[solno](pl, iset, act);	  
-	      }
-	      break;
-	    }
+
+    for (int solno = 1; solno <= sol.m_profiles.Length(); solno++) {
+      const Vector<T> &profile = sol.m_profiles[solno];
+      p_subgame.m_solutions.push_back(thissolns[soln]);
+      DVector<T> &solution = p_subgame.m_solutions.back();
+      for (int pl = 1, index = 1; pl <= subgame->NumPlayers(); pl++) {
+	GamePlayer player = subgame->GetPlayer(pl);
+	for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+	  int id = p_subgame.m_infosets[pl][iset];
+	  for (int act = 1; act <= player->GetInfoset(iset)->NumActions(); act++) {
+	    solution(pl, id, act) = profile[index++];
 	  }
 	}
       }
-      
-      Vector<T> subval(subgame->NumPlayers());
-      GameOutcome outcome = n->GetOutcome();
-      for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-	subval[pl] = sol[solno].GetPayoff(pl);
-	if (outcome) {
-	  subval[pl] += outcome->GetPayoff<T>(pl);
-        }
-      }
 
-      GameOutcome ov = efg->NewOutcome();
-      for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
-	ov->SetPayoff(pl, lexical_cast<std::string>(subval[pl]));
-      }
- 
-      values.Append(ov);
+      p_subgame.m_values.push_back(p_subgame.m_rootPayoffs + sol.m_values[solno]);
     }
-    //printf("Finished with scenario %d of %d; total solutions so far = %d\n",
-    //soln, thissolns.Length(), solns.Length());
   }
-
-  n->DeleteTree();
 }
 
+} // end nested anonymous namespace
+
 template <class T>
 List<MixedBehaviorProfile<T> > 
 SubgameBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 {
-  Game efg = p_support.GetGame()->GetRoot()->CopySubgame();
+  this->m_progress.Start();
+  SubgameList<T> subgames(p_support.GetGame()->GetRoot());
+  DVector<T> templateSolution(p_support.NumActions());
+  std::map<std::string, CachedEquilibria<T> > cache;
 
-  for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
-    for (int iset = 1; iset <= efg->GetPlayer(pl)->NumInfosets(); iset++) {
-      efg->GetPlayer(pl)->GetInfoset(iset)->SetLabel(lexical_cast<std::string>(iset));
+#ifdef _OPENMP
+  int threads = (m_threads > 0) ? m_threads : omp_get_max_threads();
+#endif  // _OPENMP
+
+  // Exceptions cannot leave a parallel region; they are recorded,
+  // and raised again once all threads have finished
+  bool done = false, interrupted = false;
+  std::string error;
+  for (int height = 0; height <= subgames[1].m_height && !done; height++) {
+    Array<Subgame<T> *> level;
+    for (int i = 1; i <= subgames.Length(); i++) {
+      if (subgames[i].m_height == height) {
+	level.push_back(&subgames[i]);
+      }
     }
-  }
 
-  BehaviorSupportProfile support(efg);
+    // A level with a single subgame leaves the threads to its solver
+    int numSubgames = level.Length();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(std::min(threads, numSubgames))
+#endif  // _OPENMP
+    for (int i = 1; i <= numSubgames; i++) {
+      bool skip;
+#ifdef _OPENMP
+#pragma omp critical(gambit_subgames)
+#endif  // _OPENMP
+      skip = done;
+      if (skip) {
+	// Loops in parallel cannot break; the remaining subgames are skipped
+	continue;
+      }
+
+      bool failed = false;
+      try {
+	SolveSubgame(*m_solver, this->m_context, (m_reuse) ? &cache : 0,
+		     subgames, *level[i], templateSolution);
+      }
+      catch (SolverInterrupted &) {
+	failed = true;
+#ifdef _OPENMP
+#pragma omp critical(gambit_subgames)
+#endif  // _OPENMP
+	interrupted = true;
+      }
+      catch (std::exception &ex) {
+	failed = true;
+#ifdef _OPENMP
+#pragma omp critical(gambit_subgames)
+#endif  // _OPENMP
+	{
+	  if (error.empty())  error = ex.what();
+	}
+      }
 
-  for (int pl = 1; pl <= efg->NumPlayers(); pl++)  {
-    GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-    for (int iset = 1; iset <= player->NumInfosets(); iset++)  {
-      GameInfoset infoset = player->GetInfoset(iset);
-      for (int act = 1; act <= infoset->NumActions(); act++) {
-	if (!p_support.Contains(infoset->GetAction(act))) {
-	  support.RemoveAction(efg->GetPlayer(pl)->GetInfoset(iset)->GetAction(act));
+#ifdef _OPENMP
+#pragma omp critical(gambit_subgames)
+#endif  // _OPENMP
+      {
+	// If any subgame has no equilibrium, neither does the game
+	if (failed || level[i]->m_solutions.Length() == 0) {
+	  done = true;
 	}
+	// Equilibria of the whole game are only known once the root is reached
+	this->m_progress.Report(0);
       }
     }
   }
+  if (!error.empty()) {
+    throw Exception(error);
+  }
 
+  // No equilibrium of the whole game is known until all subgames
+  // are solved
   List<DVector<T> > vectors;
-  List<GameOutcome> values;
-  SolveSubgames(support, DVector<T>(support.NumActions()),
-		efg->GetRoot(), vectors, values);
+  if (!interrupted) {
+    vectors = subgames[1].m_solutions;
+  }
 
   List<MixedBehaviorProfile<T> > solutions;
   for (int i = 1; i <= vectors.Length(); i++) {
@@ -454,6 +1155,7 @@ SubgameBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   for (int i = 1; i <= solutions.Length(); i++) {
     this->m_onEquilibrium->Render(solutions[i]);
   }
+  this->m_progress.Finish(solutions.Length());
   return solutions;
 }
 
@@ -20,7 +20,14 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif  // _OPENMP
+#include <algorithm>
+#include <cfloat>
+
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 #include "gambit/nash/simpdiv.h"
 
 namespace Gambit {
@@ -35,35 +42,94 @@ inline GameStrategy GetStrategy(const Game &game, int pl, int st)
   return game->Players()[pl]->Strategies()[st];
 }
 
-Rational 
-NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
-				   const Rational &d) const
+//
+// Comparisons of coordinates of points of the grid with mesh d.  In
+// floating point, these are made to within half the mesh, so that
+// roundoff in stepping from point to point cannot change them.
+//
+inline bool GridLessEqual(const Rational &a, const Rational &b, const Rational &)
+{ return a <= b; }
+inline bool GridLessEqual(double a, double b, double d)
+{ return a < b + 0.5 * d; }
+
+inline bool GridGreaterEqual(const Rational &a, const Rational &b, const Rational &)
+{ return a >= b; }
+inline bool GridGreaterEqual(double a, double b, double d)
+{ return a > b - 0.5 * d; }
+
+//
+// Comparisons of payoffs and regrets in choosing the label of a point.
+// In floating point, values within roundoff of each other are treated as
+// equal, so that ties are broken the same way however the point was
+// reached.
+//
+inline bool PayoffGreater(const Rational &a, const Rational &b)
+{ return a > b; }
+inline bool PayoffGreater(double a, double b)
+{ return a > b + 1.0e-12 * std::max(1.0, std::max(fabs(a), fabs(b))); }
+
+//
+// The number of vertices between full evaluations of the payoffs to
+// the strategies.  Corrections are exact in rational arithmetic, but
+// accumulate roundoff in floating point.
+//
+inline int PayoffRefreshInterval(const Rational &) { return 0; }
+inline int PayoffRefreshInterval(double) { return 100; }
+
+//
+// Whether refining the grid further can no longer reduce the regret
+// maxz.  In floating point, regrets are computed only to within roundoff
+// relative to the largest payoff p_scale, and coordinates are resolved
+// only to a limited mesh; Certify then continues in exact arithmetic.
+//
+inline bool AtPrecision(const Rational &, const Rational &, double)
+{ return false; }
+inline bool AtPrecision(double maxz, double d, double p_scale)
+{ return maxz < 64.0 * DBL_EPSILON * p_scale || d < 1.0e-12; }
+
+// Whether the coordinate y has reached zero, or has moved the length
+// of the leash from its value v at the start
+template <class T> bool
+NashSimpdivStrategySolver<T>::AtBoundary(const State &state,
+					 const T &v, const T &y) const
+{
+  return (GridLessEqual(y, T(0), state.d) ||
+	  GridGreaterEqual(v - y, T(m_leashLength) * state.d, state.d));
+}
+
+template <class T> T
+NashSimpdivStrategySolver<T>::Simplex(MixedStrategyProfile<T> &y,
+				      const T &d) const
 {
   Game game = y.GetGame();
-  State state;
+  // Corrections to the payoffs only save work on games in table form
+  State state(y, dynamic_cast<GameTableRep *>(&*game) != 0);
   state.d = d;
   Array<int> nstrats(game->NumStrategies());
   Array<int> ylabel(2);
   RectArray<int> labels(y.MixedProfileLength(), 2), pi(y.MixedProfileLength(), 2);
   PVector<int> U(nstrats), TT(nstrats);
-  PVector<Rational> ab(nstrats), besty(nstrats), v(nstrats);
+  PVector<T> ab(nstrats), besty(nstrats), v(nstrats);
   for (int i = 1; i <= v.Length(); i++) {
     v[i] = y[i];
   }
-  besty = static_cast<Vector<Rational> &>(y);
+  besty = static_cast<Vector<T> &>(y);
   int i = 0;
   int j, k, h, jj, hh,ii, kk,tot;
-  Rational maxz;
+  T maxz;
 
 // Label step0 not currently used, hence commented
 // step0:
   TT = 0;
   U = 0;
-  ab = Rational(0);
+  ab = T(0);
   for (j = 1; j <= game->NumPlayers(); j++)  {
     GamePlayer player = game->Players()[j];
     for (h = 1; h <= nstrats[j]; h++)  {
-      if (v(j,h) == Rational(0)) {
+      // In floating point, a coordinate which should be zero may carry
+      // roundoff from the walk on the coarser grid
+      if (GridLessEqual(v(j,h), T(0), d)) {
+	v(j,h) = T(0);
 	U(j,h) = 1;
       }
       y[player->Strategies()[h]] = v(j,h);
@@ -71,6 +137,9 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   }
 
  step1:
+  // Each visit here labels a new vertex of the simplex
+  Stats::Count(Stats::PIVOTS);
+  this->Checkpoint();
   maxz = state.getlabel(y, ylabel, besty);
   j = ylabel[1];
   h = ylabel[2];
@@ -157,8 +226,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   
   /* case3a */
   if (i==1 && 
-      (y[GetStrategy(game, j, k)]<=Rational(0) || 
-       (v(j,k)-y[GetStrategy(game, j, k)]) >= Rational(m_leashLength)*state.d)) {
+      AtBoundary(state, v(j,k), y[GetStrategy(game, j, k)])) {
     for (hh = 1, tot = 0; hh <= nstrats[j]; hh++) {
       if (TT(j,hh)==1 || U(j,hh)==1)  {
 	tot++;
@@ -177,19 +245,17 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   }
   /* case3b */
   else if (i>=2 && i<=state.t &&
-	   (y[GetStrategy(game, j, k)] <= Rational(0) || 
-	    (v(j,k)-y[GetStrategy(game, j, k)]) >= Rational(m_leashLength)*state.d)) {
+	   AtBoundary(state, v(j,k), y[GetStrategy(game, j, k)])) {
     goto step4;
   }
   /* case3c */
-  else if (i==state.t+1 && ab(j,kk) == Rational(0)) {
-    if (y[GetStrategy(game, j, h)] <= Rational(0) || 
-	(v(j,h)-y[GetStrategy(game, j, h)]) >= Rational(m_leashLength)*state.d) {
+  else if (i==state.t+1 && ab(j,kk) == T(0)) {
+    if (AtBoundary(state, v(j,h), y[GetStrategy(game, j, h)])) {
       goto step4;
     }
     else {
       k=0;
-      while (ab(j,kk) == Rational(0) && k==0) {
+      while (ab(j,kk) == T(0) && k==0) {
 	if(kk==h)k=1;
 	kk++;
 	if (kk > nstrats[j]) {
@@ -231,8 +297,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   j = pi(i-1,1);
   h = pi(i-1,2);
   TT(j,h) = 0;
-  if (y[GetStrategy(game, j, h)] <= Rational(0) || 
-      (v(j,h)-y[GetStrategy(game, j, h)]) >= Rational(m_leashLength)*state.d) {
+  if (AtBoundary(state, v(j,h), y[GetStrategy(game, j, h)])) {
     U(j,h) = 1;
   }
   labels.RotateUp(i,state.t+1);
@@ -263,7 +328,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
     if (k == h) {
       kk = 0;
     }
-    ab(j,k) -= Rational(1);
+    ab(j,k) -= T(1);
     k++;
     if (k > nstrats[j]) {
       k = 1;
@@ -281,12 +346,13 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   return maxz;
 }
 
-void NashSimpdivStrategySolver::update(State &state,
-				       RectArray<int> &pi,
-				       RectArray<int> &labels,
-				       PVector<Rational> &ab,
-				       const PVector<int> &U,
-				       int j, int i) const
+template <class T> void
+NashSimpdivStrategySolver<T>::update(State &state,
+				     RectArray<int> &pi,
+				     RectArray<int> &labels,
+				     PVector<T> &ab,
+				     const PVector<int> &U,
+				     int j, int i) const
 {
   int jj, hh, k,f;
   
@@ -304,7 +370,7 @@ void NashSimpdivStrategySolver::update(State &state,
       k=get_c(jj,hh,ab.Lengths()[jj],U);
       while(f) {
 	if(k==hh)f=0;
-	ab(j,k) += Rational(1);
+	ab(j,k) += T(1);
 	k++;
 	if(k>ab.Lengths()[jj])k=1;
       }
@@ -320,7 +386,7 @@ void NashSimpdivStrategySolver::update(State &state,
       k=get_c(jj,hh,ab.Lengths()[jj],U);
       while(f) {
 	if(k==hh)f=0;
-	ab(j,k) -= Rational(1);
+	ab(j,k) -= T(1);
 	k++;
 	if(k>ab.Lengths()[jj])k=1;
       }
@@ -329,22 +395,23 @@ void NashSimpdivStrategySolver::update(State &state,
   }
 }
 
-void NashSimpdivStrategySolver::getY(State &state,
-				     MixedStrategyProfile<Rational> &x,
-				     PVector<Rational> &v, 
-				     const PVector<int> &U,
-				     const PVector<int> &TT,
-				     const PVector<Rational> &ab,
-				     const RectArray<int> &pi,
-				     int k) const
+template <class T> void
+NashSimpdivStrategySolver<T>::getY(State &state,
+				   MixedStrategyProfile<T> &x,
+				   PVector<T> &v, 
+				   const PVector<int> &U,
+				   const PVector<int> &TT,
+				   const PVector<T> &ab,
+				   const RectArray<int> &pi,
+				   int k) const
 {
-  static_cast<Vector<Rational> & >(x) = v;
-  for (int j = 1; j <= x.GetGame()->Players().size(); j++) {
+  static_cast<Vector<T> & >(x) = v;
+  for (int j = 1; j <= x.GetGame()->NumPlayers(); j++) {
     GamePlayer player = x.GetGame()->Players()[j];
-    for (int h = 1; h <= player->Strategies().size(); h++) {
+    for (int h = 1; h <= player->NumStrategies(); h++) {
       if (TT(j,h) == 1 || U(j,h) == 1) {
 	x[player->Strategies()[h]] += state.d*ab(j,h);
-	int hh = (h > 1) ? h-1 : player->Strategies().size();
+	int hh = (h > 1) ? h-1 : player->NumStrategies();
 	x[player->Strategies()[hh]] -= state.d*ab(j,h);
       }
     }
@@ -354,21 +421,23 @@ void NashSimpdivStrategySolver::getY(State &state,
   }
 }
 
-void NashSimpdivStrategySolver::getnexty(State &state,
-					 MixedStrategyProfile<Rational> &x,
-					 const RectArray<int> &pi, 
-					 const PVector<int> &U,
-					 int i) const
+template <class T> void
+NashSimpdivStrategySolver<T>::getnexty(State &state,
+				       MixedStrategyProfile<T> &x,
+				       const RectArray<int> &pi, 
+				       const PVector<int> &U,
+				       int i) const
 {
   int j = pi(i,1);
   GamePlayer player = x.GetGame()->Players()[j];
   int h = pi(i,2);
   x[player->Strategies()[h]] += state.d;
-  int hh = get_b(j, h, player->Strategies().size(), U);
+  int hh = get_b(j, h, player->NumStrategies(), U);
   x[player->Strategies()[hh]] -= state.d;
 }
 
-int NashSimpdivStrategySolver::get_b(int j, int h, int nstrats, const PVector<int> &U) const
+template <class T> int
+NashSimpdivStrategySolver<T>::get_b(int j, int h, int nstrats, const PVector<int> &U) const
 {
   int hh = (h > 1) ? h-1 : nstrats;
   while (U(j,hh)) {
@@ -380,36 +449,112 @@ int NashSimpdivStrategySolver::get_b(int j, int h, int nstrats, const PVector<in
   return hh;
 }
 
-int NashSimpdivStrategySolver::get_c(int j, int h, int nstrats,
-				     const PVector<int> &U) const
+template <class T> int
+NashSimpdivStrategySolver<T>::get_c(int j, int h, int nstrats,
+				    const PVector<int> &U) const
 {
   int hh = get_b(j, h, nstrats, U) + 1;
   return (hh > nstrats) ? 1 : hh;
 }
 
-Rational 
-NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
-					   Array<int> &ylabel,
-					   PVector<Rational> &besty)
+template <class T>
+NashSimpdivStrategySolver<T>::State::State(const MixedStrategyProfile<T> &p_y,
+					   bool p_incremental)
+  : t(0), ibar(1), bestz(1.0e30),
+    incremental(p_incremental), havePayoffs(false), updates(0),
+    lasty(p_y), payoffs(p_y.GetGame()->NumStrategies())
+{ }
+
+//
+// Brings the payoffs to each strategy up to date with the profile yy.
+// Payoffs are multilinear, so if player q's probability on strategy k
+// moves by delta, the payoff to strategy s of each other player moves
+// by exactly delta times the payoff to s against k.  Correcting for
+// each moved coordinate of player q costs about 1/n_q of evaluating all
+// the payoffs afresh; a pivot moves two coordinates, so on larger
+// games this is much the cheaper.
+//
+template <class T> void
+NashSimpdivStrategySolver<T>::State::UpdatePayoffs(const MixedStrategyProfile<T> &yy)
+{
+  Game game = yy.GetGame();
+  double moved = 0.0;
+  if (incremental && havePayoffs) {
+    for (int q = 1; q <= game->NumPlayers(); q++) {
+      GamePlayer player = game->Players()[q];
+      int changed = 0;
+      for (int k = 1; k <= player->Strategies().Length(); k++) {
+	if (yy[player->Strategies()[k]] != lasty[player->Strategies()[k]]) {
+	  changed++;
+	}
+      }
+      moved += (double) changed / (double) player->NumStrategies();
+    }
+  }
+
+  if (!incremental || !havePayoffs || moved >= 1.0 ||
+      (PayoffRefreshInterval(T(0)) > 0 &&
+       updates >= PayoffRefreshInterval(T(0)))) {
+    for (int i = 1; i <= game->NumPlayers(); i++) {
+      GamePlayer player = game->Players()[i];
+      for (int j = 1; j <= player->Strategies().Length(); j++) {
+	payoffs(i,j) = yy.GetPayoff(player->Strategies()[j]);
+      }
+    }
+    static_cast<Vector<T> &>(lasty) = yy;
+    havePayoffs = true;
+    updates = 0;
+    return;
+  }
+
+  // Move one player at a time, so that each correction is taken against
+  // the current probabilities of the other players
+  for (int q = 1; q <= game->NumPlayers(); q++) {
+    GamePlayer player = game->Players()[q];
+    for (int k = 1; k <= player->Strategies().Length(); k++) {
+      GameStrategy strategy = player->Strategies()[k];
+      T delta = yy[strategy] - lasty[strategy];
+      if (delta == T(0))  continue;
+      for (int i = 1; i <= game->NumPlayers(); i++) {
+	if (i == q)  continue;
+	GamePlayer other = game->Players()[i];
+	for (int j = 1; j <= other->Strategies().Length(); j++) {
+	  payoffs(i,j) += delta * lasty.GetPayoffDeriv(i, other->Strategies()[j],
+						       strategy);
+	}
+      }
+    }
+    for (int k = 1; k <= player->Strategies().Length(); k++) {
+      lasty[player->Strategies()[k]] = yy[player->Strategies()[k]];
+    }
+  }
+  updates++;
+}
+
+template <class T> T
+NashSimpdivStrategySolver<T>::State::getlabel(MixedStrategyProfile<T> &yy,
+					      Array<int> &ylabel,
+					      PVector<T> &besty)
 {
-  Rational maxz = -1000000;
+  T maxz = -1000000;
   ylabel[1] = 1;
   ylabel[2] = 1;
+  UpdatePayoffs(yy);
   
   for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
     GamePlayer player = yy.GetGame()->Players()[i];
-    Rational payoff = 0;
-    Rational maxval = -1000000;
+    T payoff = 0;
+    T maxval = -1000000;
     int jj = 0;
-    for (int j = 1; j <= player->Strategies().size(); j++) {
-      pay = yy.GetPayoff(player->Strategies()[j]);
+    for (int j = 1; j <= player->NumStrategies(); j++) {
+      pay = payoffs(i,j);
       payoff += yy[player->Strategies()[j]] * pay;
-      if (pay > maxval) {
+      if (PayoffGreater(pay, maxval)) {
 	maxval = pay;
 	jj = j;
       }
     }
-    if (maxval - payoff > maxz) {
+    if (PayoffGreater(maxval - payoff, maxz)) {
       maxz = maxval - payoff;
       ylabel[1] = i;
       ylabel[2] = jj;
@@ -419,7 +564,7 @@ NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
     bestz = maxz;
     for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
       GamePlayer player = yy.GetGame()->Players()[i];
-      for (int j = 1; j <= player->Strategies().size(); j++) {
+      for (int j = 1; j <= player->NumStrategies(); j++) {
 	besty(i,j) = yy[player->Strategies()[j]];
       }
     }
@@ -440,35 +585,154 @@ inline Integer find_lcd(const Vector<Rational> &vec)
   return lcd;
 }
 
+// Sets p_profile to p_values, which may be on a different copy of the game
+template <class T, class U>
+void CopyProfile(MixedStrategyProfile<T> &p_profile,
+		 const MixedStrategyProfile<U> &p_values)
+{
+  for (int i = 1; i <= p_profile.MixedProfileLength(); i++) {
+    p_profile[i] = static_cast<T>(p_values[i]);
+  }
+}
 
-List<MixedStrategyProfile<Rational> >
-NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start) const
+//
+// With exact arithmetic, the approximation needs no certification.
+//
+template<> void
+NashSimpdivStrategySolver<Rational>::Certify(MixedStrategyProfile<Rational> &,
+					     const Rational &) const
+{ }
+
+//
+// Rounds the approximation p_y, computed in floating point, to the
+// nearest point of the grid with mesh p_d, and checks in exact arithmetic
+// that it is within tolerance of an equilibrium.  If not, this continues
+// the subdivision from that point in exact arithmetic.
+//
+template<> void
+NashSimpdivStrategySolver<double>::Certify(MixedStrategyProfile<double> &p_y,
+					   const Rational &p_d) const
 {
-  if (!p_start.GetGame()->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  const double TOL = 1.0e-10;
+  Game game = p_y.GetGame();
+  MixedStrategyProfile<Rational> y(game->NewMixedStrategyProfile(Rational(0)));
+  double mesh = p_d.denominator().as_double();
+  Rational maxz(0);
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = game->Players()[pl];
+    // Each player's probabilities are a number of steps of the grid,
+    // which must total one; any shortfall from rounding goes to the
+    // strategy with the largest probability
+    double total = 0.0;
+    int largest = 1;
+    Array<double> steps(player->NumStrategies());
+    for (int st = 1; st <= steps.Length(); st++) {
+      steps[st] = std::max(0.0, floor(p_y[player->Strategies()[st]] * mesh + 0.5));
+      total += steps[st];
+      if (steps[st] > steps[largest])  largest = st;
+    }
+    steps[largest] += mesh - total;
+    for (int st = 1; st <= steps.Length(); st++) {
+      y[player->Strategies()[st]] = Rational(steps[st]) * p_d;
+    }
   }
-  Integer k = find_lcd((const Vector<Rational> &) p_start);
-  Rational d = Rational(1, k);
-    
-  MixedStrategyProfile<Rational> y(p_start);
-  if (m_verbose) {
-    this->m_onEquilibrium->Render(y, "start");
+
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = game->Players()[pl];
+    Rational payoff(0), maxval(-1000000);
+    for (int st = 1; st <= player->Strategies().Length(); st++) {
+      Rational pay = y.GetPayoff(player->Strategies()[st]);
+      payoff += y[player->Strategies()[st]] * pay;
+      if (pay > maxval)  maxval = pay;
+    }
+    if (maxval - payoff > maxz)  maxz = maxval - payoff;
+  }
+  if (maxz < Rational(TOL)) {
+    CopyProfile(p_y, y);
+    return;
   }
 
-  while (true) {
-    const double TOL = 1.0e-10;
-    d /= m_gridResize;
-    Rational maxz = Simplex(y, d);
+  NashSimpdivStrategySolver<Rational> exact(m_gridResize, m_leashLength);
+  exact.SetContext(m_context);
+  MixedStrategyProfile<Rational> result(game->NewMixedStrategyProfile(Rational(0)));
+  if (!exact.Approximate(y, result, false)) {
+    throw SolverInterrupted(m_context->GetStatus());
+  }
+  CopyProfile(p_y, result);
+}
+
+//
+// In verbose mode, renders an intermediate approximation, or adds it to
+// p_trace if one is given.
+//
+template <class T> void
+NashSimpdivStrategySolver<T>::Verbose(const MixedStrategyProfile<T> &p_profile,
+				      const std::string &p_label,
+				      Trace *p_trace) const
+{
+  if (!m_verbose) {
+    return;
+  }
+  if (p_trace) {
+    p_trace->m_profiles.push_back(p_profile);
+    p_trace->m_labels.push_back(p_label);
+  }
+  else {
+    this->m_onEquilibrium->Render(p_profile, p_label);
+  }
+}
+
+//
+// Computes an approximate equilibrium from p_start into p_result,
+// returning false if the solver was interrupted before one was found.
+// Progress is reported on each refinement of the grid if p_report is set.
+//
+template <class T> bool
+NashSimpdivStrategySolver<T>::Approximate(const MixedStrategyProfile<Rational> &p_start,
+					  MixedStrategyProfile<T> &p_result,
+					  bool p_report, Trace *p_trace) const
+{
+  Rational d(Rational(1, find_lcd((const Vector<Rational> &) p_start)));
+  Game game = p_start.GetGame();
+  double scale = std::max(fabs((double) game->GetMaxPayoff()),
+			  fabs((double) game->GetMinPayoff()));
+  MixedStrategyProfile<T> &y = p_result;
+  CopyProfile(y, p_start);
+  Verbose(y, "start", p_trace);
+
+  try {
+    while (true) {
+      const double TOL = 1.0e-10;
+      d /= m_gridResize;
+      T maxz = Simplex(y, static_cast<T>(d));
     
-    if (m_verbose) {
-      this->m_onEquilibrium->Render(y, lexical_cast<std::string>(d));
+      Verbose(y, lexical_cast<std::string>(d), p_trace);
+      if (maxz < T(TOL) || AtPrecision(maxz, static_cast<T>(d), scale)) break;
+      if (p_report)  this->m_progress.Report(0);
     }
-    if (maxz < Rational(TOL)) break;
+    Certify(y, d);
   }
-    
-  this->m_onEquilibrium->Render(y);
-  List<MixedStrategyProfile<Rational> > sol;
-  sol.push_back(y);
+  catch (SolverInterrupted &) {
+    // The approximation on the current grid is not an equilibrium
+    return false;
+  }
+  return true;
+}
+
+template <class T> List<MixedStrategyProfile<T> >
+NashSimpdivStrategySolver<T>::Solve(const MixedStrategyProfile<Rational> &p_start) const
+{
+  if (!p_start.GetGame()->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  this->m_progress.Start();
+  List<MixedStrategyProfile<T> > sol;
+  MixedStrategyProfile<T> y(p_start.GetGame()->NewMixedStrategyProfile(T(0)));
+  if (Approximate(p_start, y, true)) {
+    this->m_onEquilibrium->Render(y);
+    sol.push_back(y);
+  }
+  this->m_progress.Finish(sol.Length());
   return sol;
 }
 
@@ -484,8 +748,8 @@ NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start)
 /// to a long initial search before reaching a candidate neighborhood
 /// for an equilibrium.
 ///
-List<MixedStrategyProfile<Rational> >
-NashSimpdivStrategySolver::Solve(const Game &p_game) const
+template <class T> List<MixedStrategyProfile<T> >
+NashSimpdivStrategySolver<T>::Solve(const Game &p_game) const
 {
   MixedStrategyProfile<Rational> start = p_game->NewMixedStrategyProfile(Rational(0));
   static_cast<Vector<Rational> &>(start) = Rational(0);
@@ -494,7 +758,100 @@ NashSimpdivStrategySolver::Solve(const Game &p_game) const
   }
   return Solve(start);
 }
-  
+
+// Whether p_profile is more than 1e-6 from each of p_profiles; as
+// approximations from different starts differ, this is how equilibria
+// are told apart
+template <class T>
+bool IsDistinct(const MixedStrategyProfile<T> &p_profile,
+		const List<MixedStrategyProfile<T> > &p_profiles)
+{
+  for (int i = 1; i <= p_profiles.Length(); i++) {
+    double dist = 0.0;
+    for (int j = 1; j <= p_profile.MixedProfileLength(); j++) {
+      dist = std::max(dist, fabs(static_cast<double>(p_profile[j] - p_profiles[i][j])));
+    }
+    if (dist < 1.0e-6)  return false;
+  }
+  return true;
+}
+
+template <class T> List<MixedStrategyProfile<T> >
+NashSimpdivStrategySolver<T>::Solve(const List<MixedStrategyProfile<Rational> > &p_starts,
+				    int p_stopAfter, int p_threads) const
+{
+  List<MixedStrategyProfile<T> > sol;
+  if (p_starts.empty()) {
+    return sol;
+  }
+  Game game = p_starts[1].GetGame();
+  if (!game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  this->m_progress.Start();
+
+  int numStarts = p_starts.Length();
+  bool done = false;
+#ifdef _OPENMP
+  if (p_threads <= 0) {
+    p_threads = omp_get_max_threads();
+  }
+#else
+  p_threads = 1;
+#endif  // _OPENMP
+  // Reference counts on game objects are not atomic, so when running in
+  // parallel each start is solved on a private copy of the game, made
+  // (like all other access to the game itself) in a critical section
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(p_threads)
+#endif  // _OPENMP
+  for (int i = 1; i <= numStarts; i++) {
+    Game local;
+    bool skip;
+#ifdef _OPENMP
+#pragma omp critical(gambit_simpdiv)
+#endif  // _OPENMP
+    {
+      skip = done;
+      if (!skip) {
+	local = (p_threads > 1) ? game->Copy() : game;
+      }
+    }
+    if (skip) {
+      // Loops in parallel cannot break; the remaining starts are skipped
+      continue;
+    }
+
+    MixedStrategyProfile<Rational> start(local->NewMixedStrategyProfile(Rational(0)));
+    CopyProfile(start, p_starts[i]);
+    MixedStrategyProfile<T> y(local->NewMixedStrategyProfile(T(0)));
+    Trace trace;
+    bool found = Approximate(start, y, false, &trace);
+
+#ifdef _OPENMP
+#pragma omp critical(gambit_simpdiv)
+#endif  // _OPENMP
+    {
+      for (int j = 1; j <= trace.m_profiles.Length(); j++) {
+	this->m_onEquilibrium->Render(trace.m_profiles[j], trace.m_labels[j]);
+      }
+      if (found && !done && IsDistinct(y, sol)) {
+	MixedStrategyProfile<T> eqm(game->NewMixedStrategyProfile(T(0)));
+	CopyProfile(eqm, y);
+	this->m_onEquilibrium->Render(eqm);
+	sol.push_back(eqm);
+	done = (p_stopAfter > 0 && sol.Length() >= p_stopAfter);
+      }
+      this->m_progress.Report(sol.Length());
+    }
+  }
+
+  this->m_progress.Finish(sol.Length());
+  return sol;
+}
+
+template class NashSimpdivStrategySolver<double>;
+template class NashSimpdivStrategySolver<Rational>;
 
 }  // end namespace Gambit::Nash
 }  // end namespace Gambit
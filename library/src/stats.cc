@@ -0,0 +1,161 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/stats.cc
+// Instrumentation counters and phase timers for the solvers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <map>
+#include <vector>
+#include <sys/time.h>
+#include "gambit/gambit.h"
+
+namespace Gambit {
+
+namespace Stats {
+
+namespace {
+
+const char *s_names[NUM_COUNTERS] = {
+  "pivots", "refactorizations", "payoff_evaluations",
+  "jacobian_builds", "qr_decompositions", "path_steps"
+};
+
+#ifndef GAMBIT_NO_STATS
+// Totals by phase name; all access is inside the critical section
+std::map<std::string, double> s_phases;
+// The counter blocks of all threads which have counted; blocks are kept
+// after their threads finish, so their counts are still reported
+std::vector<CounterBlock *> s_blocks;
+#endif  // GAMBIT_NO_STATS
+
+}  // end anonymous namespace
+
+#ifndef GAMBIT_NO_STATS
+CounterBlock *g_threadCounts = 0;
+
+CounterBlock *NewCounterBlock(void)
+{
+  CounterBlock *block = new CounterBlock;
+  for (int i = 0; i < NUM_COUNTERS; block->m_counts[i++] = 0);
+#ifdef _OPENMP
+#pragma omp critical(gambit_stats)
+#endif  // _OPENMP
+  s_blocks.push_back(block);
+  return block;
+}
+
+long GetCount(Counter p_counter)
+{
+  long total = 0;
+#ifdef _OPENMP
+#pragma omp critical(gambit_stats)
+#endif  // _OPENMP
+  for (size_t i = 0; i < s_blocks.size(); i++) {
+    total += s_blocks[i]->m_counts[p_counter];
+  }
+  return total;
+}
+#endif  // GAMBIT_NO_STATS
+
+const char *GetName(Counter p_counter)
+{
+  if (p_counter < 0 || p_counter >= NUM_COUNTERS)  throw IndexException();
+  return s_names[p_counter];
+}
+
+double GetPhaseTime(const std::string &p_phase)
+{
+  double total = 0.0;
+#ifndef GAMBIT_NO_STATS
+#ifdef _OPENMP
+#pragma omp critical(gambit_stats)
+#endif  // _OPENMP
+  {
+    std::map<std::string, double>::const_iterator phase = s_phases.find(p_phase);
+    if (phase != s_phases.end())  total = phase->second;
+  }
+#endif  // GAMBIT_NO_STATS
+  return total;
+}
+
+void Reset(void)
+{
+#ifndef GAMBIT_NO_STATS
+#ifdef _OPENMP
+#pragma omp critical(gambit_stats)
+#endif  // _OPENMP
+  {
+    for (size_t i = 0; i < s_blocks.size(); i++) {
+      for (int j = 0; j < NUM_COUNTERS; s_blocks[i]->m_counts[j++] = 0);
+    }
+    s_phases.clear();
+  }
+#endif  // GAMBIT_NO_STATS
+}
+
+double WallClock(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+void WriteJSON(std::ostream &p_stream)
+{
+  std::ostringstream s;
+#ifndef GAMBIT_NO_STATS
+  s << "{\"enabled\": true, \"counters\": {";
+#else
+  s << "{\"enabled\": false, \"counters\": {";
+#endif  // GAMBIT_NO_STATS
+  for (int i = 0; i < NUM_COUNTERS; i++) {
+    s << ((i > 0) ? ", " : "") << "\"" << s_names[i] << "\": "
+      << GetCount((Counter) i);
+  }
+  s << "}, \"phases\": {";
+#ifndef GAMBIT_NO_STATS
+#ifdef _OPENMP
+#pragma omp critical(gambit_stats)
+#endif  // _OPENMP
+  {
+    for (std::map<std::string, double>::const_iterator phase = s_phases.begin();
+	 phase != s_phases.end(); ++phase) {
+      s << ((phase != s_phases.begin()) ? ", " : "") << "\"" << phase->first
+	<< "\": " << phase->second;
+    }
+  }
+#endif  // GAMBIT_NO_STATS
+  s << "}}";
+  p_stream << s.str();
+}
+
+#ifndef GAMBIT_NO_STATS
+PhaseTimer::~PhaseTimer()
+{
+  double elapsed = WallClock() - m_start;
+#ifdef _OPENMP
+#pragma omp critical(gambit_stats)
+#endif  // _OPENMP
+  s_phases[m_phase] += elapsed;
+}
+#endif  // GAMBIT_NO_STATS
+
+}  // end namespace Gambit::Stats
+
+}  // end namespace Gambit
@@ -20,8 +20,11 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <cmath>
+
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
+#include "gambit/linalg/lpsolve.h"
 
 namespace Gambit {
 
@@ -221,13 +224,261 @@ bool StrategySupportProfile::RemoveStrategy(const GameStrategy &p_strategy)
 //                 Identification of dominated strategies
 //---------------------------------------------------------------------------
 
+namespace {
+
+//
+// The payoffs to one player, stored as a dense matrix with one row for
+// each of the player's candidate strategies and one column for each
+// contingency of the other players' strategies in the support.  The
+// payoffs are computed once, when the slice is built; dominance tests
+// are then done directly on the matrix, instead of visiting profiles
+// of the game.
+//
+// A copy of the payoffs is kept in doubles.  Where the two copies of a
+// pair of payoffs differ by clearly more than the error in converting
+// them, the doubles decide the comparison; otherwise the exact payoffs
+// are compared, so the answers do not depend on rounding.
+//
+// During iterated elimination, rows and columns are switched off as
+// strategies are removed from the support.  For each ordered pair of
+// rows, the column which last showed that the first does not dominate
+// the second is remembered, and the pair is only rechecked once that
+// column has been switched off.  (For weak dominance, a pair of rows
+// equal on all columns is marked -1; this cannot change.)
+//
+class PayoffSlice {
+private:
+  bool m_strict, m_external;
+  Array<GameStrategy> m_rows;
+  Array<bool> m_rowActive, m_colActive;
+  int m_numCols;
+  // Column index strides and number of strategies for each other player
+  Array<int> m_stride, m_radix;
+  Array<Rational> m_exact;
+  Array<double> m_approx;
+  Array<int> m_witness;
+
+  int Cell(int p_row, int p_col) const
+    { return (p_row - 1) * m_numCols + p_col; }
+  const Rational &Exact(int p_row, int p_col) const
+    { return m_exact[Cell(p_row, p_col)]; }
+
+public:
+  PayoffSlice(const StrategySupportProfile &, int p_player,
+	      bool p_strict, bool p_external);
+
+  int NumRows(void) const { return m_rows.Length(); }
+  const GameStrategy &GetRow(int p_row) const { return m_rows[p_row]; }
+  bool IsActive(int p_row) const { return m_rowActive[p_row]; }
+
+  /// Switch off a row, after the strategy is removed from the support
+  void RemoveRow(int p_row) { m_rowActive[p_row] = false; }
+  /// Switch off columns, after the p_index'th strategy of another
+  /// player in the original support is removed
+  void RemoveColumns(int p_player, int p_index);
+
+  bool Dominates(int s, int t);
+  bool IsDominated(int t);
+  bool IsMixedDominated(int t) const;
+};
+
+PayoffSlice::PayoffSlice(const StrategySupportProfile &p_support,
+			 int p_player, bool p_strict, bool p_external)
+  : m_strict(p_strict), m_external(p_external), m_numCols(1),
+    m_stride(p_support.NumPlayers()), m_radix(p_support.NumPlayers())
+{
+  GamePlayer player = p_support.GetGame()->GetPlayer(p_player);
+  if (p_external) {
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      m_rows.Append(player->GetStrategy(st));
+      m_rowActive.Append(p_support.Contains(player->GetStrategy(st)));
+    }
+  }
+  else {
+    for (int st = 1; st <= p_support.NumStrategies(p_player); st++) {
+      m_rows.Append(p_support.GetStrategy(p_player, st));
+      m_rowActive.Append(true);
+    }
+  }
+
+  // StrategyProfileIterator advances the lowest-numbered player first
+  for (int pl = 1; pl <= p_support.NumPlayers(); pl++) {
+    if (pl == p_player) {
+      m_stride[pl] = 0;
+      m_radix[pl] = 1;
+    }
+    else {
+      m_stride[pl] = m_numCols;
+      m_radix[pl] = p_support.NumStrategies(pl);
+      m_numCols *= m_radix[pl];
+    }
+  }
+
+  m_colActive = Array<bool>(m_numCols);
+  for (int c = 1; c <= m_numCols; m_colActive[c++] = true);
+  m_exact = Array<Rational>(m_rows.Length() * m_numCols);
+  m_approx = Array<double>(m_rows.Length() * m_numCols);
+  m_witness = Array<int>(m_rows.Length() * m_rows.Length());
+  for (int i = 1; i <= m_witness.Length(); m_witness[i++] = 0);
+
+  int c = 1;
+  for (StrategyProfileIterator iter(p_support, p_player, 1);
+       !iter.AtEnd(); iter++, c++) {
+    for (int r = 1; r <= m_rows.Length(); r++) {
+      m_exact[Cell(r, c)] = (*iter)->GetStrategyValue(m_rows[r]);
+      m_approx[Cell(r, c)] = (double) m_exact[Cell(r, c)];
+    }
+  }
+}
+
+void PayoffSlice::RemoveColumns(int p_player, int p_index)
+{
+  for (int c = 1; c <= m_numCols; c++) {
+    if ((c - 1) / m_stride[p_player] % m_radix[p_player] == p_index - 1) {
+      m_colActive[c] = false;
+    }
+  }
+}
+
+bool PayoffSlice::Dominates(int s, int t)
+{
+  int &witness = m_witness[(s - 1) * m_rows.Length() + t];
+  if (witness == -1 || (witness > 0 && m_colActive[witness])) {
+    return false;
+  }
+
+  const double *ps = &m_approx[Cell(s, 1)], *pt = &m_approx[Cell(t, 1)];
+  const bool *active = &m_colActive[1];
+  bool equal = true;
+  for (int c = 0; c < m_numCols; c++) {
+    if (!active[c])  continue;
+    if (ps[c] - pt[c] > 1.0e-9 * (std::fabs(ps[c]) + std::fabs(pt[c]))) {
+      equal = false;
+      continue;
+    }
+    const Rational &a = Exact(s, c + 1), &b = Exact(t, c + 1);
+    if (a < b || (m_strict && a == b)) {
+      witness = c + 1;
+      return false;
+    }
+    else if (a > b) {
+      equal = false;
+    }
+  }
+
+  if (!m_strict && equal) {
+    witness = -1;
+    return false;
+  }
+  return true;
+}
+
+bool PayoffSlice::IsDominated(int t)
+{
+  for (int s = 1; s <= m_rows.Length(); s++) {
+    if (s != t && (m_external || m_rowActive[s]) && Dominates(s, t)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//
+// Tests for dominance by a mixture sigma of the other active rows by
+// solving the linear program
+//    maximize z subject to  sum_s sigma_s u_s(c) - u_t(c) >= z - M,
+//                           sum_s sigma_s = 1,  sigma, z >= 0,
+// for each active column c.  The offset M exceeds the range of the
+// payoffs, so z = 0 is always feasible; t is strictly dominated exactly
+// when the optimum exceeds M.  If the optimum equals M, t is weakly
+// dominated exactly when some mixture with sigma u(c) >= u_t(c) for all
+// c has a larger total payoff than t over the active columns.
+//
+bool PayoffSlice::IsMixedDominated(int t) const
+{
+  int k = 0, m = 0;
+  for (int s = 1; s <= m_rows.Length(); s++) {
+    if (s != t && m_rowActive[s])  k++;
+  }
+  for (int c = 1; c <= m_numCols; c++) {
+    if (m_colActive[c])  m++;
+  }
+  if (k == 0)  return false;
+
+  Array<int> rows(k), cols(m);
+  for (int s = 1, r = 0; s <= m_rows.Length(); s++) {
+    if (s != t && m_rowActive[s])  rows[++r] = s;
+  }
+  for (int c = 1, i = 0; c <= m_numCols; c++) {
+    if (m_colActive[c])  cols[++i] = c;
+  }
+
+  Rational minpay = Exact(t, cols[1]), maxpay = minpay;
+  for (int i = 1; i <= m; i++) {
+    for (int r = 0; r <= k; r++) {
+      const Rational &u = Exact((r == 0) ? t : rows[r], cols[i]);
+      if (u < minpay)  minpay = u;
+      if (u > maxpay)  maxpay = u;
+    }
+  }
+  Rational offset = maxpay - minpay + Rational(1);
+
+  Matrix<Rational> A(1, m + 1, 1, k + 1);
+  Vector<Rational> b(1, m + 1), c(1, k + 1);
+  for (int i = 1; i <= m; i++) {
+    for (int j = 1; j <= k; j++) {
+      A(i, j) = -Exact(rows[j], cols[i]);
+    }
+    A(i, k + 1) = Rational(1);
+    b[i] = offset - Exact(t, cols[i]);
+  }
+  for (int j = 1; j <= k; j++) {
+    A(m + 1, j) = Rational(1);
+  }
+  A(m + 1, k + 1) = Rational(0);
+  b[m + 1] = Rational(1);
+  c = Rational(0);
+  c[k + 1] = Rational(1);
+
+  Rational best;
+  {
+    linalg::LPSolve<Rational> lp(A, b, c, 1);
+    best = lp.OptimumCost();
+  }
+  if (best > offset)  return true;
+  if (m_strict || best < offset)  return false;
+
+  Matrix<Rational> A2(1, m + 1, 1, k);
+  Vector<Rational> b2(1, m + 1), c2(1, k);
+  Rational total(0);
+  c2 = Rational(0);
+  for (int i = 1; i <= m; i++) {
+    for (int j = 1; j <= k; j++) {
+      A2(i, j) = -Exact(rows[j], cols[i]);
+      c2[j] += Exact(rows[j], cols[i]);
+    }
+    b2[i] = -Exact(t, cols[i]);
+    total += Exact(t, cols[i]);
+  }
+  for (int j = 1; j <= k; j++) {
+    A2(m + 1, j) = Rational(1);
+  }
+  b2[m + 1] = Rational(1);
+
+  linalg::LPSolve<Rational> lp(A2, b2, c2, 1);
+  return (lp.IsFeasible() && lp.OptimumCost() > total);
+}
+
+}  // end anonymous namespace
+
 bool StrategySupportProfile::Dominates(const GameStrategy &s,
 				const GameStrategy &t, 
 				bool p_strict) const
 {
   bool equal = true;
   
-  for (StrategyProfileIterator iter(*this); !iter.AtEnd(); iter++) {
+  // Holding s fixed visits each contingency of the other players once
+  for (StrategyProfileIterator iter(*this, s); !iter.AtEnd(); iter++) {
     Rational ap = (*iter)->GetStrategyValue(s);
     Rational bp = (*iter)->GetStrategyValue(t);
     if (p_strict && ap <= bp) {
@@ -269,71 +520,29 @@ bool StrategySupportProfile::IsDominated(const GameStrategy &s,
   }
 }
 
+bool StrategySupportProfile::IsMixedDominated(const GameStrategy &s,
+					      bool p_strict) const
+{
+  if (!Contains(s))  return false;
+  PayoffSlice slice(*this, s->GetPlayer()->GetNumber(), p_strict, false);
+  return (slice.IsDominated(GetIndex(s)) || 
+	  slice.IsMixedDominated(GetIndex(s)));
+}
+
 bool StrategySupportProfile::Undominated(StrategySupportProfile &newS, int p_player,
 				  bool p_strict, bool p_external) const
 {
-  Array<GameStrategy> set((p_external) ? 
-			  m_nfg->GetPlayer(p_player)->NumStrategies() :
-			  NumStrategies(p_player));
+  PayoffSlice slice(*this, p_player, p_strict, p_external);
+  bool removed = false;
 
-  if (p_external) {
-    for (int st = 1; st <= set.Length(); st++) {
-      set[st] = m_nfg->GetPlayer(p_player)->GetStrategy(st);
-    }
-  }
-  else {
-    for (int st = 1; st <= set.Length(); st++) {
-      set[st] = GetStrategy(p_player, st);
+  for (int st = 1; st <= slice.NumRows(); st++) {
+    if (slice.IsActive(st) && slice.IsDominated(st)) {
+      newS.RemoveStrategy(slice.GetRow(st));
+      removed = true;
     }
   }
 
-  int min = 0, dis = set.Length() - 1;
-
-  while (min <= dis) {
-    int pp;
-    for (pp = 0;
-	 pp < min && !Dominates(set[pp+1], set[dis+1], p_strict);
-	 pp++);
-    if (pp < min)
-      dis--;
-    else  {
-      GameStrategy foo = set[dis+1];
-      set[dis+1] = set[min+1];
-      set[min+1] = foo;
-
-      for (int inc = min + 1; inc <= dis; )  {
-	if (Dominates(set[min+1], set[dis+1], p_strict)) {
-	  //p_tracefile << GetStrategy(p_player, set[dis+1])->GetNumber() << " dominated by " << GetStrategy(p_player, set[min+1])->GetNumber() << '\n';
-	  dis--;
-	}
-	else if (Dominates(set[dis+1], set[min+1], p_strict)) {
-	  //p_tracefile << GetStrategy(p_player, set[min+1])->GetNumber() << " dominated by " << GetStrategy(p_player, set[dis+1])->GetNumber() << '\n';
-	  foo = set[dis+1];
-	  set[dis+1] = set[min+1];
-	  set[min+1] = foo;
-	  dis--;
-	}
-	else  {
-	  foo = set[dis+1];
-	  set[dis+1] = set[inc+1];
-	  set[inc+1] = foo;
-	  inc++;
-	}
-      }
-      min++;
-    }
-  }
-    
-  if (min + 1 <= set.Length()) {
-    for (int i = min + 1; i <= set.Length(); i++) {
-      newS.RemoveStrategy(set[i]);
-    }
-    
-    return true;
-  }
-  else {
-    return false;
-  }
+  return removed;
 }
 
 StrategySupportProfile StrategySupportProfile::Undominated(bool p_strict,
@@ -361,6 +570,56 @@ StrategySupportProfile::Undominated(bool p_strict, const Array<int> &players) co
   return newS;
 }
 
+StrategySupportProfile 
+StrategySupportProfile::IteratedUndominated(bool p_strict, bool p_mixed) const
+{
+  StrategySupportProfile newS(*this);
+  // The slices are built once on this support; the row and column
+  // indices of each slice are the indices of strategies in this support.
+  Array<PayoffSlice *> slices(m_nfg->NumPlayers());
+  for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++) {
+    slices[pl] = new PayoffSlice(*this, pl, p_strict, false);
+  }
+
+  try {
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      // Identify dominated strategies for all players before removing any
+      Array<Array<int> > dominated(m_nfg->NumPlayers());
+      for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++) {
+	for (int st = 1; st <= slices[pl]->NumRows(); st++) {
+	  if (slices[pl]->IsActive(st) &&
+	      (slices[pl]->IsDominated(st) ||
+	       (p_mixed && slices[pl]->IsMixedDominated(st)))) {
+	    dominated[pl].Append(st);
+	  }
+	}
+      }
+
+      for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++) {
+	for (int i = 1; i <= dominated[pl].Length(); i++) {
+	  int st = dominated[pl][i];
+	  if (newS.RemoveStrategy(slices[pl]->GetRow(st))) {
+	    changed = true;
+	    slices[pl]->RemoveRow(st);
+	    for (int opp = 1; opp <= m_nfg->NumPlayers(); opp++) {
+	      if (opp != pl)  slices[opp]->RemoveColumns(pl, st);
+	    }
+	  }
+	}
+      }
+    }
+  }
+  catch (...) {
+    for (int pl = 1; pl <= slices.Length(); delete slices[pl++]);
+    throw;
+  }
+
+  for (int pl = 1; pl <= slices.Length(); delete slices[pl++]);
+  return newS;
+}
+
 //---------------------------------------------------------------------------
 //                Identification of overwhelmed strategies
 //---------------------------------------------------------------------------
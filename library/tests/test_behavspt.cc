@@ -0,0 +1,199 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_behavspt.cc
+// Checks the reachability kept by behavior supports as actions are removed
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <sstream>
+
+#include "gambit/gambit.h"
+
+using namespace Gambit;
+
+namespace {
+
+int failures = 0;
+
+void Fail(const char *p_test, const char *p_message)
+{
+  std::cerr << p_test << ": " << p_message << std::endl;
+  failures++;
+}
+
+// A game with chance moves below personal moves, and information sets
+// whose members lie under different actions
+Game MakeGame(void)
+{
+  std::istringstream file("EFG 2 R \"\" { \"1\" \"2\" }\n\"\"\n"
+			  "p \"\" 1 1 \"\" { \"L\" \"R\" } 0\n"
+			  "c \"\" 1 \"\" { \"h\" 1/2 \"t\" 1/2 } 0\n"
+			  "p \"\" 2 1 \"\" { \"l\" \"r\" } 0\n"
+			  "p \"\" 1 2 \"\" { \"a\" \"b\" } 0\n"
+			  "t \"\" 1 \"\" { 1, 0 }\n"
+			  "t \"\" 2 \"\" { 0, 1 }\n"
+			  "t \"\" 3 \"\" { 2, 2 }\n"
+			  "p \"\" 2 1 \"\" { \"l\" \"r\" } 0\n"
+			  "p \"\" 1 2 \"\" { \"a\" \"b\" } 0\n"
+			  "t \"\" 4 \"\" { 1, 1 }\n"
+			  "t \"\" 5 \"\" { 0, 0 }\n"
+			  "t \"\" 6 \"\" { 3, 0 }\n"
+			  "p \"\" 2 2 \"\" { \"x\" \"y\" \"z\" } 0\n"
+			  "c \"\" 2 \"\" { \"u\" 1/3 \"d\" 2/3 } 0\n"
+			  "p \"\" 1 3 \"\" { \"c\" \"e\" } 0\n"
+			  "t \"\" 7 \"\" { 0, 0 }\n"
+			  "t \"\" 8 \"\" { 1, 0 }\n"
+			  "t \"\" 9 \"\" { 0, 2 }\n"
+			  "p \"\" 1 3 \"\" { \"c\" \"e\" } 0\n"
+			  "t \"\" 10 \"\" { 1, 1 }\n"
+			  "t \"\" 11 \"\" { 2, 1 }\n"
+			  "t \"\" 12 \"\" { 0, 3 }\n");
+  return ReadGame(file);
+}
+
+// Marks the nonterminal nodes reached when players choose only actions
+// in the support
+void MarkReachable(const BehaviorSupportProfile &p_support,
+		   const GameNode &p_node, Array<bool> &p_reached)
+{
+  if (p_node->IsTerminal())  return;
+  p_reached[p_node->GetNumber()] = true;
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    if (p_node->GetPlayer()->IsChance() ||
+	p_support.Contains(p_node->GetInfoset()->GetAction(i))) {
+      MarkReachable(p_support, p_node->GetChild(i), p_reached);
+    }
+  }
+}
+
+Array<bool> Reachable(const BehaviorSupportProfile &p_support)
+{
+  Game game = p_support.GetGame();
+  Array<bool> reached(game->NumNodes());
+  for (int i = 1; i <= reached.Length(); reached[i++] = false);
+  MarkReachable(p_support, game->GetRoot(), reached);
+  return reached;
+}
+
+int CountReached(const GameInfoset &p_infoset, const Array<bool> &p_reached)
+{
+  int count = 0;
+  for (int m = 1; m <= p_infoset->NumMembers(); m++) {
+    if (p_reached[p_infoset->GetMember(m)->GetNumber()])  count++;
+  }
+  return count;
+}
+
+// Compares what the support says is reachable with a walk of the tree
+void CheckReachable(const BehaviorSupportProfile &p_support,
+		    const Array<bool> &p_reached)
+{
+  Game game = p_support.GetGame();
+  bool actionsAtActive = true;
+  for (int pl = 0; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = (pl == 0) ? game->GetChance() : game->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      GameInfoset infoset = player->GetInfoset(iset);
+      int count = CountReached(infoset, p_reached);
+      if (p_support.NumActiveMembers(infoset) != count) {
+	Fail("CheckReachable", "wrong number of active members");
+      }
+      if (p_support.IsActive(infoset) != (count > 0)) {
+	Fail("CheckReachable", "wrong activity of information set");
+      }
+      for (int m = 1; m <= infoset->NumMembers(); m++) {
+	GameNode member = infoset->GetMember(m);
+	if (p_support.IsActive(member) != p_reached[member->GetNumber()]) {
+	  Fail("CheckReachable", "wrong activity of node");
+	}
+      }
+      if (pl > 0) {
+	if (p_support.ReachableMembers(infoset).Length() != count) {
+	  Fail("CheckReachable", "wrong list of reachable members");
+	}
+	if (count > 0 && p_support.NumActions(infoset) == 0) {
+	  actionsAtActive = false;
+	}
+      }
+    }
+  }
+  if (p_support.HasActiveActionsAtActiveInfosets() != actionsAtActive) {
+    Fail("CheckReachable", "wrong check of actions at active information sets");
+  }
+}
+
+//
+// Removes each set of actions in turn, checking after each removal the
+// activity of nodes and information sets, and the information sets
+// reported as made unreachable
+//
+void TestRemoveActions(void)
+{
+  Game game = MakeGame();
+  Array<GameAction> actions;
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = game->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      for (int act = 1; act <= player->GetInfoset(iset)->NumActions(); act++) {
+	actions.Append(player->GetInfoset(iset)->GetAction(act));
+      }
+    }
+  }
+
+  CheckReachable(BehaviorSupportProfile(game),
+		 Reachable(BehaviorSupportProfile(game)));
+
+  for (int set = 1; set < (1 << actions.Length()); set++) {
+    BehaviorSupportProfile support(game);
+    for (int i = 1; i <= actions.Length(); i++) {
+      if (!(set & (1 << (i - 1))))  continue;
+
+      Array<bool> before = Reachable(support);
+      List<GameInfoset> unreachable;
+      support.RemoveAction(actions[i], unreachable);
+      Array<bool> after = Reachable(support);
+      CheckReachable(support, after);
+
+      for (int pl = 0; pl <= game->NumPlayers(); pl++) {
+	GamePlayer player = (pl == 0) ? game->GetChance() : game->GetPlayer(pl);
+	for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+	  GameInfoset infoset = player->GetInfoset(iset);
+	  int listed = 0;
+	  for (int j = 1; j <= unreachable.Length(); j++) {
+	    if (unreachable[j] == infoset)  listed++;
+	  }
+	  bool lost = (CountReached(infoset, before) > 0 &&
+		       CountReached(infoset, after) == 0);
+	  if (listed != ((lost) ? 1 : 0)) {
+	    Fail("TestRemoveActions",
+		 "wrong list of information sets made unreachable");
+	  }
+	}
+      }
+    }
+  }
+}
+
+}  // end anonymous namespace
+
+int main(void)
+{
+  TestRemoveActions();
+  return (failures == 0) ? 0 : 1;
+}
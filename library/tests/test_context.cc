@@ -0,0 +1,202 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_context.cc
+// Checks the budgets and cancellation of solver contexts
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <sstream>
+
+#include "gambit/gambit.h"
+#include "gambit/nash/lcp.h"
+
+using namespace Gambit;
+using namespace Gambit::Nash;
+
+namespace {
+
+int failures = 0;
+
+void Fail(const char *p_test, const char *p_message)
+{
+  std::cerr << p_test << ": " << p_message << std::endl;
+  failures++;
+}
+
+// A coordination game with three pure and four mixed equilibria
+Game MakeGame(void)
+{
+  std::istringstream file("NFG 1 R \"\" { \"1\" \"2\" } { 3 3 }\n"
+			  "3 3 0 0 0 0 0 0 2 2 0 0 0 0 0 0 1 1\n");
+  return ReadGame(file);
+}
+
+List<MixedStrategyProfile<Rational> >
+Solve(const Game &p_game, const shared_ptr<SolverContext> &p_context)
+{
+  NashLcpStrategySolver<Rational> solver(0, 0);
+  solver.SetContext(p_context);
+  return solver.Solve(p_game);
+}
+
+bool Contains(const List<MixedStrategyProfile<Rational> > &p_profiles,
+	      const MixedStrategyProfile<Rational> &p_profile)
+{
+  for (int i = 1; i <= p_profiles.Length(); i++) {
+    if (static_cast<const Vector<Rational> &>(p_profiles[i]) ==
+	static_cast<const Vector<Rational> &>(p_profile)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void TestIterationLimit(void)
+{
+  Game game = MakeGame();
+  shared_ptr<SolverContext> context(new SolverContext);
+  List<MixedStrategyProfile<Rational> > all = Solve(game, context);
+  long pivots = context->NumIterations();
+  if (context->IsInterrupted() || all.Length() < 2) {
+    Fail("TestIterationLimit", "unlimited solve did not complete");
+    return;
+  }
+
+  // Stopping partway along returns the equilibria found so far, more of
+  // them the larger the budget, and says why
+  int found = 0;
+  bool partial = false;
+  for (long limit = 1; limit < pivots; limit++) {
+    context = new SolverContext;
+    context->SetIterationLimit(limit);
+    List<MixedStrategyProfile<Rational> > some = Solve(game, context);
+    if (context->GetStatus() != SOLVER_ITERATIONS_EXCEEDED) {
+      Fail("TestIterationLimit", "status is not SOLVER_ITERATIONS_EXCEEDED");
+    }
+    if (some.Length() < found) {
+      Fail("TestIterationLimit", "larger budget found fewer equilibria");
+    }
+    for (int i = 1; i <= some.Length(); i++) {
+      if (!Contains(all, some[i])) {
+	Fail("TestIterationLimit", "limited solve returned a non-equilibrium");
+      }
+    }
+    found = some.Length();
+    if (found > 0 && found < all.Length())  partial = true;
+  }
+  if (!partial) {
+    Fail("TestIterationLimit", "no budget stopped the solve partway");
+  }
+
+  // Once exhausted, the context stops every later solve until reset
+  if (Solve(game, context).Length() != 0) {
+    Fail("TestIterationLimit", "exhausted context allowed a solve");
+  }
+  context->Reset();
+  context->SetIterationLimit(0);
+  if (Solve(game, context).Length() != all.Length() ||
+      context->IsInterrupted()) {
+    Fail("TestIterationLimit", "reset context did not complete the solve");
+  }
+}
+
+void TestSharedBudget(void)
+{
+  // The budget is shared among threads: exactly the allowed number of
+  // checks succeed, however they are interleaved
+  const long limit = 1000;
+  SolverContext context;
+  context.SetIterationLimit(limit);
+  long passed = 0;
+#pragma omp parallel for reduction(+:passed)
+  for (int i = 0; i < 10 * limit; i++) {
+    try {
+      context.Check();
+      passed++;
+    }
+    catch (SolverInterrupted &) { }
+  }
+  if (passed != limit) {
+    Fail("TestSharedBudget", "number of checks passed differs from the limit");
+  }
+  if (context.GetStatus() != SOLVER_ITERATIONS_EXCEEDED) {
+    Fail("TestSharedBudget", "status is not SOLVER_ITERATIONS_EXCEEDED");
+  }
+}
+
+void TestDeadline(void)
+{
+  Game game = MakeGame();
+  shared_ptr<SolverContext> context(new SolverContext);
+  context->SetDeadline(Stats::WallClock() - 1.0);
+  if (Solve(game, context).Length() != 0) {
+    Fail("TestDeadline", "solve past the deadline found equilibria");
+  }
+  if (context->GetStatus() != SOLVER_DEADLINE_PASSED) {
+    Fail("TestDeadline", "status is not SOLVER_DEADLINE_PASSED");
+  }
+
+  context = new SolverContext;
+  context->SetTimeLimit(3600.0);
+  Solve(game, context);
+  if (context->IsInterrupted()) {
+    Fail("TestDeadline", "solve was interrupted before the deadline");
+  }
+}
+
+void TestCancellation(void)
+{
+  Game game = MakeGame();
+  shared_ptr<CancellationToken> token(new CancellationToken);
+  shared_ptr<SolverContext> context(new SolverContext);
+  context->SetCancellationToken(token);
+  Solve(game, context);
+  if (context->IsInterrupted()) {
+    Fail("TestCancellation", "solve was interrupted without cancellation");
+  }
+
+  token->Cancel();
+  context->Reset();
+  if (Solve(game, context).Length() != 0) {
+    Fail("TestCancellation", "cancelled solve found equilibria");
+  }
+  if (context->GetStatus() != SOLVER_CANCELLED) {
+    Fail("TestCancellation", "status is not SOLVER_CANCELLED");
+  }
+  try {
+    context->Check();
+    Fail("TestCancellation", "Check() passed after cancellation");
+  }
+  catch (SolverInterrupted &e) {
+    if (e.GetStatus() != SOLVER_CANCELLED) {
+      Fail("TestCancellation", "exception does not carry SOLVER_CANCELLED");
+    }
+  }
+}
+
+}  // end anonymous namespace
+
+int main(void)
+{
+  TestIterationLimit();
+  TestSharedBudget();
+  TestDeadline();
+  TestCancellation();
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_enumpure.cc
+// Checks the best-response sweeps of the pure equilibrium solvers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <sstream>
+
+#include "gambit/gambit.h"
+#include "gambit/nash/enumpure.h"
+
+using namespace Gambit;
+using namespace Gambit::Nash;
+
+namespace {
+
+int failures = 0;
+
+void Fail(const std::string &p_test, const char *p_message)
+{
+  std::cerr << p_test << ": " << p_message << std::endl;
+  failures++;
+}
+
+Game ReadGameText(const std::string &p_text)
+{
+  std::istringstream file(p_text);
+  return ReadGame(file);
+}
+
+int Random(int p_range, unsigned long &p_seed)
+{
+  p_seed = p_seed * 1103515245ul + 12345ul;
+  return (p_seed / 65536) % p_range;
+}
+
+// A game in table form with payoffs drawn from 0..p_range-1; small
+// ranges give ties among best responses, and more equilibria
+Game MakeTableGame(const Array<int> &p_dim, int p_range, unsigned long &p_seed)
+{
+  std::ostringstream text;
+  text << "NFG 1 R \"\" {";
+  for (int pl = 1; pl <= p_dim.Length(); pl++)  text << " \"" << pl << "\"";
+  text << " } {";
+  int size = 1;
+  for (int pl = 1; pl <= p_dim.Length(); pl++) {
+    text << " " << p_dim[pl];
+    size *= p_dim[pl];
+  }
+  text << " }\n";
+  for (int i = 0; i < size * p_dim.Length(); i++) {
+    text << Random(p_range, p_seed) << " ";
+  }
+  text << "\n";
+  return ReadGameText(text.str());
+}
+
+// A tree with a chance move, an information set spanning several nodes,
+// and information sets which are reached only after some choices of
+// player 1
+Game MakeTreeGame(unsigned long &p_seed)
+{
+  std::ostringstream text;
+  text << "EFG 2 R \"\" { \"1\" \"2\" \"3\" }\n\"\"\n"
+       << "p \"\" 1 1 \"\" { \"L\" \"M\" \"R\" } 0\n"
+       << "p \"\" 2 1 \"\" { \"l\" \"r\" } 0\n";
+  int outcome = 0;
+  for (int i = 1; i <= 2; i++) {
+    text << "t \"\" " << ++outcome << " \"\" { " << Random(3, p_seed) << ", "
+	 << Random(3, p_seed) << ", " << Random(3, p_seed) << " }\n";
+  }
+  text << "c \"\" 1 \"\" { \"h\" 1/2 \"t\" 1/2 } 0\n";
+  for (int node = 1; node <= 2; node++) {
+    text << "p \"\" 2 1 \"\" { \"l\" \"r\" } 0\n"
+	 << "p \"\" 3 1 \"\" { \"x\" \"y\" \"z\" } 0\n";
+    for (int i = 1; i <= 3; i++) {
+      text << "t \"\" " << ++outcome << " \"\" { " << Random(3, p_seed) << ", "
+	   << Random(3, p_seed) << ", " << Random(3, p_seed) << " }\n";
+    }
+    text << "t \"\" " << ++outcome << " \"\" { " << Random(3, p_seed) << ", "
+	 << Random(3, p_seed) << ", " << Random(3, p_seed) << " }\n";
+  }
+  text << "p \"\" 1 2 \"\" { \"a\" \"b\" } 0\n";
+  for (int i = 1; i <= 2; i++) {
+    text << "t \"\" " << ++outcome << " \"\" { " << Random(3, p_seed) << ", "
+	 << Random(3, p_seed) << ", " << Random(3, p_seed) << " }\n";
+  }
+  return ReadGameText(text.str());
+}
+
+template <class P>
+bool SameProfiles(const List<P> &p_found, const List<P> &p_expected)
+{
+  if (p_found.Length() != p_expected.Length())  return false;
+  for (int i = 1; i <= p_found.Length(); i++) {
+    if (static_cast<const Vector<Rational> &>(p_found[i]) !=
+	static_cast<const Vector<Rational> &>(p_expected[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//
+// The sweep, on one thread or several, should find the contingencies
+// which pass IsNash(), in the order of StrategyProfileIterator
+//
+void CheckStrategic(const std::string &p_test, const Game &p_game)
+{
+  List<MixedStrategyProfile<Rational> > expected;
+  for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
+    if ((*citer)->IsNash()) {
+      expected.Append((*citer)->ToMixedStrategyProfile());
+    }
+  }
+
+  int threads[3] = { 1, 4, 0 };
+  for (int i = 0; i < 3; i++) {
+    EnumPureStrategySolver solver(0, threads[i]);
+    if (!SameProfiles(solver.Solve(p_game), expected)) {
+      Fail(p_test, "strategic sweep disagrees with IsNash()");
+    }
+  }
+}
+
+//
+// The agent sweep should find the contingencies which pass IsAgentNash(),
+// in the order of BehaviorProfileIterator
+//
+void CheckAgent(const std::string &p_test, const Game &p_game)
+{
+  BehaviorSupportProfile support(p_game);
+  List<MixedBehaviorProfile<Rational> > expected;
+  for (BehaviorProfileIterator citer(support); !citer.AtEnd(); citer++) {
+    if (citer->IsAgentNash()) {
+      expected.Append(citer->ToMixedBehaviorProfile());
+    }
+  }
+
+  int threads[3] = { 1, 4, 0 };
+  for (int i = 0; i < 3; i++) {
+    EnumPureAgentSolver solver(0, threads[i]);
+    if (!SameProfiles(solver.Solve(support), expected)) {
+      Fail(p_test, "agent sweep disagrees with IsAgentNash()");
+    }
+  }
+}
+
+void TestTable(void)
+{
+  unsigned long seed = 1;
+  int dims[6][4] = { { 2, 1, 1, 0 }, { 2, 3, 4, 0 }, { 3, 2, 2, 2 },
+		     { 3, 1, 5, 2 }, { 3, 4, 3, 3 }, { 2, 7, 6, 0 } };
+  for (int d = 0; d < 6; d++) {
+    Array<int> dim(dims[d][0]);
+    for (int pl = 1; pl <= dim.Length(); pl++)  dim[pl] = dims[d][pl];
+    int ranges[3] = { 2, 3, 100 };
+    for (int r = 0; r < 3; r++) {
+      for (int trial = 1; trial <= 5; trial++) {
+	std::ostringstream test;
+	test << "TestTable " << d << " range " << ranges[r] << " #" << trial;
+	CheckStrategic(test.str(), MakeTableGame(dim, ranges[r], seed));
+      }
+    }
+  }
+}
+
+// Enough contingencies that each player's sweep runs over more than one
+// block of lines
+void TestBlocks(void)
+{
+  unsigned long seed = 3;
+  Array<int> dim(14);
+  for (int pl = 1; pl <= dim.Length(); dim[pl++] = 2);
+  CheckStrategic("TestBlocks", MakeTableGame(dim, 2, seed));
+}
+
+void TestTree(void)
+{
+  unsigned long seed = 2;
+  for (int trial = 1; trial <= 20; trial++) {
+    std::ostringstream test;
+    test << "TestTree #" << trial;
+    Game game = MakeTreeGame(seed);
+    CheckStrategic(test.str(), game);
+    CheckAgent(test.str(), game);
+  }
+}
+
+}  // end anonymous namespace
+
+int main(void)
+{
+  TestTable();
+  TestBlocks();
+  TestTree();
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,252 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_exactbasis.cc
+// Checks exact basis solves against the pivoting tableaux
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cmath>
+#include <iostream>
+
+#include "gambit/gambit.h"
+#include "gambit/linalg/tableau.h"
+#include "gambit/linalg/exactbasis.h"
+
+using namespace Gambit;
+using namespace Gambit::linalg;
+
+namespace {
+
+int failures = 0;
+
+void Fail(const char *p_test, const char *p_message)
+{
+  std::cerr << p_test << ": " << p_message << std::endl;
+  failures++;
+}
+
+Matrix<Rational> MakeMatrix(int p_rows, int p_cols, const int *p_entries)
+{
+  Matrix<Rational> A(1, p_rows, 1, p_cols);
+  for (int i = 1; i <= p_rows; i++) {
+    for (int j = 1; j <= p_cols; j++) {
+      A(i, j) = Rational(p_entries[(i - 1) * p_cols + j - 1]);
+    }
+  }
+  return A;
+}
+
+Vector<Rational> MakeVector(int p_length, const int *p_entries)
+{
+  Vector<Rational> v(1, p_length);
+  for (int i = 1; i <= p_length; i++) {
+    v[i] = Rational(p_entries[i - 1]);
+  }
+  return v;
+}
+
+// An arbitrary cost for each label, used to compare dual vectors
+Rational Cost(int p_label)
+{ return Rational(3 * p_label + 7); }
+
+//
+// Pivots the tableau, starting from the slack basis, until its basic
+// variables are the given labels.  The rows in which the labels end up
+// need not match their order in p_labels.  Throws BadPivot if the basis
+// is singular.
+//
+template <class T>
+void PivotTo(TableauInterface<T> &p_tableau, const Array<int> &p_labels)
+{
+  for (int k = p_labels.First(); k <= p_labels.Last(); k++) {
+    if (p_tableau.Member(p_labels[k]))  continue;
+    int outrow = 0;
+    for (int i = p_tableau.MinRow(); i <= p_tableau.MaxRow(); i++) {
+      if (!p_labels.Contains(p_tableau.Label(i)) &&
+	  p_tableau.CanPivot(p_tableau.Label(i), p_labels[k])) {
+	outrow = i;
+	break;
+      }
+    }
+    if (outrow == 0) {
+      throw typename BaseTableau<T>::BadPivot();
+    }
+    p_tableau.Pivot(outrow, p_labels[k]);
+  }
+}
+
+//
+// Solves for the basis given by p_labels with both backends of
+// ExactBasis, and compares the basic solution and dual vector to those
+// of Tableau<Rational> and of Tableau<double>, whose solves use LUdecomp.
+//
+void CheckBasis(const char *p_test, const Matrix<Rational> &A,
+		const Vector<Rational> &b, const Array<int> &p_labels)
+{
+  Vector<Rational> c(A.MinRow(), A.MaxRow());
+  for (int i = c.First(); i <= c.Last(); i++) {
+    c[i] = Cost(p_labels[i]);
+  }
+
+  Vector<Rational> x(A.MinRow(), A.MaxRow()), y(A.MinRow(), A.MaxRow());
+  ExactBasis(A, p_labels, EXACT_MODULAR).Solve(b, x);
+  ExactBasis(A, p_labels, EXACT_MODULAR).SolveT(c, y);
+  Vector<Rational> xr(A.MinRow(), A.MaxRow()), yr(A.MinRow(), A.MaxRow());
+  ExactBasis(A, p_labels, EXACT_RATIONAL).Solve(b, xr);
+  ExactBasis(A, p_labels, EXACT_RATIONAL).SolveT(c, yr);
+  if (x != xr || y != yr) {
+    Fail(p_test, "modular and rational backends disagree");
+  }
+
+  Tableau<Rational> exact(A, b);
+  PivotTo(exact, p_labels);
+  Vector<Rational> xt(A.MinRow(), A.MaxRow()), yt(A.MinRow(), A.MaxRow());
+  Vector<Rational> ct(A.MinRow(), A.MaxRow());
+  exact.BasisVector(xt);
+  for (int i = exact.MinRow(); i <= exact.MaxRow(); i++) {
+    ct[i] = Cost(exact.Label(i));
+  }
+  exact.SolveT(ct, yt);
+
+  Matrix<double> Ad(A.MinRow(), A.MaxRow(), A.MinCol(), A.MaxCol());
+  Vector<double> bd(b.First(), b.Last());
+  for (int i = A.MinRow(); i <= A.MaxRow(); i++) {
+    for (int j = A.MinCol(); j <= A.MaxCol(); j++) {
+      Ad(i, j) = (double) A(i, j);
+    }
+    bd[i] = (double) b[i];
+  }
+  Tableau<double> floating(Ad, bd);
+  PivotTo(floating, p_labels);
+  Vector<double> xd(A.MinRow(), A.MaxRow()), yd(A.MinRow(), A.MaxRow());
+  Vector<double> cd(A.MinRow(), A.MaxRow());
+  floating.BasisVector(xd);
+  for (int i = floating.MinRow(); i <= floating.MaxRow(); i++) {
+    cd[i] = (double) Cost(floating.Label(i));
+  }
+  floating.SolveT(cd, yd);
+
+  for (int i = p_labels.First(); i <= p_labels.Last(); i++) {
+    int label = p_labels[i];
+    if (x[i] != xt[exact.Find(label)]) {
+      Fail(p_test, "basic solution differs from Tableau<Rational>");
+    }
+    if (std::fabs((double) x[i] - xd[floating.Find(label)]) > 1.0e-9) {
+      Fail(p_test, "basic solution differs from Tableau<double>");
+    }
+    if (y[i] != yt[i]) {
+      Fail(p_test, "dual vector differs from Tableau<Rational>");
+    }
+    if (std::fabs((double) y[i] - yd[i]) > 1.0e-9) {
+      Fail(p_test, "dual vector differs from Tableau<double>");
+    }
+  }
+}
+
+void TestSmallBases(void)
+{
+  const int a[] = { 2, 1, 0, 1,
+		    1, 3, 1, -2,
+		    0, 1, 4, 5 };
+  const int b[] = { 1, 2, 3 };
+  Matrix<Rational> A = MakeMatrix(3, 4, a);
+  Vector<Rational> rhs = MakeVector(3, b);
+
+  const int bases[][3] = { { 1, 2, 3 }, { 3, -2, 1 }, { -1, 4, 2 },
+			   { 4, 3, -3 }, { -1, -2, -3 } };
+  for (int k = 0; k < 5; k++) {
+    Array<int> labels(3);
+    for (int i = 1; i <= 3; i++)  labels[i] = bases[k][i - 1];
+    CheckBasis("TestSmallBases", A, rhs, labels);
+  }
+}
+
+void TestLargeEntries(void)
+{
+  // Entries large enough that the solution needs several primes
+  const int a[] = { 1000003, -999983, 65537, 7,
+		    -524287, 1000033, 131071, -11,
+		    8191, 2147, -1000037, 13,
+		    104729, -7919, 15485863, 1000039 };
+  const int b[] = { 999999, -123457, 314159, 271828 };
+  Matrix<Rational> A = MakeMatrix(4, 4, a);
+  Vector<Rational> rhs = MakeVector(4, b);
+  Array<int> labels(4);
+  for (int i = 1; i <= 4; i++)  labels[i] = i;
+  CheckBasis("TestLargeEntries", A, rhs, labels);
+
+  SquareMatrix<Rational> M(4);
+  Vector<Rational> r(4), x(4);
+  for (int i = 1; i <= 4; i++) {
+    for (int j = 1; j <= 4; j++)  M(i, j) = A(i, j);
+    r[i] = rhs[i];
+  }
+  ModularSolve(M, r, x);
+  if (x != M.Inverse() * r) {
+    Fail("TestLargeEntries", "ModularSolve differs from the inverse");
+  }
+}
+
+void TestSingular(void)
+{
+  // The second column is twice the first
+  const int a[] = { 1, 2, 0,
+		    2, 4, 1,
+		    3, 6, 5 };
+  const int b[] = { 1, 1, 1 };
+  Matrix<Rational> A = MakeMatrix(3, 3, a);
+  Vector<Rational> rhs = MakeVector(3, b);
+  Array<int> labels(3);
+  labels[1] = 1;  labels[2] = 2;  labels[3] = -3;
+
+  SquareMatrix<Rational> M(3);
+  for (int i = 1; i <= 3; i++) {
+    for (int j = 1; j <= 3; j++)  M(i, j) = A(i, j);
+  }
+  Vector<Rational> x(3);
+  try {
+    ModularSolve(M, rhs, x);
+    Fail("TestSingular", "ModularSolve accepted a singular matrix");
+  }
+  catch (SingularMatrixException &) { }
+
+  for (int backend = EXACT_RATIONAL; backend <= EXACT_MODULAR; backend++) {
+    try {
+      ExactBasis(A, labels, (ExactBackend) backend).Solve(rhs, x);
+      Fail("TestSingular", "ExactBasis accepted a singular basis");
+    }
+    catch (SingularMatrixException &) { }
+  }
+
+  Tableau<Rational> exact(A, rhs);
+  try {
+    PivotTo(exact, labels);
+    Fail("TestSingular", "Tableau<Rational> pivoted to a singular basis");
+  }
+  catch (BaseTableau<Rational>::BadPivot &) { }
+}
+
+}  // end anonymous namespace
+
+int main(void)
+{
+  TestSmallBases();
+  TestLargeEntries();
+  TestSingular();
+  return (failures == 0) ? 0 : 1;
+}
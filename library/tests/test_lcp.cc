@@ -0,0 +1,203 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_lcp.cc
+// Checks the float-guided exact mode of the strategic LCP solver
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <sstream>
+
+#include "gambit/gambit.h"
+#include "gambit/nash/lcp.h"
+
+using namespace Gambit;
+using namespace Gambit::Nash;
+
+namespace {
+
+int failures = 0;
+
+void Fail(const std::string &p_test, const char *p_message)
+{
+  std::cerr << p_test << ": " << p_message << std::endl;
+  failures++;
+}
+
+Game ReadGameText(const std::string &p_text)
+{
+  std::istringstream file(p_text);
+  return ReadGame(file);
+}
+
+// A bimatrix game with payoffs drawn from 0..p_range-1; small ranges
+// give degenerate games
+Game MakeRandomGame(int p_rows, int p_cols, int p_range, unsigned long &p_seed)
+{
+  std::ostringstream text;
+  text << "NFG 1 R \"\" { \"1\" \"2\" } { " << p_rows << " " << p_cols << " }\n";
+  for (int i = 0; i < 2 * p_rows * p_cols; i++) {
+    p_seed = p_seed * 1103515245ul + 12345ul;
+    text << (p_seed / 65536) % p_range << " ";
+  }
+  text << "\n";
+  return ReadGameText(text.str());
+}
+
+// A coordination game with three pure and four mixed equilibria
+Game MakeCoordinationGame(void)
+{
+  return ReadGameText("NFG 1 R \"\" { \"1\" \"2\" } { 3 3 }\n"
+		      "3 3 0 0 0 0 0 0 2 2 0 0 0 0 0 0 1 1\n");
+}
+
+// A small extensive game, solved through its strategic form
+Game MakeTreeGame(void)
+{
+  return ReadGameText("EFG 2 R \"\" { \"1\" \"2\" }\n\"\"\n"
+		      "p \"\" 1 1 \"\" { \"L\" \"R\" } 0\n"
+		      "p \"\" 2 1 \"\" { \"l\" \"r\" } 0\n"
+		      "p \"\" 1 2 \"\" { \"a\" \"b\" } 0\n"
+		      "t \"\" 1 \"\" { 3, 1 }\n"
+		      "t \"\" 2 \"\" { 0, 2 }\n"
+		      "t \"\" 3 \"\" { 1, 3 }\n"
+		      "p \"\" 2 1 \"\" { \"l\" \"r\" } 0\n"
+		      "t \"\" 4 \"\" { 2, 0 }\n"
+		      "p \"\" 1 3 \"\" { \"c\" \"d\" } 0\n"
+		      "t \"\" 5 \"\" { 0, 1 }\n"
+		      "t \"\" 6 \"\" { 2, 2 }\n");
+}
+
+// von Stengel's 6x6 game with 75 equilibria, on which the
+// floating-point paths cycle
+Game MakeStengelGame(void)
+{
+  return ReadGameText("NFG 1 R \"\" { \"1\" \"2\" } { 6 6 }\n"
+		      "9504 72336 -111771 -461736 397584 1227336 171204 "
+		      "-1718376 1303104 1303104 737154 -453420 -660 48081 "
+		      "31680 -300036 -113850 774576 -45936 -1039236 -453420 "
+		      "737154 -227040 -227040 19976 29216 -130944 -178761 "
+		      "451176 451176 208626 -586476 1227336 397584 774576 "
+		      "-113850 -20526 14124 168124 -84436 -586476 208626 "
+		      "-263076 -263076 -1718376 171204 -1039236 -45936 1776 "
+		      "1776 -8514 -8976 29216 19976 14124 -20526 72336 9504 "
+		      "48081 -660 -8976 -8514 52764 52764 -178761 -130944 "
+		      "-84436 168124 -461736 -111771 -300036 31680\n");
+}
+
+//
+// Checks that the hybrid mode finds the same equilibria, in the same
+// order, as exact pivoting.  Returns the number of pivots the hybrid
+// mode made in excess of exact pivoting: none when its floating-point
+// paths are certified, and those of the abandoned paths when it falls
+// back to exact pivoting.  (Always zero if statistics are compiled out.)
+//
+long CheckSame(const std::string &p_test, const Game &p_game,
+	       int p_stopAfter, int p_maxDepth)
+{
+  NashLcpStrategySolver<Rational> exact(p_stopAfter, p_maxDepth);
+  NashLcpStrategySolver<Rational> hybrid(p_stopAfter, p_maxDepth, 0, true);
+  Stats::Reset();
+  List<MixedStrategyProfile<Rational> > expected = exact.Solve(p_game);
+  long exactPivots = Stats::GetCount(Stats::PIVOTS);
+  Stats::Reset();
+  List<MixedStrategyProfile<Rational> > found = hybrid.Solve(p_game);
+  long excess = Stats::GetCount(Stats::PIVOTS) - exactPivots;
+
+  if (expected.Length() == 0) {
+    Fail(p_test, "exact pivoting found no equilibrium");
+  }
+  if (found.Length() != expected.Length()) {
+    Fail(p_test, "hybrid mode found a different number of equilibria");
+    return excess;
+  }
+  for (int i = 1; i <= found.Length(); i++) {
+    if (static_cast<const Vector<Rational> &>(found[i]) !=
+	static_cast<const Vector<Rational> &>(expected[i])) {
+      Fail(p_test, "hybrid mode found a different equilibrium");
+    }
+  }
+  return excess;
+}
+
+void TestCoordination(void)
+{
+  CheckSame("TestCoordination", MakeCoordinationGame(), 0, 0);
+  CheckSame("TestCoordination", MakeCoordinationGame(), 1, 0);
+  CheckSame("TestCoordination", MakeCoordinationGame(), 0, 1);
+}
+
+void TestTree(void)
+{
+  CheckSame("TestTree", MakeTreeGame(), 0, 0);
+  CheckSame("TestTree", MakeTreeGame(), 1, 0);
+}
+
+void TestRandom(void)
+{
+  unsigned long seed = 1;
+  int guided = 0;
+  for (int size = 2; size <= 6; size++) {
+    for (int trial = 1; trial <= 10; trial++) {
+      std::ostringstream test;
+      test << "TestRandom " << size << "x" << size + 1 << " #" << trial;
+      if (CheckSame(test.str(), MakeRandomGame(size, size + 1, 100, seed),
+		    0, 0) == 0) {
+	guided++;
+      }
+    }
+  }
+  // The floating-point paths are all sound on games in general position
+  if (guided != 50) {
+    Fail("TestRandom", "hybrid mode fell back to exact pivoting");
+  }
+}
+
+void TestDegenerate(void)
+{
+  unsigned long seed = 2;
+  for (int size = 2; size <= 5; size++) {
+    for (int trial = 1; trial <= 10; trial++) {
+      std::ostringstream test;
+      test << "TestDegenerate " << size << "x" << size << " #" << trial;
+      CheckSame(test.str(), MakeRandomGame(size, size, 3, seed), 0, 0);
+    }
+  }
+}
+
+void TestFallback(void)
+{
+  long excess = CheckSame("TestFallback", MakeStengelGame(), 0, 0);
+#ifndef GAMBIT_NO_STATS
+  if (excess == 0) {
+    Fail("TestFallback", "hybrid mode did not fall back to exact pivoting");
+  }
+#endif  // GAMBIT_NO_STATS
+}
+
+}  // end anonymous namespace
+
+int main(void)
+{
+  TestCoordination();
+  TestTree();
+  TestRandom();
+  TestDegenerate();
+  TestFallback();
+  return (failures == 0) ? 0 : 1;
+}
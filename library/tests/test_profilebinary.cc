@@ -0,0 +1,236 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_profilebinary.cc
+// Checks that the binary profile renderers and reader agree
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+#include "gambit/gambit.h"
+#include "gambit/nash.h"
+
+using namespace Gambit;
+using namespace Gambit::Nash;
+
+namespace {
+
+int failures = 0;
+
+void Fail(const char *p_test, const char *p_message)
+{
+  std::cerr << p_test << ": " << p_message << std::endl;
+  failures++;
+}
+
+Game ReadGameText(const std::string &p_text)
+{
+  std::istringstream file(p_text);
+  return ReadGame(file);
+}
+
+bool SameProbs(const Vector<Rational> &p_profile, const Array<Rational> &p_probs)
+{
+  if (p_profile.Length() != p_probs.Length())  return false;
+  for (int i = 1; i <= p_probs.Length(); i++) {
+    if (p_profile[i] != p_probs[i])  return false;
+  }
+  return true;
+}
+
+Game MakeStrategicGame(void)
+{
+  return ReadGameText("NFG 1 R \"\" { \"1\" \"2\" } { 2 3 }\n"
+		      "1 1 0 0 0 0 1 1 2 2 0 0\n");
+}
+
+Game MakeTreeGame(void)
+{
+  return ReadGameText("EFG 2 R \"\" { \"1\" \"2\" }\n\"\"\n"
+		      "p \"\" 1 1 \"\" { \"L\" \"R\" } 0\n"
+		      "p \"\" 2 1 \"\" { \"l\" \"r\" } 0\n"
+		      "t \"\" 1 \"\" { 1, 1 }\n"
+		      "t \"\" 2 \"\" { 0, 2 }\n"
+		      "p \"\" 2 1 \"\" { \"l\" \"r\" } 0\n"
+		      "t \"\" 3 \"\" { 2, 0 }\n"
+		      "t \"\" 4 \"\" { 3, 3 }\n");
+}
+
+void TestMixedRational(void)
+{
+  Game game = MakeStrategicGame();
+  MixedStrategyProfile<Rational> first(game->NewMixedStrategyProfile(Rational(0)));
+  MixedStrategyProfile<Rational> second(game->NewMixedStrategyProfile(Rational(0)));
+  // The last probability of the first profile needs the text form, as
+  // its denominator does not fit in 64 bits
+  const Rational big = lexical_cast<Rational>(std::string("1/1180591620717411303424"));
+  for (int i = 1; i <= first.MixedProfileLength(); i++) {
+    first[i] = Rational(i, 7);
+    second[i] = Rational(-i, 3);
+  }
+  first[first.MixedProfileLength()] = big;
+
+  std::stringstream stream;
+  MixedStrategyBinaryRenderer<Rational> renderer(stream);
+  renderer.Render(first);
+  renderer.Render(second, "candidate");
+
+  ProfileBinaryReader<Rational> reader(stream);
+  if (reader.IsBehavior()) {
+    Fail("TestMixedRational", "stream reports behavior profiles");
+  }
+  std::string label;
+  Array<Rational> probs;
+  if (!reader.Next(label, probs) || label != "NE" ||
+      !SameProbs(first, probs)) {
+    Fail("TestMixedRational", "first profile differs");
+  }
+  if (!reader.Next(label, probs) || label != "candidate" ||
+      !SameProbs(second, probs)) {
+    Fail("TestMixedRational", "second profile differs");
+  }
+  if (reader.Next(label, probs)) {
+    Fail("TestMixedRational", "stream has more profiles than written");
+  }
+}
+
+void TestMixedDouble(void)
+{
+  Game game = MakeStrategicGame();
+  MixedStrategyProfile<double> profile(game->NewMixedStrategyProfile(0.0));
+  for (int i = 1; i <= profile.MixedProfileLength(); i++) {
+    profile[i] = 1.0 / (i + 2.0);
+  }
+
+  std::stringstream stream;
+  MixedStrategyBinaryRenderer<double> renderer(stream);
+  renderer.Render(profile);
+  std::string data = stream.str();
+
+  // Doubles are read back bit for bit
+  std::istringstream input(data);
+  List<MixedStrategyProfile<double> > profiles =
+    ProfileBinaryReader<double>(input).ReadMixed(game);
+  if (profiles.Length() != 1 ||
+      static_cast<const Vector<double> &>(profiles[1]) !=
+      static_cast<const Vector<double> &>(profile)) {
+    Fail("TestMixedDouble", "profile differs");
+  }
+
+  // A stream of doubles may be read as rationals, to within the precision
+  // of the conversion
+  std::istringstream again(data);
+  List<MixedStrategyProfile<Rational> > exact =
+    ProfileBinaryReader<Rational>(again).ReadMixed(game);
+  if (exact.Length() != 1) {
+    Fail("TestMixedDouble", "stream read as rationals has no profile");
+  }
+  else {
+    for (int i = 1; i <= profile.MixedProfileLength(); i++) {
+      if (std::fabs((double) exact[1][i] - profile[i]) > 1.0e-9) {
+	Fail("TestMixedDouble", "profile read as rationals differs");
+      }
+    }
+  }
+
+  // Reading a mixed strategy stream as behavior profiles is an error
+  std::istringstream wrong(data);
+  try {
+    ProfileBinaryReader<double>(wrong).ReadBehav(MakeTreeGame());
+    Fail("TestMixedDouble", "mixed strategy stream read as behavior profiles");
+  }
+  catch (InvalidFileException &) { }
+}
+
+void TestBehavior(void)
+{
+  Game game = MakeTreeGame();
+  MixedBehaviorProfile<Rational> profile(game);
+  for (int i = 1; i <= profile.Length(); i++) {
+    profile[i] = Rational(i, 5);
+  }
+
+  std::stringstream stream;
+  BehavStrategyBinaryRenderer<Rational> renderer(stream);
+  renderer.Render(profile);
+
+  ProfileBinaryReader<Rational> reader(stream);
+  if (!reader.IsBehavior()) {
+    Fail("TestBehavior", "stream reports mixed strategy profiles");
+  }
+  List<MixedBehaviorProfile<Rational> > profiles = reader.ReadBehav(game);
+  if (profiles.Length() != 1 ||
+      static_cast<const Vector<Rational> &>(profiles[1]) !=
+      static_cast<const Vector<Rational> &>(profile)) {
+    Fail("TestBehavior", "profile differs");
+  }
+}
+
+void TestInvalid(void)
+{
+  Game game = MakeStrategicGame();
+
+  // A renderer which renders nothing still writes a valid stream
+  std::stringstream empty;
+  MixedStrategyBinaryRenderer<double> renderer(empty);
+  if (ProfileBinaryReader<double>(empty).ReadMixed(game).Length() != 0) {
+    Fail("TestInvalid", "empty stream has profiles");
+  }
+
+  std::istringstream text("NE,1,0,0,1,0\n");
+  try {
+    ProfileBinaryReader<double> reader(text);
+    Fail("TestInvalid", "text output read as a binary stream");
+  }
+  catch (InvalidFileException &) { }
+
+  // A stream which ends part way through a profile
+  MixedStrategyProfile<double> profile(game->NewMixedStrategyProfile(0.0));
+  std::stringstream stream;
+  MixedStrategyBinaryRenderer<double> full(stream);
+  full.Render(profile);
+  std::string data = stream.str();
+  std::istringstream truncated(data.substr(0, data.length() - 3));
+  try {
+    ProfileBinaryReader<double>(truncated).ReadMixed(game);
+    Fail("TestInvalid", "truncated stream was read");
+  }
+  catch (InvalidFileException &) { }
+
+  // A stream of profiles on another game
+  std::istringstream other(data);
+  try {
+    ProfileBinaryReader<double>(other).ReadMixed(ReadGameText(
+      "NFG 1 R \"\" { \"1\" \"2\" } { 2 2 }\n1 1 0 0 0 0 1 1\n"));
+    Fail("TestInvalid", "profile read on a game of another size");
+  }
+  catch (InvalidFileException &) { }
+}
+
+}  // end anonymous namespace
+
+int main(void)
+{
+  TestMixedRational();
+  TestMixedDouble();
+  TestBehavior();
+  TestInvalid();
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,432 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_subgame.cc
+// Checks the solution of games by backward induction on subgames
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <sstream>
+
+#include "gambit/gambit.h"
+#include "gambit/nash/enumpure.h"
+#include "gambit/nash/lcp.h"
+#include "tools/lp/efglp.h"
+
+using namespace Gambit;
+using namespace Gambit::Nash;
+
+namespace {
+
+int failures = 0;
+
+void Fail(const std::string &p_test, const char *p_message)
+{
+  std::cerr << p_test << ": " << p_message << std::endl;
+  failures++;
+}
+
+Game ReadGameText(const std::string &p_text)
+{
+  std::istringstream file(p_text);
+  return ReadGame(file);
+}
+
+int Random(int p_range, unsigned long &p_seed)
+{
+  p_seed = p_seed * 1103515245ul + 12345ul;
+  return (p_seed / 65536) % p_range;
+}
+
+//
+// The text of a subgame in which player 1 chooses a or b, and then
+// player 2 chooses c or d without knowing player 1's choice.  The
+// payoffs to the two players are given for ac, ad, bc and bd in turn.
+// If p_inner is not empty, it is the subgame reached by bd instead.
+// The information sets and outcomes used are numbered on from the
+// counts given.
+//
+std::string SubgameText(const Array<int> &p_payoffs, const std::string &p_inner,
+			int &p_infoset1, int &p_infoset2, int &p_outcome)
+{
+  std::ostringstream text;
+  int infoset2 = ++p_infoset2;
+  text << "p \"\" 1 " << ++p_infoset1 << " \"\" { \"a\" \"b\" } 0\n";
+  for (int i = 0; i < 4; i++) {
+    if (i % 2 == 0) {
+      text << "p \"\" 2 " << infoset2 << " \"\" { \"c\" \"d\" } 0\n";
+    }
+    if (i == 3 && !p_inner.empty()) {
+      text << p_inner;
+    }
+    else {
+      text << "t \"\" " << ++p_outcome << " \"\" { "
+	   << p_payoffs[2 * i + 1] << ", " << p_payoffs[2 * i + 2] << " }\n";
+    }
+  }
+  return text.str();
+}
+
+Array<int> RandomPayoffs(int p_range, unsigned long &p_seed)
+{
+  Array<int> payoffs(8);
+  for (int i = 1; i <= 8; payoffs[i++] = Random(p_range, p_seed));
+  return payoffs;
+}
+
+// The text of a game in which player 1 first chooses among the subgames
+std::string GameText(const Array<std::string> &p_subgames)
+{
+  std::ostringstream text;
+  text << "EFG 2 R \"\" { \"1\" \"2\" }\n\"\"\n"
+       << "p \"\" 1 1 \"\" {";
+  for (int i = 1; i <= p_subgames.Length(); i++) {
+    text << " \"s" << i << "\"";
+  }
+  text << " } 0\n";
+  for (int i = 1; i <= p_subgames.Length(); i++) {
+    text << p_subgames[i];
+  }
+  return text.str();
+}
+
+// The payoffs of the subgame after a positive affine transformation of
+// each player's payoffs, which keeps a game with constant sum 4
+// constant-sum
+Array<int> Rescale(const Array<int> &p_payoffs)
+{
+  Array<int> payoffs(p_payoffs);
+  for (int i = 1; i <= 8; i += 2) {
+    payoffs[i] = 2 * payoffs[i] - 1;
+    payoffs[i + 1] = 2 * payoffs[i + 1] - 3;
+  }
+  return payoffs;
+}
+
+//
+// A game of six subgames: four copies of a game, one of them rescaled,
+// and two copies of another.  The subgames all have constant sum 4, and
+// each has a unique equilibrium, in mixed strategies.
+//
+Game MakeRepeatedGame(void)
+{
+  int first[8] = { 3, 1, 0, 4, 1, 3, 2, 2 };
+  int second[8] = { 0, 4, 4, 0, 3, 1, 1, 3 };
+  Array<int> payoffs1(8), payoffs2(8);
+  for (int i = 1; i <= 8; i++) {
+    payoffs1[i] = first[i - 1];
+    payoffs2[i] = second[i - 1];
+  }
+  Array<std::string> subgames;
+  int infoset1 = 1, infoset2 = 0, outcome = 0;
+  subgames.push_back(SubgameText(payoffs1, "", infoset1, infoset2, outcome));
+  subgames.push_back(SubgameText(payoffs2, "", infoset1, infoset2, outcome));
+  subgames.push_back(SubgameText(payoffs1, "", infoset1, infoset2, outcome));
+  subgames.push_back(SubgameText(Rescale(payoffs1), "",
+				 infoset1, infoset2, outcome));
+  subgames.push_back(SubgameText(payoffs2, "", infoset1, infoset2, outcome));
+  subgames.push_back(SubgameText(payoffs1, "", infoset1, infoset2, outcome));
+  return ReadGameText(GameText(subgames));
+}
+
+// A game of p_count random subgames, of which every other one has
+// another subgame nested in it
+Game MakeNestedGame(int p_count, int p_range, unsigned long &p_seed)
+{
+  Array<std::string> subgames;
+  int infoset1 = 1, infoset2 = 0, outcome = 0;
+  for (int i = 1; i <= p_count; i++) {
+    std::string inner;
+    if (i % 2 == 0) {
+      inner = SubgameText(RandomPayoffs(p_range, p_seed), "",
+			  infoset1, infoset2, outcome);
+    }
+    subgames.push_back(SubgameText(RandomPayoffs(p_range, p_seed), inner,
+				   infoset1, infoset2, outcome));
+  }
+  return ReadGameText(GameText(subgames));
+}
+
+template <class T>
+bool SameProfiles(const List<MixedBehaviorProfile<T> > &p_found,
+		  const List<MixedBehaviorProfile<T> > &p_expected)
+{
+  if (p_found.Length() != p_expected.Length())  return false;
+  for (int i = 1; i <= p_found.Length(); i++) {
+    if (static_cast<const Vector<T> &>(p_found[i]) !=
+	static_cast<const Vector<T> &>(p_expected[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//
+// Each subgame is extracted as a game of its own and solved by the
+// stage solver.  The part of each equilibrium of the whole game in a
+// subgame should be one of the equilibria the stage solver finds when
+// given that subgame alone, and each of these should be used.
+//
+void TestExtraction(void)
+{
+  unsigned long seed = 1;
+  shared_ptr<BehavSolver<Rational> > stage(new NashLcpBehaviorSolver<Rational>(0, 0));
+  for (int trial = 1; trial <= 5; trial++) {
+    std::ostringstream test;
+    test << "TestExtraction #" << trial;
+
+    Array<std::string> subgames;
+    List<List<MixedBehaviorProfile<Rational> > > alone;
+    int infoset1 = 1, infoset2 = 0, outcome = 0;
+    for (int i = 1; i <= 3; i++) {
+      Array<int> payoffs = RandomPayoffs(10, seed);
+      subgames.push_back(SubgameText(payoffs, "",
+				     infoset1, infoset2, outcome));
+      int aloneInfoset1 = 0, aloneInfoset2 = 0, aloneOutcome = 0;
+      Game game = ReadGameText("EFG 2 R \"\" { \"1\" \"2\" }\n\"\"\n" +
+			       SubgameText(payoffs, "", aloneInfoset1,
+					   aloneInfoset2, aloneOutcome));
+      alone.push_back(stage->Solve(BehaviorSupportProfile(game)));
+    }
+
+    Game game = ReadGameText(GameText(subgames));
+    SubgameBehavSolver<Rational> solver(stage);
+    List<MixedBehaviorProfile<Rational> > solutions =
+      solver.Solve(BehaviorSupportProfile(game));
+    if (solutions.Length() == 0) {
+      Fail(test.str(), "no equilibrium found");
+    }
+    for (int i = 1; i <= solutions.Length(); i++) {
+      if (solutions[i].GetLiapValue() != Rational(0)) {
+	Fail(test.str(), "solution is not an equilibrium");
+      }
+    }
+
+    for (int sg = 1; sg <= 3; sg++) {
+      GameInfoset infoset1 = game->GetPlayer(1)->GetInfoset(sg + 1);
+      GameInfoset infoset2 = game->GetPlayer(2)->GetInfoset(sg);
+      Array<bool> used(alone[sg].Length());
+      for (int j = 1; j <= used.Length(); used[j++] = false);
+      for (int i = 1; i <= solutions.Length(); i++) {
+	bool found = false;
+	for (int j = 1; j <= alone[sg].Length(); j++) {
+	  const MixedBehaviorProfile<Rational> &profile = alone[sg][j];
+	  GameInfoset aloneInfoset1 = profile.GetGame()->GetPlayer(1)->GetInfoset(1);
+	  GameInfoset aloneInfoset2 = profile.GetGame()->GetPlayer(2)->GetInfoset(1);
+	  bool same = true;
+	  for (int act = 1; act <= 2; act++) {
+	    same = same &&
+	      solutions[i](infoset1->GetAction(act)) == profile(aloneInfoset1->GetAction(act)) &&
+	      solutions[i](infoset2->GetAction(act)) == profile(aloneInfoset2->GetAction(act));
+	  }
+	  if (same) {
+	    found = used[j] = true;
+	  }
+	}
+	if (!found) {
+	  Fail(test.str(), "solution does not match the subgame solved alone");
+	}
+      }
+      for (int j = 1; j <= used.Length(); j++) {
+	if (!used[j]) {
+	  Fail(test.str(), "equilibrium of a subgame is not used");
+	}
+      }
+    }
+  }
+}
+
+//
+// Subgames which do not contain one another are solved concurrently;
+// the solutions should not depend on the number of threads.  Returns
+// the number of equilibria found.
+//
+template <class T>
+int CheckThreads(const std::string &p_test, const Game &p_game,
+		 shared_ptr<BehavSolver<T> > p_stage)
+{
+  List<MixedBehaviorProfile<T> > expected =
+    SubgameBehavSolver<T>(p_stage).Solve(BehaviorSupportProfile(p_game));
+  int threads[2] = { 4, 0 };
+  for (int i = 0; i < 2; i++) {
+    SubgameBehavSolver<T> solver(p_stage, 0, threads[i]);
+    if (!SameProfiles(solver.Solve(BehaviorSupportProfile(p_game)), expected)) {
+      Fail(p_test, "solutions depend on the number of threads");
+    }
+  }
+  return expected.Length();
+}
+
+void TestThreads(void)
+{
+  unsigned long seed = 2;
+  shared_ptr<BehavSolver<Rational> > lcp(new NashLcpBehaviorSolver<Rational>(0, 0));
+  shared_ptr<BehavSolver<Rational> > enumpure(new EnumPureAgentSolver());
+  // Not all of the games have pure equilibria
+  int pure = 0;
+  for (int trial = 1; trial <= 6; trial++) {
+    std::ostringstream test;
+    test << "TestThreads #" << trial;
+    Game game = MakeNestedGame(4, 4, seed);
+    if (CheckThreads(test.str(), game, lcp) == 0) {
+      Fail(test.str(), "no equilibrium found");
+    }
+    pure += CheckThreads(test.str(), game, enumpure);
+  }
+  if (pure == 0) {
+    Fail("TestThreads", "no pure equilibrium found");
+  }
+}
+
+// Passes each game on to another solver, counting the games
+template <class T> class CountingSolver : public BehavSolver<T> {
+public:
+  CountingSolver(shared_ptr<BehavSolver<T> > p_solver)
+    : m_solver(p_solver), m_count(0) { }
+  virtual ~CountingSolver() { }
+
+  virtual List<MixedBehaviorProfile<T> > Solve(const BehaviorSupportProfile &p_support) const
+  {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif  // _OPENMP
+    m_count++;
+    return m_solver->Solve(p_support);
+  }
+
+  int NumSolved(void) const { return m_count; }
+
+private:
+  shared_ptr<BehavSolver<T> > m_solver;
+  mutable int m_count;
+};
+
+//
+// Subgames which differ only by rescaling payoffs are solved once when
+// equilibria are reused, and the solutions are the same as when every
+// subgame is solved
+//
+void TestReuse(void)
+{
+  Game game = MakeRepeatedGame();
+  shared_ptr<BehavSolver<Rational> > lcp(new NashLcpBehaviorSolver<Rational>(0, 0));
+  CountingSolver<Rational> *counter = new CountingSolver<Rational>(lcp);
+  shared_ptr<BehavSolver<Rational> > stage(counter);
+
+  List<MixedBehaviorProfile<Rational> > expected =
+    SubgameBehavSolver<Rational>(stage, 0, 1, false).Solve(BehaviorSupportProfile(game));
+  // The six subgames, then the choice among them
+  if (counter->NumSolved() != 7) {
+    Fail("TestReuse", "subgames were not all solved without reuse");
+  }
+  if (expected.Length() == 0) {
+    Fail("TestReuse", "no equilibrium found");
+  }
+
+  int threads[2] = { 1, 4 };
+  for (int i = 0; i < 2; i++) {
+    counter = new CountingSolver<Rational>(lcp);
+    stage = counter;
+    SubgameBehavSolver<Rational> solver(stage, 0, threads[i], true);
+    if (!SameProfiles(solver.Solve(BehaviorSupportProfile(game)), expected)) {
+      Fail("TestReuse", "solutions differ when equilibria are reused");
+    }
+    // One subgame of each kind, then the choice among them
+    if (counter->NumSolved() != 3) {
+      Fail("TestReuse", "equilibria were not reused");
+    }
+  }
+
+  // With repeated random subgames, some having several equilibria
+  unsigned long seed = 3;
+  for (int trial = 1; trial <= 5; trial++) {
+    std::ostringstream test;
+    test << "TestReuse #" << trial;
+    Array<int> payoffs1 = RandomPayoffs(4, seed);
+    Array<int> payoffs2 = RandomPayoffs(4, seed);
+    Array<std::string> subgames;
+    int infoset1 = 1, infoset2 = 0, outcome = 0;
+    subgames.push_back(SubgameText(payoffs1, "", infoset1, infoset2, outcome));
+    subgames.push_back(SubgameText(payoffs2, "", infoset1, infoset2, outcome));
+    subgames.push_back(SubgameText(payoffs1, "", infoset1, infoset2, outcome));
+    subgames.push_back(SubgameText(payoffs2, "", infoset1, infoset2, outcome));
+    Game random = ReadGameText(GameText(subgames));
+    List<MixedBehaviorProfile<Rational> > all =
+      SubgameBehavSolver<Rational>(lcp, 0, 1, false).Solve(BehaviorSupportProfile(random));
+    List<MixedBehaviorProfile<Rational> > reused =
+      SubgameBehavSolver<Rational>(lcp, 0, 1, true).Solve(BehaviorSupportProfile(random));
+    if (!SameProfiles(reused, all)) {
+      Fail(test.str(), "solutions differ when equilibria are reused");
+    }
+  }
+}
+
+//
+// The linear programming solver is correct only for constant-sum games,
+// so gambit-lp does not reuse its equilibria for rescaled subgames.  The
+// rescaled subgame is then solved by the LP itself.
+//
+void TestNoReuse(void)
+{
+  Game game = MakeRepeatedGame();
+  shared_ptr<BehavSolver<Rational> > lp(new NashLpBehavSolver<Rational>());
+  CountingSolver<Rational> *counter = new CountingSolver<Rational>(lp);
+  shared_ptr<BehavSolver<Rational> > stage(counter);
+  List<MixedBehaviorProfile<Rational> > solutions =
+    SubgameBehavSolver<Rational>(stage, 0, 1, false).Solve(BehaviorSupportProfile(game));
+  if (counter->NumSolved() != 7) {
+    Fail("TestNoReuse", "subgames were not all solved by the LP");
+  }
+  if (solutions.Length() != 1) {
+    Fail("TestNoReuse", "LP did not find one equilibrium");
+    return;
+  }
+
+  int infoset1 = 0, infoset2 = 0, outcome = 0;
+  int first[8] = { 3, 1, 0, 4, 1, 3, 2, 2 };
+  Array<int> payoffs(8);
+  for (int i = 1; i <= 8; i++)  payoffs[i] = first[i - 1];
+  Game alone = ReadGameText("EFG 2 R \"\" { \"1\" \"2\" }\n\"\"\n" +
+			    SubgameText(Rescale(payoffs), "",
+					infoset1, infoset2, outcome));
+  List<MixedBehaviorProfile<Rational> > expected =
+    NashLpBehavSolver<Rational>().Solve(BehaviorSupportProfile(alone));
+  if (expected.Length() != 1) {
+    Fail("TestNoReuse", "LP did not solve the rescaled subgame alone");
+    return;
+  }
+  for (int act = 1; act <= 2; act++) {
+    if (solutions[1](game->GetPlayer(1)->GetInfoset(5)->GetAction(act)) !=
+	expected[1](alone->GetPlayer(1)->GetInfoset(1)->GetAction(act)) ||
+	solutions[1](game->GetPlayer(2)->GetInfoset(4)->GetAction(act)) !=
+	expected[1](alone->GetPlayer(2)->GetInfoset(1)->GetAction(act))) {
+      Fail("TestNoReuse", "rescaled subgame was not solved by the LP");
+    }
+  }
+}
+
+}  // end anonymous namespace
+
+int main(void)
+{
+  TestExtraction();
+  TestThreads();
+  TestReuse();
+  TestNoReuse();
+  return (failures == 0) ? 0 : 1;
+}
@@ -25,8 +25,10 @@
 #include <wx/wx.h>
 #endif  // WX_PRECOMP
 #include <wx/tokenzr.h>
+#include <sstream>
 
 #include "gambit/gambit.h"
+#include "gambit/nash.h"       // for ProfileBinaryReader
 #include "gambit/tinyxml.h"    // for XML parser for Load()
 
 #include "analysis.h"
@@ -36,6 +38,127 @@ using namespace Gambit;
 
 
 
+//=========================================================================
+//                  classes gbtBehavProfileCache, gbtMixedProfileCache
+//=========================================================================
+
+template <class T>
+gbtBehavProfileCache<T>::gbtBehavProfileCache(const MixedBehaviorProfile<T> &p_profile)
+  : m_payoffs(p_profile.GetGame()->NumPlayers())
+{
+  Game game = p_profile.GetGame();
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    m_payoffs[pl] = p_profile.GetPayoff(pl);
+  }
+
+  int numNodes = game->NumNodes();
+  m_realizProb = Array<T>(numNodes);
+  m_beliefProb = Array<T>(numNodes);
+  m_nodeValue = Array<Array<T> >(numNodes);
+  // Terminal nodes map to the (empty) information set with index zero
+  m_nodeInfoset = Array<int>(numNodes);
+
+  int numInfosets = game->GetChance()->NumInfosets();
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    numInfosets += game->GetPlayer(pl)->NumInfosets();
+  }
+  m_reached = Array<bool>(0, numInfosets);
+  m_defined = Array<bool>(0, numInfosets);
+  m_infosetProb = Array<T>(0, numInfosets);
+  m_infosetValue = Array<T>(0, numInfosets);
+  m_actionProb = Array<Array<T> >(0, numInfosets);
+  m_actionValue = Array<Array<T> >(0, numInfosets);
+  m_reached[0] = m_defined[0] = false;
+  m_infosetProb[0] = m_infosetValue[0] = (T) 0;
+
+  for (int i = 1; i <= numNodes; i++) {
+    m_realizProb[i] = m_beliefProb[i] = (T) 0;
+    m_nodeInfoset[i] = 0;
+  }
+
+  int index = 0;
+  for (int pl = 0; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = (pl == 0) ? game->GetChance() : game->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      GameInfoset infoset = player->GetInfoset(iset);
+      index++;
+      m_infosetProb[index] = p_profile.GetRealizProb(infoset);
+      m_reached[index] = (m_infosetProb[index] > (T) 0);
+      m_defined[index] = (!player->IsChance() &&
+			  p_profile.IsDefinedAt(infoset));
+      m_infosetValue[index] = (T) 0;
+      m_actionProb[index] = Array<T>(infoset->NumActions());
+      m_actionValue[index] = Array<T>(infoset->NumActions());
+      for (int act = 1; act <= infoset->NumActions(); act++) {
+	GameAction action = infoset->GetAction(act);
+	m_actionProb[index][act] = 
+	  (m_defined[index]) ? p_profile.GetActionProb(action) : (T) 0;
+	m_actionValue[index][act] = (T) 0;
+      }
+      if (m_reached[index] && !player->IsChance()) {
+	m_infosetValue[index] = p_profile.GetPayoff(infoset);
+	for (int act = 1; act <= infoset->NumActions(); act++) {
+	  m_actionValue[index][act] = p_profile.GetPayoff(infoset->GetAction(act));
+	}
+      }
+
+      for (int m = 1; m <= infoset->NumMembers(); m++) {
+	GameNode member = infoset->GetMember(m);
+	m_nodeInfoset[member->GetNumber()] = index;
+	if (m_reached[index]) {
+	  m_beliefProb[member->GetNumber()] = p_profile.GetBeliefProb(member);
+	}
+      }
+    }
+  }
+
+  CacheNodes(p_profile, game->GetRoot());
+}
+
+template <class T> void
+gbtBehavProfileCache<T>::CacheNodes(const MixedBehaviorProfile<T> &p_profile,
+				    const GameNode &p_node)
+{
+  m_realizProb[p_node->GetNumber()] = p_profile.GetRealizProb(p_node);
+  m_nodeValue[p_node->GetNumber()] = p_profile.GetPayoff(p_node);
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    CacheNodes(p_profile, p_node->GetChild(i));
+  }
+}
+
+template <class T>
+gbtMixedProfileCache<T>::gbtMixedProfileCache(const MixedStrategyProfile<T> &p_profile)
+  : m_profile(p_profile),
+    m_payoffs(p_profile.GetGame()->NumPlayers()), m_havePayoffs(false),
+    m_strategyValue(p_profile.MixedProfileLength()),
+    m_haveValue(p_profile.MixedProfileLength())
+{
+  for (int i = 1; i <= m_haveValue.Length(); m_haveValue[i++] = false);
+}
+
+template <class T>
+const T &gbtMixedProfileCache<T>::GetPayoff(int pl) const
+{
+  if (!m_havePayoffs) {
+    for (int i = 1; i <= m_payoffs.Length(); i++) {
+      m_payoffs[i] = m_profile.GetPayoff(i);
+    }
+    m_havePayoffs = true;
+  }
+  return m_payoffs[pl];
+}
+
+template <class T>
+const T &gbtMixedProfileCache<T>::GetStrategyValue(int p_strategy) const
+{
+  if (!m_haveValue[p_strategy]) {
+    m_strategyValue[p_strategy] = 
+      m_profile.GetPayoff(m_profile.GetGame()->GetStrategy(p_strategy));
+    m_haveValue[p_strategy] = true;
+  }
+  return m_strategyValue[p_strategy];
+}
+
 //=========================================================================
 //                     class gbtAnalysisProfileList
 //=========================================================================
@@ -88,37 +211,142 @@ OutputToBehavProfile(gbtGameDocument *p_doc, const wxString &p_text)
   throw gbtNotNashException();
 }
 
+template <class T> MixedStrategyProfile<T>
+ProbsToMixedProfile(gbtGameDocument *p_doc, const std::string &p_label,
+		    const Array<T> &p_probs)
+{
+  MixedStrategyProfile<T> profile(p_doc->GetGame()->NewMixedStrategyProfile((T) 0.0));
+
+  if (p_label == "NE" && p_probs.Length() == profile.MixedProfileLength()) {
+    for (int i = 1; i <= profile.MixedProfileLength(); i++) {
+      profile[i] = p_probs[i];
+    }
+    return profile;
+  }
+
+  throw gbtNotNashException();
+}
+
+template <class T> MixedBehaviorProfile<T>
+ProbsToBehavProfile(gbtGameDocument *p_doc, const std::string &p_label,
+		    const Array<T> &p_probs)
+{
+  MixedBehaviorProfile<T> profile(p_doc->GetGame());
+
+  if (p_label == "NE" && p_probs.Length() == profile.Length()) {
+    for (int i = 1; i <= profile.Length(); i++) {
+      profile[i] = p_probs[i];
+    }
+    return profile;
+  }
+
+  throw gbtNotNashException();
+}
+
+/// The length of the header of a binary profile stream
+const std::string::size_type s_binaryHeaderLength = 7;
+
 }  // end anonymous namespace
 
 
+template <class T> void
+gbtAnalysisProfileList<T>::AppendBehav(const MixedBehaviorProfile<T> &p_profile)
+{
+  m_behavProfiles.Append(p_profile);
+  m_behavCache.Append(gbtBehavProfileCache<T>(p_profile));
+}
+
+template <class T> void
+gbtAnalysisProfileList<T>::AppendMixed(const MixedStrategyProfile<T> &p_profile)
+{
+  m_mixedProfiles.Append(p_profile);
+  m_mixedCache.Append(gbtMixedProfileCache<T>(p_profile));
+}
+
+template <class T> void
+gbtAnalysisProfileList<T>::AddBehav(const MixedBehaviorProfile<T> &p_profile)
+{
+  AppendBehav(p_profile);
+  AppendMixed(p_profile.ToMixedProfile());
+  m_current = m_behavProfiles.Length();
+}
+
+template <class T> void
+gbtAnalysisProfileList<T>::AddMixed(const MixedStrategyProfile<T> &p_profile)
+{
+  AppendMixed(p_profile);
+  if (m_doc->IsTree()) {
+    AppendBehav(MixedBehaviorProfile<T>(p_profile));
+  }
+  m_current = m_mixedProfiles.Length();
+}
+
 template <class T> void
 gbtAnalysisProfileList<T>::AddOutput(const wxString &p_output)
 {
   try {
     if (m_isBehav) {
-      MixedBehaviorProfile<T> profile(OutputToBehavProfile<T>(m_doc, p_output));
-      m_behavProfiles.Append(profile);
-      m_mixedProfiles.Append(profile.ToMixedProfile());
-      m_current = m_behavProfiles.Length();
+      AddBehav(OutputToBehavProfile<T>(m_doc, p_output));
     }
     else {
-      MixedStrategyProfile<T> profile(OutputToMixedProfile<T>(m_doc,
-							      p_output));
-      m_mixedProfiles.Append(profile);
-      if (m_doc->IsTree()) {
-	m_behavProfiles.Append(MixedBehaviorProfile<T>(profile));
-      }
-      m_current = m_mixedProfiles.Length();
+      AddMixed(OutputToMixedProfile<T>(m_doc, p_output));
     }
   }
   catch (gbtNotNashException &) { }
 }
 
+//
+// The output arrives in pieces as the command writes it, which need not
+// end at the end of a profile.  The header is kept at the front of the
+// unread output, so the reader can begin again at the first profile not
+// yet read; the profiles which are complete are read, and removed.
+//
+template <class T> void
+gbtAnalysisProfileList<T>::AddBinaryOutput(const std::string &p_output)
+{
+  m_binaryOutput += p_output;
+  if (m_binaryOutput.length() < s_binaryHeaderLength)  return;
+
+  std::istringstream stream(m_binaryOutput);
+  std::streamoff read = s_binaryHeaderLength;
+  try {
+    Nash::ProfileBinaryReader<T> reader(stream);
+    if (reader.IsBehavior() != m_isBehav) {
+      throw InvalidFileException("Profile stream holds the wrong profiles");
+    }
+    std::string label;
+    Array<T> probs;
+    try {
+      while (reader.Next(label, probs)) {
+	read = stream.tellg();
+	try {
+	  if (m_isBehav) {
+	    AddBehav(ProbsToBehavProfile(m_doc, label, probs));
+	  }
+	  else {
+	    AddMixed(ProbsToMixedProfile(m_doc, label, probs));
+	  }
+	}
+	catch (gbtNotNashException &) { }
+      }
+    }
+    catch (InvalidFileException &) {
+      // The rest of the profile has not yet arrived
+    }
+  }
+  catch (InvalidFileException &) {
+    // The output is not a stream of profiles for this list
+    m_binaryOutput.clear();
+    return;
+  }
+  m_binaryOutput.erase(s_binaryHeaderLength, read - s_binaryHeaderLength);
+}
+
 template <class T>
 void gbtAnalysisProfileList<T>::BuildNfg(void)
 {
   for (int i = 1; i <= m_behavProfiles.Length(); i++) {
-    m_mixedProfiles.Append(m_behavProfiles[i].ToMixedProfile());
+    AppendMixed(m_behavProfiles[i].ToMixedProfile());
   }
 }
 
@@ -138,6 +366,9 @@ void gbtAnalysisProfileList<T>::Clear(void)
 {
   m_behavProfiles = List<MixedBehaviorProfile<T> >();
   m_mixedProfiles = List<MixedStrategyProfile<T> >();
+  m_behavCache = List<gbtBehavProfileCache<T> >();
+  m_mixedCache = List<gbtMixedProfileCache<T> >();
+  m_binaryOutput.clear();
   m_current = 0;
 }
 
@@ -200,7 +431,7 @@ void gbtAnalysisProfileList<T>::Load(TiXmlNode *p_analysis)
 	TextToBehavProfile<T>(m_doc,
 			      wxString(node->FirstChild()->Value(),
 				       *wxConvCurrent));
-      m_behavProfiles.Append(profile);
+      AppendBehav(profile);
       m_isBehav = true;
       m_current = m_behavProfiles.Length();
     }
@@ -209,7 +440,7 @@ void gbtAnalysisProfileList<T>::Load(TiXmlNode *p_analysis)
 	TextToMixedProfile<T>(m_doc,
 			      wxString(node->FirstChild()->Value(),
 				       *wxConvCurrent));
-      m_mixedProfiles.Append(profile);
+      AppendMixed(profile);
       m_isBehav = false;
       m_current = m_mixedProfiles.Length();
     }
@@ -223,11 +454,11 @@ gbtAnalysisProfileList<T>::GetPayoff(int pl, int p_index) const
 
   try {
     if (m_doc->IsTree()) {
-      return lexical_cast<std::string>(m_behavProfiles[index].GetPayoff(pl),
+      return lexical_cast<std::string>(m_behavCache[index].GetPayoff(pl),
 		    m_doc->GetStyle().NumDecimals());
     }
     else {
-      return lexical_cast<std::string>(m_mixedProfiles[index].GetPayoff(pl),
+      return lexical_cast<std::string>(m_mixedCache[index].GetPayoff(pl),
 		    m_doc->GetStyle().NumDecimals());
     }
   }
@@ -243,7 +474,7 @@ gbtAnalysisProfileList<T>::GetRealizProb(const GameNode &p_node,
   int index = (p_index == -1) ? m_current : p_index;
 
   try {
-    return lexical_cast<std::string>(m_behavProfiles[index].GetRealizProb(p_node),
+    return lexical_cast<std::string>(m_behavCache[index].GetRealizProb(p_node),
 		  m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
@@ -260,8 +491,9 @@ gbtAnalysisProfileList<T>::GetBeliefProb(const GameNode &p_node,
   if (!p_node->GetPlayer()) return "";
 
   try {
-    if (m_behavProfiles[index].GetRealizProb(p_node->GetInfoset()) > Rational(0)) {
-      return lexical_cast<std::string>(m_behavProfiles[index].GetBeliefProb(p_node),
+    const gbtBehavProfileCache<T> &cache = m_behavCache[index];
+    if (cache.IsReached(p_node)) {
+      return lexical_cast<std::string>(cache.GetBeliefProb(p_node),
 		    m_doc->GetStyle().NumDecimals());
     }
     else {
@@ -281,7 +513,7 @@ gbtAnalysisProfileList<T>::GetNodeValue(const GameNode &p_node,
   int index = (p_index == -1) ? m_current : p_index;
 
   try {
-    return lexical_cast<std::string>(m_behavProfiles[index].GetPayoff(p_node)[p_player], 
+    return lexical_cast<std::string>(m_behavCache[index].GetNodeValue(p_node, p_player), 
 		  m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
@@ -298,7 +530,7 @@ gbtAnalysisProfileList<T>::GetInfosetProb(const GameNode &p_node,
   if (!p_node->GetPlayer()) return "";
 
   try {
-    return lexical_cast<std::string>(m_behavProfiles[index].GetRealizProb(p_node->GetInfoset()),
+    return lexical_cast<std::string>(m_behavCache[index].GetInfosetProb(p_node),
 		  m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
@@ -315,8 +547,9 @@ gbtAnalysisProfileList<T>::GetInfosetValue(const GameNode &p_node,
   if (!p_node->GetPlayer() || p_node->GetPlayer()->IsChance())  return "";
 
   try {
-    if (m_behavProfiles[index].GetRealizProb(p_node->GetInfoset()) > Rational(0)) {
-      return lexical_cast<std::string>(m_behavProfiles[index].GetPayoff(p_node->GetInfoset()),
+    const gbtBehavProfileCache<T> &cache = m_behavCache[index];
+    if (cache.IsReached(p_node)) {
+      return lexical_cast<std::string>(cache.GetInfosetValue(p_node),
 		    m_doc->GetStyle().NumDecimals());
     }
     else {
@@ -343,13 +576,13 @@ gbtAnalysisProfileList<T>::GetActionProb(const GameNode &p_node, int p_act,
   if (!p_node->GetPlayer())  return "";
   
   try {
-    const MixedBehaviorProfile<T> &profile = m_behavProfiles[index];
+    const gbtBehavProfileCache<T> &cache = m_behavCache[index];
 
-    if (!profile.IsDefinedAt(p_node->GetInfoset())) {
+    if (!cache.IsDefined(p_node)) {
       return "*";
     }
   
-    return lexical_cast<std::string>(profile.GetActionProb(p_node->GetInfoset()->GetAction(p_act)),
+    return lexical_cast<std::string>(cache.GetActionProb(p_node, p_act),
 		  m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
@@ -357,6 +590,24 @@ gbtAnalysisProfileList<T>::GetActionProb(const GameNode &p_node, int p_act,
   }
 }
 
+template <class T> double
+gbtAnalysisProfileList<T>::GetActionProbValue(const GameNode &p_node,
+					      int p_act, int p_index) const
+{
+  int index = (p_index == -1) ? m_current : p_index;
+
+  if (!p_node->GetPlayer() || p_node->GetPlayer()->IsChance())  return 0.0;
+
+  try {
+    const gbtBehavProfileCache<T> &cache = m_behavCache[index];
+    return (cache.IsDefined(p_node)) ? 
+      (double) cache.GetActionProb(p_node, p_act) : 0.0;
+  }
+  catch (IndexException &) {
+    return 0.0;
+  }
+}
+
 template <class T> std::string
 gbtAnalysisProfileList<T>::GetActionProb(int p_action, int p_index) const
 {
@@ -385,8 +636,9 @@ gbtAnalysisProfileList<T>::GetActionValue(const GameNode &p_node, int p_act,
   if (!p_node->GetPlayer() || p_node->GetPlayer()->IsChance()) return "";
   
   try {
-    if (m_behavProfiles[index].GetRealizProb(p_node->GetInfoset()) > Rational(0)) {
-      return lexical_cast<std::string>(m_behavProfiles[index].GetPayoff(p_node->GetInfoset()->GetAction(p_act)),
+    const gbtBehavProfileCache<T> &cache = m_behavCache[index];
+    if (cache.IsReached(p_node)) {
+      return lexical_cast<std::string>(cache.GetActionValue(p_node, p_act),
 		    m_doc->GetStyle().NumDecimals());
     }
     else  {
@@ -419,9 +671,7 @@ gbtAnalysisProfileList<T>::GetStrategyValue(int p_strategy, int p_index) const
   int index = (p_index == -1) ? m_current : p_index;
 
   try {
-    const MixedStrategyProfile<T> &profile = m_mixedProfiles[index];
-    GameStrategy strategy = profile.GetGame()->GetStrategy(p_strategy);
-    return lexical_cast<std::string>(profile.GetPayoff(strategy),
+    return lexical_cast<std::string>(m_mixedCache[index].GetStrategyValue(p_strategy),
 		  m_doc->GetStyle().NumDecimals());
   }
   catch (IndexException &) {
@@ -476,5 +726,9 @@ gbtAnalysisProfileList<T>::Save(std::ostream &p_file) const
 
 
 // Explicit instantiations
+template class gbtBehavProfileCache<double>;
+template class gbtBehavProfileCache<Rational>;
+template class gbtMixedProfileCache<double>;
+template class gbtMixedProfileCache<Rational>;
 template class gbtAnalysisProfileList<double>;
 template class gbtAnalysisProfileList<Rational>;
@@ -40,12 +40,14 @@ class gbtAnalysisOutput {
 protected:
   gbtGameDocument *m_doc;
   wxString m_label, m_description, m_command;
+  bool m_binary;
 
 public:
   /// @name Lifecycle
   //@{
   /// Construct a new output group
-  gbtAnalysisOutput(gbtGameDocument *p_doc) : m_doc(p_doc) { }
+  gbtAnalysisOutput(gbtGameDocument *p_doc)
+    : m_doc(p_doc), m_binary(false) { }
   /// Clean up an output group
   virtual ~gbtAnalysisOutput() { }
   //@}
@@ -70,6 +72,12 @@ public:
   /// Set the command used to generate the list
   void SetCommand(const wxString &p_command) { m_command = p_command; }
 
+  /// Does the command write its profiles in the binary format?
+  bool IsBinary(void) const { return m_binary; }
+
+  /// Set whether the command writes its profiles in the binary format
+  void SetBinary(bool p_binary) { m_binary = p_binary; }
+
   /// The number of profiles in the list
   virtual int NumProfiles(void) const = 0;
 
@@ -101,6 +109,10 @@ public:
   virtual std::string GetActionProb(const Gambit::GameNode &, int act,
 				    int p_index = -1) const = 0;
   virtual std::string GetActionProb(int p_action, int p_index = -1) const = 0;
+  /// The probability of the action at a personal node, as a number;
+  /// zero where the profile is not defined
+  virtual double GetActionProbValue(const Gambit::GameNode &, int act,
+				    int p_index = -1) const = 0;
   virtual std::string GetStrategyProb(int p_strategy,
 				      int p_index = -1) const = 0;
   virtual std::string GetStrategyValue(int p_strategy,
@@ -108,6 +120,9 @@ public:
 
 
   virtual void AddOutput(const wxString &) = 0;
+  /// Add output of a command writing the binary format, which may end
+  /// part way through a profile
+  virtual void AddBinaryOutput(const std::string &) = 0;
 
   /// Map all behavior profiles to corresponding mixed profiles
   virtual void BuildNfg(void) = 0;
@@ -116,6 +131,86 @@ public:
   virtual void Save(std::ostream &) const = 0;
 };
 
+//!
+//! The quantities displayed for a behavior profile, computed once when
+//! the profile is added to a list.  Views ask for these at each redraw;
+//! answering from the library would recompute them (and, for
+//! information sets, sum over the members) every time.  Node quantities
+//! are indexed by node number, and information set quantities by the
+//! index stored for each node.  Values which are not well-defined (such
+//! as beliefs at an information set reached with probability zero) are
+//! left at zero, and flagged by IsReached() or IsDefined().
+//!
+//! Node numbers are only stable while the game is not edited; the
+//! document discards its profile lists, and with them these caches,
+//! on any change to the game or its payoffs.
+//!
+template <class T> class gbtBehavProfileCache {
+private:
+  Gambit::Vector<T> m_payoffs;
+  Gambit::Array<T> m_realizProb, m_beliefProb;
+  Gambit::Array<Gambit::Array<T> > m_nodeValue;
+  Gambit::Array<int> m_nodeInfoset;
+  Gambit::Array<bool> m_reached, m_defined;
+  Gambit::Array<T> m_infosetProb, m_infosetValue;
+  Gambit::Array<Gambit::Array<T> > m_actionProb, m_actionValue;
+
+public:
+  gbtBehavProfileCache(const Gambit::MixedBehaviorProfile<T> &);
+
+  const T &GetPayoff(int pl) const { return m_payoffs[pl]; }
+
+  const T &GetRealizProb(const Gambit::GameNode &p_node) const
+    { return m_realizProb[p_node->GetNumber()]; }
+  const T &GetBeliefProb(const Gambit::GameNode &p_node) const
+    { return m_beliefProb[p_node->GetNumber()]; }
+  const T &GetNodeValue(const Gambit::GameNode &p_node, int pl) const
+    { return m_nodeValue[p_node->GetNumber()][pl]; }
+
+  /// Is the node's information set reached with positive probability?
+  bool IsReached(const Gambit::GameNode &p_node) const
+    { return m_reached[InfosetIndex(p_node)]; }
+  /// Is the profile defined at the node's information set?
+  bool IsDefined(const Gambit::GameNode &p_node) const
+    { return m_defined[InfosetIndex(p_node)]; }
+  const T &GetInfosetProb(const Gambit::GameNode &p_node) const
+    { return m_infosetProb[InfosetIndex(p_node)]; }
+  const T &GetInfosetValue(const Gambit::GameNode &p_node) const
+    { return m_infosetValue[InfosetIndex(p_node)]; }
+  const T &GetActionProb(const Gambit::GameNode &p_node, int p_act) const
+    { return m_actionProb[InfosetIndex(p_node)][p_act]; }
+  const T &GetActionValue(const Gambit::GameNode &p_node, int p_act) const
+    { return m_actionValue[InfosetIndex(p_node)][p_act]; }
+
+private:
+  int InfosetIndex(const Gambit::GameNode &p_node) const
+    { return m_nodeInfoset[p_node->GetNumber()]; }
+  void CacheNodes(const Gambit::MixedBehaviorProfile<T> &,
+		  const Gambit::GameNode &);
+};
+
+//!
+//! The quantities displayed for a mixed strategy profile.  Unlike those
+//! of a behavior profile, these are each computed when first asked for,
+//! and kept thereafter: for a game tree with many strategies, the value
+//! of each strategy is costly to compute, and only those shown are
+//! needed.  Strategies are indexed as in the profile.
+//!
+template <class T> class gbtMixedProfileCache {
+private:
+  Gambit::MixedStrategyProfile<T> m_profile;
+  mutable Gambit::Vector<T> m_payoffs;
+  mutable bool m_havePayoffs;
+  mutable Gambit::Array<T> m_strategyValue;
+  mutable Gambit::Array<bool> m_haveValue;
+
+public:
+  gbtMixedProfileCache(const Gambit::MixedStrategyProfile<T> &);
+
+  const T &GetPayoff(int pl) const;
+  const T &GetStrategyValue(int p_strategy) const;
+};
+
 //!
 //! This class manages a list of profiles, computed, e.g., by an
 //! algorithm for finding Nash equilibria.  It maintains two lists
@@ -128,6 +223,19 @@ private:
   int m_current;
   Gambit::List<Gambit::MixedBehaviorProfile<T> > m_behavProfiles;
   Gambit::List<Gambit::MixedStrategyProfile<T> > m_mixedProfiles;
+  Gambit::List<gbtBehavProfileCache<T> > m_behavCache;
+  Gambit::List<gbtMixedProfileCache<T> > m_mixedCache;
+  /// Binary output not yet read: the header, followed by the part of a
+  /// profile whose remainder has not arrived
+  std::string m_binaryOutput;
+
+  /// @name Adding profiles along with their cached quantities
+  //@{
+  void AppendBehav(const Gambit::MixedBehaviorProfile<T> &);
+  void AppendMixed(const Gambit::MixedStrategyProfile<T> &);
+  void AddBehav(const Gambit::MixedBehaviorProfile<T> &);
+  void AddMixed(const Gambit::MixedStrategyProfile<T> &);
+  //@}
 
 public:
   //!
@@ -166,6 +274,8 @@ public:
   std::string GetActionProb(const Gambit::GameNode &, int act,
 			    int p_index = -1) const;
   std::string GetActionProb(int p_action, int p_index = -1) const;
+  double GetActionProbValue(const Gambit::GameNode &, int act,
+			    int p_index = -1) const;
   std::string GetStrategyProb(int p_strategy,
 			      int p_index = -1) const;
   std::string GetStrategyValue(int p_strategy,
@@ -184,6 +294,7 @@ public:
   //!
   //@{
   void AddOutput(const wxString &);
+  void AddBinaryOutput(const std::string &);
   /// Map all behavior profiles to corresponding mixed profiles
   void BuildNfg(void);
 
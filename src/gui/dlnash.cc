@@ -207,7 +207,8 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
     if (m_countChoice->GetSelection() == 0) {
       if (m_doc->NumPlayers() == 2 && m_doc->IsConstSum()) {
 	cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
-	cmd->SetCommand(prefix + wxT("lp") + options);
+	cmd->SetCommand(prefix + wxT("lp --binary") + options);
+	cmd->SetBinary(true);
 	cmd->SetDescription(wxT("One equilibrium by solving a linear program ")
 			    + game);
       }
@@ -220,13 +221,15 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
     else if (m_countChoice->GetSelection() == 1) {
       if (m_doc->NumPlayers() == 2) {
 	cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
-	cmd->SetCommand(prefix + wxT("lcp") + options);
+	cmd->SetCommand(prefix + wxT("lcp --binary") + options);
+	cmd->SetBinary(true);
 	cmd->SetDescription(wxT("Some equilibria by solving a linear ")
 			       wxT("complementarity program ") + game);
       }
       else {
 	cmd = new gbtAnalysisProfileList<double>(m_doc, useEfg);
-	cmd->SetCommand(prefix + wxT("liap -d 10") + options);
+	cmd->SetCommand(prefix + wxT("liap --binary") + options);
+	cmd->SetBinary(true);
 	cmd->SetDescription(wxT("Some equilibria by function minimization ") +
 			    game);
       }
@@ -234,7 +237,8 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
     else {
       if (m_doc->NumPlayers() == 2) {
 	cmd = new gbtAnalysisProfileList<Rational>(m_doc, false);
-	cmd->SetCommand(prefix + wxT("enummixed"));
+	cmd->SetCommand(prefix + wxT("enummixed --binary"));
+	cmd->SetBinary(true);
 	cmd->SetDescription(wxT("All equilibria by enumeration of mixed ")
 			       wxT("strategies in strategic game"));
       }
@@ -248,12 +252,14 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
   }
   else if (method == s_enumpure) {
     cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
-    cmd->SetCommand(prefix + wxT("enumpure") + options);
+    cmd->SetCommand(prefix + wxT("enumpure --binary") + options);
+    cmd->SetBinary(true);
     cmd->SetDescription(count + wxT(" in pure strategies ") + game);
   }
   else if (method == s_enummixed) {
     cmd = new gbtAnalysisProfileList<Rational>(m_doc, false);
-    cmd->SetCommand(prefix + wxT("enummixed") + options);
+    cmd->SetCommand(prefix + wxT("enummixed --binary") + options);
+    cmd->SetBinary(true);
     cmd->SetDescription(count + 
 			wxT(" by enumeration of mixed strategies ")
 			    wxT("in strategic game"));
@@ -266,30 +272,35 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
   }
   else if (method == s_gnm) {
     cmd = new gbtAnalysisProfileList<double>(m_doc, false);
-    cmd->SetCommand(prefix + wxT("gnm -d 10") + options);
+    cmd->SetCommand(prefix + wxT("gnm --binary") + options);
+    cmd->SetBinary(true);
     cmd->SetDescription(count + wxT(" by global Newton tracing ")
 			wxT("in strategic game"));
   }
   else if (method == s_ipa) {
     cmd = new gbtAnalysisProfileList<double>(m_doc, false);
-    cmd->SetCommand(prefix + wxT("ipa -d 10") + options);
+    cmd->SetCommand(prefix + wxT("ipa --binary") + options);
+    cmd->SetBinary(true);
     cmd->SetDescription(count + wxT(" by iterated polymatrix approximation ")
 			wxT("in strategic game"));
   }
   else if (method == s_lp) {
     cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
-    cmd->SetCommand(prefix + wxT("lp") + options);
+    cmd->SetCommand(prefix + wxT("lp --binary") + options);
+    cmd->SetBinary(true);
     cmd->SetDescription(count + wxT(" by solving a linear program ") + game);
   }
   else if (method == s_lcp) {
     cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
-    cmd->SetCommand(prefix + wxT("lcp") + options);
+    cmd->SetCommand(prefix + wxT("lcp --binary") + options);
+    cmd->SetBinary(true);
     cmd->SetDescription(count + wxT(" by solving a linear complementarity ")
 				   wxT("program ") + game);
   }
   else if (method == s_liap) {
     cmd = new gbtAnalysisProfileList<double>(m_doc, useEfg);
-    cmd->SetCommand(prefix + wxT("liap -d 10") + options);
+    cmd->SetCommand(prefix + wxT("liap --binary") + options);
+    cmd->SetBinary(true);
     cmd->SetDescription(count + wxT(" by function minimization ") + game);
   }
   else if (method == s_logit) {
@@ -299,7 +310,8 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
   }
   else if (method == s_simpdiv) {
     cmd = new gbtAnalysisProfileList<double>(m_doc, false);
-    cmd->SetCommand(prefix + wxT("simpdiv") + options);
+    cmd->SetCommand(prefix + wxT("simpdiv --binary") + options);
+    cmd->SetBinary(true);
     cmd->SetDescription(count + wxT(" by simplicial subdivision ")
 				    wxT("in strategic game"));
   }
@@ -150,13 +150,18 @@ void gbtNashMonitorDialog::OnIdle(wxIdleEvent &p_event)
   if (!m_process)  return;
 
   if (m_process->IsInputAvailable()) {
-    wxTextInputStream tis(*m_process->GetInputStream());
+    if (m_output->IsBinary()) {
+      ReadBinaryOutput();
+    }
+    else {
+      wxTextInputStream tis(*m_process->GetInputStream());
 
-    wxString msg;
-    msg << tis.ReadLine();
+      wxString msg;
+      msg << tis.ReadLine();
 
-    m_doc->DoAddOutput(*m_output, msg);
-    m_countText->SetLabel(wxString::Format(wxT("Number of equilibria found so far: %d"), m_output->NumProfiles()));
+      m_doc->DoAddOutput(*m_output, msg);
+      m_countText->SetLabel(wxString::Format(wxT("Number of equilibria found so far: %d"), m_output->NumProfiles()));
+    }
 
     p_event.RequestMore();
   }
@@ -165,6 +170,25 @@ void gbtNashMonitorDialog::OnIdle(wxIdleEvent &p_event)
   }
 }
 
+//
+// Profiles in the binary format are not split into lines; this takes
+// only the bytes which are available, so as not to wait on the command,
+// and the profile list keeps the start of any profile not yet complete.
+//
+void gbtNashMonitorDialog::ReadBinaryOutput(void)
+{
+  wxInputStream *stream = m_process->GetInputStream();
+  std::string bytes;
+  while (bytes.length() < 4096 && m_process->IsInputAvailable()) {
+    int c = stream->GetC();
+    if (c == wxEOF)  break;
+    bytes += (char) c;
+  }
+
+  m_doc->DoAddOutput(*m_output, bytes);
+  m_countText->SetLabel(wxString::Format(wxT("Number of equilibria found so far: %d"), m_output->NumProfiles()));
+}
+
 void gbtNashMonitorDialog::OnTimer(wxTimerEvent &p_event)
 {
   wxWakeUpIdle();
@@ -176,6 +200,11 @@ void gbtNashMonitorDialog::OnEndProcess(wxProcessEvent &p_event)
   m_timer.Stop();
 
   while (m_process->IsInputAvailable()) {
+    if (m_output->IsBinary()) {
+      ReadBinaryOutput();
+      continue;
+    }
+
     wxTextInputStream tis(*m_process->GetInputStream());
 
     wxString msg;
@@ -39,6 +39,7 @@ private:
   gbtAnalysisOutput *m_output;
   
   void Start(gbtAnalysisOutput *);
+  void ReadBinaryOutput(void);
 
   void OnStop(wxCommandEvent &);
   void OnTimer(wxTimerEvent &);
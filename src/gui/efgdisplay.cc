@@ -583,7 +583,8 @@ void gbtEfgDisplay::OnUpdate(void)
     }
   }
 
-  // Force a rebuild on every change for now.
+  // The layout is rebuilt on every change, though only for the edited
+  // subtree when the change is confined to one.
   RefreshTree();
 
   Gambit::GameNode selectNode = m_doc->GetSelectNode();
@@ -612,8 +613,13 @@ void gbtEfgDisplay::OnUpdate(void)
 
 void gbtEfgDisplay::RefreshTree(void)
 {
-  m_layout.BuildNodeList(m_doc->GetEfgSupport());
-  m_layout.Layout(m_doc->GetEfgSupport());
+  if (m_doc->GetEditedSubtree()) {
+    m_layout.Layout(m_doc->GetEfgSupport(), m_doc->GetEditedSubtree());
+  }
+  else {
+    m_layout.BuildNodeList(m_doc->GetEfgSupport());
+    m_layout.Layout(m_doc->GetEfgSupport());
+  }
   Refresh();
 }
 
@@ -662,7 +668,23 @@ void gbtEfgDisplay::OnDraw(wxDC &p_dc)
 #endif
   p_dc.Clear();
   int maxX = m_layout.MaxX();
-  m_layout.Render(p_dc, false);
+
+  // Only the part of the tree in the damaged region of the window
+  // (or, outside of a paint event, in the visible part) needs drawing
+  wxRect region = GetUpdateRegion().GetBox();
+  if (region.GetWidth() == 0 || region.GetHeight() == 0) {
+    region = wxRect(wxPoint(0, 0), GetClientSize());
+  }
+  int left, top, right, bottom;
+  CalcUnscrolledPosition(region.GetLeft(), region.GetTop(), &left, &top);
+  CalcUnscrolledPosition(region.GetRight(), region.GetBottom(),
+			 &right, &bottom);
+  m_layout.Render(p_dc,
+		  wxRect(wxPoint((int) (left / (.01 * m_zoom)) - 1,
+				 (int) (top / (.01 * m_zoom)) - 1),
+			 wxPoint((int) (right / (.01 * m_zoom)) + 1,
+				 (int) (bottom / (.01 * m_zoom)) + 1)),
+		  false);
 #if !wxCHECK_VERSION(2,7,0)
   p_dc.EndDrawing();
 #endif
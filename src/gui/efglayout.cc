@@ -22,6 +22,7 @@
 
 #include <cmath>
 #include <algorithm>    // for std::min, std::max
+#include <map>
 
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
@@ -332,6 +333,14 @@ void gbtNodeEntry::DrawOutcome(wxDC &p_dc, bool p_noHints) const
 			 point.x - (m_x + m_size + 20), height);
 }
 
+void gbtNodeEntry::OffsetOutcomeExtent(int p_dx, int p_dy) const
+{
+  m_outcomeRect.Offset(p_dx, p_dy);
+  for (int pl = 1; pl <= m_payoffRect.Length(); pl++) {
+    m_payoffRect[pl].Offset(p_dx, p_dy);
+  }
+}
+
 bool gbtNodeEntry::NodeHitTest(int p_x, int p_y) const
 {
   if (p_x < m_x || p_x >= m_x + m_size) {
@@ -353,15 +362,23 @@ bool gbtNodeEntry::NodeHitTest(int p_x, int p_y) const
 
 gbtTreeLayout::gbtTreeLayout(gbtEfgDisplay *p_parent, gbtGameDocument *p_doc)
   : gbtGameView(p_doc), 
-    /* m_parent(p_parent),*/ m_infosetSpacing(40),
-    c_leftMargin(20), c_topMargin(40)
+    /* m_parent(p_parent),*/ m_supportRestricted(false), 
+    m_maxX(0), m_maxY(0), m_maxLevel(0), m_infosetSpacing(40),
+    c_leftMargin(20), c_topMargin(40), c_bandHeight(200)
 { }
 
+//
+// The hit tests only need to look at the entries listed in the band
+// containing the point.  Each band lists its entries in the order of
+// m_nodeList, so the entry found is the same as a search of the whole
+// list would find.
+//
 Gambit::GameNode gbtTreeLayout::NodeHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->NodeHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode();
+  const Gambit::Array<int> &entries = GetBandEntries(p_y);
+  for (int i = 1; i <= entries.Length(); i++) {
+    if (m_nodeList[entries[i]]->NodeHitTest(p_x, p_y)) {
+      return m_nodeList[entries[i]]->GetNode();
     }
   }
   return 0;
@@ -369,9 +386,10 @@ Gambit::GameNode gbtTreeLayout::NodeHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::OutcomeHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->OutcomeHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode();
+  const Gambit::Array<int> &entries = GetBandEntries(p_y);
+  for (int i = 1; i <= entries.Length(); i++) {
+    if (m_nodeList[entries[i]]->OutcomeHitTest(p_x, p_y)) {
+      return m_nodeList[entries[i]]->GetNode();
     }
   }
   return 0;
@@ -379,9 +397,10 @@ Gambit::GameNode gbtTreeLayout::OutcomeHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::BranchAboveHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->BranchAboveHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode()->GetParent();
+  const Gambit::Array<int> &entries = GetBandEntries(p_y);
+  for (int i = 1; i <= entries.Length(); i++) {
+    if (m_nodeList[entries[i]]->BranchAboveHitTest(p_x, p_y)) {
+      return m_nodeList[entries[i]]->GetNode()->GetParent();
     }
   }
   return 0;
@@ -389,9 +408,10 @@ Gambit::GameNode gbtTreeLayout::BranchAboveHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::BranchBelowHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->BranchAboveHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode()->GetParent();
+  const Gambit::Array<int> &entries = GetBandEntries(p_y);
+  for (int i = 1; i <= entries.Length(); i++) {
+    if (m_nodeList[entries[i]]->BranchBelowHitTest(p_x, p_y)) {
+      return m_nodeList[entries[i]]->GetNode()->GetParent();
     }
   }
   return 0;
@@ -399,8 +419,9 @@ Gambit::GameNode gbtTreeLayout::BranchBelowHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::InfosetHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    gbtNodeEntry *entry = m_nodeList[i];
+  const Gambit::Array<int> &entries = GetBandEntries(p_y);
+  for (int i = 1; i <= entries.Length(); i++) {
+    gbtNodeEntry *entry = m_nodeList[entries[i]];
     if (entry->GetNextMember() && entry->GetNode()->GetInfoset()) {
       if (p_x > entry->X() + entry->GetSublevel() * m_infosetSpacing - 2 &&
 	  p_x < entry->X() + entry->GetSublevel() * m_infosetSpacing + 2) {
@@ -551,9 +572,31 @@ gbtNodeEntry *gbtTreeLayout::GetValidChild(Gambit::GameNode e)
 
 gbtNodeEntry *gbtTreeLayout::GetEntry(Gambit::GameNode p_node) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->GetNode() == p_node) {
-      return m_nodeList[i];
+  int pos = GetPosition(p_node);
+  return (pos > 0) ? m_nodeList[pos] : 0;
+}
+
+//
+// Returns the position of the node's entry in m_nodeList, or zero if
+// the node is not shown.  The lookup is by node number; should the
+// numbering have changed since the list was built, it falls back on
+// searching the list.
+//
+int gbtTreeLayout::GetPosition(Gambit::GameNode p_node) const
+{
+  if (!p_node) return 0;
+
+  int number = p_node->GetNumber();
+  if (number >= 1 && number <= m_nodePositions.Length()) {
+    int pos = m_nodePositions[number];
+    if (pos == 0 || m_nodeList[pos]->GetNode() == p_node) {
+      return pos;
+    }
+  }
+
+  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+    if (m_nodeList[pos]->GetNode() == p_node) {
+      return pos;
     }
   }
   return 0;
@@ -561,10 +604,11 @@ gbtNodeEntry *gbtTreeLayout::GetEntry(Gambit::GameNode p_node) const
 
 Gambit::GameNode gbtTreeLayout::PriorSameLevel(Gambit::GameNode p_node) const
 {
-  gbtNodeEntry *entry = GetEntry(p_node);
-  if (entry) {
-    for (int i = m_nodeList.Find(entry) - 1; i >= 1; i--) {
-      if (m_nodeList[i]->GetLevel() == entry->GetLevel())
+  int pos = GetPosition(p_node);
+  if (pos > 0) {
+    int level = m_nodeList[pos]->GetLevel();
+    for (int i = pos - 1; i >= 1; i--) {
+      if (m_nodeList[i]->GetLevel() == level)
 	return m_nodeList[i]->GetNode();
     }
   }
@@ -573,10 +617,11 @@ Gambit::GameNode gbtTreeLayout::PriorSameLevel(Gambit::GameNode p_node) const
 
 Gambit::GameNode gbtTreeLayout::NextSameLevel(Gambit::GameNode p_node) const
 {
-  gbtNodeEntry *entry = GetEntry(p_node);
-  if (entry) {
-    for (int i = m_nodeList.Find(entry) + 1; i <= m_nodeList.Length(); i++) {
-      if (m_nodeList[i]->GetLevel() == entry->GetLevel()) { 
+  int pos = GetPosition(p_node);
+  if (pos > 0) {
+    int level = m_nodeList[pos]->GetLevel();
+    for (int i = pos + 1; i <= m_nodeList.Length(); i++) {
+      if (m_nodeList[i]->GetLevel() == level) { 
 	return m_nodeList[i]->GetNode();
       }
     }
@@ -584,6 +629,24 @@ Gambit::GameNode gbtTreeLayout::NextSameLevel(Gambit::GameNode p_node) const
   return 0;
 }
 
+//
+// Returns the horizontal position of the nodes on the level, before
+// room is made for the information set lines
+//
+int gbtTreeLayout::LevelX(int p_level) const
+{
+  const gbtStyle &settings = m_doc->GetStyle();
+  if (settings.BranchStyle() == GBT_BRANCH_STYLE_LINE) {
+    return c_leftMargin + p_level * (settings.NodeSize() +
+				     settings.BranchLength());
+  }
+  else {
+    return c_leftMargin + p_level * (settings.NodeSize() +
+				     settings.BranchLength() +
+				     settings.TineLength());
+  }
+}
+
 int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::BehaviorSupportProfile &p_support,
 				 int &p_maxy, int &p_miny, int &p_ycoord)
 {
@@ -626,15 +689,7 @@ int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::Behavior
     }
   }
     
-  if (settings.BranchStyle() == GBT_BRANCH_STYLE_LINE) {
-    entry->SetX(c_leftMargin + entry->GetLevel() * (settings.NodeSize() +
-						    settings.BranchLength()));
-  }
-  else {
-    entry->SetX(c_leftMargin + entry->GetLevel() * (settings.NodeSize() +
-						    settings.BranchLength() +
-						    settings.TineLength()));
-  }
+  entry->SetX(LevelX(entry->GetLevel()));
 
   if (p_node->GetPlayer() && p_node->GetPlayer()->IsChance()) {
     entry->SetColor(settings.ChanceColor());
@@ -663,76 +718,67 @@ int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::Behavior
 }
 
 //
-// Checks if there are any nodes in the same infoset as e that are either
-// on the same level (if SHOWISET_SAME) or on any level (if SHOWISET_ALL)
+// Links each entry to the next entry in the list with the same
+// information set: on the same level (if SHOWISET_SAME) or on any level
+// (if SHOWISET_ALL).  This is done in one pass backwards through the
+// list, remembering the last entry seen for each information set (and
+// level).
 //
-gbtNodeEntry *gbtTreeLayout::NextInfoset(gbtNodeEntry *e)
+void gbtTreeLayout::LinkInfosetMembers(void)
 {
-  const gbtStyle &draw_settings = m_doc->GetStyle();
-  
-  for (int pos = m_nodeList.Find(e) + 1; pos <= m_nodeList.Length(); pos++) {
-    gbtNodeEntry *e1 = m_nodeList[pos];
-    // infosets are the same and the nodes are on the same level
-    if (e->GetNode()->GetInfoset() == e1->GetNode()->GetInfoset()) {
-      if (draw_settings.InfosetConnect() == GBT_INFOSET_CONNECT_ALL) {
-	return e1;
-      }
-      else if (e->GetLevel() == e1->GetLevel()) {
-	return e1;
-      }
-    }
+  bool allLevels = (m_doc->GetStyle().InfosetConnect() == 
+		    GBT_INFOSET_CONNECT_ALL);
+  std::map<std::pair<Gambit::GameInfosetRep *, int>, gbtNodeEntry *> next;
+
+  for (int pos = m_nodeList.Length(); pos >= 1; pos--) {
+    gbtNodeEntry *entry = m_nodeList[pos];
+    std::pair<Gambit::GameInfosetRep *, int> key(entry->GetNode()->GetInfoset(),
+						 (allLevels) ? 0 : entry->GetLevel());
+    std::map<std::pair<Gambit::GameInfosetRep *, int>, gbtNodeEntry *>::const_iterator member = next.find(key);
+    entry->SetNextMember((member != next.end()) ? member->second : 0);
+    next[key] = entry;
   }
-  return 0;
 }
 
 //
-// CheckInfosetEntry.  Checks how many infoset lines are to be drawn at each
-// level, spaces them by setting each infoset's node's num to the previous
-// infoset node+1.  Also lengthens the nodes by the amount of space taken up
-// by the infoset lines.
+// Checks how many infoset lines are to be drawn at each level, and
+// numbers them.  The entries are visited in the order given; the first
+// entry of each information set on a level which is linked to another
+// member takes the next free number on that level, and later entries of
+// the same information set on that level share it.
 //
-void gbtTreeLayout::CheckInfosetEntry(gbtNodeEntry *e)
-{
-  int pos;
-  gbtNodeEntry *infoset_entry, *e1;
-  // Check if the infoset this entry belongs to (on this level) has already
-  // been processed.  If so, make this entry->num the same as the one already
-  // processed and return
-  infoset_entry = NextInfoset(e);
-  for (pos = 1; pos <= m_nodeList.Length(); pos++) {
-    e1 = m_nodeList[pos];
-    // if the infosets are the same and they are on the same level and e1 has been processed
-    if (e->GetNode()->GetInfoset() == e1->GetNode()->GetInfoset() && 
-	e->GetLevel() == e1->GetLevel() && e1->GetSublevel() > 0) {
-      e->SetSublevel(e1->GetSublevel());
-      if (infoset_entry) {
-	e->SetNextMember(infoset_entry);
-      }
-      return;
+void gbtTreeLayout::NumberInfosetLines(const Gambit::Array<gbtNodeEntry *> &p_entries,
+				       int p_count)
+{
+  std::map<std::pair<Gambit::GameInfosetRep *, int>, int> sublevels;
+  Gambit::Array<int> maxSublevel(0, m_maxLevel);
+  for (int level = 0; level <= m_maxLevel; maxSublevel[level++] = 0);
+
+  for (int i = 1; i <= p_count; i++) {
+    gbtNodeEntry *entry = p_entries[i];
+    std::pair<Gambit::GameInfosetRep *, int> key(entry->GetNode()->GetInfoset(),
+						 entry->GetLevel());
+    std::map<std::pair<Gambit::GameInfosetRep *, int>, int>::const_iterator line = sublevels.find(key);
+    if (line != sublevels.end()) {
+      entry->SetSublevel(line->second);
     }
-  }
-    
-  // If we got here, this entry does not belong to any processed infoset yet.
-  // Check if it belongs to ANY infoset, if not just return
-  if (!infoset_entry) return;
-    
-  // If we got here, then this entry is new and is connected to other entries
-  // find the entry on the same level with the maximum num.
-  // This entry will have num = num+1.
-  int num = 0;
-  for (pos = 1; pos <= m_nodeList.Length(); pos++) {
-    e1 = m_nodeList[pos];
-    // Find the max num for this level
-    if (e->GetLevel() == e1->GetLevel())  {
-      num = std::max(e1->GetSublevel(), num);
+    else if (entry->GetNextMember()) {
+      entry->SetSublevel(++maxSublevel[entry->GetLevel()]);
+      sublevels[key] = entry->GetSublevel();
+    }
+    else {
+      entry->SetSublevel(0);
     }
   }
-  num++;
-  e->SetSublevel(num);
-  e->SetNextMember(infoset_entry);
 }
 
-void gbtTreeLayout::FillInfosetTable(Gambit::GameNode n, const Gambit::BehaviorSupportProfile &cur_sup)
+//
+// Collects the entries shown, children before parents, which is the
+// order in which the infoset lines are numbered
+//
+void gbtTreeLayout::FillInfosetTable(Gambit::GameNode n, const Gambit::BehaviorSupportProfile &cur_sup,
+				     Gambit::Array<gbtNodeEntry *> &p_entries,
+				     int &p_count)
 {
   const gbtStyle &draw_settings = m_doc->GetStyle();
   gbtNodeEntry *entry = GetNodeEntry(n);
@@ -744,13 +790,13 @@ void gbtTreeLayout::FillInfosetTable(Gambit::GameNode n, const Gambit::BehaviorS
       }
             
       if (in_sup || !draw_settings.RootReachable()) {
-	FillInfosetTable(n->GetChild(i), cur_sup);
+	FillInfosetTable(n->GetChild(i), cur_sup, p_entries, p_count);
       }
     }
   }
 
   if (entry) {
-    CheckInfosetEntry(entry);
+    p_entries[++p_count] = entry;
   }
 }
 
@@ -773,9 +819,9 @@ void gbtTreeLayout::UpdateTableInfosets(void)
   }
     
   // now add the needed length to each level, and set maxX accordingly
-  m_maxX = 0;
   for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
     gbtNodeEntry *entry = m_nodeList[pos];
+    entry->SetX(LevelX(entry->GetLevel()));
     if (entry->GetLevel() != 0) {
       entry->SetX(entry->X() + 
 		  (nums[entry->GetLevel()-1] +
@@ -785,9 +831,9 @@ void gbtTreeLayout::UpdateTableInfosets(void)
   }
 }
 
-void gbtTreeLayout::UpdateTableParents(void)
+void gbtTreeLayout::UpdateTableParents(int p_first, int p_last)
 {
-  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+  for (int pos = p_first; pos <= p_last; pos++) {
     gbtNodeEntry *e = m_nodeList[pos];
     e->SetParent((e->GetNode() == m_doc->GetGame()->GetRoot()) ? 
 		 e : GetValidParent(e->GetNode()));
@@ -805,48 +851,290 @@ void gbtTreeLayout::Layout(const Gambit::BehaviorSupportProfile &p_support)
     BuildNodeList(p_support);
   }
 
+  m_maxX = 0;
   int miny = 0, maxy = 0, ycoord = c_topMargin;
   LayoutSubtree(m_doc->GetGame()->GetRoot(), p_support, maxy, miny, ycoord);
 
   const gbtStyle &draw_settings = m_doc->GetStyle();
   if (draw_settings.InfosetConnect() != GBT_INFOSET_CONNECT_NONE) {
     // FIXME! This causes lines to disappear... sometimes.
-    FillInfosetTable(m_doc->GetGame()->GetRoot(), p_support);
+    LinkInfosetMembers();
+    Gambit::Array<gbtNodeEntry *> entries(m_nodeList.Length());
+    int count = 0;
+    FillInfosetTable(m_doc->GetGame()->GetRoot(), p_support, entries, count);
+    NumberInfosetLines(entries, count);
     UpdateTableInfosets();
   }
 
-  UpdateTableParents();
+  UpdateTableParents(1, m_nodeList.Length());
   GenerateLabels();
+  ComputeOutcomeExtents(1, m_nodeList.Length());
 
   m_maxY = maxy + 25;
+  BuildBands();
+}
+
+//
+// Only the entries of the subtree are built and laid out afresh.  The
+// entries after it in the list are moved up or down by the change in
+// its height, and its ancestors centred again over their children.
+// The numbering of the information set lines on each level depends on
+// the whole tree, as do the labels, so these are still done throughout.
+// This relies on every node being shown, so that an entry's position in
+// the list is its node's number: the nodes before the subtree keep
+// their numbers, and its entries take the place of those formerly in
+// the same child slot of its parent.  Otherwise, the whole tree is laid
+// out again.
+//
+void gbtTreeLayout::Layout(const Gambit::BehaviorSupportProfile &p_support,
+			   Gambit::GameNode p_subtree)
+{
+  Gambit::GameNode parent = (p_subtree) ? p_subtree->GetParent() : 0;
+  int first = (parent) ? p_subtree->GetNumber() : 0;
+  if (!parent || m_supportRestricted ||
+      m_nodeList.Length() != m_nodePositions.Length() ||
+      first > m_nodeList.Length() ||
+      m_nodeList[parent->GetNumber()]->GetNode() != parent ||
+      (m_nodeList[first]->GetLevel() != 
+       m_nodeList[parent->GetNumber()]->GetLevel() + 1)) {
+    BuildNodeList(p_support);
+    Layout(p_support);
+    return;
+  }
+
+  const gbtStyle &settings = m_doc->GetStyle();
+  m_infosetSpacing = 
+    (settings.InfosetJoin() == GBT_INFOSET_JOIN_LINES) ? 10 : 40;
+
+  // The old entries of the subtree run up to the next entry on its level
+  // or above.  Their nodes may no longer exist, so only the entries
+  // themselves are looked at.
+  int level = m_nodeList[first]->GetLevel();
+  int last = first;
+  while (last < m_nodeList.Length() && 
+	 m_nodeList[last + 1]->GetLevel() > level) {
+    last++;
+  }
+  int ycoord = 0, terminals = 0;
+  for (int pos = first; pos <= last; pos++) {
+    if (pos == last || 
+	m_nodeList[pos + 1]->GetLevel() <= m_nodeList[pos]->GetLevel()) {
+      if (terminals++ == 0) {
+	ycoord = m_nodeList[pos]->Y();
+      }
+    }
+  }
+
+  Gambit::Array<gbtNodeEntry *> oldList = m_nodeList;
+  m_nodePositions = Gambit::Array<int>(m_doc->GetGame()->NumNodes());
+  for (int i = 1; i <= m_nodePositions.Length(); i++) {
+    m_nodePositions[i] = i;
+  }
+  m_nodeList = Gambit::Array<gbtNodeEntry *>(m_nodePositions.Length());
+  m_maxLevel = 0;
+  for (int pos = 1; pos < first; pos++) {
+    m_nodeList[pos] = oldList[pos];
+    m_maxLevel = std::max(m_maxLevel, oldList[pos]->GetLevel());
+  }
+  int count = first - 1;
+  BuildNodeList(p_subtree, p_support, level, count);
+  int end = count;
+  if (m_supportRestricted ||
+      end + oldList.Length() - last != m_nodeList.Length()) {
+    for (int pos = first; pos <= end; delete m_nodeList[pos++]);
+    m_nodeList = oldList;
+    BuildNodeList(p_support);
+    Layout(p_support);
+    return;
+  }
+  for (int pos = last + 1; pos <= oldList.Length(); pos++) {
+    m_nodeList[++count] = oldList[pos];
+    m_maxLevel = std::max(m_maxLevel, oldList[pos]->GetLevel());
+  }
+  for (int pos = first; pos <= last; delete oldList[pos++]);
+
+  // Remember where the other entries were, to move their outcomes
+  // along with them
+  Gambit::Array<int> oldX(m_nodeList.Length()), oldY(m_nodeList.Length());
+  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+    if (pos < first || pos > end) {
+      oldX[pos] = m_nodeList[pos]->X();
+      oldY[pos] = m_nodeList[pos]->Y();
+    }
+  }
+
+  int miny = 0, maxy = 0, start = ycoord;
+  LayoutSubtree(p_subtree, p_support, maxy, miny, ycoord);
+  int shift = ycoord - (start + terminals * settings.TerminalSpacing());
+  for (int pos = end + 1; pos <= m_nodeList.Length(); pos++) {
+    m_nodeList[pos]->SetY(m_nodeList[pos]->Y() + shift);
+  }
+  for (Gambit::GameNode node = parent; node; node = node->GetParent()) {
+    GetEntry(node)->SetY((GetEntry(node->GetChild(1))->Y() +
+			  GetEntry(node->GetChild(node->NumChildren()))->Y()) / 2);
+  }
+  m_maxY += shift;
+
+  m_maxX = 0;
+  if (settings.InfosetConnect() != GBT_INFOSET_CONNECT_NONE) {
+    LinkInfosetMembers();
+    Gambit::Array<gbtNodeEntry *> entries(m_nodeList.Length());
+    count = 0;
+    FillInfosetTable(m_doc->GetGame()->GetRoot(), p_support, entries, count);
+    NumberInfosetLines(entries, count);
+    UpdateTableInfosets();
+  }
+
+  UpdateTableParents(first, end);
+  GenerateLabels();
+  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+    if (pos < first || pos > end) {
+      gbtNodeEntry *entry = m_nodeList[pos];
+      if (entry->X() != oldX[pos] || entry->Y() != oldY[pos]) {
+	entry->OffsetOutcomeExtent(entry->X() - oldX[pos],
+				   entry->Y() - oldY[pos]);
+      }
+    }
+  }
+  ComputeOutcomeExtents(first, end);
+  BuildBands();
+}
+
+//
+// Sets the extent of each entry's outcome, and widens the layout to
+// take them in.  Rendering only draws the entries in view, so the
+// extents cannot wait to be found as the tree is drawn: instead the
+// outcomes are drawn once into a scratch bitmap.
+//
+void gbtTreeLayout::ComputeOutcomeExtents(int p_first, int p_last)
+{
+  wxBitmap bitmap(1, 1);
+  wxMemoryDC dc;
+  dc.SelectObject(bitmap);
+  for (int pos = p_first; pos <= p_last; pos++) {
+    m_nodeList[pos]->DrawOutcome(dc, false);
+  }
+  dc.SelectObject(wxNullBitmap);
+
+  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+    m_maxX = std::max(m_maxX, m_nodeList[pos]->GetOutcomeExtent().GetRight());
+  }
+}
+
+//
+// Files each entry in the bands covered by everything drawn on its
+// behalf: its node and labels, the branch from its parent, its outcome,
+// and the information set line to the next member.  Labels are drawn
+// just above and below the node and its branch; the allowance for them
+// is generous, as their extents are only known once drawn.
+//
+void gbtTreeLayout::BuildBands(void)
+{
+  const int margin = 3 * m_doc->GetStyle().GetFont().GetPointSize() + 30;
+  int numEntries = m_nodeList.Length();
+
+  Gambit::Array<int> top(numEntries), bottom(numEntries);
+  int maxBottom = 0;
+  for (int pos = 1; pos <= numEntries; pos++) {
+    gbtNodeEntry *entry = m_nodeList[pos];
+    int y1 = entry->Y() - std::max(entry->GetSize() / 2, 8);
+    int y2 = entry->Y() + std::max(entry->GetSize() / 2, 8);
+    y1 = std::min(y1, entry->GetOutcomeExtent().GetTop());
+    y2 = std::max(y2, entry->GetOutcomeExtent().GetBottom());
+    if (entry->GetParent() && entry->GetParent() != entry) {
+      y1 = std::min(y1, entry->GetParent()->Y());
+      y2 = std::max(y2, entry->GetParent()->Y());
+    }
+    if (entry->GetNextMember() && entry->GetNode()->GetInfoset()) {
+      y1 = std::min(y1, entry->GetNextMember()->Y());
+      y2 = std::max(y2, entry->GetNextMember()->Y());
+    }
+    top[pos] = y1 - margin;
+    bottom[pos] = y2 + margin;
+    maxBottom = std::max(maxBottom, bottom[pos]);
+  }
+
+  // Terminal nodes are drawn in their own right; other nodes are
+  // drawn along with their first child
+  m_isDrawn = Gambit::Array<bool>(numEntries);
+  for (int pos = 1; pos <= numEntries; pos++) {
+    m_isDrawn[pos] = (m_nodeList[pos]->GetNode()->NumChildren() == 0);
+  }
+  for (int pos = 1; pos <= numEntries; pos++) {
+    gbtNodeEntry *entry = m_nodeList[pos];
+    if (entry->GetChildNumber() == 1) {
+      m_isDrawn[GetPosition(entry->GetParent()->GetNode())] = true;
+    }
+  }
+
+  // Count the entries in each band first, so each band's list is
+  // allocated only once
+  m_bands = Gambit::Array<Gambit::Array<int> >(maxBottom / c_bandHeight + 1);
+  Gambit::Array<int> counts(m_bands.Length());
+  for (int band = 1; band <= counts.Length(); counts[band++] = 0);
+  m_firstBand = Gambit::Array<int>(numEntries);
+  for (int pos = 1; pos <= numEntries; pos++) {
+    m_firstBand[pos] = GetBand(top[pos]);
+    for (int band = m_firstBand[pos]; band <= GetBand(bottom[pos]); band++) {
+      counts[band]++;
+    }
+  }
+
+  for (int band = 1; band <= m_bands.Length(); band++) {
+    m_bands[band] = Gambit::Array<int>(counts[band]);
+    counts[band] = 0;
+  }
+  for (int pos = 1; pos <= numEntries; pos++) {
+    for (int band = m_firstBand[pos]; band <= GetBand(bottom[pos]); band++) {
+      m_bands[band][++counts[band]] = pos;
+    }
+  }
+}
+
+int gbtTreeLayout::GetBand(int p_y) const
+{
+  if (p_y < 0) return 1;
+  return std::min(p_y / c_bandHeight + 1, m_bands.Length());
+}
+
+const Gambit::Array<int> &gbtTreeLayout::GetBandEntries(int p_y) const
+{
+  static const Gambit::Array<int> s_noEntries;
+  if (m_bands.Length() == 0) return s_noEntries;
+  return m_bands[GetBand(p_y)];
 }
 
 void gbtTreeLayout::BuildNodeList(Gambit::GameNode p_node, const Gambit::BehaviorSupportProfile &p_support,
-				  int p_level)
+				  int p_level, int &p_count)
 {
   gbtNodeEntry *entry = new gbtNodeEntry(p_node);
   entry->SetStyle(&m_doc->GetStyle());
-  m_nodeList.Append(entry);
+  m_nodeList[++p_count] = entry;
+  m_nodePositions[p_node->GetNumber()] = p_count;
   entry->SetLevel(p_level);
+  Gambit::GameInfoset infoset = p_node->GetInfoset();
+  if (infoset && !infoset->GetPlayer()->IsChance() &&
+      p_support.NumActions(infoset) < infoset->NumActions()) {
+    m_supportRestricted = true;
+  }
   if (m_doc->GetStyle().RootReachable()) {
-    Gambit::GameInfoset infoset = p_node->GetInfoset();
     if (infoset) {
       if (infoset->GetPlayer()->IsChance()) {
 	for (int i = 1; i <= p_node->NumChildren(); i++) {
-	  BuildNodeList(p_node->GetChild(i), p_support, p_level + 1);
+	  BuildNodeList(p_node->GetChild(i), p_support, p_level + 1, p_count);
 	}
       }
       else {
 	for (int i = 1; i <= p_support.NumActions(infoset); i++) {
 	  BuildNodeList(p_node->GetChild(p_support.GetAction(infoset, i)->GetNumber()),
-			p_support, p_level + 1);
+			p_support, p_level + 1, p_count);
 	}
       }
     }
   }
   else {
     for (int i = 1; i <= p_node->NumChildren(); i++) {
-      BuildNodeList(p_node->GetChild(i), p_support, p_level + 1);
+      BuildNodeList(p_node->GetChild(i), p_support, p_level + 1, p_count);
     }
   }
   m_maxLevel = std::max(p_level, m_maxLevel);
@@ -854,12 +1142,31 @@ void gbtTreeLayout::BuildNodeList(Gambit::GameNode p_node, const Gambit::Behavio
 
 void gbtTreeLayout::BuildNodeList(const Gambit::BehaviorSupportProfile &p_support)
 {
-  while (m_nodeList.Length() > 0) {
-    delete m_nodeList.Remove(1);
+  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+    delete m_nodeList[pos];
   }
+  // The bands refer to the old entries; they are rebuilt by Layout()
+  m_bands = Gambit::Array<Gambit::Array<int> >();
+  m_firstBand = Gambit::Array<int>();
+  m_isDrawn = Gambit::Array<bool>();
+
+  m_nodePositions = Gambit::Array<int>(m_doc->GetGame()->NumNodes());
+  for (int i = 1; i <= m_nodePositions.Length(); m_nodePositions[i++] = 0);
 
   m_maxLevel = 0;
-  BuildNodeList(m_doc->GetGame()->GetRoot(), p_support, 0);
+  m_supportRestricted = false;
+  // The list is allocated once for every node of the game, and trimmed
+  // afterwards if some are not shown
+  m_nodeList = Gambit::Array<gbtNodeEntry *>(m_nodePositions.Length());
+  int count = 0;
+  BuildNodeList(m_doc->GetGame()->GetRoot(), p_support, 0, count);
+  if (count < m_nodeList.Length()) {
+    Gambit::Array<gbtNodeEntry *> shown(count);
+    for (int pos = 1; pos <= count; pos++) {
+      shown[pos] = m_nodeList[pos];
+    }
+    m_nodeList = shown;
+  }
 }
 
 
@@ -889,13 +1196,8 @@ void gbtTreeLayout::GenerateLabels(void)
       else {
 	int profile = m_doc->GetCurrentProfile();
 	if (profile > 0) {
-	  try {
-	    entry->SetActionProb((double) Gambit::lexical_cast<Gambit::Rational>(m_doc->GetProfiles().GetActionProb(parent, entry->GetChildNumber())));
-	  }
-	  catch (ValueException &) {
-	    // This occurs when the probability is undefined
-	    entry->SetActionProb(0.0);
-	  }
+	  // This is zero when the probability is undefined
+	  entry->SetActionProb(m_doc->GetProfiles().GetActionProbValue(parent, entry->GetChildNumber()));
 	}
       }
     }
@@ -903,106 +1205,106 @@ void gbtTreeLayout::GenerateLabels(void)
 }
 
 //
-// RenderSubtree: Render branches and labels
-//
-// The following speed optimizations have been added:
-// The algorithm now traverses the tree as a linear linked list, eliminating
-// expensive searches.
+// RenderEntry: Draws the entry's node, with its incoming branch, labels
+// and outcome, and the information set line to the next member.
 //
-// There was some clipping code in here, but it didn't correctly
-// deal with drawing information sets while scrolling.  So, the code
-// has temporarily been removed.  It remains to be seen whether
-// performance will require a more sophisticated solution to the
-// problem.  (TLT 5/2001)
-//
-void gbtTreeLayout::RenderSubtree(wxDC &p_dc, bool p_noHints) const
+void gbtTreeLayout::RenderEntry(wxDC &p_dc, const gbtNodeEntry *p_entry,
+				bool p_noHints) const
 {
   const gbtStyle &settings = m_doc->GetStyle();
 
-  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
-    gbtNodeEntry *entry = m_nodeList[pos];  
-    gbtNodeEntry *parentEntry = entry->GetParent();
-        
-    if (entry->GetChildNumber() == 1) {
-      parentEntry->Draw(p_dc, m_doc->GetSelectNode(), p_noHints);
+  p_entry->Draw(p_dc, m_doc->GetSelectNode(), p_noHints);
 
-      if (m_doc->GetStyle().InfosetConnect() != GBT_INFOSET_CONNECT_NONE &&
-	  parentEntry->GetNextMember()) {
-	int nextX = parentEntry->GetNextMember()->X();
-	int nextY = parentEntry->GetNextMember()->Y();
+  if (settings.InfosetConnect() != GBT_INFOSET_CONNECT_NONE &&
+      p_entry->GetNode()->GetInfoset() && p_entry->GetNextMember()) {
+    int nextX = p_entry->GetNextMember()->X();
+    int nextY = p_entry->GetNextMember()->Y();
 
-	if ((m_doc->GetStyle().InfosetConnect() !=
-	     GBT_INFOSET_CONNECT_SAMELEVEL) ||
-	    parentEntry->X() == nextX) {
+    if ((settings.InfosetConnect() != GBT_INFOSET_CONNECT_SAMELEVEL) ||
+	p_entry->X() == nextX) {
 #ifdef __WXGTK__
-	  // A problem with using styled pens and user scaling on wxGTK
-	  p_dc.SetPen(wxPen(parentEntry->GetColor(), 1, wxSOLID));
+      // A problem with using styled pens and user scaling on wxGTK
+      p_dc.SetPen(wxPen(p_entry->GetColor(), 1, wxSOLID));
 #else
-	  p_dc.SetPen(wxPen(parentEntry->GetColor(), 1, wxDOT));
+      p_dc.SetPen(wxPen(p_entry->GetColor(), 1, wxDOT));
 #endif   // __WXGTK__
-	  p_dc.DrawLine(parentEntry->X(), parentEntry->Y(), 
-			parentEntry->X(), nextY);
-	  if (settings.InfosetJoin() == GBT_INFOSET_JOIN_CIRCLES) {
-	    p_dc.DrawLine(parentEntry->X() + parentEntry->GetSize(), 
-			  parentEntry->Y(),
-			  parentEntry->X() + parentEntry->GetSize(), 
-			  nextY);
-	  }
+      p_dc.DrawLine(p_entry->X(), p_entry->Y(), p_entry->X(), nextY);
+      if (settings.InfosetJoin() == GBT_INFOSET_JOIN_CIRCLES) {
+	p_dc.DrawLine(p_entry->X() + p_entry->GetSize(), p_entry->Y(),
+		      p_entry->X() + p_entry->GetSize(), nextY);
+      }
 
-	  if (parentEntry->GetNextMember()->X() != parentEntry->X()) {
-	    // Draw a little arrow in the direction of the iset.
-	    int startX, endX; 
-	    if (settings.InfosetJoin() == GBT_INFOSET_JOIN_LINES) {
-	      startX = parentEntry->X();
-	      endX = (startX + m_infosetSpacing * 
-		      ((parentEntry->GetNextMember()->X() > 
-			parentEntry->X()) ? 1 : -1));
-	    }
-	    else {
-	      if (parentEntry->GetNextMember()->X() < parentEntry->X()) {
-		// information set is continued to the left
-		startX = parentEntry->X() + parentEntry->GetSize();
-		endX = parentEntry->X() - m_infosetSpacing;
-	      }
-	      else {
-		// information set is continued to the right
-		startX = parentEntry->X();
-		endX = (parentEntry->X() + parentEntry->GetSize() + 
-			m_infosetSpacing);
-	      }
-	    }
-	    p_dc.DrawLine(startX, nextY, endX, nextY);
-	    if (startX > endX) {
-	      p_dc.DrawLine(endX, nextY, endX + m_infosetSpacing / 2,
-			    nextY + m_infosetSpacing / 2);
-	      p_dc.DrawLine(endX, nextY, endX + m_infosetSpacing / 2,
-			    nextY - m_infosetSpacing / 2);
-	    }
-	    else {
-	      p_dc.DrawLine(endX, nextY, endX - m_infosetSpacing / 2,
-			    nextY + m_infosetSpacing / 2);
-	      p_dc.DrawLine(endX, nextY, endX - m_infosetSpacing / 2,
-			    nextY - m_infosetSpacing / 2);
-	    }
+      if (nextX != p_entry->X()) {
+	// Draw a little arrow in the direction of the iset.
+	int startX, endX; 
+	if (settings.InfosetJoin() == GBT_INFOSET_JOIN_LINES) {
+	  startX = p_entry->X();
+	  endX = (startX + m_infosetSpacing * 
+		  ((nextX > p_entry->X()) ? 1 : -1));
+	}
+	else {
+	  if (nextX < p_entry->X()) {
+	    // information set is continued to the left
+	    startX = p_entry->X() + p_entry->GetSize();
+	    endX = p_entry->X() - m_infosetSpacing;
 	  }
+	  else {
+	    // information set is continued to the right
+	    startX = p_entry->X();
+	    endX = (p_entry->X() + p_entry->GetSize() + m_infosetSpacing);
+	  }
+	}
+	p_dc.DrawLine(startX, nextY, endX, nextY);
+	if (startX > endX) {
+	  p_dc.DrawLine(endX, nextY, endX + m_infosetSpacing / 2,
+			nextY + m_infosetSpacing / 2);
+	  p_dc.DrawLine(endX, nextY, endX + m_infosetSpacing / 2,
+			nextY - m_infosetSpacing / 2);
+	}
+	else {
+	  p_dc.DrawLine(endX, nextY, endX - m_infosetSpacing / 2,
+			nextY + m_infosetSpacing / 2);
+	  p_dc.DrawLine(endX, nextY, endX - m_infosetSpacing / 2,
+			nextY - m_infosetSpacing / 2);
 	}
       }
     }
+  }
 
-    if (entry->GetNode()->NumChildren() == 0) {
-      entry->Draw(p_dc, m_doc->GetSelectNode(), p_noHints);
-    }
-
-    // As we draw, we determine the outcome label extents.  Adjust the
-    // overall size of the plot accordingly.
-    if (entry->GetOutcomeExtent().GetRight() > m_maxX) {
-      m_maxX = entry->GetOutcomeExtent().GetRight();
-    }
+  // The outcome extents are found by Layout(), but may differ slightly
+  // on the device drawn to.  Adjust the overall size of the plot
+  // accordingly.
+  if (p_entry->GetOutcomeExtent().GetRight() > m_maxX) {
+    m_maxX = p_entry->GetOutcomeExtent().GetRight();
   }
 }
 
 void gbtTreeLayout::Render(wxDC &p_dc, bool p_noHints) const
 { 
-  RenderSubtree(p_dc, p_noHints);
+  for (int pos = 1; pos <= m_isDrawn.Length(); pos++) {
+    if (m_isDrawn[pos]) {
+      RenderEntry(p_dc, m_nodeList[pos], p_noHints);
+    }
+  }
 }
 
+void gbtTreeLayout::Render(wxDC &p_dc, const wxRect &p_region,
+			   bool p_noHints) const
+{ 
+  if (m_bands.Length() == 0) return;
+
+  int firstBand = GetBand(p_region.GetTop());
+  int lastBand = GetBand(p_region.GetBottom());
+  for (int band = firstBand; band <= lastBand; band++) {
+    const Gambit::Array<int> &entries = m_bands[band];
+    for (int i = 1; i <= entries.Length(); i++) {
+      int pos = entries[i];
+      // An entry listed in several of the bands is drawn only once,
+      // from the first of them in the region
+      if (m_isDrawn[pos] && 
+	  (m_firstBand[pos] == band || band == firstBand)) {
+	RenderEntry(p_dc, m_nodeList[pos], p_noHints);
+      }
+    }
+  }
+}
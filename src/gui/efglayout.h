@@ -156,6 +156,8 @@ public:
 
   const wxRect &GetOutcomeExtent(void) const { return m_outcomeRect; }
   const wxRect &GetPayoffExtent(int pl) const { return m_payoffRect[pl]; }
+  /// Moves the extents of the outcome and its payoffs along with the node
+  void OffsetOutcomeExtent(int p_dx, int p_dy) const;
 
   void Draw(wxDC &, Gambit::GameNode selection, bool p_noHints) const;
   void DrawIncomingBranch(wxDC &) const;
@@ -168,27 +170,49 @@ class gbtTreeLayout : public gbtGameView {
 private:
   /* gbtEfgDisplay *m_parent; */
   Gambit::Array<gbtNodeEntry *> m_nodeList;
+  // The position in m_nodeList of each node's entry, indexed by node
+  // number; zero for nodes which are not shown
+  Gambit::Array<int> m_nodePositions;
+  // Whether the support the entries were built for lacks some actions
+  bool m_supportRestricted;
+  // A uniform grid of horizontal bands, each c_bandHeight high, over the
+  // layout.  Each band lists (in increasing order) the positions of the
+  // entries whose node, incoming branch, labels, outcome, or information
+  // set line may extend into it; hit-testing and rendering only consider
+  // the bands they touch.
+  Gambit::Array<Gambit::Array<int> > m_bands;
+  // The first band each entry is listed in
+  Gambit::Array<int> m_firstBand;
+  // Whether the entry's node is drawn when rendering
+  Gambit::Array<bool> m_isDrawn;
   mutable int m_maxX, m_maxY, m_maxLevel;
   int m_infosetSpacing;
 
-  const int c_leftMargin, c_topMargin;
+  const int c_leftMargin, c_topMargin, c_bandHeight;
 
   gbtNodeEntry *GetEntry(Gambit::GameNode) const;
+  int GetPosition(Gambit::GameNode) const;
 
-  gbtNodeEntry *NextInfoset(gbtNodeEntry *);
-  void CheckInfosetEntry(gbtNodeEntry *);
+  void LinkInfosetMembers(void);
+  void NumberInfosetLines(const Gambit::Array<gbtNodeEntry *> &, int);
 
-  void BuildNodeList(Gambit::GameNode, const Gambit::BehaviorSupportProfile &, int);
+  void BuildNodeList(Gambit::GameNode, const Gambit::BehaviorSupportProfile &, int, int &);
 
+  int LevelX(int p_level) const;
   int LayoutSubtree(Gambit::GameNode, const Gambit::BehaviorSupportProfile &, int &, int &, int &);
-  void FillInfosetTable(Gambit::GameNode, const Gambit::BehaviorSupportProfile &);
+  void FillInfosetTable(Gambit::GameNode, const Gambit::BehaviorSupportProfile &,
+			Gambit::Array<gbtNodeEntry *> &, int &);
   void UpdateTableInfosets(void);
-  void UpdateTableParents(void);
+  void UpdateTableParents(int p_first, int p_last);
+  void ComputeOutcomeExtents(int p_first, int p_last);
+  void BuildBands(void);
+  int GetBand(int p_y) const;
+  const Gambit::Array<int> &GetBandEntries(int p_y) const;
 
   wxString CreateNodeLabel(const gbtNodeEntry *, int) const;
   wxString CreateBranchLabel(const gbtNodeEntry *, int) const;
 
-  void RenderSubtree(wxDC &dc, bool p_noHints) const;
+  void RenderEntry(wxDC &dc, const gbtNodeEntry *, bool p_noHints) const;
 
   // Overriding gbtGameView members
   void OnUpdate(void) { }
@@ -202,6 +226,9 @@ public:
 
   void BuildNodeList(const Gambit::BehaviorSupportProfile &);
   void Layout(const Gambit::BehaviorSupportProfile &);
+  /// Lays out the tree again after a change confined to the subtree
+  /// rooted at the node
+  void Layout(const Gambit::BehaviorSupportProfile &, Gambit::GameNode p_subtree);
   void GenerateLabels(void);
 
   // The following member functions are for temporary compatibility only
@@ -219,7 +246,11 @@ public:
   Gambit::GameNode BranchBelowHitTest(int, int) const;
   Gambit::GameNode InfosetHitTest(int, int) const;
 
+  /// Renders the whole tree
   void Render(wxDC &, bool p_noHints) const;
+  /// Renders only the parts of the tree which may intersect the
+  /// rectangle, given in layout coordinates
+  void Render(wxDC &, const wxRect &p_region, bool p_noHints) const;
 };
 
 #endif  // EFGLAYOUT_H
@@ -188,7 +188,7 @@ bool gbtStrategyDominanceStack::PreviousLevel(void)
 
 gbtGameDocument::gbtGameDocument(Gambit::Game p_game) 
   : m_game(p_game),
-    m_selectNode(0), m_modified(false),
+    m_selectNode(0), m_editedSubtree(0), m_modified(false),
     m_behavSupports(this, true), m_stratSupports(this, true),
     m_currentProfileList(0)
 {
@@ -355,7 +355,8 @@ void gbtGameDocument::SaveDocument(std::ostream &p_file) const
   p_file << "</gambit:document>\n";
 }
 
-void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications)
+void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications,
+				  Gambit::GameNode p_subtree)
 {
   if (p_modifications != GBT_DOC_MODIFIED_NONE) {
     m_modified = true;
@@ -381,7 +382,9 @@ void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications)
     m_currentProfileList = 0;
   }
 
+  m_editedSubtree = p_subtree;
   for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
+  m_editedSubtree = 0;
 }
 
 void gbtGameDocument::PostPendingChanges(void)
@@ -730,7 +733,7 @@ void gbtGameDocument::DoSetNodeLabel(GameNode p_node, const wxString &p_label)
 void gbtGameDocument::DoAppendMove(GameNode p_node, GameInfoset p_infoset)
 {
   p_node->AppendMove(p_infoset);
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node);
 }
 
 void gbtGameDocument::DoInsertMove(GameNode p_node, GamePlayer p_player,
@@ -740,19 +743,19 @@ void gbtGameDocument::DoInsertMove(GameNode p_node, GamePlayer p_player,
   for (int act = 1; act <= infoset->NumActions(); act++) {
     infoset->GetAction(act)->SetLabel(lexical_cast<std::string>(act));
   }
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node->GetParent());
 }
 
 void gbtGameDocument::DoInsertMove(GameNode p_node, GameInfoset p_infoset)
 {
   p_node->InsertMove(p_infoset);
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node->GetParent());
 }
 
 void gbtGameDocument::DoCopyTree(GameNode p_destNode, GameNode p_srcNode)
 {
   p_destNode->CopyTree(p_srcNode);
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_destNode);
 }
 
 void gbtGameDocument::DoMoveTree(GameNode p_destNode, GameNode p_srcNode)
@@ -765,13 +768,13 @@ void gbtGameDocument::DoDeleteParent(GameNode p_node)
 {
   if (!p_node || !p_node->GetParent()) return;
   p_node->DeleteParent();
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node);
 }
 
 void gbtGameDocument::DoDeleteTree(GameNode p_node)
 {
   p_node->DeleteTree();
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node);
 }
 
 void gbtGameDocument::DoSetPlayer(GameInfoset p_infoset, GamePlayer p_player)
@@ -795,7 +798,7 @@ void gbtGameDocument::DoSetPlayer(GameNode p_node, GamePlayer p_player)
 void gbtGameDocument::DoNewOutcome(GameNode p_node)
 {
   p_node->SetOutcome(m_game->NewOutcome());
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS, p_node);
 }
 
 void gbtGameDocument::DoNewOutcome(const PureStrategyProfile &p_profile)
@@ -807,14 +810,14 @@ void gbtGameDocument::DoNewOutcome(const PureStrategyProfile &p_profile)
 void gbtGameDocument::DoSetOutcome(GameNode p_node, GameOutcome p_outcome)
 {
   p_node->SetOutcome(p_outcome);
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS, p_node);
 }
 
 void gbtGameDocument::DoRemoveOutcome(GameNode p_node)
 {
   if (!p_node || !p_node->GetOutcome()) return;
   p_node->SetOutcome(0);
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS, p_node);
 }
 
 void gbtGameDocument::DoCopyOutcome(GameNode p_node, GameOutcome p_outcome)
@@ -825,7 +828,7 @@ void gbtGameDocument::DoCopyOutcome(GameNode p_node, GameOutcome p_outcome)
     outcome->SetPayoff(pl, p_outcome->GetPayoff<std::string>(pl));
   }
   p_node->SetOutcome(outcome);
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS, p_node);
 }
 
 void gbtGameDocument::DoSetPayoff(GameOutcome p_outcome, int p_player,
@@ -842,3 +845,10 @@ void gbtGameDocument::DoAddOutput(gbtAnalysisOutput &p_list,
   p_list.AddOutput(p_output);
   UpdateViews(GBT_DOC_MODIFIED_NONE);
 }
+
+void gbtGameDocument::DoAddOutput(gbtAnalysisOutput &p_list,
+				  const std::string &p_output)
+{
+  p_list.AddBinaryOutput(p_output);
+  UpdateViews(GBT_DOC_MODIFIED_NONE);
+}
@@ -230,6 +230,9 @@ private:
 
   gbtStyle m_style;
   Gambit::GameNode m_selectNode;
+  // While the views are being updated, the root of the subtree to which
+  // the modification was confined, if it is known to be
+  Gambit::GameNode m_editedSubtree;
   bool m_modified;
 
   gbtBehavDominanceStack m_behavSupports;
@@ -241,7 +244,8 @@ private:
   Gambit::List<std::string> m_undoList, m_redoList;
 
 
-  void UpdateViews(gbtGameModificationType p_modifications);
+  void UpdateViews(gbtGameModificationType p_modifications,
+		   Gambit::GameNode p_subtree = 0);
 
 public:
   gbtGameDocument(Gambit::Game p_game);
@@ -263,6 +267,11 @@ public:
   const wxString &GetFilename(void) const { return m_filename; }
   void SetFilename(const wxString &p_filename) { m_filename = p_filename; }
 
+  /// Returns the root of the subtree to which the modification being
+  /// reported to the views was confined, or null if it was not (or is
+  /// not known to have been) confined to one subtree
+  Gambit::GameNode GetEditedSubtree(void) const { return m_editedSubtree; }
+
   bool IsModified(void) const { return m_modified; }
   void SetModified(bool p_modified) { m_modified = p_modified; }
 
@@ -381,6 +390,7 @@ public:
 		   const wxString &p_value);
 
   void DoAddOutput(gbtAnalysisOutput &p_list, const wxString &p_output);
+  void DoAddOutput(gbtAnalysisOutput &p_list, const std::string &p_output);
 };
 
 class gbtGameView {
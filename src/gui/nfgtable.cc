@@ -279,11 +279,11 @@ void gbtRowPlayerWidget::DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords)
   const Gambit::StrategySupportProfile &support = m_doc->GetNfgSupport();
   int player = m_table->GetRowPlayer(p_coords.GetCol() + 1);
   int strat = m_table->RowToStrategy(p_coords.GetCol() + 1, p_coords.GetRow());
-  Gambit::GameStrategy strategy = support.GetStrategy(player, strat);
+  int dominance = m_table->GetDominance(support.GetStrategy(player, strat));
 
-  if (support.IsDominated(strategy, false)) {
+  if (dominance > 0) {
     wxRect rect = CellToRect(p_coords);
-    if (support.IsDominated(strategy, true)) {
+    if (dominance == 2) {
       p_dc.SetPen(wxPen(m_doc->GetStyle().GetPlayerColor(player),
 			2, wxSOLID));
     }
@@ -308,11 +308,18 @@ void gbtRowPlayerWidget::OnUpdate(void)
   if (newCols < GetNumberCols())  DeleteCols(0, GetNumberCols() - newCols);
   if (newCols == 0)  InsertCols(0, 1);
 
+  // Clear all the spans at once; setting each cell back to a single
+  // row one at a time takes time quadratic in the number of rows.
+  // Unlike SetCellSpan(), this does not refresh the cells which were
+  // spanned, so they are refreshed here.
+  wxSheetSelection *spans = GetTable()->GetSpannedBlocks();
+  if (spans->HasSelection()) {
+    RefreshGridCellBlock(spans->GetBoundingBlock());
+    spans->Clear();
+  }
   for (int col = 0; col < GetNumberCols(); col++) {
-    for (int row = 0; row < GetNumberRows(); 
-	 SetCellSpan(wxSheetCoords(row++, col), wxSheetCoords(1, 1)));
-
     int span = m_table->NumRowsSpanned(col+1);
+    if (span == 1)  continue;
 
     int row = 0;
     while (row < GetNumberRows()) {
@@ -445,11 +452,16 @@ void gbtColPlayerWidget::OnUpdate(void)
   if (newRows < GetNumberRows())  DeleteRows(0, GetNumberRows() - newRows);
   if (newRows == 0)  InsertRows(0, 1);
 
+  // As for the row player sheet, clear all the spans at once, and
+  // refresh the cells which were spanned
+  wxSheetSelection *spans = GetTable()->GetSpannedBlocks();
+  if (spans->HasSelection()) {
+    RefreshGridCellBlock(spans->GetBoundingBlock());
+    spans->Clear();
+  }
   for (int row = 0; row < GetNumberRows(); row++) {
-    for (int col = 0; col < GetNumberCols(); 
-	 SetCellSpan(wxSheetCoords(row, col++), wxSheetCoords(1, 1)));
-
     int span = m_table->NumColsSpanned(row+1) * m_doc->NumPlayers();
+    if (span == 1)  continue;
 
     int col = 0;
     while (col < GetNumberCols()) {
@@ -516,11 +528,11 @@ void gbtColPlayerWidget::DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords)
   const Gambit::StrategySupportProfile &support = m_doc->GetNfgSupport();
   int player = m_table->GetColPlayer(p_coords.GetRow() + 1);
   int strat = m_table->ColToStrategy(p_coords.GetRow() + 1, p_coords.GetCol());
-  Gambit::GameStrategy strategy = support.GetStrategy(player, strat);
+  int dominance = m_table->GetDominance(support.GetStrategy(player, strat));
 
-  if (support.IsDominated(strategy, false)) {
+  if (dominance > 0) {
     wxRect rect = CellToRect(p_coords);
-    if (support.IsDominated(strategy, true)) {
+    if (dominance == 2) {
       p_dc.SetPen(wxPen(m_doc->GetStyle().GetPlayerColor(player),
 			2, wxSOLID));
     }
@@ -598,6 +610,8 @@ private:
 
   /// Maps columns to corresponding player
   int ColToPlayer(int p_col) const;
+  /// Returns the strategy of the cell's player in its contingency
+  Gambit::GameStrategy CellToStrategy(const wxSheetCoords &p_coords) const;
 
 public:
   gbtPayoffsWidget(gbtTableWidget *p_parent, gbtGameDocument *p_doc);
@@ -638,6 +652,22 @@ int gbtPayoffsWidget::ColToPlayer(int p_col) const
   }
 }
 
+Gambit::GameStrategy 
+gbtPayoffsWidget::CellToStrategy(const wxSheetCoords &p_coords) const
+{
+  const Gambit::StrategySupportProfile &support = m_doc->GetNfgSupport();
+  int index = p_coords.GetCol() % m_doc->NumPlayers() + 1;
+  if (index <= m_table->NumRowPlayers()) {
+    return support.GetStrategy(m_table->GetRowPlayer(index),
+			       m_table->RowToStrategy(index, p_coords.GetRow()));
+  }
+  else {
+    index -= m_table->NumRowPlayers();
+    return support.GetStrategy(m_table->GetColPlayer(index),
+			       m_table->ColToStrategy(index, p_coords.GetCol()));
+  }
+}
+
 void gbtPayoffsWidget::OnUpdate(void)
 {
   int newCols = m_table->NumColContingencies() * m_doc->NumPlayers();
@@ -655,9 +685,7 @@ wxString gbtPayoffsWidget::GetCellValue(const wxSheetCoords &p_coords)
 {
   if (IsLabelCell(p_coords))  return wxT("");
 
-  Gambit::PureStrategyProfile profile = m_table->CellToProfile(p_coords);
-  int player = ColToPlayer(p_coords.GetCol());
-  return wxString(Gambit::lexical_cast<std::string>(profile->GetPayoff(player)).c_str(), *wxConvCurrent);
+  return m_table->GetPayoffText(p_coords, ColToPlayer(p_coords.GetCol()));
 }
 
 void gbtPayoffsWidget::SetCellValue(const wxSheetCoords &p_coords,
@@ -737,13 +765,12 @@ void gbtPayoffsWidget::DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords)
 
   if (!m_table->ShowDominance() || IsLabelCell(p_coords)) return;
 
-  Gambit::PureStrategyProfile profile = m_table->CellToProfile(p_coords);
   int player = ColToPlayer(p_coords.GetCol());
-  const Gambit::StrategySupportProfile &support = m_doc->GetNfgSupport();
+  int dominance = m_table->GetDominance(CellToStrategy(p_coords));
 
-  if (support.IsDominated(profile->GetStrategy(player), false)) {
+  if (dominance > 0) {
     wxRect rect = CellToRect(p_coords);
-    if (support.IsDominated(profile->GetStrategy(player), true)) {
+    if (dominance == 2) {
       p_dc.SetPen(wxPen(m_doc->GetStyle().GetPlayerColor(player),
 			2, wxSOLID));
     }
@@ -990,6 +1017,11 @@ void gbtTableWidget::OnUpdate(void)
     }
   }
 
+  // Any change to the document may change the payoffs, the support,
+  // or the arrangement of the players
+  m_payoffText.clear();
+  m_dominance.clear();
+
   dynamic_cast<gbtPayoffsWidget *>(m_payoffSheet)->OnUpdate();
 
   // We add margins to the player labels to match the scrollbars,
@@ -1133,6 +1165,61 @@ gbtTableWidget::CellToProfile(const wxSheetCoords &p_coords) const
   return profile;
 }
 
+//=========================================================================
+//                  gbtTableWidget: Cached cell contents
+//=========================================================================
+
+//
+// The payoff sheet asks for the contents of each cell it draws, and
+// only draws the cells which are visible.  Building the profile for a
+// contingency and formatting its payoffs is comparatively expensive,
+// so the formatted payoffs of all players are kept for the contingencies
+// most recently shown.  The cache is emptied when it grows past a few
+// screenfuls of contingencies, and on every update from the document.
+//
+static const unsigned int s_maxCachedContingencies = 4096;
+
+wxString gbtTableWidget::GetPayoffText(const wxSheetCoords &p_coords,
+				       int p_player) const
+{
+  std::pair<int, int> key(p_coords.GetRow(), 
+			  p_coords.GetCol() / m_doc->NumPlayers());
+  std::map<std::pair<int, int>, Gambit::Array<wxString> >::const_iterator cell = m_payoffText.find(key);
+  if (cell == m_payoffText.end()) {
+    if (m_payoffText.size() >= s_maxCachedContingencies) {
+      m_payoffText.clear();
+    }
+
+    Gambit::PureStrategyProfile profile = CellToProfile(p_coords);
+    Gambit::Array<wxString> payoffs(m_doc->NumPlayers());
+    for (int pl = 1; pl <= payoffs.Length(); pl++) {
+      payoffs[pl] = wxString(Gambit::lexical_cast<std::string>(profile->GetPayoff(pl)).c_str(), *wxConvCurrent);
+    }
+    cell = m_payoffText.insert(std::make_pair(key, payoffs)).first;
+  }
+  return cell->second[p_player];
+}
+
+//
+// Checking dominance compares the strategy with each of the player's
+// other strategies against every contingency, and each cell drawn with
+// dominance indicators shown needs it; the result is kept until the
+// next update.
+//
+int gbtTableWidget::GetDominance(const Gambit::GameStrategy &p_strategy) const
+{
+  std::map<Gambit::GameStrategyRep *, int>::const_iterator entry = m_dominance.find(p_strategy);
+  if (entry != m_dominance.end())  return entry->second;
+
+  const Gambit::StrategySupportProfile &support = m_doc->GetNfgSupport();
+  int dominance = 0;
+  if (support.IsDominated(p_strategy, false)) {
+    dominance = (support.IsDominated(p_strategy, true)) ? 2 : 1;
+  }
+  m_dominance[p_strategy] = dominance;
+  return dominance;
+}
+
 class gbtNfgPrintout : public wxPrintout {
 private:
   gbtTableWidget *m_table;
@@ -23,6 +23,8 @@
 #ifndef NFGTABLE_H
 #define NFGTABLE_H
 
+#include <map>
+
 class gbtGameDocument;
 class gbtNfgPanel;
 
@@ -39,6 +41,12 @@ private:
 
   Gambit::Array<int> m_rowPlayers, m_colPlayers;
 
+  /// Formatted payoffs of the contingencies recently displayed, keyed
+  /// by row and column contingency; each lists the payoffs of all players
+  mutable std::map<std::pair<int, int>, Gambit::Array<wxString> > m_payoffText;
+  /// Dominance of the strategies displayed, as returned by GetDominance()
+  mutable std::map<Gambit::GameStrategyRep *, int> m_dominance;
+
   /// @name Event handlers
   //@{
   /// Called when row label sheet is scrolled
@@ -129,6 +137,16 @@ public:
   Gambit::PureStrategyProfile CellToProfile(const wxSheetCoords &) const;
   //@}
 
+  /// @name Cached cell contents
+  //@{
+  /// Returns the player's payoff in the contingency of a payoff cell,
+  /// formatted for display
+  wxString GetPayoffText(const wxSheetCoords &, int p_player) const;
+  /// Returns 2 if the strategy is strictly dominated in the current
+  /// support, 1 if it is weakly dominated, and 0 otherwise
+  int GetDominance(const Gambit::GameStrategy &) const;
+  //@}
+
   /// @name Exporting/printing graphics
   //@{
   /// Creates a printout object of the game as currently displayed
@@ -22,6 +22,8 @@
 import itertools
 
 from libcpp cimport bool
+from libc.stdlib cimport malloc, free
+from cpython.buffer cimport PyBUF_WRITABLE, PyBUF_STRIDES, PyBUF_FORMAT
 from gambit.lib.error import UndefinedOperationError
 import gambit.gte
 
@@ -119,6 +121,72 @@ cdef class GameStrategies(Collection):
         s.strategy = self.game.deref().GetStrategy(st+1)
         return s
 
+cdef class PayoffTensor(object):
+    """A read-only copy of the payoffs of a strategic game, exported through
+    the buffer protocol.  Entry [pl, s1, ..., sn] is the payoff to player pl
+    when each player i plays strategy si.  numpy.asarray() gives a view of
+    the tensor without copying it."""
+    cdef double *payoffs
+    cdef Py_ssize_t ndim
+    cdef Py_ssize_t *shape
+    cdef Py_ssize_t *strides
+
+    def __cinit__(self):
+        self.payoffs = NULL
+        self.shape = NULL
+        self.strides = NULL
+
+    def __dealloc__(self):
+        free(self.payoffs)
+        free(self.shape)
+        free(self.strides)
+
+    cdef load(self, Game g):
+        cdef Py_ssize_t stride
+        cdef int i, num_players, num_cont
+        num_players = len(g.players)
+        num_cont = NumContingencies(g.game)
+        self.ndim = num_players + 1
+        self.shape = <Py_ssize_t *> malloc(self.ndim * sizeof(Py_ssize_t))
+        self.strides = <Py_ssize_t *> malloc(self.ndim * sizeof(Py_ssize_t))
+        self.payoffs = <double *> malloc(max(num_players * num_cont, 1) * sizeof(double))
+        if self.shape == NULL or self.strides == NULL or self.payoffs == NULL:
+            raise MemoryError()
+        self.shape[0] = num_players
+        self.strides[0] = num_cont * sizeof(double)
+        stride = sizeof(double)
+        for i in range(num_players):
+            self.shape[i+1] = len(g.players[i].strategies)
+            self.strides[i+1] = stride
+            stride *= self.shape[i+1]
+        GetPayoffs(g.game, self.payoffs)
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        cdef Py_ssize_t i
+        if flags & PyBUF_WRITABLE:
+            raise BufferError("Payoff tensor is read-only")
+        if (flags & PyBUF_STRIDES) != PyBUF_STRIDES:
+            raise BufferError("Payoff tensor requires a strided buffer")
+        buffer.buf = self.payoffs
+        buffer.obj = self
+        buffer.itemsize = sizeof(double)
+        buffer.len = buffer.itemsize
+        for i in range(self.ndim):
+            buffer.len *= self.shape[i]
+        buffer.readonly = 1
+        if flags & PyBUF_FORMAT:
+            buffer.format = b"d"
+        else:
+            buffer.format = NULL
+        buffer.ndim = self.ndim
+        buffer.shape = self.shape
+        buffer.strides = self.strides
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
 cdef class Game(object):
     cdef c_Game game
 
@@ -144,15 +212,42 @@ cdef class Game(object):
     @classmethod
     def from_arrays(cls, *arrays):
         cdef Game g
+        cdef double[::1] payoffs
+        cdef long[::1] num, den
+        import numpy
+        arrays = [ numpy.asarray(a) for a in arrays ]
         if len(set(a.shape for a in arrays)) > 1:
             raise ValueError("All specified arrays must have the same shape")
+        if len(arrays) != len(arrays[0].shape):
+            raise ValueError("Number of arrays must equal the number of dimensions")
         g = Game.new_table(arrays[0].shape)
+        if arrays[0].size == 0:
+            return g
+        # Integer and floating-point arrays are loaded in a single call,
+        # with the payoffs of all players concatenated in the order used
+        # by the table (strategy of the first player varying fastest).
+        kinds = set(a.dtype.kind for a in arrays)
+        if kinds <= set("biu"):
+            try:
+                num = numpy.concatenate([ a.astype(numpy.int_, casting="safe").ravel(order="F")
+                                          for a in arrays ])
+            except TypeError:
+                # Unsigned values which may not fit in a long
+                kinds = set("O")
+            else:
+                den = numpy.ones(len(num), dtype=numpy.int_)
+                SetPayoffs(g.game, &num[0], &den[0])
+                return g
+        elif kinds <= set("biuf"):
+            payoffs = numpy.concatenate([ a.astype(numpy.float64).ravel(order="F")
+                                          for a in arrays ])
+            SetPayoffs(g.game, &payoffs[0])
+            return g
         for profile in itertools.product(*(xrange(arrays[0].shape[i])
                                          for i in xrange(len(g.players)))):
             for pl in xrange(len(g.players)):
                 g[profile][pl] = arrays[pl][profile]
         return g
-        
 
     @classmethod
     def read_game(cls, char *fn):
@@ -373,6 +468,15 @@ cdef class Game(object):
     def support_profile(self):
         return StrategySupportProfile(list(self.strategies), self)
 
+    def payoff_tensor(self):
+        cdef PayoffTensor t
+        if self.is_tree:
+            raise UndefinedOperationError("Operation only defined for "\
+                                           "games with a strategic representation")
+        t = PayoffTensor()
+        t.load(self)
+        return t
+
     def num_nodes(self):
         if self.is_tree:
             return self.game.deref().NumNodes()
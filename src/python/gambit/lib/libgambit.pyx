@@ -243,6 +243,8 @@ cdef extern from "gambit/game.h":
         c_Rational GetMaxPayoff(int)
         bool IsPerfectRecall()
 
+        c_Game Copy() except +RuntimeError
+
         c_PureStrategyProfile NewPureStrategyProfile()
         c_MixedStrategyProfileDouble NewMixedStrategyProfile(double)
         c_MixedStrategyProfileRational NewMixedStrategyProfile(c_Rational)
@@ -361,6 +363,7 @@ cdef extern from "gambit/stratspt.h":
         c_GameStrategy GetStrategy(int, int) except +IndexError
         bool Contains(c_GameStrategy)
         c_StrategySupportProfile Undominated(bool, bool)
+        c_StrategySupportProfile IteratedUndominated(bool, bool)
         c_MixedStrategyProfileDouble NewMixedStrategyProfileDouble "NewMixedStrategyProfile<double>"()
         c_MixedStrategyProfileRational NewMixedStrategyProfileRational "NewMixedStrategyProfile<Rational>"()
 
@@ -371,8 +374,14 @@ cdef extern from "util.h":
     cxx_string WriteGame(c_StrategySupportProfile) except +IOError
 
     c_Rational to_rational(char *)
+
+    int NumContingencies(c_Game) except +TypeError
+    void GetPayoffs(c_Game, double *) except +TypeError
+    void SetPayoffs(c_Game, double *) except +ValueError
+    void SetPayoffs(c_Game, long *, long *) except +ValueError
     
     void setitem_array_int "setitem"(Array[int] *, int, int)
+    void setitem_array_game "setitem"(Array[c_Game] *, int, c_Game)
 
     void setitem_mspd_int "setitem"(c_MixedStrategyProfileDouble *, int, double)
     void setitem_mspd_strategy "setitem"(c_MixedStrategyProfileDouble *,
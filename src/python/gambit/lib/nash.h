@@ -20,8 +20,13 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif  // _OPENMP
+
 #include "gambit/gambit.h"
 #include "tools/logit/nfglogit.h"
+#include "tools/liap/nfgliap.h"
 
 using namespace std;
 using namespace Gambit;
@@ -54,6 +59,13 @@ logit_atlambda(const Game &p_game, double p_lambda)
 							    p_lambda, 1.0));
 }
 
+LogitQREMixedStrategyProfile *
+logit_continue(const LogitQREMixedStrategyProfile &p_start, const Game &p_game)
+{
+  StrategicQREPathTracer alg;
+  return new LogitQREMixedStrategyProfile(alg.SolveAtGame(p_start, p_game));
+}
+
 List<LogitQREMixedStrategyProfile>
 logit_principal_branch(const Game &p_game, double p_maxLambda=1000000.0)
 {
@@ -64,3 +76,86 @@ logit_principal_branch(const Game &p_game, double p_maxLambda=1000000.0)
   return alg.TraceStrategicPath(p_game, null_stream, p_maxLambda, 1.0);
 }
 
+//
+// Solver returning the terminal profile on the principal branch of the
+// logit QRE correspondence, which approximates a Nash equilibrium.
+//
+class NashLogitStrategySolver : public StrategySolver<double> {
+public:
+  NashLogitStrategySolver(double p_maxLambda = 1000000.0)
+    : m_maxLambda(p_maxLambda) { }
+  virtual ~NashLogitStrategySolver() { }
+
+  List<MixedStrategyProfile<double> > Solve(const Game &p_game) const
+  {
+    StrategicQREPathTracer alg;
+    alg.SetFullGraph(false);
+    alg.SetContext(m_context);
+    NullBuffer null_buffer;
+    std::ostream null_stream(&null_buffer);
+    List<LogitQREMixedStrategyProfile> branch =
+      alg.TraceStrategicPath(LogitQREMixedStrategyProfile(p_game), null_stream,
+			     m_maxLambda, 1.0);
+    List<MixedStrategyProfile<double> > eqa;
+    // A branch cut short by the context does not end at an equilibrium
+    if (!branch.empty() && !(m_context.get() && m_context->IsInterrupted())) {
+      eqa.push_back(branch.back().GetProfile());
+    }
+    return eqa;
+  }
+
+private:
+  double m_maxLambda;
+};
+
+//
+// The solvers below are run without holding the Python global interpreter
+// lock.  Reference counts on game objects are not atomic, so a solver
+// must only ever see a private copy of a game, obtained via Game::Copy()
+// while the lock is held.  The profiles it computes are then transferred
+// back to the original game, again with the lock held.
+//
+
+// Create a copy on the heap of the profile at index p_index of p_profiles,
+// computed on a copy of p_game, as a profile on p_game itself
+template <class T> MixedStrategyProfile<T> *
+transfer_profile(const Game &p_game, const List<MixedStrategyProfile<T> > &p_profiles,
+		 int p_index)
+{
+  const MixedStrategyProfile<T> &source = p_profiles[p_index];
+  MixedStrategyProfile<T> *profile =
+    new MixedStrategyProfile<T>(p_game->NewMixedStrategyProfile(T(0)));
+  for (int i = 1; i <= source.MixedProfileLength(); i++) {
+    (*profile)[i] = source[i];
+  }
+  return profile;
+}
+
+// Solve each of the (private copies of) games in p_games with p_solver,
+// using up to p_threads threads (all available if p_threads <= 0).
+// The message of any exception thrown in solving game i is stored in
+// p_errors[i].
+template <class T> void
+solve_batch(const StrategySolver<T> *p_solver, const Array<Game> *p_games,
+	    Array<List<MixedStrategyProfile<T> > > *p_results,
+	    Array<std::string> *p_errors, int p_threads)
+{
+  int numGames = p_games->Length();
+#ifdef _OPENMP
+  if (p_threads <= 0) {
+    p_threads = omp_get_max_threads();
+  }
+#pragma omp parallel for schedule(dynamic) num_threads(p_threads)
+#endif  // _OPENMP
+  for (int i = 1; i <= numGames; i++) {
+    try {
+      (*p_results)[i] = p_solver->Solve((*p_games)[i]);
+    }
+    catch (std::exception &e) {
+      (*p_errors)[i] = e.what();
+    }
+    catch (...) {
+      (*p_errors)[i] = "Unknown error";
+    }
+  }
+}
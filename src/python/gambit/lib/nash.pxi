@@ -315,10 +315,104 @@ cdef class LPStrategySolverRational(object):
         return ret
 
 
+cdef extern from "gambit/nash.h":
+    cdef cppclass c_StrategySolverDouble "StrategySolver<double>":
+        pass
+    cdef cppclass c_StrategySolverRational "StrategySolver<Rational>":
+        pass
+
+cdef extern from "nash.h":
+    c_MixedStrategyProfileDouble *transfer_profile_mspd "transfer_profile"(c_Game, c_List[c_MixedStrategyProfileDouble], int)
+    c_MixedStrategyProfileRational *transfer_profile_mspr "transfer_profile"(c_Game, c_List[c_MixedStrategyProfileRational], int)
+    void solve_batch_double "solve_batch"(c_StrategySolverDouble *, Array[c_Game] *,
+                                          Array[c_List[c_MixedStrategyProfileDouble]] *,
+                                          Array[cxx_string] *, int) nogil
+    void solve_batch_rational "solve_batch"(c_StrategySolverRational *, Array[c_Game] *,
+                                            Array[c_List[c_MixedStrategyProfileRational]] *,
+                                            Array[cxx_string] *, int) nogil
+
+# The solvers below run without holding the GIL.  Each works on a private
+# copy of the game, and the resulting profiles are transferred back to the
+# caller's game; see nash.h.
+
+cdef _transfer_mspd(Game game, c_List[c_MixedStrategyProfileDouble] solns):
+    cdef MixedStrategyProfileDouble p
+    ret = [ ]
+    for i in xrange(solns.Length()):
+        p = MixedStrategyProfileDouble()
+        p.profile = transfer_profile_mspd(game.game, solns, i+1)
+        ret.append(p)
+    return ret
+
+cdef _transfer_mspr(Game game, c_List[c_MixedStrategyProfileRational] solns):
+    cdef MixedStrategyProfileRational p
+    ret = [ ]
+    for i in xrange(solns.Length()):
+        p = MixedStrategyProfileRational()
+        p.profile = transfer_profile_mspr(game.game, solns, i+1)
+        ret.append(p)
+    return ret
+
+cdef Array[c_Game] *_copy_games(games) except NULL:
+    cdef Array[c_Game] *copies
+    copies = new Array[c_Game](len(games))
+    try:
+        for (i, game) in enumerate(games):
+            setitem_array_game(copies, i+1, (<Game?>game).game.deref().Copy())
+    except:
+        del copies
+        raise
+    return copies
+
+cdef _check_batch_errors(Array[cxx_string] *errors):
+    cdef cxx_string msg
+    for i in xrange(errors.Length()):
+        msg = errors.getitem(i+1)
+        if msg.c_str()[0] != 0:
+            raise RuntimeError("Error solving game %d: %s" % (i, msg.c_str()))
+
+cdef _solve_batch_double(c_StrategySolverDouble *alg, games, int threads):
+    cdef Array[c_Game] *copies
+    cdef Array[c_List[c_MixedStrategyProfileDouble]] *results
+    cdef Array[cxx_string] *errors
+    games = list(games)
+    copies = _copy_games(games)
+    results = new Array[c_List[c_MixedStrategyProfileDouble]](len(games))
+    errors = new Array[cxx_string](len(games))
+    try:
+        with nogil:
+            solve_batch_double(alg, copies, results, errors, threads)
+        _check_batch_errors(errors)
+        return [ _transfer_mspd(game, results.getitem(i+1))
+                 for (i, game) in enumerate(games) ]
+    finally:
+        del results
+        del errors
+        del copies
+
+cdef _solve_batch_rational(c_StrategySolverRational *alg, games, int threads):
+    cdef Array[c_Game] *copies
+    cdef Array[c_List[c_MixedStrategyProfileRational]] *results
+    cdef Array[cxx_string] *errors
+    games = list(games)
+    copies = _copy_games(games)
+    results = new Array[c_List[c_MixedStrategyProfileRational]](len(games))
+    errors = new Array[cxx_string](len(games))
+    try:
+        with nogil:
+            solve_batch_rational(alg, copies, results, errors, threads)
+        _check_batch_errors(errors)
+        return [ _transfer_mspr(game, results.getitem(i+1))
+                 for (i, game) in enumerate(games) ]
+    finally:
+        del results
+        del errors
+        del copies
+
 cdef extern from "gambit/nash/simpdiv.h":
-    cdef cppclass c_NashSimpdivStrategySolver "NashSimpdivStrategySolver":
+    cdef cppclass c_NashSimpdivStrategySolver "NashSimpdivStrategySolver<Rational>"(c_StrategySolverRational):
         c_NashSimpdivStrategySolver()
-        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedStrategyProfileRational] Solve(c_Game) nogil except +RuntimeError
         c_List[c_MixedStrategyProfileRational] Solve(c_MixedStrategyProfileRational) except +RuntimeError
 
 cdef class SimpdivStrategySolver(object):
@@ -329,20 +423,19 @@ cdef class SimpdivStrategySolver(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game copy
         cdef c_List[c_MixedStrategyProfileRational] solns
-        cdef MixedStrategyProfileRational p
-        solns = self.alg.Solve(game.game)
-        ret = [ ]
-        for i in xrange(solns.Length()):
-            p = MixedStrategyProfileRational()
-            p.profile = copyitem_list_mspr(solns, i+1)
-            ret.append(p)
-        return ret
+        copy = game.game.deref().Copy()
+        with nogil:
+            solns = self.alg.Solve(copy)
+        return _transfer_mspr(game, solns)
+    def solve_batch(self, games, int threads=0):
+        return _solve_batch_rational(self.alg, games, threads)
 
 cdef extern from "gambit/nash/ipa.h":
-    cdef cppclass c_NashIPAStrategySolver "NashIPAStrategySolver":
+    cdef cppclass c_NashIPAStrategySolver "NashIPAStrategySolver"(c_StrategySolverDouble):
         c_NashIPAStrategySolver()
-        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) nogil except +RuntimeError
 
 cdef class IPAStrategySolver(object):
     cdef c_NashIPAStrategySolver *alg
@@ -352,20 +445,19 @@ cdef class IPAStrategySolver(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game copy
         cdef c_List[c_MixedStrategyProfileDouble] solns
-        cdef MixedStrategyProfileDouble p
-        solns = self.alg.Solve(game.game)
-        ret = [ ]
-        for i in xrange(solns.Length()):
-            p = MixedStrategyProfileDouble()
-            p.profile = copyitem_list_mspd(solns, i+1)
-            ret.append(p)
-        return ret
+        copy = game.game.deref().Copy()
+        with nogil:
+            solns = self.alg.Solve(copy)
+        return _transfer_mspd(game, solns)
+    def solve_batch(self, games, int threads=0):
+        return _solve_batch_double(self.alg, games, threads)
 
 cdef extern from "gambit/nash/gnm.h":
-    cdef cppclass c_NashGNMStrategySolver "NashGNMStrategySolver":
+    cdef cppclass c_NashGNMStrategySolver "NashGNMStrategySolver"(c_StrategySolverDouble):
         c_NashGNMStrategySolver()
-        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) nogil except +RuntimeError
 
 cdef class GNMStrategySolver(object):
     cdef c_NashGNMStrategySolver *alg
@@ -375,15 +467,58 @@ cdef class GNMStrategySolver(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game copy
         cdef c_List[c_MixedStrategyProfileDouble] solns
-        cdef MixedStrategyProfileDouble p
-        solns = self.alg.Solve(game.game)
-        ret = [ ]
-        for i in xrange(solns.Length()):
-            p = MixedStrategyProfileDouble()
-            p.profile = copyitem_list_mspd(solns, i+1)
-            ret.append(p)
-        return ret
+        copy = game.game.deref().Copy()
+        with nogil:
+            solns = self.alg.Solve(copy)
+        return _transfer_mspd(game, solns)
+    def solve_batch(self, games, int threads=0):
+        return _solve_batch_double(self.alg, games, threads)
+
+cdef extern from "tools/liap/nfgliap.h":
+    cdef cppclass c_NashLiapStrategySolver "NashLiapStrategySolver"(c_StrategySolverDouble):
+        c_NashLiapStrategySolver(int)
+        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) nogil except +RuntimeError
+
+cdef class LiapStrategySolver(object):
+    cdef c_NashLiapStrategySolver *alg
+
+    def __cinit__(self, p_maxits=100):
+        self.alg = new c_NashLiapStrategySolver(p_maxits)
+    def __dealloc__(self):
+        del self.alg
+    def solve(self, Game game):
+        cdef c_Game copy
+        cdef c_List[c_MixedStrategyProfileDouble] solns
+        copy = game.game.deref().Copy()
+        with nogil:
+            solns = self.alg.Solve(copy)
+        return _transfer_mspd(game, solns)
+    def solve_batch(self, games, int threads=0):
+        return _solve_batch_double(self.alg, games, threads)
+
+cdef extern from "nash.h":
+    cdef cppclass c_NashLogitStrategySolver "NashLogitStrategySolver"(c_StrategySolverDouble):
+        c_NashLogitStrategySolver(double)
+        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) nogil except +RuntimeError
+
+cdef class LogitStrategySolver(object):
+    cdef c_NashLogitStrategySolver *alg
+
+    def __cinit__(self, p_maxLambda=1000000.0):
+        self.alg = new c_NashLogitStrategySolver(p_maxLambda)
+    def __dealloc__(self):
+        del self.alg
+    def solve(self, Game game):
+        cdef c_Game copy
+        cdef c_List[c_MixedStrategyProfileDouble] solns
+        copy = game.game.deref().Copy()
+        with nogil:
+            solns = self.alg.Solve(copy)
+        return _transfer_mspd(game, solns)
+    def solve_batch(self, games, int threads=0):
+        return _solve_batch_double(self.alg, games, threads)
 
 cdef extern from "tools/logit/nfglogit.h":
     cdef cppclass c_LogitQREMixedStrategyProfile "LogitQREMixedStrategyProfile":
@@ -407,6 +542,7 @@ cdef extern from "util.h":
 cdef extern from "nash.h":
     c_LogitQREMixedStrategyProfile *_logit_estimate "logit_estimate"(c_MixedStrategyProfileDouble *)
     c_LogitQREMixedStrategyProfile *_logit_atlambda "logit_atlambda"(c_Game, double)
+    c_LogitQREMixedStrategyProfile *_logit_continue "logit_continue"(c_LogitQREMixedStrategyProfile, c_Game) except +ValueError
     c_List[c_LogitQREMixedStrategyProfile] _logit_principal_branch "logit_principal_branch"(c_Game, double)
     
 cdef class LogitQREMixedStrategyProfile(object):
@@ -459,6 +595,17 @@ def logit_atlambda(Game p_game, double p_lambda):
     ret = LogitQREMixedStrategyProfile()
     ret.thisptr = _logit_atlambda(p_game.game, p_lambda)
     return ret
+
+def logit_continue(LogitQREMixedStrategyProfile p_start, Game p_game):
+    """Compute the QRE of a game at the lambda of p_start, a QRE of
+    another game of the same dimensions, by continuation in the payoffs
+    from the game of p_start.  This is much cheaper than
+    logit_atlambda when solving a sequence of similar games.
+    """
+    cdef LogitQREMixedStrategyProfile ret
+    ret = LogitQREMixedStrategyProfile()
+    ret.thisptr = _logit_continue(deref(p_start.thisptr), p_game.game)
+    return ret
    
 def logit_principal_branch(Game p_game, double p_maxLambda=100000.0):
     cdef c_List[c_LogitQREMixedStrategyProfile] solns
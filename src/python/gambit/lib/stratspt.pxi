@@ -133,6 +133,13 @@ cdef class StrategySupportProfile(Collection):
         new_profile = StrategySupportProfile(restriction.strategies, self.game)
         return new_profile 
 
+    def iterated_undominated(self, strict=False, mixed=False):
+        cdef StrategicRestriction restriction
+        restriction = StrategicRestriction()
+        restriction.support = new c_StrategySupportProfile(self.support.IteratedUndominated(strict, mixed))
+        new_profile = StrategySupportProfile(restriction.strategies, self.game)
+        return new_profile
+
     def union(self, StrategySupportProfile other):
         return StrategySupportProfile(self.unique(list(self) + list(other)), self.game)
 
@@ -30,6 +30,7 @@
 #include <fstream>
 #include <sstream>
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 #include "gambit/nash.h"
 
 using namespace std;
@@ -85,3 +86,18 @@ void setitem(C *p_container, const X &p_index, const T &p_value)
 // Convert the (C-style) string p_value to a Rational
 inline Rational to_rational(const char *p_value)
 { return lexical_cast<Rational>(std::string(p_value)); }
+
+// Bulk access to the payoffs of a strategic game; see the corresponding
+// member functions of GameTableRep for the layout of the arrays.
+// These throw std::bad_cast if the game is not a table.
+inline int NumContingencies(const Game &p_game)
+{ return dynamic_cast<GameTableRep &>(*p_game).NumContingencies(); }
+
+inline void GetPayoffs(const Game &p_game, double *p_payoffs)
+{ dynamic_cast<GameTableRep &>(*p_game).GetPayoffs(p_payoffs); }
+
+inline void SetPayoffs(const Game &p_game, const double *p_payoffs)
+{ dynamic_cast<GameTableRep &>(*p_game).SetPayoffs(p_payoffs); }
+
+inline void SetPayoffs(const Game &p_game, const long *p_num, const long *p_den)
+{ dynamic_cast<GameTableRep &>(*p_game).SetPayoffs(p_num, p_den); }
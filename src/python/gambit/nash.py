@@ -24,6 +24,7 @@ A set of utilities for computing Nash equilibria
 """
 
 import sys
+import struct
 import subprocess
 from fractions import Fraction
 from gambit.profiles import Solution
@@ -36,6 +37,59 @@ class NashSolution(Solution):
                                                self._profile)
     
     
+def read_binary_profiles(data, game):
+    """
+    Reads the profiles in data, the output of a solver tool run with the
+    --binary option, as profiles on game.  Returns a list of
+    (label, profile) pairs.  Profiles have rational probabilities if the
+    tool computed in exact arithmetic.
+    """
+    if data[0:5] != b"GBTP\x01" or len(data) < 7:
+        raise ValueError("Not a binary profile stream")
+    kind, typecode = struct.unpack_from("<cc", data, 5)
+    if kind not in (b"m", b"b") or typecode not in (b"d", b"q"):
+        raise ValueError("Not a binary profile stream")
+    rational = (typecode == b"q")
+    pos = 7
+    profiles = [ ]
+    try:
+        while pos < len(data):
+            (length,) = struct.unpack_from("<H", data, pos)
+            label = data[pos+2:pos+2+length].decode("utf-8")
+            pos += 2 + length
+            (count,) = struct.unpack_from("<I", data, pos)
+            pos += 4
+            if kind == b"b":
+                profile = game.mixed_behavior_profile(rational=rational)
+            else:
+                profile = game.mixed_strategy_profile(rational=rational)
+            if len(profile) != count:
+                raise ValueError("Profile does not match the game")
+            if not rational:
+                values = struct.unpack_from("<%dd" % count, data, pos)
+                pos += 8 * count
+            else:
+                values = [ ]
+                for i in range(count):
+                    (tag,) = struct.unpack_from("<B", data, pos)
+                    if tag == 0:
+                        num, den = struct.unpack_from("<qq", data, pos+1)
+                        values.append(Fraction(num, den))
+                        pos += 17
+                    elif tag == 1:
+                        (size,) = struct.unpack_from("<I", data, pos+1)
+                        text = data[pos+5:pos+5+size].decode("ascii")
+                        values.append(Fraction(text))
+                        pos += 5 + size
+                    else:
+                        raise ValueError("Unknown rational tag %d" % tag)
+            for (i, v) in enumerate(values):
+                profile[i] = v
+            profiles.append((label, profile))
+    except struct.error:
+        raise ValueError("Profile stream ended part way through a profile")
+    return profiles
+
 class ExternalSolver(object):
     """
     Base class for managing calls to external programs.
@@ -74,6 +128,14 @@ class ExternalSolver(object):
             profiles.append(NashSolution(profile))
         return profiles
 
+    def _parse_binary_output(self, stream, game):
+        data = stream.read()
+        # A program which fails writes nothing to standard output
+        if not data:  return [ ]
+        return [ NashSolution(profile)
+                 for (label, profile) in read_binary_profiles(data, game)
+                 if label == "NE" ]
+
 class ExternalEnumPureSolver(ExternalSolver):
     """
     Algorithm class to manage calls to external gambit-enumpure solver
@@ -85,9 +147,8 @@ class ExternalEnumPureSolver(ExternalSolver):
         command_line = "gambit-enumpure"
         if use_strategic and game.is_tree:
             command_line += " -S"
-        return self._parse_output(self.launch(command_line, game),
-                                  game, rational=True,
-                                  extensive=game.is_tree and not use_strategic)
+        return self._parse_binary_output(
+            self.launch(command_line + " --binary", game), game)
 
 class ExternalLPSolver(ExternalSolver):
     """
@@ -107,9 +168,8 @@ class ExternalLPSolver(ExternalSolver):
             command_line = "gambit-lp -d 10"
         if use_strategic and game.is_tree:
             command_line += " -S"
-        return self._parse_output(self.launch(command_line, game),
-                                  game, rational,
-                                  extensive=game.is_tree and not use_strategic)
+        return self._parse_binary_output(
+            self.launch(command_line + " --binary", game), game)
 
 class ExternalLCPSolver(ExternalSolver):
     """
@@ -128,9 +188,8 @@ class ExternalLCPSolver(ExternalSolver):
             command_line = "gambit-lcp -d 10"
         if use_strategic and game.is_tree:
             command_line += " -S"
-        return self._parse_output(self.launch(command_line, game),
-                                  game, rational,
-                                  extensive=game.is_tree and not use_strategic)
+        return self._parse_binary_output(
+            self.launch(command_line + " --binary", game), game)
 
 class ExternalEnumMixedSolver(ExternalSolver):
     """
@@ -144,8 +203,8 @@ class ExternalEnumMixedSolver(ExternalSolver):
             command_line = "gambit-enummixed"
         else:
             command_line = "gambit-enummixed -d 10"
-        return self._parse_output(self.launch(command_line, game),
-                                  game, rational)
+        return self._parse_binary_output(
+            self.launch(command_line + " --binary", game), game)
 
 class ExternalSimpdivSolver(ExternalSolver):
     """
@@ -156,8 +215,8 @@ class ExternalSimpdivSolver(ExternalSolver):
         if not game.is_perfect_recall:
             raise RuntimeError("Computing equilibria of games with imperfect recall is not supported.")
         command_line = "gambit-simpdiv"
-        return self._parse_output(self.launch(command_line, game),
-                                  game, rational=True)
+        return self._parse_binary_output(
+            self.launch(command_line + " --binary", game), game)
     
 class ExternalGlobalNewtonSolver(ExternalSolver):
     """
@@ -168,8 +227,8 @@ class ExternalGlobalNewtonSolver(ExternalSolver):
         if not game.is_perfect_recall:
             raise RuntimeError("Computing equilibria of games with imperfect recall is not supported.")
         command_line = "gambit-gnm -d 10"
-        return self._parse_output(self.launch(command_line, game),
-                                  game, rational=False)
+        return self._parse_binary_output(
+            self.launch(command_line + " --binary", game), game)
 
 class ExternalEnumPolySolver(ExternalSolver):
     """
@@ -197,9 +256,8 @@ class ExternalLyapunovSolver(ExternalSolver):
         command_line = "gambit-liap -d 10"
         if use_strategic and game.is_tree:
             command_line += " -S"
-        return self._parse_output(self.launch(command_line, game),
-                                  game, rational=False,
-                                  extensive=game.is_tree and not use_strategic)
+        return self._parse_binary_output(
+            self.launch(command_line + " --binary", game), game)
 
 class ExternalIteratedPolymatrixSolver(ExternalSolver):
     """
@@ -210,8 +268,8 @@ class ExternalIteratedPolymatrixSolver(ExternalSolver):
         if not game.is_perfect_recall:
             raise RuntimeError("Computing equilibria of games with imperfect recall is not supported.")
         command_line = "gambit-ipa -d 10"
-        return self._parse_output(self.launch(command_line, game),
-                                  game, rational=False)
+        return self._parse_binary_output(
+            self.launch(command_line + " --binary", game), game)
 
 class ExternalLogitSolver(ExternalSolver):
     """
@@ -325,7 +383,48 @@ def gnm_solve(game, external=False):
     alg = gambit.lib.libgambit.GNMStrategySolver()
     return alg.solve(game)
 
+def liap_solve(game, use_strategic=False, external=False, maxits=100):
+    """Convenience function to solve game to find mixed-strategy
+    Nash equilibria by minimization of the Lyapunov function.
+    """
+    if external or (game.is_tree and not use_strategic):
+        return ExternalLyapunovSolver().solve(game, use_strategic=use_strategic)
+    alg = gambit.lib.libgambit.LiapStrategySolver(maxits)
+    return alg.solve(game)
+
+def logit_solve(game, use_strategic=False, external=False):
+    """Convenience function to solve game to find a mixed-strategy
+    Nash equilibrium by tracing the principal branch of the logit
+    quantal response equilibrium correspondence.
+    """
+    if external or (game.is_tree and not use_strategic):
+        return ExternalLogitSolver().solve(game, use_strategic=use_strategic)
+    alg = gambit.lib.libgambit.LogitStrategySolver()
+    return alg.solve(game)
+
+_batch_solvers = {
+    "simpdiv": gambit.lib.libgambit.SimpdivStrategySolver,
+    "gnm":     gambit.lib.libgambit.GNMStrategySolver,
+    "ipa":     gambit.lib.libgambit.IPAStrategySolver,
+    "liap":    gambit.lib.libgambit.LiapStrategySolver,
+    "logit":   gambit.lib.libgambit.LogitStrategySolver,
+}
+
+def batch_solve(games, method, threads=0):
+    """Solve each game in the list games using the named method, one of
+    'simpdiv', 'gnm', 'ipa', 'liap' or 'logit'.  The games are solved
+    in-process on up to threads native threads (as many as available
+    if threads is zero), without holding the global interpreter lock.
+    Returns a list containing the list of profiles found for each game.
+    """
+    try:
+        alg = _batch_solvers[method]()
+    except KeyError:
+        raise ValueError("Unknown method '%s'" % method)
+    return alg.solve_batch(games, threads)
+
 logit_estimate = gambit.lib.libgambit.logit_estimate
 logit_atlambda = gambit.lib.libgambit.logit_atlambda
+logit_continue = gambit.lib.libgambit.logit_continue
 logit_principal_branch = gambit.lib.libgambit.logit_principal_branch
 
@@ -1,3 +1,5 @@
+import re
+
 import gambit
 import nose.tools
 from gambit.lib.error import MismatchError
@@ -48,3 +50,22 @@ class TestGambitInfosets(object):
     def test_infoset_add_action_error(self):
         nose.tools.assert_raises(MismatchError, self.extensive_game.infosets[0].actions.add, self.extensive_game.actions[3])
 
+
+    def test_infoset_canonical_order(self):
+        "Test to ensure members and infosets are renumbered in tree order"
+        g = gambit.Game.new_tree()
+        p1 = g.players.add()
+        p2 = g.players.add()
+        g.root.append_move(p1, 3)
+        late = g.root.children[2].append_move(p2, 2)
+        late.label = "late"
+        early = g.root.children[1].append_move(p2, 2)
+        early.label = "early"
+        # Joining the first child puts the last member out of order
+        g.root.children[0].append_move(late)
+        assert list(late.members) == [g.root.children[0], g.root.children[2]]
+        assert [i.label for i in p2.infosets] == ["late", "early"]
+        numbers = dict((label, int(number)) for number, label in
+                       re.findall(r'^p "" 2 (\d+) "(\w+)"', g.write(),
+                                  re.MULTILINE))
+        assert numbers == { "late": 1, "early": 2 }
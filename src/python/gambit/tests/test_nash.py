@@ -0,0 +1,131 @@
+import decimal
+import distutils.spawn
+import fractions
+import struct
+import subprocess
+import gambit
+import gambit.nash
+from nose.plugins.skip import SkipTest
+from nose.tools import assert_raises
+
+def run_binary(command_line, filename):
+    "Runs a solver tool with --binary on a game file, returning its output"
+    program = command_line.split()[0]
+    if distutils.spawn.find_executable(program) is None:
+        raise SkipTest("%s is not installed" % program)
+    return subprocess.check_output("%s -q --binary %s" % (command_line, filename),
+                                   shell=True)
+
+class TestGambitNash(object):
+    def setUp(self):
+        self.game = gambit.Game.read_game("test_games/mixed_strategy.nfg")
+
+    def tearDown(self):
+        del self.game
+
+    def test_batch_solve_matches_single(self):
+        "Test batch_solve agrees with solving each game in turn"
+        games = [ self.game, self.game ]
+        single = gambit.nash.simpdiv_solve(self.game)
+        batch = gambit.nash.batch_solve(games, "simpdiv", threads=2)
+        assert len(batch) == len(games)
+        for result in batch:
+            assert len(result) == len(single)
+            for (p, q) in zip(result, single):
+                assert list(p) == list(q)
+                assert p.game == self.game
+
+    def test_batch_solve_unknown_method(self):
+        "Test batch_solve rejects an unknown method"
+        assert_raises(ValueError, gambit.nash.batch_solve,
+                      [ self.game ], "enumpoly")
+
+    def test_logit_solve_in_process(self):
+        "Test in-process logit returns one profile on the original game"
+        result = gambit.nash.logit_solve(self.game, use_strategic=True)
+        assert len(result) == 1
+        assert result[0].game == self.game
+
+    def test_logit_continue_matches_atlambda(self):
+        "Test continuing a QRE to a perturbed game agrees with solving it afresh"
+        other = gambit.Game.read_game("test_games/mixed_strategy.nfg")
+        other.outcomes[0][0] = decimal.Decimal("1.25")
+        start = gambit.nash.logit_atlambda(self.game, 2.0)
+        result = gambit.nash.logit_continue(start, other)
+        fresh = gambit.nash.logit_atlambda(other, 2.0)
+        assert result.game == other
+        assert abs(result.lam - 2.0) < 1.0e-8
+        for (p, q) in zip(result.profile, fresh.profile):
+            assert abs(p - q) < 1.0e-9
+
+    def test_read_binary_profiles(self):
+        "Test reading profiles in the binary format written with --binary"
+        def rational(num, den):
+            return struct.pack("<Bqq", 0, num, den)
+        text = b"1/3"
+        data = (b"GBTP\x01mq" +
+                struct.pack("<H", 2) + b"NE" + struct.pack("<I", 5) +
+                rational(1, 2) + rational(1, 2) + rational(0, 1) +
+                struct.pack("<BI", 1, len(text)) + text + rational(2, 3))
+        result = gambit.nash.read_binary_profiles(data, self.game)
+        assert len(result) == 1
+        (label, profile) = result[0]
+        assert label == "NE"
+        assert list(profile) == [ fractions.Fraction(1, 2),
+                                  fractions.Fraction(1, 2), 0,
+                                  fractions.Fraction(1, 3),
+                                  fractions.Fraction(2, 3) ]
+
+    def test_read_binary_profiles_invalid(self):
+        "Test reading text output as binary profiles raises ValueError"
+        assert_raises(ValueError, gambit.nash.read_binary_profiles,
+                      b"NE,1,0,0,1,0\n", self.game)
+        assert_raises(ValueError, gambit.nash.read_binary_profiles,
+                      b"GBTP\x01md\x02\x00NE\x05\x00\x00\x00", self.game)
+
+    def test_binary_output_rational(self):
+        "Test reading the binary output of gambit-lcp in exact arithmetic"
+        result = gambit.nash.read_binary_profiles(
+            run_binary("gambit-lcp", "test_games/mixed_strategy.nfg"), self.game)
+        expected = gambit.nash.lcp_solve(self.game, rational=True)
+        assert len(result) == len(expected)
+        for ((label, profile), eqm) in zip(result, expected):
+            assert label == "NE"
+            assert list(profile) == list(eqm)
+
+    def test_binary_output_double(self):
+        "Test reading the binary output of gambit-lcp in floating point"
+        result = gambit.nash.read_binary_profiles(
+            run_binary("gambit-lcp -d 10", "test_games/mixed_strategy.nfg"), self.game)
+        expected = gambit.nash.lcp_solve(self.game, rational=False)
+        assert len(result) == len(expected)
+        for ((label, profile), eqm) in zip(result, expected):
+            assert label == "NE"
+            for (p, q) in zip(profile, eqm):
+                assert isinstance(p, float)
+                assert abs(p - q) < 1.0e-9
+
+    def test_binary_output_lp(self):
+        "Test reading the binary output of gambit-lp"
+        filename = "test_games/const_sum_game.nfg"
+        game = gambit.Game.read_game(filename)
+        result = gambit.nash.read_binary_profiles(run_binary("gambit-lp", filename),
+                                                  game)
+        expected = gambit.nash.lp_solve(game, rational=True)
+        assert len(result) == len(expected)
+        for ((label, profile), eqm) in zip(result, expected):
+            assert label == "NE"
+            assert list(profile) == list(eqm)
+
+    def test_binary_output_behavior(self):
+        "Test reading behavior profiles from the binary output of gambit-lcp"
+        filename = "test_games/complicated_extensive_game.efg"
+        game = gambit.Game.read_game(filename)
+        result = gambit.nash.read_binary_profiles(run_binary("gambit-lcp", filename),
+                                                  game)
+        expected = gambit.nash.lcp_solve(game, rational=True)
+        assert len(result) == len(expected)
+        for ((label, profile), eqm) in zip(result, expected):
+            assert label == "NE"
+            assert isinstance(profile, gambit.lib.libgambit.MixedBehaviorProfile)
+            assert list(profile) == list(eqm)
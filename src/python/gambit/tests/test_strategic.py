@@ -1,5 +1,9 @@
 import gambit
+import fractions
 import warnings
+import numpy
+from nose.tools import assert_raises
+from gambit.lib.error import UndefinedOperationError
 
 class TestGambitStrategicGame(object):
     def setUp(self):
@@ -72,3 +76,48 @@ class TestGambitStrategicGame(object):
         assert self.game.players[1].strategies[1].label == "Defect"
 
     
+
+    def test_game_from_integer_arrays(self):
+        "Test bulk loading of integer payoff arrays"
+        m = numpy.array([ [ 8, 2 ], [ 10, 5 ] ])
+        g = gambit.Game.from_arrays(m, numpy.transpose(m))
+        assert g[1,0][0] == 10
+        assert g[1,0][1] == 2
+        assert g[0,1][1] == 10
+        assert g[1,0][0] == fractions.Fraction(10)
+
+    def test_game_from_float_arrays(self):
+        "Test bulk loading of floating-point payoff arrays, which are exact"
+        m = numpy.array([ [ 0.5, -1.25, 3 ], [ 0.0, 2.0, 0.75 ] ])
+        g = gambit.Game.from_arrays(m, -m)
+        assert g[0,1][0] == fractions.Fraction(-5, 4)
+        assert g[1,2][1] == fractions.Fraction(-3, 4)
+
+    def test_game_from_object_arrays(self):
+        "Test loading of arrays of rational payoffs"
+        m = numpy.array([ [ fractions.Fraction(1, 3), 2 ], [ 3, 4 ] ],
+                        dtype=object)
+        g = gambit.Game.from_arrays(m, m)
+        assert g[0,0][1] == fractions.Fraction(1, 3)
+
+    def test_game_from_arrays_bad_values(self):
+        "Test bulk loading of non-finite payoffs and mismatched arrays"
+        m = numpy.array([ [ numpy.inf, 1.0 ], [ 1.0, 1.0 ] ])
+        assert_raises(ValueError, gambit.Game.from_arrays, m, m)
+        assert_raises(ValueError, gambit.Game.from_arrays, m)
+
+    def test_game_payoff_tensor(self):
+        "Test the read-only payoff tensor of a strategic game"
+        a = numpy.arange(24).reshape(2, 3, 4)
+        g = gambit.Game.from_arrays(a, 2*a, -a)
+        t = numpy.asarray(g.payoff_tensor())
+        assert t.shape == (3, 2, 3, 4)
+        assert not t.flags.writeable
+        assert (t[0] == a).all()
+        assert (t[1] == 2*a).all()
+        assert (t[2] == -a).all()
+
+    def test_game_payoff_tensor_tree(self):
+        "Test the payoff tensor is not available for extensive games"
+        g = gambit.Game.new_tree()
+        assert_raises(UndefinedOperationError, g.payoff_tensor)
@@ -1,6 +1,10 @@
 import gambit
 import fractions
+import distutils.spawn
+import re
+import subprocess
 import nose.tools
+from nose.plugins.skip import SkipTest
 from nose.tools import assert_raises
 from gambit.lib.error import UndefinedOperationError
 
@@ -117,3 +121,69 @@ class TestGambitStrategySupportProfile(object):
         "Test removing the last strategy of a player"
         profile = self.support_profile.remove(self.support_profile[3])
         profile = profile.remove(profile[3])
+
+
+def convert_labels(options, filename):
+    "Runs gambit-convert with options, returning the strategy labels it prints"
+    if distutils.spawn.find_executable("gambit-convert") is None:
+        raise SkipTest("gambit-convert is not installed")
+    output = subprocess.check_output("gambit-convert -q -O html %s %s" %
+                                     (options, filename), shell=True)
+    return re.findall("<b>([^<]*)</b>", output.decode("ascii"))
+
+class TestGambitDominance(object):
+    # Of player 1's strategies, C is strictly dominated by an equal mixture
+    # of A and B but by no pure strategy, and D is weakly dominated by A
+    # but not strictly dominated by any mixture
+    def setUp(self):
+        self.game = gambit.Game.read_game("test_games/dominance.nfg")
+        self.support_profile = self.game.support_profile()
+
+    def tearDown(self):
+        del self.game
+        del self.support_profile
+
+    def labels(self, profile):
+        return [strategy.label for strategy in profile]
+
+    def test_strict(self):
+        "Test iterated elimination of strictly dominated strategies"
+        profile = self.support_profile.iterated_undominated(strict=True)
+        assert self.labels(profile) == ["A", "B", "C", "D", "L", "R"]
+        assert profile == self.support_profile.undominated(strict=True)
+
+    def test_weak(self):
+        "Test iterated elimination of weakly dominated strategies"
+        profile = self.support_profile.iterated_undominated(strict=False)
+        assert self.labels(profile) == ["A", "B", "C", "L", "R"]
+        assert profile == self.support_profile.undominated(strict=False)
+
+    def test_strict_mixed(self):
+        "Test iterated elimination of strategies strictly dominated by mixtures"
+        profile = self.support_profile.iterated_undominated(strict=True,
+                                                            mixed=True)
+        assert self.labels(profile) == ["A", "B", "D", "L", "R"]
+
+    def test_weak_mixed(self):
+        "Test iterated elimination of strategies weakly dominated by mixtures"
+        profile = self.support_profile.iterated_undominated(strict=False,
+                                                            mixed=True)
+        assert self.labels(profile) == ["A", "B", "L", "R"]
+
+    def test_iterated(self):
+        "Test that iterated elimination matches repeated single rounds"
+        game = gambit.Game.read_game("test_games/mixed_strategy.nfg")
+        profile = game.support_profile()
+        iterated = profile.iterated_undominated()
+        while profile.undominated() != profile:
+            profile = profile.undominated()
+        assert iterated == profile
+
+    def test_convert(self):
+        "Test the dominance options of gambit-convert"
+        filename = "test_games/dominance.nfg"
+        assert convert_labels("", filename) == ["L", "R", "A", "B", "C", "D"]
+        assert convert_labels("-d", filename) == ["L", "R", "A", "B", "C", "D"]
+        assert convert_labels("-w", filename) == ["L", "R", "A", "B", "C"]
+        assert convert_labels("-d -m", filename) == ["L", "R", "A", "B", "D"]
+        assert convert_labels("-w -m", filename) == ["L", "R", "A", "B"]
@@ -32,6 +32,14 @@ if 'setuptools.extension' in sys.modules:
     m.Extension.__dict__ = m._Extension.__dict__
     
 import glob
+
+# Batch solving runs games on parallel threads using OpenMP, where the
+# compiler supports it; otherwise games are solved in turn.
+if sys.platform in ("win32", "darwin"):
+    openmp_flags = [ ]
+else:
+    openmp_flags = [ "-fopenmp" ]
+
 libgame = Extension("gambit.lib.libgambit",
                     sources=[ "gambit/lib/libgambit.pyx" ] +
                             glob.glob("gambit/lib/*.pxi") +
@@ -42,9 +50,12 @@ libgame = Extension("gambit.lib.libgambit",
                               "../tools/lp/efglp.cc",
                               "../tools/logit/path.cc",
                               "../tools/logit/nfglogit.cc",
-                              "../tools/logit/efglogit.cc" ],
+                              "../tools/logit/efglogit.cc",
+                              "../tools/liap/nfgliap.cc" ],
                     language="c++",
-                    include_dirs=[ "../..", "../../library/include", ".." ] )
+                    include_dirs=[ "../..", "../../library/include", ".." ],
+                    extra_compile_args=openmp_flags,
+                    extra_link_args=openmp_flags )
 
 setup(name="gambit",
       version="16.0.0",
@@ -0,0 +1,818 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/bench/bench.cc
+// Performance benchmarks for the equilibrium solvers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <getopt.h>
+#include <sys/time.h>
+#ifndef _WIN32
+#include <unistd.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif  // _WIN32
+
+#include "gambit/gambit.h"
+#include "gambit/nash/enumpure.h"
+#include "gambit/nash/enummixed.h"
+#include "gambit/nash/lcp.h"
+#include "gambit/nash/simpdiv.h"
+#include "gambit/nash/gnm.h"
+#include "gambit/nash/ipa.h"
+#include "tools/lp/nfglp.h"
+#include "tools/lp/efglp.h"
+#include "tools/liap/nfgliap.h"
+#include "tools/liap/efgliap.h"
+#include "tools/logit/nfglogit.h"
+#include "tools/logit/efglogit.h"
+
+using namespace Gambit;
+using namespace Gambit::Nash;
+
+//
+// Version of the generated corpus.  Any change to the generators or to
+// the list of games must increment this, since results (and the stored
+// baseline) are only comparable between runs on the same corpus.
+//
+const int CORPUS_VERSION = 1;
+
+//------------------------------------------------------------------------
+//                         Allocation counting
+//------------------------------------------------------------------------
+
+// Number of calls to operator new since the last reset.  The solvers
+// are compiled into this program, so every allocation they make is seen.
+static unsigned long s_allocations = 0;
+
+void *operator new(size_t p_size) throw (std::bad_alloc)
+{
+#pragma omp atomic
+  s_allocations++;
+  void *p = malloc((p_size > 0) ? p_size : 1);
+  if (!p)  throw std::bad_alloc();
+  return p;
+}
+
+void *operator new[](size_t p_size) throw (std::bad_alloc)
+{
+  return operator new(p_size);
+}
+
+void operator delete(void *p) throw ()
+{
+  free(p);
+}
+
+void operator delete[](void *p) throw ()
+{
+  free(p);
+}
+
+namespace {
+
+//------------------------------------------------------------------------
+//                           Game generation
+//------------------------------------------------------------------------
+
+//
+// A 64-bit linear congruential generator (Knuth's MMIX constants).  The
+// library's random number sources are not guaranteed to produce the same
+// sequence across platforms, which the corpus must.
+//
+class Generator {
+public:
+  Generator(unsigned long p_seed) : m_state(p_seed) { }
+
+  /// Returns a payoff drawn uniformly from 0, ..., p_range - 1
+  int Next(int p_range)
+  {
+    m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (int) ((m_state >> 33) % (unsigned long long) p_range);
+  }
+
+private:
+  unsigned long long m_state;
+};
+
+//
+// Returns a strategic game with the given dimensions, and payoffs drawn
+// uniformly from 0, ..., 99.  If p_zeroSum is true, the game is a
+// two-player zero-sum game.
+//
+Game RandomTable(const Array<int> &p_dim, unsigned long p_seed, bool p_zeroSum)
+{
+  Generator generator(p_seed);
+  Game game = NewTable(p_dim);
+  for (StrategyProfileIterator iter(game); !iter.AtEnd(); iter++) {
+    GameOutcome outcome = (*iter)->GetOutcome();
+    if (p_zeroSum) {
+      int payoff = generator.Next(100);
+      outcome->SetPayoff(1, Rational(payoff));
+      outcome->SetPayoff(2, Rational(-payoff));
+    }
+    else {
+      for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+	outcome->SetPayoff(pl, Rational(generator.Next(100)));
+      }
+    }
+  }
+  return game;
+}
+
+//
+// Returns a two-player tree of the given depth, with p_actions actions at
+// each node and the players alternating, starting with player 1.  Player
+// 2 does not observe the move of player 1 immediately before, but
+// everything else is observed, so the game has perfect recall.  Payoffs
+// at the terminal nodes are drawn as in RandomTable.
+//
+Game RandomTree(int p_depth, int p_actions, unsigned long p_seed,
+		bool p_zeroSum)
+{
+  Generator generator(p_seed);
+  Game game = NewTree();
+  game->NewPlayer();
+  game->NewPlayer();
+
+  std::vector<GameNode> level(1, game->GetRoot());
+  for (int depth = 0; depth < p_depth; depth++) {
+    GamePlayer player = game->GetPlayer(depth % 2 + 1);
+    GameInfoset infoset = 0;
+    for (size_t i = 0; i < level.size(); i++) {
+      if (depth % 2 == 1 && i % p_actions != 0) {
+	// Siblings are adjacent in the level, and share player 2's infoset
+	level[i]->AppendMove(infoset);
+      }
+      else {
+	infoset = level[i]->AppendMove(player, p_actions);
+      }
+    }
+    std::vector<GameNode> next;
+    for (size_t i = 0; i < level.size(); i++) {
+      for (int a = 1; a <= p_actions; a++) {
+	next.push_back(level[i]->GetChild(a));
+      }
+    }
+    level = next;
+  }
+
+  for (size_t i = 0; i < level.size(); i++) {
+    GameOutcome outcome = game->NewOutcome();
+    int payoff = generator.Next(100);
+    outcome->SetPayoff(1, Rational(payoff));
+    outcome->SetPayoff(2, Rational((p_zeroSum) ? -payoff : generator.Next(100)));
+    level[i]->SetOutcome(outcome);
+  }
+  return game;
+}
+
+struct CorpusGame {
+  std::string m_name;
+  Game m_game;
+
+  CorpusGame(const std::string &p_name, const Game &p_game)
+    : m_name(p_name), m_game(p_game) { }
+};
+
+Array<int> Dimensions(int p_players, int p_strategies)
+{
+  Array<int> dim(p_players);
+  for (int pl = 1; pl <= p_players; pl++)  dim[pl] = p_strategies;
+  return dim;
+}
+
+//
+// The corpus, in increasing order of size within each family.  Seeds
+// are fixed, so the corpus is identical from run to run.
+//
+std::vector<CorpusGame> BuildCorpus(void)
+{
+  std::vector<CorpusGame> corpus;
+  corpus.push_back(CorpusGame("nfg-2p-4x4", RandomTable(Dimensions(2, 4), 1, false)));
+  corpus.push_back(CorpusGame("nfg-2p-8x8", RandomTable(Dimensions(2, 8), 2, false)));
+  corpus.push_back(CorpusGame("nfg-2p-12x12", RandomTable(Dimensions(2, 12), 3, false)));
+  corpus.push_back(CorpusGame("nfg-zs-10x10", RandomTable(Dimensions(2, 10), 4, true)));
+  corpus.push_back(CorpusGame("nfg-zs-30x30", RandomTable(Dimensions(2, 30), 5, true)));
+  corpus.push_back(CorpusGame("nfg-3p-3x3x3", RandomTable(Dimensions(3, 3), 6, false)));
+  corpus.push_back(CorpusGame("nfg-3p-5x5x5", RandomTable(Dimensions(3, 5), 7, false)));
+  corpus.push_back(CorpusGame("nfg-4p-3x3x3x3", RandomTable(Dimensions(4, 3), 8, false)));
+  corpus.push_back(CorpusGame("efg-2p-d3b2", RandomTree(3, 2, 9, false)));
+  corpus.push_back(CorpusGame("efg-2p-d4b2", RandomTree(4, 2, 10, false)));
+  corpus.push_back(CorpusGame("efg-zs-d4b2", RandomTree(4, 2, 11, true)));
+  return corpus;
+}
+
+//------------------------------------------------------------------------
+//                               Solvers
+//------------------------------------------------------------------------
+
+// Each entry point runs a solver on a game, and returns the number of
+// profiles it reports.  A solver may also have a preparation step, run
+// on the game once before the timed runs.
+
+int RunEnumPure(const Game &p_game)
+{ return EnumPureStrategySolver().Solve(p_game).Length(); }
+
+int RunEnumMixed(const Game &p_game)
+{ return EnumMixedStrategySolver<Rational>().Solve(p_game).Length(); }
+
+int RunLcp(const Game &p_game)
+{ return NashLcpStrategySolver<Rational>(0, 0).Solve(p_game).Length(); }
+
+int RunLp(const Game &p_game)
+{ return NashLpStrategySolver<Rational>().Solve(p_game).Length(); }
+
+int RunSimpdiv(const Game &p_game)
+{ return NashSimpdivStrategySolver<Rational>().Solve(p_game).Length(); }
+
+int RunSimpdivFloat(const Game &p_game)
+{ return NashSimpdivStrategySolver<double>().Solve(p_game).Length(); }
+
+// From the centroid, or from random points, liap does not converge on
+// the games in the corpus, whose payoffs are large.  It is timed instead
+// from each equilibrium gnm finds, from which it converges.
+List<MixedStrategyProfile<double> > s_liapStarts;
+
+void PrepareLiap(const Game &p_game)
+{ s_liapStarts = NashGNMStrategySolver().Solve(p_game); }
+
+int RunLiap(const Game &)
+{
+  int found = 0;
+  for (int i = 1; i <= s_liapStarts.Length(); i++) {
+    found += NashLiapStrategySolver(100).Solve(s_liapStarts[i]).Length();
+  }
+  return found;
+}
+
+int RunLogit(const Game &p_game)
+{
+  std::ostream null(0);
+  StrategicQREPathTracer tracer;
+  tracer.SetFullGraph(false);
+  return tracer.TraceStrategicPath(LogitQREMixedStrategyProfile(p_game),
+				   null, 1000000.0, 1.0).Length();
+}
+
+int RunGnm(const Game &p_game)
+{ return NashGNMStrategySolver().Solve(p_game).Length(); }
+
+int RunIpa(const Game &p_game)
+{ return NashIPAStrategySolver().Solve(p_game).Length(); }
+
+int RunEnumPureAgent(const Game &p_game)
+{ return EnumPureAgentSolver().Solve(BehaviorSupportProfile(p_game)).Length(); }
+
+int RunLcpBehav(const Game &p_game)
+{
+  return NashLcpBehaviorSolver<Rational>(0, 0).Solve(BehaviorSupportProfile(p_game)).Length();
+}
+
+int RunLpBehav(const Game &p_game)
+{
+  return NashLpBehavSolver<Rational>().Solve(BehaviorSupportProfile(p_game)).Length();
+}
+
+int RunLogitBehav(const Game &p_game)
+{
+  // The agent tracer writes its results rather than returning them;
+  // it reports the single terminal profile.
+  std::ostream null(0);
+  AgentQREPathTracer tracer;
+  tracer.SetFullGraph(false);
+  tracer.TraceAgentPath(LogitQREMixedBehaviorProfile(p_game),
+			null, 1000000.0, 1.0);
+  return 1;
+}
+
+enum GameKind { KIND_TABLE, KIND_TREE };
+
+struct BenchSolver {
+  const char *m_name;
+  GameKind m_kind;
+  /// Number of players required, or 0 for any number
+  int m_players;
+  /// Whether the game must be constant-sum
+  bool m_constSum;
+  /// Largest game (in total strategies or actions) to run on, or 0
+  int m_maxSize;
+  int (*m_run)(const Game &);
+  /// Run once on the game before the timed runs, or null
+  void (*m_prepare)(const Game &);
+};
+
+//
+// The solvers benchmarked.  Size limits keep each run to at most a few
+// seconds in an optimised build; they should be raised as the solvers
+// get faster (which changes what the baseline records).  liap is not run
+// on trees: it finds no equilibrium of any tree in the corpus, even when
+// started from one, so its runs would measure nothing useful.
+//
+const BenchSolver s_solvers[] = {
+  { "enumpure",  KIND_TABLE, 0, false,  0, RunEnumPure },
+  { "enummixed", KIND_TABLE, 2, false, 16, RunEnumMixed },
+  { "lcp",       KIND_TABLE, 2, false, 24, RunLcp },
+  { "lp",        KIND_TABLE, 2, true,   0, RunLp },
+  { "simpdiv",   KIND_TABLE, 0, false, 15, RunSimpdiv },
+  { "simpdiv-float", KIND_TABLE, 0, false, 15, RunSimpdivFloat },
+  { "liap",      KIND_TABLE, 0, false, 24, RunLiap, PrepareLiap },
+  { "logit",     KIND_TABLE, 0, false,  0, RunLogit },
+  { "gnm",       KIND_TABLE, 0, false,  0, RunGnm },
+  { "ipa",       KIND_TABLE, 0, false,  0, RunIpa },
+  { "enumpure",  KIND_TREE,  0, false,  0, RunEnumPureAgent },
+  { "lcp",       KIND_TREE,  2, false,  0, RunLcpBehav },
+  { "lp",        KIND_TREE,  2, true,   0, RunLpBehav },
+  { "logit",     KIND_TREE,  0, false,  0, RunLogitBehav },
+  { 0,           KIND_TABLE, 0, false,  0, 0 }
+};
+
+bool Applies(const BenchSolver &p_solver, const Game &p_game)
+{
+  if (p_game->IsTree() != (p_solver.m_kind == KIND_TREE))  return false;
+  if (p_solver.m_players > 0 && p_game->NumPlayers() != p_solver.m_players) {
+    return false;
+  }
+  if (p_solver.m_constSum && !p_game->IsConstSum())  return false;
+  int size = ((p_game->IsTree()) ? p_game->BehavProfileLength() :
+	      p_game->MixedProfileLength());
+  return (p_solver.m_maxSize == 0 || size <= p_solver.m_maxSize);
+}
+
+//------------------------------------------------------------------------
+//                             Measurement
+//------------------------------------------------------------------------
+
+struct Measurement {
+  std::string m_status;
+  double m_time;
+  unsigned long m_allocations;
+  long m_peakRSS;
+  int m_equilibria;
+  long m_pivots;
+
+  Measurement(void)
+    : m_status("ok"), m_time(0.0), m_allocations(0), m_peakRSS(-1),
+      m_equilibria(0), m_pivots(-1) { }
+};
+
+//
+// Runs the solver's preparation step, if any, and then the solver
+// p_repeats times, recording the best wall time, and the allocations
+// and pivots of the last run.
+//
+void RunRepeated(const BenchSolver &p_solver, const Game &p_game,
+		 int p_repeats, Measurement &p_result)
+{
+  try {
+    if (p_solver.m_prepare)  p_solver.m_prepare(p_game);
+    for (int r = 1; r <= p_repeats; r++) {
+      s_allocations = 0;
+      Stats::Reset();
+      double start = Stats::WallClock();
+      p_result.m_equilibria = p_solver.m_run(p_game);
+      double elapsed = Stats::WallClock() - start;
+      if (r == 1 || elapsed < p_result.m_time)  p_result.m_time = elapsed;
+    }
+    p_result.m_allocations = s_allocations;
+    p_result.m_pivots = Stats::GetCount(Stats::PIVOTS);
+  }
+  catch (std::exception &) {
+    p_result.m_status = "error";
+  }
+}
+
+#ifndef _WIN32
+//
+// Each measurement is taken in a child process, so that peak resident
+// set size can be attributed to one solver run, and so that a run can be
+// abandoned once it exceeds the time limit.
+//
+Measurement Measure(const BenchSolver &p_solver, const Game &p_game,
+		    int p_repeats, int p_timeout)
+{
+  Measurement result;
+  int fds[2];
+  if (pipe(fds) != 0) {
+    result.m_status = "error";
+    return result;
+  }
+  std::cout.flush();
+  std::cerr.flush();
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    alarm(p_timeout);
+    RunRepeated(p_solver, p_game, p_repeats, result);
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    char buffer[256];
+    int length = sprintf(buffer, "%s %.17g %lu %ld %d %ld\n",
+			 result.m_status.c_str(), result.m_time,
+			 result.m_allocations, (long) usage.ru_maxrss,
+			 result.m_equilibria, result.m_pivots);
+    if (write(fds[1], buffer, length) != length)  _exit(1);
+    _exit(0);
+  }
+
+  close(fds[1]);
+  if (pid < 0) {
+    close(fds[0]);
+    result.m_status = "error";
+    return result;
+  }
+  std::string report;
+  char buffer[256];
+  ssize_t count;
+  while ((count = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    report.append(buffer, count);
+  }
+  close(fds[0]);
+
+  int status;
+  waitpid(pid, &status, 0);
+  if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) {
+    result.m_status = "timeout";
+  }
+  else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || report == "") {
+    result.m_status = "error";
+  }
+  else {
+    std::istringstream is(report);
+    is >> result.m_status >> result.m_time >> result.m_allocations
+       >> result.m_peakRSS >> result.m_equilibria >> result.m_pivots;
+  }
+  return result;
+}
+#else
+// Without fork(), runs are made in-process, with no time limit, and
+// peak memory is not reported.
+Measurement Measure(const BenchSolver &p_solver, const Game &p_game,
+		    int p_repeats, int)
+{
+  Measurement result;
+  RunRepeated(p_solver, p_game, p_repeats, result);
+  return result;
+}
+#endif  // _WIN32
+
+//------------------------------------------------------------------------
+//                         Results and baselines
+//------------------------------------------------------------------------
+
+struct BenchResult {
+  std::string m_solver, m_game;
+  Measurement m_measurement;
+};
+
+//
+// Results are written one to a line, so that baselines can be read back
+// without a general JSON parser.
+//
+void WriteResults(std::ostream &p_stream, int p_repeats,
+		  const std::vector<BenchResult> &p_results)
+{
+  p_stream << "{\n";
+  p_stream << "  \"corpus\": " << CORPUS_VERSION << ",\n";
+  p_stream << "  \"gambit\": \"" << VERSION << "\",\n";
+  p_stream << "  \"repeats\": " << p_repeats << ",\n";
+  p_stream << "  \"results\": [\n";
+  for (size_t i = 0; i < p_results.size(); i++) {
+    const Measurement &m = p_results[i].m_measurement;
+    p_stream << "    { \"solver\": \"" << p_results[i].m_solver << "\", ";
+    p_stream << "\"game\": \"" << p_results[i].m_game << "\", ";
+    p_stream << "\"status\": \"" << m.m_status << "\", ";
+    p_stream << "\"time\": " << std::setprecision(6) << m.m_time << ", ";
+    p_stream << "\"allocations\": " << m.m_allocations << ", ";
+    p_stream << "\"peak_rss_kb\": " << m.m_peakRSS << ", ";
+    p_stream << "\"equilibria\": " << m.m_equilibria << ", ";
+    p_stream << "\"pivots\": " << m.m_pivots << " }";
+    p_stream << ((i + 1 < p_results.size()) ? ",\n" : "\n");
+  }
+  p_stream << "  ]\n";
+  p_stream << "}\n";
+}
+
+// Extracts the value of the given key from a line written by WriteResults
+bool FindField(const std::string &p_line, const std::string &p_key,
+	       std::string &p_value)
+{
+  std::string::size_type pos = p_line.find("\"" + p_key + "\": ");
+  if (pos == std::string::npos)  return false;
+  pos += p_key.length() + 4;
+  if (pos < p_line.length() && p_line[pos] == '"') {
+    std::string::size_type end = p_line.find('"', pos + 1);
+    if (end == std::string::npos)  return false;
+    p_value = p_line.substr(pos + 1, end - pos - 1);
+  }
+  else {
+    std::string::size_type end = p_line.find_first_of(",}", pos);
+    p_value = p_line.substr(pos, end - pos);
+  }
+  return true;
+}
+
+typedef std::map<std::string, BenchResult> Baseline;
+
+std::string ResultKey(const std::string &p_solver, const std::string &p_game)
+{ return p_solver + " " + p_game; }
+
+//
+// Reads a baseline written by WriteResults.  Throws InvalidFileException
+// if the baseline was made with a different version of the corpus.
+//
+Baseline ReadBaseline(std::istream &p_stream)
+{
+  Baseline baseline;
+  std::string line, value;
+  bool haveCorpus = false;
+  while (std::getline(p_stream, line)) {
+    if (!haveCorpus && FindField(line, "corpus", value)) {
+      if (atoi(value.c_str()) != CORPUS_VERSION) {
+	throw InvalidFileException("Baseline was made with corpus version " +
+				   value);
+      }
+      haveCorpus = true;
+    }
+    BenchResult result;
+    if (!FindField(line, "solver", result.m_solver) ||
+	!FindField(line, "game", result.m_game)) {
+      continue;
+    }
+    Measurement &m = result.m_measurement;
+    FindField(line, "status", m.m_status);
+    if (FindField(line, "time", value))  m.m_time = atof(value.c_str());
+    if (FindField(line, "allocations", value)) {
+      m.m_allocations = strtoul(value.c_str(), 0, 10);
+    }
+    if (FindField(line, "peak_rss_kb", value))  m.m_peakRSS = atol(value.c_str());
+    if (FindField(line, "equilibria", value))  m.m_equilibria = atoi(value.c_str());
+    if (FindField(line, "pivots", value))  m.m_pivots = atol(value.c_str());
+    baseline[ResultKey(result.m_solver, result.m_game)] = result;
+  }
+  if (!haveCorpus) {
+    throw InvalidFileException("Baseline does not record a corpus version");
+  }
+  return baseline;
+}
+
+//
+// Compares a result against the baseline, writing a line to p_stream
+// for each regression found, and returns the number of regressions.
+// A changed status, number of equilibria or number of pivots is always
+// a regression.  Time, allocations and peak memory depend on the machine
+// and build, so increases in these are reported, but counted only if
+// p_resources is true.  Times within p_minTime seconds of the baseline
+// are treated as noise.
+//
+int Compare(const BenchResult &p_result, const Baseline &p_baseline,
+	    bool p_resources, double p_tolerance, double p_minTime,
+	    std::ostream &p_stream)
+{
+  Baseline::const_iterator base =
+    p_baseline.find(ResultKey(p_result.m_solver, p_result.m_game));
+  if (base == p_baseline.end())  return 0;
+  const Measurement &was = base->second.m_measurement;
+  const Measurement &now = p_result.m_measurement;
+  std::string prefix = p_result.m_solver + " on " + p_result.m_game + ": ";
+
+  if (now.m_status != was.m_status) {
+    p_stream << prefix << "status " << now.m_status
+	     << " (baseline " << was.m_status << ")\n";
+    return 1;
+  }
+  if (now.m_status != "ok")  return 0;
+
+  int regressions = 0, resources = 0;
+  if (now.m_equilibria != was.m_equilibria) {
+    p_stream << prefix << now.m_equilibria << " equilibria (baseline "
+	     << was.m_equilibria << ")\n";
+    regressions++;
+  }
+  if (now.m_time > was.m_time * (1.0 + p_tolerance) &&
+      now.m_time - was.m_time > p_minTime) {
+    p_stream << prefix << "time " << now.m_time << "s (baseline "
+	     << was.m_time << "s)\n";
+    resources++;
+  }
+  if (now.m_allocations > was.m_allocations * (1.0 + p_tolerance)) {
+    p_stream << prefix << now.m_allocations << " allocations (baseline "
+	     << was.m_allocations << ")\n";
+    resources++;
+  }
+  // Pivot counts are deterministic, so any increase is a regression
+  if (was.m_pivots >= 0 && now.m_pivots > was.m_pivots) {
+    p_stream << prefix << now.m_pivots << " pivots (baseline "
+	     << was.m_pivots << ")\n";
+    regressions++;
+  }
+  if (was.m_peakRSS > 0 && now.m_peakRSS > was.m_peakRSS * (1.0 + p_tolerance)) {
+    p_stream << prefix << "peak RSS " << now.m_peakRSS << "kB (baseline "
+	     << was.m_peakRSS << "kB)\n";
+    resources++;
+  }
+  return (p_resources) ? regressions + resources : regressions;
+}
+
+}  // end anonymous namespace
+
+//------------------------------------------------------------------------
+//                            Main program
+//------------------------------------------------------------------------
+
+void PrintBanner(std::ostream &p_stream)
+{
+  p_stream << "Benchmark the Nash equilibrium solvers on a generated corpus\n";
+  p_stream << "Gambit version " VERSION ", Copyright (C) 1994-2016, The Gambit Project\n";
+  p_stream << "This is free software, distributed under the GNU GPL\n\n";
+}
+
+void PrintHelp(char *progname)
+{
+  PrintBanner(std::cerr);
+  std::cerr << "Usage: " << progname << " [OPTIONS]\n";
+  std::cerr << "Runs each solver on each game in the corpus it applies to.\n";
+
+  std::cerr << "Options:\n";
+  std::cerr << "  -b FILE          compare against the baseline results in FILE\n";
+  std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -n REPEATS       time the best of REPEATS runs (default is 3)\n";
+  std::cerr << "  -o FILE          write results to FILE (default is standard output)\n";
+  std::cerr << "  -q               quiet mode (suppresses banner and progress)\n";
+  std::cerr << "  -r               treat slowdowns and increased memory use as\n";
+  std::cerr << "                   regressions, as well as changed results\n";
+  std::cerr << "  -s SOLVER        only run SOLVER (may be given more than once)\n";
+  std::cerr << "  -t TOLERANCE     fractional increase in time or memory use reported\n";
+  std::cerr << "                   (default is 0.25)\n";
+  std::cerr << "  -T SECONDS       time limit for each solver run (default is 60)\n";
+  std::cerr << "  -v, --version    print version information\n";
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  opterr = 0;
+  bool quiet = false, resources = false;
+  int repeats = 3, timeout = 60;
+  double tolerance = 0.25;
+  std::string outputFile, baselineFile;
+  std::vector<std::string> only;
+
+  int long_opt_index = 0;
+  struct option long_options[] = {
+    { "help", 0, NULL, 'h'   },
+    { "version", 0, NULL, 'v'  },
+    { 0,    0,    0,    0   }
+  };
+  int c;
+  while ((c = getopt_long(argc, argv, "b:hn:o:qrs:t:T:v", long_options, &long_opt_index)) != -1) {
+    switch (c) {
+    case 'v':
+      PrintBanner(std::cerr); exit(1);
+    case 'b':
+      baselineFile = optarg;
+      break;
+    case 'n':
+      repeats = atoi(optarg);
+      break;
+    case 'o':
+      outputFile = optarg;
+      break;
+    case 'q':
+      quiet = true;
+      break;
+    case 'r':
+      resources = true;
+      break;
+    case 's':
+      only.push_back(optarg);
+      break;
+    case 't':
+      tolerance = atof(optarg);
+      break;
+    case 'T':
+      timeout = atoi(optarg);
+      break;
+    case 'h':
+      PrintHelp(argv[0]);
+      break;
+    case '?':
+      if (isprint(optopt)) {
+	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
+      }
+      else {
+	std::cerr << argv[0] << ": Unknown option character `\\x" << optopt << "`.\n";
+      }
+      return 1;
+    default:
+      abort();
+    }
+  }
+  if (repeats < 1 || timeout < 1) {
+    PrintHelp(argv[0]);
+  }
+
+  if (!quiet) {
+    PrintBanner(std::cerr);
+  }
+
+  try {
+    Baseline baseline;
+    if (baselineFile != "") {
+      std::ifstream file(baselineFile.c_str());
+      if (!file.is_open()) {
+	std::ostringstream error_message;
+	error_message << argv[0] << ": " << baselineFile;
+	perror(error_message.str().c_str());
+	exit(1);
+      }
+      baseline = ReadBaseline(file);
+    }
+
+    std::vector<CorpusGame> corpus = BuildCorpus();
+    std::vector<BenchResult> results;
+    int regressions = 0;
+    for (int s = 0; s_solvers[s].m_name; s++) {
+      const BenchSolver &solver = s_solvers[s];
+      if (!only.empty() &&
+	  std::find(only.begin(), only.end(), solver.m_name) == only.end()) {
+	continue;
+      }
+      for (size_t g = 0; g < corpus.size(); g++) {
+	if (!Applies(solver, corpus[g].m_game))  continue;
+	BenchResult result;
+	result.m_solver = solver.m_name;
+	result.m_game = corpus[g].m_name;
+	result.m_measurement = Measure(solver, corpus[g].m_game,
+				       repeats, timeout);
+	if (!quiet) {
+	  const Measurement &m = result.m_measurement;
+	  std::cerr << std::setw(10) << std::left << result.m_solver
+		    << std::setw(16) << result.m_game << std::right;
+	  if (m.m_status == "ok") {
+	    std::cerr << std::fixed << std::setprecision(4)
+		      << std::setw(10) << m.m_time << "s"
+		      << std::setw(12) << m.m_allocations << " allocs"
+		      << std::setw(9) << m.m_peakRSS << " kB"
+		      << std::setw(6) << m.m_equilibria << " eq"
+		      << std::setw(9) << m.m_pivots << " pivots\n";
+	    std::cerr.unsetf(std::ios::fixed);
+	  }
+	  else {
+	    std::cerr << "  " << m.m_status << "\n";
+	  }
+	}
+	regressions += Compare(result, baseline, resources, tolerance, 0.01,
+			       std::cerr);
+	results.push_back(result);
+      }
+    }
+
+    if (outputFile != "") {
+      std::ofstream file(outputFile.c_str());
+      WriteResults(file, repeats, results);
+    }
+    else {
+      WriteResults(std::cout, repeats, results);
+    }
+
+    if (regressions > 0) {
+      std::cerr << regressions << " regression(s) against baseline "
+		<< baselineFile << "\n";
+      return 1;
+    }
+    return 0;
+  }
+  catch (std::runtime_error &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
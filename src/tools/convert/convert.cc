@@ -51,6 +51,10 @@ void PrintHelp(char *progname)
   std::cerr << "     FORMAT=sgame  convert to LaTeX sgame style\n";
   std::cerr << "  -c PLAYER        the player to show on columns (default is 2)\n";
   std::cerr << "  -r PLAYER        the player to show on rows (default is 1)\n";
+  std::cerr << "  -d               eliminate strictly dominated strategies\n";
+  std::cerr << "  -w               eliminate weakly dominated strategies\n";
+  std::cerr << "  -m               also eliminate strategies dominated by\n";
+  std::cerr << "                   mixed strategies (with -d or -w)\n";
   std::cerr << "  -h               print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   exit(1);
@@ -61,10 +65,10 @@ int main(int argc, char *argv[])
 {
   int c;
   int rowPlayer = 1, colPlayer = 2;
-  bool quiet = false;
+  bool quiet = false, eliminate = false, strict = false, mixed = false;
   std::string format;
 
-  while ((c = getopt(argc, argv, "r:c:hqO:")) != -1) {
+  while ((c = getopt(argc, argv, "r:c:dwmhqO:")) != -1) {
     switch (c) {
     case 'r':
       rowPlayer = atoi(optarg);
@@ -75,6 +79,17 @@ int main(int argc, char *argv[])
     case 'O':
       format = optarg;
       break;
+    case 'd':
+      eliminate = true;
+      strict = true;
+      break;
+    case 'w':
+      eliminate = true;
+      strict = false;
+      break;
+    case 'm':
+      mixed = true;
+      break;
     case 'q':
       quiet = true;
       break;
@@ -137,6 +152,11 @@ int main(int argc, char *argv[])
       return 1;
     }
 
+    if (eliminate) {
+      Gambit::StrategySupportProfile support(game);
+      game = support.IteratedUndominated(strict, mixed).Restrict();
+    }
+
     if (format == "html") {
       Gambit::HTMLGameWriter writer;
       std::cout << writer.Write(game, rowPlayer, colPlayer);
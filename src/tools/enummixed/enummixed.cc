@@ -69,6 +69,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -L               use lrslib for enumeration (experimental!)\n";
   std::cerr << "  -c               output connectedness information\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          write solver statistics to standard error, as JSON\n";
+  std::cerr << "  --binary         write equilibria in the compact binary format\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
@@ -81,9 +83,12 @@ int main(int argc, char *argv[])
   bool showConnect = false;
   int numDecimals = 6;
 
+  int printStats = 0, printBinary = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
+    { "stats", 0, &printStats, 1 },
+    { "binary", 0, &printBinary, 1 },
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
@@ -112,6 +117,8 @@ int main(int argc, char *argv[])
     case 'q':
       quiet = true;
       break;
+    case 0:
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -125,6 +132,10 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (printBinary) {
+    SetBinaryStdout();
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -144,17 +155,33 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    shared_ptr<ProgressObserver> progress;
+    if (printStats) {
+      progress = new ProgressJSONWriter(std::cerr);
+    }
     if (uselrs) {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-      renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      if (printBinary) {
+	renderer = new MixedStrategyBinaryRenderer<Rational>(std::cout);
+      }
+      else {
+	renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      }
       EnumMixedLrsStrategySolver solver(renderer);
+      solver.SetProgressObserver(progress);
       solver.Solve(game);
     }
     else if (useFloat) {
       shared_ptr<StrategyProfileRenderer<double> > renderer;
-      renderer = new MixedStrategyCSVRenderer<double>(std::cout,
-						      numDecimals);
+      if (printBinary) {
+	renderer = new MixedStrategyBinaryRenderer<double>(std::cout);
+      }
+      else {
+	renderer = new MixedStrategyCSVRenderer<double>(std::cout,
+						        numDecimals);
+      }
       EnumMixedStrategySolver<double> solver(renderer);
+      solver.SetProgressObserver(progress);
       shared_ptr<EnumMixedStrategySolution<double> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
@@ -165,8 +192,14 @@ int main(int argc, char *argv[])
     }
     else {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-      renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      if (printBinary) {
+	renderer = new MixedStrategyBinaryRenderer<Rational>(std::cout);
+      }
+      else {
+	renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      }
       EnumMixedStrategySolver<Rational> solver(renderer);
+      solver.SetProgressObserver(progress);
       shared_ptr<EnumMixedStrategySolution<Rational> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
@@ -175,6 +208,10 @@ int main(int argc, char *argv[])
 	PrintCliques(cliques, renderer);
       }
     }
+    if (printStats) {
+      Stats::WriteJSON(std::cerr);
+      std::cerr << std::endl;
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
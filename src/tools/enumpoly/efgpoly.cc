@@ -36,6 +36,8 @@ using namespace Gambit;
 
 extern int g_numDecimals;
 extern bool g_verbose;
+extern int g_numThreads;
+extern SolverContext *g_context;
 
 //
 // A class to organize the data needed to build the polynomials
@@ -269,6 +271,8 @@ SolveSupport(const BehaviorSupportProfile &p_support, bool &p_isSingular)
   gRectangle<double> Cube(bottoms, tops); 
 
   QuikSolv<double> quickie(equations);
+  quickie.SetNumThreads(g_numThreads);
+  quickie.SetContext(g_context);
 #ifdef UNUSED
   if(params.trace>0) {
     (*params.tracefile) << "\nThe equilibrium equations are \n" 
@@ -396,8 +400,15 @@ void SolveExtensive(const Game &p_game)
     }
       
     bool isSingular = false;
-    List<MixedBehaviorProfile<double> > newsolns = 
-      SolveSupport(supports[i], isSingular);
+    List<MixedBehaviorProfile<double> > newsolns;
+    try {
+      if (g_context)  g_context->Check();
+      newsolns = SolveSupport(supports[i], isSingular);
+    }
+    catch (SolverInterrupted &) {
+      // The equilibria on the supports already searched have been printed
+      return;
+    }
 
     for (int j = 1; j <= newsolns.Length(); j++) {
       MixedBehaviorProfile<double> fullProfile = ToFullSupport(newsolns[j]);
@@ -28,6 +28,7 @@
 #include "rectangl.h"
 #include "gpoly.h"
 #include "gpolylst.h"
+#include "gpolyeval.h"
 
 // ****************************
 //      class TreeOfPartials
@@ -37,10 +38,20 @@ template <class T> class TreeOfPartials {
 private:
   gTree<gPoly<T> > PartialTree;
 
+  // Compiled forms of the nonzero polynomials in the tree, in preorder,
+  // with the root polynomial first.  PartialOrders[i] is the monomial
+  // x^w, where w counts the differentiations leading to CompiledPartials[i].
+  Gambit::Array<gCompiledPoly<T> > CompiledPartials;
+  Gambit::Array<gCompiledPoly<T> > PartialOrders;
+  // Index into CompiledPartials of each first partial, or 0 if it is zero
+  Gambit::Array<int>               FirstPartials;
+
   /// Recursive Constructions and Computations ///
 
    void TreeOfPartialsRECURSIVE(gTree<gPoly<T> >&,
 				gTreeNode<gPoly<T> >*)         const;
+   void CompilePartialsRECURSIVE(const gTreeNode<gPoly<T> >*,
+				 Gambit::Array<int>&);
 
    T MaximalNonconstantContributionRECURSIVE(
 				const gTreeNode<gPoly<T> >*,
@@ -65,7 +76,7 @@ public:
    inline bool operator !=(const TreeOfPartials<T>& rhs) const 
      { return !(*this == rhs); }
    inline int Dmnsn()                                    const 
-     { return RootNode()->GetData().Dmnsn(); }
+     { return CompiledPartials[1].Dmnsn(); }
    T EvaluateRootPoly(const Gambit::Vector<T>& point)    const; 
 
 
@@ -81,6 +92,14 @@ public:
      { return RootNode()->GetData(); }
    T ValueOfRootPoly(const Gambit::Vector<T>& point)           const;
    T ValueOfPartialOfRootPoly(const int&, const Gambit::Vector<T>&)   const;
+
+   // Evaluation against a power table already filled at the point;
+   // the table must cover DegreesOfVars()
+   inline const Gambit::Array<int>& DegreesOfVars()             const
+     { return CompiledPartials[1].DegreesOfVars(); }
+   T ValueOfRootPoly(const gPowerTable<T>&)                     const;
+   T ValueOfPartialOfRootPoly(const int&, const gPowerTable<T>&) const;
+
    Gambit::Vector<T> VectorOfPartials(const Gambit::Vector<T>&)              const;
    bool      PolyHasNoRootsIn(const gRectangle<T>&)            const;
    bool MultiaffinePolyHasNoRootsIn(const gRectangle<T>&)      const;
@@ -98,6 +117,10 @@ public:
 template <class T> class ListOfPartialTrees {
 private:
   Gambit::List<TreeOfPartials<T> >     PartialTreeList;
+  // Degree of each variable in the system, used to size power tables
+  Gambit::Array<int>                   MaxDegrees;
+
+  void ComputeMaxDegrees();
 
   // Disabling this operator -- we don't want it called
   ListOfPartialTrees<T> &operator=(const ListOfPartialTrees<T> &);
@@ -124,6 +147,10 @@ public:
   Gambit::Matrix<T> DerivativeMatrix(const Gambit::Vector<T>&, const int&)      const; 
   Gambit::SquareMatrix<T> SquareDerivativeMatrix(const Gambit::Vector<T>&)      const; 
   Gambit::Vector<T> ValuesOfRootPolys(const Gambit::Vector<T>&, const int&)     const;
+  // Values and derivative matrix of the first NoEquations polynomials,
+  // computed from a single power table
+  void ValuesAndDerivativeMatrix(const Gambit::Vector<T>&, const int&,
+				 Gambit::Vector<T>&, Gambit::Matrix<T>&) const;
    T         MaximalNonconstantDifference(const int&,
 					  const int&,
 					  const Gambit::Vector<T>&, 
@@ -0,0 +1,104 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/enumpoly/gpolyeval.h
+// Compiled (flat) representation of polynomials for fast evaluation
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GPOLYEVAL_H
+#define GPOLYEVAL_H
+
+#include "gambit/gambit.h"
+#include "gpoly.h"
+
+/*
+   The root finders evaluate the same polynomials, and all their
+partial derivatives, at a very large number of points.  Walking the
+linked list of monomials in a gPoly, and recomputing every power of
+every variable for every monomial, dominates the cost of doing so.
+
+   A gCompiledPoly is a flat, read-only copy of a gPoly: the
+coefficients are stored contiguously, and each monomial is stored
+as the sparse list of (variable, exponent) pairs with nonzero
+exponent.  Evaluation is done against a gPowerTable, which holds
+the powers x_j^k of the coordinates of a point for k up to the
+maximal degree needed.  A single table is filled once per point and
+shared by every polynomial evaluated at that point.
+*/
+
+// ***********************
+//    class gPowerTable
+// ***********************
+
+template <class T> class gPowerTable {
+private:
+  Gambit::Array<int> m_offsets;  // position of x_j^0 in m_powers
+  Gambit::Array<T> m_powers;
+
+public:
+  // Constructs a table holding x_j^0, ..., x_j^{p_degrees[j]} for each j
+  gPowerTable(const Gambit::Array<int> &p_degrees);
+
+  // Fills the table with the powers of the coordinates of the point
+  void SetPoint(const Gambit::Vector<T> &);
+  // Fills the table with the Taylor weights h_j^k / k! instead
+  void SetTaylorWeights(const Gambit::Vector<T> &);
+
+  inline int Dmnsn(void) const { return m_offsets.Length(); }
+  inline const T &operator()(int p_var, int p_exp) const
+    { return m_powers[m_offsets[p_var] + p_exp]; }
+};
+
+// ***********************
+//   class gCompiledPoly
+// ***********************
+
+template <class T> class gCompiledPoly {
+private:
+  int m_dmnsn, m_degree;
+  bool m_isMultiaffine;
+  Gambit::Array<T> m_coefs;
+  // Factors of term i are at positions m_start[i], ..., m_start[i+1]-1
+  Gambit::Array<int> m_start, m_vars, m_exps;
+  Gambit::Array<int> m_degreeOfVar;
+
+public:
+  // Constructs the zero polynomial in no variables
+  gCompiledPoly(void);
+  // Constructs the compiled form of the polynomial
+  gCompiledPoly(const gPoly<T> &);
+  // Constructs the single monomial p_coef * x^p_exps
+  gCompiledPoly(const T &p_coef, const Gambit::Array<int> &p_exps);
+
+  inline int Dmnsn(void) const { return m_dmnsn; }
+  inline int Degree(void) const { return m_degree; }
+  inline int DegreeOfVar(int p_var) const { return m_degreeOfVar[p_var]; }
+  inline const Gambit::Array<int> &DegreesOfVars(void) const
+    { return m_degreeOfVar; }
+  inline bool IsMultiaffine(void) const { return m_isMultiaffine; }
+  inline bool IsZero(void) const { return (m_coefs.Length() == 0); }
+  inline int NoTerms(void) const { return m_coefs.Length(); }
+
+  // Evaluates the polynomial using a table filled at the point.
+  // The table must cover at least DegreeOfVar(j) for each variable j.
+  T Evaluate(const gPowerTable<T> &) const;
+  // Convenience version, which builds its own table
+  T Evaluate(const Gambit::Vector<T> &) const;
+};
+
+#endif  // GPOLYEVAL_H
@@ -24,6 +24,9 @@
 
 #include "nfgcpoly.h"
 
+extern int g_numThreads;
+extern Gambit::SolverContext *g_context;
+
 //-------------------------------------------------------------------------
 //              HeuristicPolEnumModule: Member functions
 //-------------------------------------------------------------------------
@@ -207,6 +210,8 @@ HeuristicPolEnumModule::NashOnSupportSolnVectors(const gPolyList<double> &equati
 					const gRectangle<double> &Cube)
 {  
   QuikSolv<double> quickie(equations);
+  quickie.SetNumThreads(g_numThreads);
+  quickie.SetContext(g_context);
   //  p_status.SetProgress(0);
 
   try {
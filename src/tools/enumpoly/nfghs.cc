@@ -37,6 +37,8 @@ void PrintProfile(std::ostream &p_stream,
 		  const std::string &p_label,
 		  const MixedStrategyProfile<double> &p_profile);
 
+extern SolverContext *g_context;
+
 //---------------------------------------------------------------------------
 //                      gbtNfgHs: member functions
 //---------------------------------------------------------------------------
@@ -81,7 +83,13 @@ void gbtNfgHs::Solve(Game game) {
   diff = 0;
   while ((size <= maxsize) && (diff <= maxdiff)) {
 
-    SolveSizeDiff(game, solutions, size, diff);
+    try {
+      SolveSizeDiff(game, solutions, size, diff);
+    }
+    catch (SolverInterrupted &) {
+      // The equilibria found so far have been printed
+      break;
+    }
     if ((m_stopAfter > 0) && (solutions.Length() >= m_stopAfter)) {
       size = maxsize + 1;
       diff = maxdiff + 1;
@@ -669,6 +677,8 @@ bool gbtNfgHs::FeasibilityProgram(Game game,
 				  Gambit::List < MixedStrategyProfile < double > > & solutions, Gambit::Array < Gambit::Array < GameStrategy > > & uninstantiatedSupports) {
 
 
+  if (g_context)  g_context->Check();
+
   StrategySupportProfile restrictedGame(game);
   for (int pl = 1; pl <= numPlayers; pl++) {
     for (int st = 1; st <= game->GetPlayer(pl)->NumStrategies(); st++) {
@@ -32,6 +32,8 @@
 
 extern int g_numDecimals;
 extern bool g_verbose; 
+extern int g_numThreads;
+extern Gambit::SolverContext *g_context;
 
 class PolEnumModule  {
 private:
@@ -263,6 +265,8 @@ PolEnumModule::NashOnSupportSolnVectors(const gPolyList<double> &equations,
 					const gRectangle<double> &Cube)
 {  
   QuikSolv<double> quickie(equations);
+  quickie.SetNumThreads(g_numThreads);
+  quickie.SetContext(g_context);
   //  p_status.SetProgress(0);
 
   try {
@@ -492,7 +496,14 @@ void SolveStrategic(const Gambit::Game &p_nfg)
       PrintSupport(std::cout, "candidate", supports[i]);
     }
 
-    PolEnum(supports[i], newsolns, newevals, newtime, is_singular);
+    try {
+      if (g_context)  g_context->Check();
+      PolEnum(supports[i], newsolns, newevals, newtime, is_singular);
+    }
+    catch (Gambit::SolverInterrupted &) {
+      // The equilibria on the supports already searched have been printed
+      return;
+    }
       
     for (int j = 1; j <= newsolns.Length(); j++) {
       Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
@@ -74,6 +74,8 @@ template <class T> class QuikSolv {
         Gambit::List<Gambit::Vector<double> >     Roots;
   const bool                         isMultiaffine;
   const Gambit::RectArray<bool>             Equation_i_uses_var_j;
+        int                          NumThreads;
+        Gambit::SolverContext       *Context;
 
   // Supporting routines for the constructors
 
@@ -129,6 +131,23 @@ template <class T> class QuikSolv {
 					const int&,
 					      int*)                  const;
 
+  // Task-parallel version of FindRootsRecursion.  Each subrectangle is
+  // examined by its own task; roots are tagged with the sequence of
+  // subdivision cells leading to them, so the list is returned in the
+  // same (depth-first) order as the serial search produces.
+  class SubdivisionState;
+
+  void               FindRootsParallel(   Gambit::List<Gambit::Vector<double> >*,
+					const gRectangle<double>&, 
+					const int&,
+					      int &iterations,
+					const int&,
+					      int*)                  const;
+  void               FindRootsTask(SubdivisionState *,
+				   const gRectangle<double>&,
+				   const Gambit::Array<int> &path,
+				         Gambit::Array<int> precedence) const;
+
   const bool         ARootExistsRecursion(const gRectangle<double>&, 
 					        Gambit::Vector<double>&,
 					  const gRectangle<double>&, 
@@ -167,6 +186,24 @@ template <class T> class QuikSolv {
    inline const bool                     IsMultiaffine()             const
      { return isMultiaffine; }
 
+   // Number of threads used to search subrectangles in FindRoots();
+   // 1 (the default) searches serially.  Has no effect unless built
+   // with OpenMP.  The roots found, their order, and whether the
+   // iteration limit is reached, are the same for any number of threads.
+   inline int                            GetNumThreads()             const
+     { return NumThreads; }
+   inline void                           SetNumThreads(int p_threads)
+     { NumThreads = (p_threads < 1) ? 1 : p_threads; }
+
+   // Budgets checked at each subrectangle searched by FindRoots(), if
+   // any.  When one is exhausted, FindRoots() throws SolverInterrupted.
+   // With a limit on the number of roots, a parallel search may examine
+   // subrectangles a serial one would not, and so use more of the budget.
+   inline Gambit::SolverContext         *GetContext()                const
+     { return Context; }
+   inline void                           SetContext(Gambit::SolverContext *p_context)
+     { Context = p_context; }
+
   // Refines the accuracy of roots obtained from other algorithms
   Gambit::Vector<double> NewtonPolishOnce(const Gambit::Vector<double> &)        const;
   Gambit::Vector<double> SlowNewtonPolishOnce(const Gambit::Vector<double> &)    const;
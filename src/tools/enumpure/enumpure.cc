@@ -51,7 +51,10 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               report equilibria in strategies even for extensive games\n";
   std::cerr << "  -A               compute agent form equilibria\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -j THREADS       search using THREADS threads\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          write solver statistics to standard error, as JSON\n";
+  std::cerr << "  --binary         write equilibria in the compact binary format\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
@@ -63,15 +66,19 @@ int main(int argc, char *argv[])
   opterr = 0;
   bool quiet = false, reportStrategic = false, solveAgent = false, bySubgames = false;
   bool printDetail = false;
+  int numThreads = 1;
   
+  int printStats = 0, printBinary = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
+    { "stats", 0, &printStats, 1 },
+    { "binary", 0, &printBinary, 1 },
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "DvhqASP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "DvhqASPj:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -87,12 +94,17 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
     case 'q':
       quiet = true;
       break;
+    case 0:
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -106,6 +118,10 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (printBinary) {
+    SetBinaryStdout();
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -125,11 +141,18 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    shared_ptr<ProgressObserver> progress;
+    if (printStats) {
+      progress = new ProgressJSONWriter(std::cerr);
+    }
     shared_ptr<StrategyProfileRenderer<Rational> > renderer;
     if (reportStrategic || !game->IsTree()) {
       if (printDetail) {
 	renderer = new MixedStrategyDetailRenderer<Rational>(std::cout);
       }
+      else if (printBinary) {
+	renderer = new MixedStrategyBinaryRenderer<Rational>(std::cout);
+      }
       else {
 	renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
       }
@@ -138,6 +161,9 @@ int main(int argc, char *argv[])
       if (printDetail) {
 	renderer = new BehavStrategyDetailRenderer<Rational>(std::cout);
       }
+      else if (printBinary) {
+	renderer = new BehavStrategyBinaryRenderer<Rational>(std::cout);
+      }
       else {
 	renderer = new BehavStrategyCSVRenderer<Rational>(std::cout);
       }
@@ -147,31 +173,39 @@ int main(int argc, char *argv[])
       if (bySubgames) {
 	shared_ptr<BehavSolver<Rational> > stage;
         if (solveAgent) {
-	  stage = new EnumPureAgentSolver();
+	  stage = new EnumPureAgentSolver(0, numThreads);
 	}
 	else {
 	  shared_ptr<StrategySolver<Rational> > substage = 
-	    new EnumPureStrategySolver();
+	    new EnumPureStrategySolver(0, numThreads);
 	  stage = new BehavViaStrategySolver<Rational>(substage);
 	}
-	SubgameBehavSolver<Rational> algorithm(stage, renderer);
+	SubgameBehavSolver<Rational> algorithm(stage, renderer, numThreads);
+	algorithm.SetProgressObserver(progress);
 	algorithm.Solve(game);
       }
       else {
 	if (solveAgent) {
-	  EnumPureAgentSolver algorithm(renderer);
+	  EnumPureAgentSolver algorithm(renderer, numThreads);
+	  algorithm.SetProgressObserver(progress);
 	  algorithm.Solve(game);
 	}
 	else {
-	  EnumPureStrategySolver algorithm(renderer);
+	  EnumPureStrategySolver algorithm(renderer, numThreads);
+	  algorithm.SetProgressObserver(progress);
 	  algorithm.Solve(game);
 	}
       }
     }
     else {
-      EnumPureStrategySolver algorithm(renderer);
+      EnumPureStrategySolver algorithm(renderer, numThreads);
+      algorithm.SetProgressObserver(progress);
       algorithm.Solve(game);
     }
+    if (printStats) {
+      Stats::WriteJSON(std::cerr);
+      std::cerr << std::endl;
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -85,6 +85,8 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          write solver statistics to standard error, as JSON\n";
+  std::cerr << "  --binary         write equilibria in the compact binary format\n";
   std::cerr << "  -n COUNT         number of perturbation vectors to generate\n";
   std::cerr << "  -s FILE          file containing perturbation vectors\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -101,9 +103,12 @@ int main(int argc, char *argv[])
   int numDecimals = 6, numVectors = 1;
   std::string startFile;
 
+  int printStats = 0, printBinary = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
+    { "stats", 0, &printStats, 1 },
+    { "binary", 0, &printBinary, 1 },
     { "version", 0, NULL, 'v'  },
     { "verbose", 0, NULL, 'V'  },
     { 0,    0,    0,    0   }
@@ -133,6 +138,8 @@ int main(int argc, char *argv[])
     case 'h':
       PrintHelp(argv[0]);
       break;
+    case 0:
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -146,6 +153,10 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (printBinary) {
+    SetBinaryStdout();
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -166,9 +177,17 @@ int main(int argc, char *argv[])
   try {
     Game game = ReadGame(*input_stream);
     shared_ptr<StrategyProfileRenderer<double> > renderer;
-    renderer = new MixedStrategyCSVRenderer<double>(std::cout,
-						    numDecimals);
+    if (printBinary) {
+      renderer = new MixedStrategyBinaryRenderer<double>(std::cout);
+    }
+    else {
+      renderer = new MixedStrategyCSVRenderer<double>(std::cout,
+						      numDecimals);
+    }
     NashGNMStrategySolver solver(renderer, verbose);
+    if (printStats) {
+      solver.SetProgressObserver(new ProgressJSONWriter(std::cerr));
+    }
 
     List<MixedStrategyProfile<double> > perts;
     if (startFile != "") {
@@ -182,6 +201,10 @@ int main(int argc, char *argv[])
     for (int i = 1; i <= perts.size(); i++) {
       solver.Solve(game, perts[i]);
     }
+    if (printStats) {
+      Stats::WriteJSON(std::cerr);
+      std::cerr << std::endl;
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -50,6 +50,8 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          write solver statistics to standard error, as JSON\n";
+  std::cerr << "  --binary         write equilibria in the compact binary format\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -63,9 +65,12 @@ int main(int argc, char *argv[])
   bool quiet = false, verbose = false;
   int numDecimals = 6;
 
+  int printStats = 0, printBinary = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
+    { "stats", 0, &printStats, 1 },
+    { "binary", 0, &printBinary, 1 },
     { "version", 0, NULL, 'v'  },
     { "verbose", 0, NULL, 'V'  },
     { 0,    0,    0,    0   }
@@ -89,6 +94,8 @@ int main(int argc, char *argv[])
     case 'h':
       PrintHelp(argv[0]);
       break;
+    case 0:
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -102,6 +109,10 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (printBinary) {
+    SetBinaryStdout();
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -122,10 +133,22 @@ int main(int argc, char *argv[])
   try {
     Game game = ReadGame(*input_stream);
     shared_ptr<StrategyProfileRenderer<double> > renderer;
-    renderer = new MixedStrategyCSVRenderer<double>(std::cout,
-						    numDecimals);
+    if (printBinary) {
+      renderer = new MixedStrategyBinaryRenderer<double>(std::cout);
+    }
+    else {
+      renderer = new MixedStrategyCSVRenderer<double>(std::cout,
+						      numDecimals);
+    }
     NashIPAStrategySolver solver(renderer);
+    if (printStats) {
+      solver.SetProgressObserver(new ProgressJSONWriter(std::cerr));
+    }
     solver.Solve(game);
+    if (printStats) {
+      Stats::WriteJSON(std::cerr);
+      std::cerr << std::endl;
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
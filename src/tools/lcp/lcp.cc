@@ -50,6 +50,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -S               use strategic game\n";
+  std::cerr << "  -H               follow paths in floating point, and certify\n";
+  std::cerr << "                   equilibria in exact arithmetic\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
   std::cerr << "  -e EQA           terminate after finding EQA equilibria\n";
   std::cerr << "                   (default is to find all accessible equilbria\n";
@@ -57,6 +59,8 @@ void PrintHelp(char *progname)
   std::cerr << "                   (only if number of equilibria sought is not 1)\n";
   std::cerr << "  -D               print detailed information about equilibria\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          write solver statistics to standard error, as JSON\n";
+  std::cerr << "  --binary         write equilibria in the compact binary format\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
@@ -67,16 +71,19 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, useStrategic = false, bySubgames = false, quiet = false;
-  bool printDetail = false;
+  bool printDetail = false, useHybrid = false;
   int numDecimals = 6, stopAfter = 0, maxDepth = 0;
 
+  int printStats = 0, printBinary = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
+    { "stats", 0, &printStats, 1 },
+    { "binary", 0, &printBinary, 1 },
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqSHPe:r:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -102,9 +109,14 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'H':
+      useHybrid = true;
+      break;
     case 'P':
       bySubgames = true;
       break;
+    case 0:
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -118,6 +130,10 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (printBinary) {
+    SetBinaryStdout();
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -137,6 +153,10 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    shared_ptr<ProgressObserver> progress;
+    if (printStats) {
+      progress = new ProgressJSONWriter(std::cerr);
+    }
     if (!game->IsTree() || useStrategic) {
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
@@ -144,11 +164,15 @@ int main(int argc, char *argv[])
 	  renderer = new MixedStrategyDetailRenderer<double>(std::cout,
 							     numDecimals);
 	}
+	else if (printBinary) {
+	  renderer = new MixedStrategyBinaryRenderer<double>(std::cout);
+	}
 	else {
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
 	NashLcpStrategySolver<double> algorithm(stopAfter, maxDepth,
 						renderer);
+	algorithm.SetProgressObserver(progress);
 	algorithm.Solve(game);
       }
       else {
@@ -156,11 +180,15 @@ int main(int argc, char *argv[])
 	if (printDetail) {
 	  renderer = new MixedStrategyDetailRenderer<Rational>(std::cout);
 	}
+	else if (printBinary) {
+	  renderer = new MixedStrategyBinaryRenderer<Rational>(std::cout);
+	}
 	else {
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
 	NashLcpStrategySolver<Rational> algorithm(stopAfter, maxDepth,
-						  renderer);
+						  renderer, useHybrid);
+	algorithm.SetProgressObserver(progress);
 	algorithm.Solve(game);
       }
     }
@@ -172,11 +200,15 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyDetailRenderer<double>(std::cout,
 							       numDecimals);
 	  }
+	  else if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<double>(std::cout);
+	  }
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
 	  NashLcpBehaviorSolver<double> algorithm(stopAfter, maxDepth, renderer);
+	  algorithm.SetProgressObserver(progress);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -184,10 +216,14 @@ int main(int argc, char *argv[])
 	  if (printDetail) {
 	    renderer = new BehavStrategyDetailRenderer<Rational>(std::cout);
 	  }
+	  else if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<Rational>(std::cout);
+	  }
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout);
 	  }
 	  NashLcpBehaviorSolver<Rational> algorithm(stopAfter, maxDepth, renderer);
+	  algorithm.SetProgressObserver(progress);
 	  algorithm.Solve(game);
 	}
       }
@@ -200,11 +236,15 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyDetailRenderer<double>(std::cout,
 							       numDecimals);
 	  }
+	  else if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<double>(std::cout);
+	  }
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
 	  SubgameBehavSolver<double> algorithm(stage, renderer);
+	  algorithm.SetProgressObserver(progress);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -215,15 +255,23 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyDetailRenderer<Rational>(std::cout,
 								 numDecimals);
 	  }
+	  else if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<Rational>(std::cout);
+	  }
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout, 
 							      numDecimals);
 	  }
 	  SubgameBehavSolver<Rational> algorithm(stage, renderer);
+	  algorithm.SetProgressObserver(progress);
 	  algorithm.Solve(game);
 	}
       }
     }
+    if (printStats) {
+      Stats::WriteJSON(std::cerr);
+      std::cerr << std::endl;
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -110,7 +110,15 @@ NashLiapBehavSolver::Solve(const MixedBehaviorProfile<double> &p_start) const
   double fval;
   minimizer.Set(F, p, fval, gradient, .01, .0001);
 
+  m_progress.Start();
   for (int iter = 1; iter <= m_maxitsN; iter++) {
+    m_progress.Report(0);
+    try {
+      Checkpoint();
+    }
+    catch (SolverInterrupted &) {
+      break;
+    }
     if (!minimizer.Iterate(F, p, fval, gradient, dx)) {
       break;
     }
@@ -126,6 +134,7 @@ NashLiapBehavSolver::Solve(const MixedBehaviorProfile<double> &p_start) const
     this->m_onEquilibrium->Render(p, "end");
   }
 
+  m_progress.Finish(solutions.Length());
   return solutions;
 }
 
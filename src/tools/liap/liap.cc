@@ -49,6 +49,8 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      print probabilities with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          write solver statistics to standard error, as JSON\n";
+  std::cerr << "  --binary         write equilibria in the compact binary format\n";
   std::cerr << "  -n COUNT         number of starting points to generate\n";
   std::cerr << "  -s FILE          file containing starting points\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -140,9 +142,12 @@ int main(int argc, char *argv[])
   double tolN = 1.0e-10;
   std::string startFile = "";
  
+  int printStats = 0, printBinary = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
+    { "stats", 0, &printStats, 1 },
+    { "binary", 0, &printBinary, 1 },
     { "version", 0, NULL, 'v'  },
     { "verbose", 0, NULL, 'V'  },
     { 0,    0,    0,    0   }
@@ -173,6 +178,8 @@ int main(int argc, char *argv[])
     case 'V':
       verbose = true;
       break;
+    case 0:
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -186,6 +193,10 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (printBinary) {
+    SetBinaryStdout();
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -205,6 +216,10 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    shared_ptr<ProgressObserver> progress;
+    if (printStats) {
+      progress = new ProgressJSONWriter(std::cerr);
+    }
     if (!game->IsTree() || useStrategic) {
       List<MixedStrategyProfile<double> > starts;
       if (startFile != "") {
@@ -216,11 +231,19 @@ int main(int argc, char *argv[])
 	starts = RandomStrategyProfiles(game, numTries);
       }
 
-      for (int i = 1; i <= starts.size(); i++) {
-	shared_ptr<StrategyProfileRenderer<double> > renderer;
+      // One renderer for all starting points, so binary output has
+      // a single header
+      shared_ptr<StrategyProfileRenderer<double> > renderer;
+      if (printBinary) {
+	renderer = new MixedStrategyBinaryRenderer<double>(std::cout);
+      }
+      else {
 	renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 							numDecimals);
+      }
+      for (int i = 1; i <= starts.size(); i++) {
 	NashLiapStrategySolver algorithm(maxitsN, verbose, renderer);
+	algorithm.SetProgressObserver(progress);
 	algorithm.Solve(starts[i]);
       }
     }
@@ -235,14 +258,26 @@ int main(int argc, char *argv[])
 	starts = RandomBehaviorProfiles(game, numTries);
       }
 
-      for (int i = 1; i <= starts.size(); i++) {
-	shared_ptr<StrategyProfileRenderer<double> > renderer;
+      // One renderer for all starting points, so binary output has
+      // a single header
+      shared_ptr<StrategyProfileRenderer<double> > renderer;
+      if (printBinary) {
+	renderer = new BehavStrategyBinaryRenderer<double>(std::cout);
+      }
+      else {
 	renderer = new BehavStrategyCSVRenderer<double>(std::cout,
 							numDecimals);
+      }
+      for (int i = 1; i <= starts.size(); i++) {
 	NashLiapBehavSolver algorithm(maxitsN, verbose, renderer);
+	algorithm.SetProgressObserver(progress);
 	algorithm.Solve(starts[i]);
       }
     }
+    if (printStats) {
+      Stats::WriteJSON(std::cerr);
+      std::cerr << std::endl;
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
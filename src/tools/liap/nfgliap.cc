@@ -139,7 +139,15 @@ NashLiapStrategySolver::Solve(const MixedStrategyProfile<double> &p_start) const
   minimizer.Set(F, (const Vector<double> &) p,
 		fval, gradient, .01, .0001);
 
+  m_progress.Start();
   for (int iter = 1; iter <= m_maxitsN; iter++) {
+    m_progress.Report(0);
+    try {
+      Checkpoint();
+    }
+    catch (SolverInterrupted &) {
+      break;
+    }
     if (!minimizer.Iterate(F, (Vector<double> &) p, fval, gradient, dx)) {
       break;
     }
@@ -155,6 +163,7 @@ NashLiapStrategySolver::Solve(const MixedStrategyProfile<double> &p_start) const
     this->m_onEquilibrium->Render(p, "end");
   }
 
+  m_progress.Finish(solutions.Length());
   return solutions;
 }
 
@@ -31,7 +31,7 @@ using namespace Gambit::Nash;
 class NashLiapStrategySolver : public StrategySolver<double> {
 public:
   NashLiapStrategySolver(int p_maxitsN, bool p_verbose = false,
-			 shared_ptr<StrategyProfileRenderer<double> > p_onEquilibrium = 0)
+			 Gambit::shared_ptr<StrategyProfileRenderer<double> > p_onEquilibrium = 0)
     : StrategySolver<double>(p_onEquilibrium),
       m_maxitsN(p_maxitsN), m_verbose(p_verbose)
   { }
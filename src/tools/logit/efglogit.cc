@@ -104,7 +104,7 @@ private:
   };
 
   Array<Equation *> m_equations;
-  const Game &m_game;
+  Game m_game;
 };
 
 AgentQREPathTracer::EquationSystem::EquationSystem(const Game &p_game)
@@ -57,6 +57,7 @@ void PrintHelp(char *progname)
   std::cerr << "  -L FILE          compute maximum likelihood estimates;\n";
   std::cerr << "                   read strategy frequencies from FILE\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          write solver statistics to standard error, as JSON\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -e               print only the terminal equilibrium\n";
   std::cerr << "                   (default is to print the entire branch)\n";
@@ -100,9 +101,11 @@ int main(int argc, char *argv[])
   bool fullGraph = true;
   int decimals = 6;
 
+  int printStats = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
+    { "stats", 0, &printStats, 1 },
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
@@ -141,6 +144,8 @@ int main(int argc, char *argv[])
     case 'l':
       targetLambda = atof(optarg);
       break;
+    case 0:
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -189,6 +194,10 @@ int main(int argc, char *argv[])
       tracer.SetFullGraph(fullGraph);
       tracer.SetDecimals(decimals);
       tracer.Estimate(start, frequencies, std::cout, maxLambda, 1.0);
+      if (printStats) {
+	Stats::WriteJSON(std::cerr);
+	std::cerr << std::endl;
+      }
       return 0;
     }
 
@@ -215,6 +224,10 @@ int main(int argc, char *argv[])
       tracer.SetDecimals(decimals);
       tracer.TraceAgentPath(start, std::cout, maxLambda, 1.0, targetLambda);
     }
+    if (printStats) {
+      Stats::WriteJSON(std::cerr);
+      std::cerr << std::endl;
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
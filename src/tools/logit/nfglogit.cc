@@ -46,7 +46,7 @@ public:
 			   Matrix<double> &p_matrix) const;
 
 private:
-  const Game &m_game;
+  Game m_game;
 };
 
 void 
@@ -186,7 +186,7 @@ public:
   
 private:
   std::ostream &m_stream;
-  const Game &m_game;
+  Game m_game;
   bool m_fullGraph;
   double m_decimals;
   mutable List<LogitQREMixedStrategyProfile> m_profiles;
@@ -256,6 +256,213 @@ StrategicQREPathTracer::SolveAtLambda(const LogitQREMixedStrategyProfile &p_star
   return func.GetProfiles().back();
 }
 
+//----------------------------------------------------------------------------
+//        StrategicQREPathTracer: Continuation between related games
+//----------------------------------------------------------------------------
+
+//
+// The QRE conditions at a fixed lambda, for the game with payoffs
+// (1-t) u_from + t u_to.  The last coordinate of a point is t.
+//
+class StrategicQREPathTracer::GameHomotopySystem : public PathTracer::EquationSystem {
+public:
+  GameHomotopySystem(const Game &p_from, const Game &p_to, double p_lambda)
+    : m_from(p_from), m_to(p_to), m_lambda(p_lambda) { }
+  virtual ~GameHomotopySystem() { }
+  // Compute the value of the system of equations at the specified point.
+  virtual void GetValue(const Vector<double> &p_point,
+  	                Vector<double> &p_lhs) const;
+  // Compute the Jacobian matrix at the specified point.
+  virtual void GetJacobian(const Vector<double> &p_point,
+			   Matrix<double> &p_matrix) const;
+
+private:
+  Game m_from, m_to;
+  double m_lambda;
+};
+
+void 
+StrategicQREPathTracer::GameHomotopySystem::GetValue(const Vector<double> &p_point,
+						     Vector<double> &p_lhs) const
+{
+  MixedStrategyProfile<double> from(m_from->NewMixedStrategyProfile(0.0));
+  MixedStrategyProfile<double> to(m_to->NewMixedStrategyProfile(0.0));
+  for (int i = 1; i <= from.MixedProfileLength(); i++) {
+    from[i] = to[i] = exp(p_point[i]);
+  }
+  double t = p_point[p_point.Length()];
+  p_lhs = 0.0;
+  for (int rowno = 0, pl = 1; pl <= m_from->NumPlayers(); pl++) {
+    GamePlayer player = m_from->Players()[pl];
+    GamePlayer player2 = m_to->Players()[pl];
+    int base = rowno;
+    for (int st = 1; st <= player->Strategies().Length(); st++) {
+      rowno++;
+      if (st == 1) {
+	// This is a sum-to-one equation
+	p_lhs[rowno] = -1.0;
+	for (int j = 1; j <= player->Strategies().Length(); j++) {
+	  p_lhs[rowno] += from[player->GetStrategy(j)];
+	}
+      }
+      else {
+	// This is a ratio equation, in the interpolated payoffs
+	double diff0 = (from.GetPayoff(player->GetStrategy(st)) -
+			from.GetPayoff(player->GetStrategy(1)));
+	double diff1 = (to.GetPayoff(player2->GetStrategy(st)) -
+			to.GetPayoff(player2->GetStrategy(1)));
+	p_lhs[rowno] = (p_point[rowno] - p_point[base + 1] -
+			m_lambda * ((1.0 - t) * diff0 + t * diff1));
+      }
+    }
+  }
+}
+
+void
+StrategicQREPathTracer::GameHomotopySystem::GetJacobian(const Vector<double> &p_point,
+							Matrix<double> &p_matrix) const
+{
+  MixedStrategyProfile<double> from(m_from->NewMixedStrategyProfile(0.0));
+  MixedStrategyProfile<double> to(m_to->NewMixedStrategyProfile(0.0));
+  for (int i = 1; i <= from.MixedProfileLength(); i++) {
+    from[i] = to[i] = exp(p_point[i]);
+  }
+  double t = p_point[p_point.Length()];
+
+  p_matrix = 0.0;
+
+  for (int rowno = 0, i = 1; i <= m_from->NumPlayers(); i++) {
+    GamePlayer player = m_from->Players()[i];
+    GamePlayer playerTo = m_to->Players()[i];
+    for (int j = 1; j <= player->Strategies().Length(); j++) {
+      rowno++;
+      if (j == 1) {
+	// This is a sum-to-one equation
+	for (int colno = 0, ell = 1; ell <= m_from->NumPlayers(); ell++) {
+	  GamePlayer player2 = m_from->Players()[ell];
+	  for (int m = 1; m <= player2->Strategies().Length(); m++) {
+	    colno++;
+	    if (i == ell) {
+	      p_matrix(colno, rowno) = from[player2->GetStrategy(m)];
+	    }
+	    // Otherwise, entry is zero
+	  }
+	}
+	// The last column is derivative wrt t, which is zero
+      }
+      else {
+	// This is a ratio equation
+	for (int colno = 0, ell = 1; ell <= m_from->NumPlayers(); ell++) {
+	  GamePlayer player2 = m_from->Players()[ell];
+	  GamePlayer player2To = m_to->Players()[ell];
+  	  for (int m = 1; m <= player2->Strategies().Length(); m++) {
+	    colno++;
+	    if (i == ell) {
+	      if (m == 1) {
+		p_matrix(colno, rowno) = -1.0;
+	      }
+	      else if (m == j) {
+		p_matrix(colno, rowno) = 1.0;
+	      }
+	      // Entry is zero for all other strategy pairs
+	    }
+	    else {
+	      double deriv0 =
+		(from.GetPayoffDeriv(i, player->GetStrategy(j),
+				     player2->GetStrategy(m)) -
+		 from.GetPayoffDeriv(i, player->GetStrategy(1),
+				     player2->GetStrategy(m)));
+	      double deriv1 =
+		(to.GetPayoffDeriv(i, playerTo->GetStrategy(j),
+				   player2To->GetStrategy(m)) -
+		 to.GetPayoffDeriv(i, playerTo->GetStrategy(1),
+				   player2To->GetStrategy(m)));
+	      p_matrix(colno, rowno) =
+		-m_lambda * from[player2->GetStrategy(m)] *
+		((1.0 - t) * deriv0 + t * deriv1);
+	    }
+	  }
+	}
+	// Fill the last column, the derivative wrt t
+	p_matrix(p_matrix.NumRows(), rowno) =
+	  -m_lambda * ((to.GetPayoff(playerTo->GetStrategy(j)) -
+			to.GetPayoff(playerTo->GetStrategy(1))) -
+		       (from.GetPayoff(player->GetStrategy(j)) -
+			from.GetPayoff(player->GetStrategy(1))));
+      }
+    }
+  }
+}
+
+//
+// Records the last point reached in tracing
+//
+class StrategicQREPathTracer::LastPointCallback : public PathTracer::CallbackFunction {
+public:
+  LastPointCallback(int p_length) : m_point(p_length) { }
+  virtual ~LastPointCallback() { }
+
+  virtual void operator()(const Vector<double> &p_point,
+			  bool p_isTerminal) const
+  { m_point = p_point; }
+  const Vector<double> &GetPoint(void) const { return m_point; }
+
+private:
+  mutable Vector<double> m_point;
+};
+
+LogitQREMixedStrategyProfile
+StrategicQREPathTracer::SolveAtGame(const LogitQREMixedStrategyProfile &p_start,
+				    const Game &p_game) const
+{
+  Game from = p_start.GetGame();
+  if (from->NumPlayers() != p_game->NumPlayers()) {
+    throw DimensionException();
+  }
+  for (int pl = 1; pl <= from->NumPlayers(); pl++) {
+    if (from->Players()[pl]->Strategies().size() !=
+	p_game->Players()[pl]->Strategies().size()) {
+      throw DimensionException();
+    }
+  }
+
+  GameHomotopySystem system(from, p_game, p_start.GetLambda());
+  // The path from t = 0 to t = 1 is short and nearly straight when the
+  // games are close, so it is worth starting with a long step
+  StrategicQREPathTracer tracer(*this);
+  tracer.SetStepsize(0.25);
+  // The orientation of the path at the start is not known in advance.
+  // Tracing the wrong way leaves the range of t at the first step, so
+  // trying the other orientation costs little.
+  double omega = 1.0;
+  for (int attempt = 1; attempt <= 2; attempt++, omega = -omega) {
+    Vector<double> x(p_start.MixedProfileLength() + 1);
+    for (int i = 1; i <= p_start.MixedProfileLength(); i++) {
+      x[i] = log(p_start[i]);
+    }
+    x[x.Length()] = 0.0;
+    LastPointCallback func(x.Length());
+    tracer.TracePath(system, x, 2.0, omega, func, LambdaCriterion(1.0));
+
+    const Vector<double> &end = func.GetPoint();
+    if (fabs(end[end.Length()] - 1.0) < 1.0e-6) {
+      MixedStrategyProfile<double> profile(p_game->NewMixedStrategyProfile(0.0));
+      for (int i = 1; i <= profile.MixedProfileLength(); i++) {
+	profile[i] = exp(end[i]);
+      }
+      return LogitQREMixedStrategyProfile(profile, p_start.GetLambda());
+    }
+    if (end[end.Length()] > 0.0) {
+      // The path turned back before reaching p_game
+      break;
+    }
+  }
+
+  std::ostream null_stream(0);
+  return SolveAtLambda(LogitQREMixedStrategyProfile(p_game), null_stream,
+		       p_start.GetLambda(), 1.0);
+}
+
 //----------------------------------------------------------------------------
 //                 StrategicQREEstimator: Criterion function
 //----------------------------------------------------------------------------
@@ -315,7 +522,7 @@ private:
   void PrintProfile(const MixedStrategyProfile<double> &, double) const;
 
   std::ostream &m_stream;
-  const Game &m_game;
+  Game m_game;
   const Vector<double> &m_frequencies;
   bool m_fullGraph;
   double m_decimals;
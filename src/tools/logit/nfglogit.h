@@ -71,6 +71,15 @@ public:
 					     std::ostream &p_logStream,
 					     double p_targetLambda,
 					     double p_omega) const;
+  // Computes the QRE of p_game at the lambda of p_start, a QRE of another
+  // game with the same dimensions.  This follows the QREs of the games
+  // with payoffs interpolated from those of p_start's game to those of
+  // p_game, holding lambda fixed; for nearby games this is much cheaper
+  // than tracing p_game's branch from the centroid.  If the path does
+  // not reach p_game (as may happen at large lambda), this falls back to
+  // SolveAtLambda() from the centroid of p_game.
+  LogitQREMixedStrategyProfile SolveAtGame(const LogitQREMixedStrategyProfile &p_start,
+					   const Game &p_game) const;
   
   void SetFullGraph(bool p_fullGraph) { m_fullGraph = p_fullGraph; }
   bool GetFullGraph(void) const { return m_fullGraph; }
@@ -85,6 +94,8 @@ protected:
   class EquationSystem;
   class LambdaCriterion;
   class CallbackFunction;
+  class GameHomotopySystem;
+  class LastPointCallback;
 };
 
 
@@ -75,6 +75,7 @@ void Givens(Matrix<double> &b, Matrix<double> &q,
 
 void QRDecomp(Matrix<double> &b, Matrix<double> &q)
 {
+  Stats::Count(Stats::QR_DECOMPOSITIONS);
   q.MakeIdent();
   for (int m = 1; m <= b.NumColumns(); m++) {
     for (int k = m + 1; k <= b.NumRows(); k++) {
@@ -120,6 +121,7 @@ PathTracer::TracePath(const EquationSystem &p_system,
 		      const CallbackFunction &p_callback,
 		      const CriterionFunction &p_criterion) const
 {
+  Stats::PhaseTimer phase("path.trace");
   const double c_tol = 1.0e-4;     // tolerance for corrector iteration
   const double c_maxDist = 0.4;    // maximal distance to curve
   const double c_maxContr = 0.6;   // maximal contraction rate in corrector
@@ -140,6 +142,7 @@ PathTracer::TracePath(const EquationSystem &p_system,
 
   p_callback(x, false);
   p_system.GetJacobian(x, b);
+  Stats::Count(Stats::JACOBIAN_BUILDS);
   QRDecomp(b, q);
   q.GetRow(q.NumRows(), t);
   
@@ -161,6 +164,7 @@ PathTracer::TracePath(const EquationSystem &p_system,
 
     double decel = 1.0 / m_maxDecel;  // initialize deceleration factor
     p_system.GetJacobian(u, b);
+    Stats::Count(Stats::JACOBIAN_BUILDS);
     QRDecomp(b, q);
 
     int iter = 1;
@@ -246,9 +250,19 @@ PathTracer::TracePath(const EquationSystem &p_system,
     }
 
     // PC step was successful; update and iterate
+    Stats::Count(Stats::PATH_STEPS);
     x = u;
     p_callback(x, false);
 
+    if (m_context.get()) {
+      try {
+	m_context->Check();
+      }
+      catch (SolverInterrupted &) {
+	break;
+      }
+    }
+
     if (t * newT < 0.0) {
       // Bifurcation detected; for now, just "jump over" and continue,
       // taking into account the change in orientation of the curve.
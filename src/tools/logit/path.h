@@ -94,6 +94,12 @@ public:
   void SetStepsize(double p_hStart) { m_hStart = p_hStart; }
   double GetStepsize(void) const { return m_hStart; }
 
+  // The context is checked at each accepted step; once it is exhausted,
+  // the last point reached is treated as the end of the path.
+  void SetContext(shared_ptr<SolverContext> p_context)
+  { m_context = p_context; }
+  shared_ptr<SolverContext> GetContext(void) const { return m_context; }
+
 protected:
   PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03)
     { } 
@@ -106,6 +112,7 @@ protected:
 
 private:
   double m_maxDecel, m_hStart;
+  shared_ptr<SolverContext> m_context;
 };
 
 }  // end namespace Gambit
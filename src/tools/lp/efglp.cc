@@ -149,8 +149,15 @@ NashLpBehavSolver<T>::SolveLP(const Matrix<T> &A,
 			      int nequals,
 			      Array<T> &p_primal, Array<T> &p_dual) const
 {
-  Gambit::linalg::LPSolve<T> LP(A, b, c, nequals);
-  const Gambit::linalg::BFS<T> &cbfs(LP.OptimumBFS());
+  Stats::PhaseTimer phase("lp.solve");
+  Gambit::linalg::BFS<T> cbfs;
+  try {
+    Gambit::linalg::LPSolve<T> LP(A, b, c, nequals, this->m_context.get());
+    cbfs = LP.OptimumBFS();
+  }
+  catch (SolverInterrupted &) {
+    return false;
+  }
   
   for (int i = 1; i <= A.NumColumns(); i++) {
     if (cbfs.count(i)) {
@@ -249,6 +256,7 @@ NashLpBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   }
 
   Gambit::linalg::BFS<T> cbfs;
+  this->m_progress.Start();
   
   GameData data(p_support.GetGame());
 
@@ -278,6 +286,7 @@ NashLpBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
     this->m_onEquilibrium->Render(profile);
     solution.push_back(profile);
   }
+  this->m_progress.Finish(solution.Length());
   return solution;
 }
 
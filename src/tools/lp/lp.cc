@@ -52,8 +52,12 @@ void PrintHelp(char *progname)
   std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -S               use strategic game\n";
+  std::cerr << "  -H               find the optimal basis in floating point,\n";
+  std::cerr << "                   and solve exactly only in that basis\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          write solver statistics to standard error, as JSON\n";
+  std::cerr << "  --binary         write equilibria in the compact binary format\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
@@ -64,15 +68,18 @@ int main(int argc, char *argv[])
   int c;
   int numDecimals = 6;
   bool useFloat = false, useStrategic = false, quiet = false, printDetail = false;
-  bool bySubgames = false;
+  bool bySubgames = false, useHybrid = false;
 
+  int printStats = 0, printBinary = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
+    { "stats", 0, &printStats, 1 },
+    { "binary", 0, &printBinary, 1 },
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvqhSP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvqhSHP", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -92,9 +99,14 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'H':
+      useHybrid = true;
+      break;
     case 'P':
       bySubgames = true;
       break;
+    case 0:
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -108,6 +120,10 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (printBinary) {
+    SetBinaryStdout();
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -127,7 +143,15 @@ int main(int argc, char *argv[])
 
   try {
     Gambit::Game game = Gambit::ReadGame(*input_stream);
-    std::cout << "Game reading complete." << std::endl;
+    shared_ptr<ProgressObserver> progress;
+    if (printStats) {
+      progress = new ProgressJSONWriter(std::cerr);
+    }
+    if (!printBinary) {
+      // Text output is read line by line, and this line skipped; in the
+      // binary format, the header must come first
+      std::cout << "Game reading complete." << std::endl;
+    }
     if (!game->IsTree() || useStrategic) {
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
@@ -135,10 +159,14 @@ int main(int argc, char *argv[])
 	  renderer = new MixedStrategyDetailRenderer<double>(std::cout,
 							     numDecimals);
 	}
+	else if (printBinary) {
+	  renderer = new MixedStrategyBinaryRenderer<double>(std::cout);
+	}
 	else {
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
 	NashLpStrategySolver<double> algorithm(renderer);
+	algorithm.SetProgressObserver(progress);
 	algorithm.Solve(game);
       }
       else {
@@ -146,10 +174,14 @@ int main(int argc, char *argv[])
 	if (printDetail) {
 	  renderer = new MixedStrategyDetailRenderer<Rational>(std::cout);
 	}
+	else if (printBinary) {
+	  renderer = new MixedStrategyBinaryRenderer<Rational>(std::cout);
+	}
 	else {
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
-	NashLpStrategySolver<Rational> algorithm(renderer);
+	NashLpStrategySolver<Rational> algorithm(renderer, useHybrid);
+	algorithm.SetProgressObserver(progress);
 	algorithm.Solve(game);
       }
     }
@@ -161,11 +193,15 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyDetailRenderer<double>(std::cout,
 							       numDecimals);
 	  }
+	  else if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<double>(std::cout);
+	  }
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
 	  NashLpBehavSolver<double> algorithm(renderer);
+	  algorithm.SetProgressObserver(progress);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -173,14 +209,20 @@ int main(int argc, char *argv[])
 	  if (printDetail) {
 	    renderer = new BehavStrategyDetailRenderer<Rational>(std::cout);
 	  }
+	  else if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<Rational>(std::cout);
+	  }
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout);
 	  }
 	  NashLpBehavSolver<Rational> algorithm(renderer);
+	  algorithm.SetProgressObserver(progress);
 	  algorithm.Solve(game);
 	}
       }
       else {
+	// Equilibria are not reused between subgames which differ by a
+	// rescaling of payoffs, as the LP solves only constant-sum games
 	if (useFloat) {
 	  shared_ptr<BehavSolver<double> > stage = 
 	    new NashLpBehavSolver<double>();
@@ -189,11 +231,15 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyDetailRenderer<double>(std::cout,
 							       numDecimals);
 	  }
+	  else if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<double>(std::cout);
+	  }
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
-	  SubgameBehavSolver<double> algorithm(stage, renderer);
+	  SubgameBehavSolver<double> algorithm(stage, renderer, 1, false);
+	  algorithm.SetProgressObserver(progress);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -204,15 +250,23 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyDetailRenderer<Rational>(std::cout,
 								 numDecimals);
 	  }
+	  else if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<Rational>(std::cout);
+	  }
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout, 
 							      numDecimals);
 	  }
-	  SubgameBehavSolver<Rational> algorithm(stage, renderer);
+	  SubgameBehavSolver<Rational> algorithm(stage, renderer, 1, false);
+	  algorithm.SetProgressObserver(progress);
 	  algorithm.Solve(game);
 	}
       }
     }
+    if (printStats) {
+      Stats::WriteJSON(std::cerr);
+      std::cerr << std::endl;
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -25,10 +25,31 @@
 #include <iostream>
 #include "gambit/gambit.h"
 #include "gambit/linalg/lpsolve.h"
+#include "gambit/linalg/exactbasis.h"
 #include "nfglp.h"
 
 using namespace Gambit;
 
+namespace {
+
+//
+// Player 1's strategy is the primal solution, and player 2's the dual
+//
+template <class T> void SetProfile(MixedStrategyProfile<T> &p_profile,
+				   const Array<T> &p_primal,
+				   const Array<T> &p_dual)
+{
+  Game game = p_profile.GetGame();
+  for (int j = 1; j <= game->Players()[1]->Strategies().Length(); j++) {
+    p_profile[game->Players()[1]->Strategies()[j]] = p_primal[j];
+  }
+  for (int j = 1; j <= game->Players()[2]->Strategies().Length(); j++) {
+    p_profile[game->Players()[2]->Strategies()[j]] = p_dual[j];
+  }
+}
+
+}  // end anonymous namespace
+
 //
 // The routine to actually solve the LP
 // This routine takes an LP of the form
@@ -48,8 +69,15 @@ NashLpStrategySolver<T>::SolveLP(const Matrix<T> &A,
 				 int nequals,
 				 Array<T> &p_primal, Array<T> &p_dual) const
 {
-  Gambit::linalg::LPSolve<T> LP(A, b, c, nequals);
-  const Gambit::linalg::BFS<T> &cbfs(LP.OptimumBFS());
+  Stats::PhaseTimer phase("lp.solve");
+  Gambit::linalg::BFS<T> cbfs;
+  try {
+    Gambit::linalg::LPSolve<T> LP(A, b, c, nequals, this->m_context.get());
+    cbfs = LP.OptimumBFS();
+  }
+  catch (SolverInterrupted &) {
+    return false;
+  }
 
   for (int i = 1; i <= A.NumColumns(); i++) {
     if (cbfs.count(i)) {
@@ -71,6 +99,85 @@ NashLpStrategySolver<T>::SolveLP(const Matrix<T> &A,
   return true;
 }
 
+//
+// Solves the LP in floating point, and then computes the primal and
+// dual solutions in the optimal basis found exactly.  Returns false if
+// the floating-point solution fails or its basis is singular; the
+// caller is responsible for certifying the result.
+//
+template <class T> bool
+NashLpStrategySolver<T>::SolveLPHybrid(const Matrix<T> &A, 
+				       const Vector<T> &b, const Vector<T> &c,
+				       int nequals,
+				       Array<T> &p_primal, Array<T> &p_dual) const
+{
+  Matrix<double> Ad(A.MinRow(), A.MaxRow(), A.MinCol(), A.MaxCol());
+  Vector<double> bd(b.First(), b.Last()), cd(c.First(), c.Last());
+  for (int i = A.MinRow(); i <= A.MaxRow(); i++) {
+    bd[i] = (double) b[i];
+    for (int j = A.MinCol(); j <= A.MaxCol(); j++) {
+      Ad(i, j) = (double) A(i, j);
+    }
+  }
+  for (int j = c.First(); j <= c.Last(); j++) {
+    cd[j] = (double) c[j];
+  }
+
+  Array<int> labels(A.MinRow(), A.MaxRow());
+  Vector<T> x(A.MinRow(), A.MaxRow()), y(A.MinRow(), A.MaxRow());
+  Vector<T> cost(A.MinRow(), A.MaxRow());
+  try {
+    Stats::PhaseTimer guidePhase("lp.guide");
+    Gambit::linalg::LPSolve<double> LP(Ad, bd, cd, nequals,
+				       this->m_context.get());
+    if (!LP.IsFeasible() || !LP.IsBounded()) {
+      return false;
+    }
+    for (int i = A.MinRow(); i <= A.MaxRow(); i++) {
+      labels[i] = LP.GetTableau().Label(i);
+      cost[i] = (labels[i] > 0) ? c[labels[i]] : (T) 0;
+    }
+  }
+  catch (std::runtime_error &) {
+    return false;
+  }
+
+  try {
+    Stats::PhaseTimer certifyPhase("lp.certify");
+    Gambit::linalg::ExactBasis basis(A, labels);
+    basis.Solve(b, x);
+    basis.SolveT(cost, y);
+  }
+  catch (std::runtime_error &) {
+    return false;
+  }
+
+  for (int i = 1; i <= A.NumColumns(); i++) {
+    p_primal[i] = (T) 0;
+  }
+  for (int i = A.MinRow(); i <= A.MaxRow(); i++) {
+    if (labels[i] > 0) {
+      p_primal[labels[i]] = x[i];
+    }
+  }
+  // Rows whose slack is basic get a zero price, since slacks cost nothing
+  for (int i = 1; i <= A.NumRows(); i++) {
+    p_dual[i] = y[i];
+  }
+  return true;
+}
+
+template<> bool
+NashLpStrategySolver<double>::SolveLPHybrid(const Matrix<double> &,
+					    const Vector<double> &,
+					    const Vector<double> &, int,
+					    Array<double> &,
+					    Array<double> &) const
+{
+  // Floating-point solutions need no certificate
+  return false;
+}
+
 //
 // Compute and print one equilibrium by solving a linear program based
 // on the strategic game representation.
@@ -88,6 +195,7 @@ NashLpStrategySolver<T>::Solve(const Game &p_game) const
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
 
+  this->m_progress.Start();
   int m = p_game->Players()[1]->Strategies().size();
   int k = p_game->Players()[2]->Strategies().size();
 
@@ -117,20 +225,25 @@ NashLpStrategySolver<T>::Solve(const Game &p_game) const
   c[m+1] = (T) 1;
   
   Array<T> primal(A.NumColumns()), dual(A.NumRows());
-  if (!SolveLP(A, b, c, 1, primal, dual)) {
-    return List<MixedStrategyProfile<T> >();
-  }
-
   MixedStrategyProfile<T> eqm(p_game->NewMixedStrategyProfile(static_cast<T>(0)));
-  for (int j = 1; j <= m; j++) {
-    eqm[p_game->Players()[1]->Strategies()[j]] = primal[j];
+  // A solution from a floating-point basis is accepted only if it
+  // is exactly an equilibrium
+  bool solved = false;
+  if (m_hybrid && SolveLPHybrid(A, b, c, 1, primal, dual)) {
+    SetProfile(eqm, primal, dual);
+    solved = (eqm.GetLiapValue() == (T) 0);
   }
-  for (int j = 1; j <= k; j++) {
-    eqm[p_game->Players()[2]->Strategies()[j]] = dual[j];
+  if (!solved) {
+    if (!SolveLP(A, b, c, 1, primal, dual)) {
+      this->m_progress.Finish(0);
+      return List<MixedStrategyProfile<T> >();
+    }
+    SetProfile(eqm, primal, dual);
   }
   this->m_onEquilibrium->Render(eqm);
   List<MixedStrategyProfile<T> > solution;
   solution.push_back(eqm);
+  this->m_progress.Finish(solution.Length());
   return solution;
 }
 
@@ -28,17 +28,29 @@
 using namespace Gambit;
 using namespace Gambit::Nash;
 
+//
+// If p_hybrid is set (meaningful only for exact arithmetic), the optimal
+// basis is found using floating-point arithmetic, and only the solution
+// in that basis is computed exactly.  The resulting profile is accepted
+// if it is exactly an equilibrium; otherwise the LP is solved again using
+// exact pivoting.
+//
 template <class T> class NashLpStrategySolver : public StrategySolver<T> {
 public:
-  NashLpStrategySolver(Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
-    : StrategySolver<T>(p_onEquilibrium) { }
+  NashLpStrategySolver(Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+		       bool p_hybrid = false)
+    : StrategySolver<T>(p_onEquilibrium), m_hybrid(p_hybrid) { }
   virtual ~NashLpStrategySolver() { }
 
   virtual List<MixedStrategyProfile<T> > Solve(const Game &) const;
 
 private:
+  bool m_hybrid;
+
   virtual bool SolveLP(const Matrix<T> &, const Vector<T> &, const Vector<T> &,
 		       int, Array<T> &, Array<T> &) const;
+  bool SolveLPHybrid(const Matrix<T> &, const Vector<T> &, const Vector<T> &,
+		     int, Array<T> &, Array<T> &) const;
 };
 
 
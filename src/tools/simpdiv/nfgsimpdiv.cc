@@ -87,8 +87,16 @@ void PrintHelp(char *progname)
   std::cerr << "With no options, computes one approximate Nash equilibrium.\n\n";
 
   std::cerr << "Options:\n";
+  std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
+  std::cerr << "                   display results with DECIMALS digits\n";
+  std::cerr << "  -e EQA           terminate after finding EQA distinct equilibria\n";
+  std::cerr << "                   (default is to solve from every starting point)\n";
   std::cerr << "  -g MULT          granularity of grid refinement at each step (default is 2)\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  --stats          write solver statistics to standard error, as JSON\n";
+  std::cerr << "  --binary         write equilibria in the compact binary format\n";
+  std::cerr << "  -j THREADS       solve from starting points using THREADS threads\n";
+  std::cerr << "                   (default 1)\n";
   std::cerr << "  -r DENOM         generate random starting points with denominator DENOM\n";
   std::cerr << "  -n COUNT         number of starting points to generate (requires -r)\n";
   std::cerr << "  -s FILE          file containing starting points\n";
@@ -104,33 +112,47 @@ int main(int argc, char *argv[])
   opterr = 0;
   std::string startFile;
   bool useRandom = false;
-  int randDenom = 1, gridResize = 2, stopAfter = 1;
-  bool verbose = false, quiet = false;
+  int randDenom = 1, gridResize = 2, numStarts = 1, stopAfter = 0;
+  int numDecimals = 6, numThreads = 1;
+  bool useFloat = false, verbose = false, quiet = false;
 
+  int printStats = 0, printBinary = 0;
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
+    { "stats", 0, &printStats, 1 },
+    { "binary", 0, &printBinary, 1 },
     { "version", 0, NULL, 'v'  },
     { "verbose", 0, NULL, 'V'  },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:e:g:hj:Vvn:r:s:qS", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
+    case 'd':
+      useFloat = true;
+      numDecimals = atoi(optarg);
+      break;
+    case 'e':
+      stopAfter = atoi(optarg);
+      break;
     case 'g':
       gridResize = atoi(optarg);
       break;
     case 'h':
       PrintHelp(argv[0]);
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 'r':
       useRandom = true;
       randDenom = atoi(optarg);
       break;
     case 'n':
-      stopAfter = atoi(optarg);
+      numStarts = atoi(optarg);
       break;
     case 's':
       startFile = optarg;
@@ -143,6 +165,8 @@ int main(int argc, char *argv[])
       break;
     case 'S':
       break;
+    case 0:
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -156,6 +180,10 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (printBinary) {
+    SetBinaryStdout();
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -175,13 +203,17 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    shared_ptr<ProgressObserver> progress;
+    if (printStats) {
+      progress = new ProgressJSONWriter(std::cerr);
+    }
     List<MixedStrategyProfile<Rational> > starts;
     if (startFile != "") {
       std::ifstream startPoints(startFile.c_str());
       starts = ReadProfiles(game, startPoints);
     }
     else if (useRandom) {
-      starts = RandomProfiles(game, stopAfter, randDenom);
+      starts = RandomProfiles(game, numStarts, randDenom);
     }
     else {
       starts.push_back(game->NewMixedStrategyProfile(Rational(0)));
@@ -190,12 +222,35 @@ int main(int argc, char *argv[])
 	starts[1][game->Players()[pl]->Strategies()[1]] = Rational(1);
       }
     }
-    for (int i = 1; i <= starts.size(); i++) {
+    if (useFloat) {
+      shared_ptr<StrategyProfileRenderer<double> > renderer;
+      if (printBinary) {
+	renderer = new MixedStrategyBinaryRenderer<double>(std::cout);
+      }
+      else {
+	renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
+      }
+      NashSimpdivStrategySolver<double> algorithm(gridResize, 0, verbose,
+						  renderer);
+      algorithm.SetProgressObserver(progress);
+      algorithm.Solve(starts, stopAfter, numThreads);
+    }
+    else {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-      renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      NashSimpdivStrategySolver algorithm(gridResize, 0, verbose,
-					  renderer);
-      algorithm.Solve(starts[i]);
+      if (printBinary) {
+	renderer = new MixedStrategyBinaryRenderer<Rational>(std::cout);
+      }
+      else {
+	renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      }
+      NashSimpdivStrategySolver<Rational> algorithm(gridResize, 0, verbose,
+						    renderer);
+      algorithm.SetProgressObserver(progress);
+      algorithm.Solve(starts, stopAfter, numThreads);
+    }
+    if (printStats) {
+      Stats::WriteJSON(std::cerr);
+      std::cerr << std::endl;
     }
     return 0;
   }